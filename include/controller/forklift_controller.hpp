@@ -43,6 +43,8 @@ namespace hako::robots::controller {
         }
         Forklift& getForklift() { return forklift; }
         void set_delta_pos(double delta) { delta_pos = delta; }
+        // Time between update() calls; the physics timestep by default.
+        void set_control_period(double period) { dt = period; }
         void update_target_lift_z(double ctrl_value) 
         {
             if (ctrl_value > 0) {
@@ -98,11 +100,12 @@ namespace hako::robots::controller {
         void update() {
             double left_torque = 0.0;
             double right_torque = 0.0;
+            const auto& state = forklift.getState();
             drive_ctrl.update(
                 target_linear_vel,
                 target_yaw_rate,
-                forklift.getBodyVelocity().x,
-                forklift.getBodyAngularVelocity().z,
+                state.body_velocity.x,
+                state.body_angular_velocity.z,
                 dt,
                 left_torque, right_torque
             );
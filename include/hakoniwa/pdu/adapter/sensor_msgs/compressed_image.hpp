@@ -0,0 +1,56 @@
+#pragma once
+
+#include "hakoniwa/pdu/converter/sensor_msgs/compressed_image.hpp"
+#include "hakoniwa/pdu/endpoint.hpp"
+#include "hakoniwa/pdu/type_endpoint.hpp"
+#include "sensor_msgs/pdu_cpptype_CompressedImage.hpp"
+#include "sensor_msgs/pdu_cpptype_conv_CompressedImage.hpp"
+#include "sensors/camera/image_codecs.hpp"
+
+namespace hako::robots::pdu::adapter::sensor_msgs
+{
+    class CompressedImagePduAdapter
+    {
+    public:
+        CompressedImagePduAdapter(
+            hakoniwa::pdu::Endpoint& endpoint,
+            const hakoniwa::pdu::PduKey& key)
+            : endpoint_(endpoint, key)
+        {
+        }
+
+        bool send(const hako::robots::sensor::camera::CompressedImageFrame& frame)
+        {
+            // A Hakoniwa PDU channel is single-writer by convention.
+            // Multiple readers may call recv(), but only one component should call send() for this PduKey.
+            HakoCpp_CompressedImage pdu {};
+            if (!hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(frame, pdu)) {
+                return false;
+            }
+            return endpoint_.send(pdu) == HAKO_PDU_ERR_OK;
+        }
+
+        // Lends frame's encoded bytes to a reused PDU for the send and hands
+        // them back, like ImagePduAdapter::send_in_place().
+        bool send_in_place(hako::robots::sensor::camera::CompressedImageFrame& frame)
+        {
+            if (!hako::robots::pdu::converter::sensor_msgs::SwapIntoHakoPdu(frame, pdu_)) {
+                return false;
+            }
+            const bool ok = endpoint_.send(pdu_) == HAKO_PDU_ERR_OK;
+            pdu_.data.swap(frame.data);
+            return ok;
+        }
+
+        bool recv(HakoCpp_CompressedImage& out)
+        {
+            return endpoint_.recv(out) == HAKO_PDU_ERR_OK;
+        }
+
+    private:
+        hakoniwa::pdu::TypedEndpoint<
+            HakoCpp_CompressedImage,
+            hako::pdu::msgs::sensor_msgs::CompressedImage> endpoint_;
+        HakoCpp_CompressedImage pdu_ {};
+    };
+}
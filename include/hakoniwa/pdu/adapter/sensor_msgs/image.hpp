@@ -30,6 +30,19 @@ namespace hako::robots::pdu::adapter::sensor_msgs
             return endpoint_.send(pdu) == HAKO_PDU_ERR_OK;
         }
 
+        // Sends frame without copying its pixels into the PDU object: the
+        // buffer is lent to a reused PDU for the send and handed back, so the
+        // only copy left is the endpoint's serialization.
+        bool send_in_place(hako::robots::sensor::camera::ImageFrame& frame)
+        {
+            if (!hako::robots::pdu::converter::sensor_msgs::SwapIntoHakoPdu(frame, pdu_)) {
+                return false;
+            }
+            const bool ok = endpoint_.send(pdu_) == HAKO_PDU_ERR_OK;
+            pdu_.data.swap(frame.data);
+            return ok;
+        }
+
         bool send(const hako::robots::sensor::camera::DepthFrame& frame)
         {
             // A Hakoniwa PDU channel is single-writer by convention.
@@ -41,6 +54,28 @@ namespace hako::robots::pdu::adapter::sensor_msgs
             return endpoint_.send(pdu) == HAKO_PDU_ERR_OK;
         }
 
+        bool send(const hako::robots::sensor::camera::DisparityFrame& frame)
+        {
+            // A Hakoniwa PDU channel is single-writer by convention.
+            // Multiple readers may call recv(), but only one component should call send() for this PduKey.
+            HakoCpp_Image pdu {};
+            if (!hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(frame, pdu)) {
+                return false;
+            }
+            return endpoint_.send(pdu) == HAKO_PDU_ERR_OK;
+        }
+
+        bool send(const hako::robots::sensor::camera::SegmentationFrame& frame)
+        {
+            // A Hakoniwa PDU channel is single-writer by convention.
+            // Multiple readers may call recv(), but only one component should call send() for this PduKey.
+            HakoCpp_Image pdu {};
+            if (!hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(frame, pdu)) {
+                return false;
+            }
+            return endpoint_.send(pdu) == HAKO_PDU_ERR_OK;
+        }
+
         bool recv(HakoCpp_Image& out)
         {
             return endpoint_.recv(out) == HAKO_PDU_ERR_OK;
@@ -50,5 +85,6 @@ namespace hako::robots::pdu::adapter::sensor_msgs
         hakoniwa::pdu::TypedEndpoint<
             HakoCpp_Image,
             hako::pdu::msgs::sensor_msgs::Image> endpoint_;
+        HakoCpp_Image pdu_ {};
     };
 }
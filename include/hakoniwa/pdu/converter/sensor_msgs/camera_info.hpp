@@ -93,4 +93,18 @@ namespace hako::robots::pdu::converter::sensor_msgs
             timestamp,
             out);
     }
+
+    inline bool ToHakoPdu(
+        const hako::robots::sensor::camera::SegmentationCameraConfig& config,
+        double timestamp,
+        HakoCpp_CameraInfo& out)
+    {
+        return detail::FillCameraInfoCommon(
+            config.frame_id,
+            config.image.width,
+            config.image.height,
+            config.horizontal_fov,
+            timestamp,
+            out);
+    }
 }
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <iostream>
+
+#include "hakoniwa/pdu/converter/common.hpp"
+#include "sensor_msgs/pdu_cpptype_CompressedImage.hpp"
+#include "sensors/camera/image_codecs.hpp"
+
+namespace hako::robots::pdu::converter::sensor_msgs
+{
+    namespace detail
+    {
+        inline bool FillCompressedImageHeader(
+            const hako::robots::sensor::camera::CompressedImageFrame& frame,
+            HakoCpp_CompressedImage& out)
+        {
+            if (frame.format.empty() || frame.data.empty()) {
+                std::cerr << "Failed to convert CompressedImageFrame: empty format or data" << std::endl;
+                return false;
+            }
+            out.header.stamp = hako::robots::pdu::converter::ToHakoTime(frame.timestamp);
+            out.header.frame_id = frame.frame_id;
+            out.format = frame.format;
+            return true;
+        }
+    }
+
+    inline bool ToHakoPdu(
+        const hako::robots::sensor::camera::CompressedImageFrame& frame,
+        HakoCpp_CompressedImage& out)
+    {
+        if (!detail::FillCompressedImageHeader(frame, out)) {
+            return false;
+        }
+        out.data = frame.data;
+        return true;
+    }
+
+    // Swaps the encoded bytes into out instead of copying them; swap again
+    // after sending to give the buffer back to the frame.
+    inline bool SwapIntoHakoPdu(
+        hako::robots::sensor::camera::CompressedImageFrame& frame,
+        HakoCpp_CompressedImage& out)
+    {
+        if (!detail::FillCompressedImageHeader(frame, out)) {
+            return false;
+        }
+        out.data.swap(frame.data);
+        return true;
+    }
+}
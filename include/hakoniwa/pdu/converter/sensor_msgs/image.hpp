@@ -12,6 +12,7 @@
 #include "hakoniwa/pdu/converter/common.hpp"
 #include "sensor_msgs/pdu_cpptype_Image.hpp"
 #include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/depth_kernels.hpp"
 
 namespace hako::robots::pdu::converter::sensor_msgs
 {
@@ -48,50 +49,86 @@ namespace hako::robots::pdu::converter::sensor_msgs
         }
     }
 
+    namespace detail
+    {
+        inline bool FillImageHeader(
+            const hako::robots::sensor::camera::ImageFrame& frame,
+            HakoCpp_Image& out)
+        {
+            const char* encoding = nullptr;
+            Hako_uint32 step = 0;
+            int channels = 0;
+
+            if (frame.format == "R8G8B8") {
+                encoding = "rgb8";
+                step = static_cast<Hako_uint32>(frame.width * 3);
+                channels = 3;
+            } else if (frame.format == "B8G8R8") {
+                encoding = "bgr8";
+                step = static_cast<Hako_uint32>(frame.width * 3);
+                channels = 3;
+            } else if (frame.format == "L8") {
+                encoding = "mono8";
+                step = static_cast<Hako_uint32>(frame.width);
+                channels = 1;
+            } else if (frame.format == "R8G8B8A8") {
+                encoding = "rgba8";
+                step = static_cast<Hako_uint32>(frame.width * 4);
+                channels = 4;
+            } else if (frame.format == "YUV422") {
+                // sensor_msgs "yuv422" is UYVY: 2 bytes per pixel.
+                encoding = "yuv422";
+                step = static_cast<Hako_uint32>(frame.width * 2);
+                channels = 2;
+            } else {
+                std::cerr << "Failed to convert ImageFrame: unsupported format '"
+                          << frame.format << "'" << std::endl;
+                return false;
+            }
+
+            if (!ValidateImageFrameCommon(
+                    frame.format,
+                    frame.width,
+                    frame.height,
+                    frame.data.size(),
+                    channels))
+            {
+                return false;
+            }
+
+            out.header.stamp = hako::robots::pdu::converter::ToHakoTime(frame.timestamp);
+            out.header.frame_id = frame.frame_id;
+            out.height = static_cast<Hako_uint32>(frame.height);
+            out.width = static_cast<Hako_uint32>(frame.width);
+            out.encoding = encoding;
+            out.is_bigendian = 0;
+            out.step = step;
+            return true;
+        }
+    }
+
     inline bool ToHakoPdu(
         const hako::robots::sensor::camera::ImageFrame& frame,
         HakoCpp_Image& out)
     {
-        std::string encoding;
-        Hako_uint32 step = 0;
-        int channels = 0;
-
-        if (frame.format == "R8G8B8") {
-            encoding = "rgb8";
-            step = static_cast<Hako_uint32>(frame.width * 3);
-            channels = 3;
-        } else if (frame.format == "B8G8R8") {
-            encoding = "bgr8";
-            step = static_cast<Hako_uint32>(frame.width * 3);
-            channels = 3;
-        } else if (frame.format == "L8") {
-            encoding = "mono8";
-            step = static_cast<Hako_uint32>(frame.width);
-            channels = 1;
-        } else {
-            std::cerr << "Failed to convert ImageFrame: unsupported format '"
-                      << frame.format << "'" << std::endl;
+        if (!detail::FillImageHeader(frame, out)) {
             return false;
         }
+        out.data = frame.data;
+        return true;
+    }
 
-        if (!detail::ValidateImageFrameCommon(
-                frame.format,
-                frame.width,
-                frame.height,
-                frame.data.size(),
-                channels))
-        {
+    // Like ToHakoPdu() but swaps the pixel buffer into out instead of copying
+    // it. frame.data receives out's previous buffer; swap again after sending
+    // to give the pixels (and their capacity) back to the frame.
+    inline bool SwapIntoHakoPdu(
+        hako::robots::sensor::camera::ImageFrame& frame,
+        HakoCpp_Image& out)
+    {
+        if (!detail::FillImageHeader(frame, out)) {
             return false;
         }
-
-        out.header.stamp = hako::robots::pdu::converter::ToHakoTime(frame.timestamp);
-        out.header.frame_id = frame.frame_id;
-        out.height = static_cast<Hako_uint32>(frame.height);
-        out.width = static_cast<Hako_uint32>(frame.width);
-        out.encoding = std::move(encoding);
-        out.is_bigendian = 0;
-        out.step = step;
-        out.data = frame.data;
+        out.data.swap(frame.data);
         return true;
     }
 
@@ -130,22 +167,13 @@ namespace hako::robots::pdu::converter::sensor_msgs
             out.encoding = "16UC1";
             out.step = static_cast<Hako_uint32>(frame.width * static_cast<int>(sizeof(std::uint16_t)));
 
-            std::vector<std::uint16_t> mm_values(expected_size, 0);
-            for (std::size_t i = 0; i < frame.data.size(); ++i) {
-                const float depth_m = frame.data[i];
-                if (!std::isfinite(depth_m) || depth_m <= 0.0F) {
-                    continue;
-                }
-                const double mm_double = std::round(static_cast<double>(depth_m) * 1000.0);
-                if (mm_double <= 0.0 ||
-                    mm_double > static_cast<double>(std::numeric_limits<std::uint16_t>::max()))
-                {
-                    continue;
-                }
-                mm_values[i] = static_cast<std::uint16_t>(mm_double);
-            }
+            // Rounded millimeters; NaN, non-positive and > 65535 mm become 0.
+            // Quantized straight into the little-endian payload bytes.
             out.data.resize(expected_size * sizeof(std::uint16_t));
-            std::memcpy(out.data.data(), mm_values.data(), out.data.size());
+            hako::robots::sensor::camera::QuantizeDepthMillimeters(
+                frame.data.data(),
+                expected_size,
+                out.data.data());
             return true;
         }
 
@@ -153,4 +181,98 @@ namespace hako::robots::pdu::converter::sensor_msgs
                   << frame.format << "'" << std::endl;
         return false;
     }
+
+    // Sent as 32FC1 disparity in pixels; NaN marks pixels without depth.
+    inline bool ToHakoPdu(
+        const hako::robots::sensor::camera::DisparityFrame& frame,
+        HakoCpp_Image& out)
+    {
+        if (frame.width <= 0 || frame.height <= 0) {
+            std::cerr << "Failed to convert DisparityFrame: invalid image size "
+                      << frame.width << "x" << frame.height << std::endl;
+            return false;
+        }
+        if (frame.format != "DISPARITY_F32_PX") {
+            std::cerr << "Failed to convert DisparityFrame: unsupported format '"
+                      << frame.format << "'" << std::endl;
+            return false;
+        }
+        const std::size_t expected_size =
+            static_cast<std::size_t>(frame.width) * static_cast<std::size_t>(frame.height);
+        if (frame.data.size() != expected_size) {
+            std::cerr << "Failed to convert DisparityFrame: data size mismatch: expected "
+                      << expected_size << ", actual " << frame.data.size() << std::endl;
+            return false;
+        }
+
+        out.header.stamp = hako::robots::pdu::converter::ToHakoTime(frame.timestamp);
+        out.header.frame_id = frame.frame_id;
+        out.height = static_cast<Hako_uint32>(frame.height);
+        out.width = static_cast<Hako_uint32>(frame.width);
+        out.is_bigendian = 0;
+        out.encoding = "32FC1";
+        out.step = static_cast<Hako_uint32>(frame.width * static_cast<int>(sizeof(float)));
+        out.data.resize(expected_size * sizeof(float));
+        std::memcpy(out.data.data(), frame.data.data(), out.data.size());
+        return true;
+    }
+
+    // LABEL_S32 is sent as 32SC1 with -1 where nothing is hit. LABEL_U16 is
+    // sent as 16UC1 holding the low 16 bits of the same values, so "nothing"
+    // becomes 65535; larger ids are rejected instead of wrapping.
+    inline bool ToHakoPdu(
+        const hako::robots::sensor::camera::SegmentationFrame& frame,
+        HakoCpp_Image& out)
+    {
+        if (frame.width <= 0 || frame.height <= 0) {
+            std::cerr << "Failed to convert SegmentationFrame: invalid image size "
+                      << frame.width << "x" << frame.height << std::endl;
+            return false;
+        }
+        const std::size_t expected_size =
+            static_cast<std::size_t>(frame.width) * static_cast<std::size_t>(frame.height);
+        if (frame.data.size() != expected_size) {
+            std::cerr << "Failed to convert SegmentationFrame: data size mismatch for format '"
+                      << frame.format << "': expected " << expected_size
+                      << ", actual " << frame.data.size() << std::endl;
+            return false;
+        }
+
+        out.header.stamp = hako::robots::pdu::converter::ToHakoTime(frame.timestamp);
+        out.header.frame_id = frame.frame_id;
+        out.height = static_cast<Hako_uint32>(frame.height);
+        out.width = static_cast<Hako_uint32>(frame.width);
+        out.is_bigendian = 0;
+
+        if (frame.format == "LABEL_S32") {
+            out.encoding = "32SC1";
+            out.step = static_cast<Hako_uint32>(frame.width * static_cast<int>(sizeof(std::int32_t)));
+            out.data.resize(expected_size * sizeof(std::int32_t));
+            std::memcpy(out.data.data(), frame.data.data(), out.data.size());
+            return true;
+        }
+        if (frame.format == "LABEL_U16") {
+            out.encoding = "16UC1";
+            out.step = static_cast<Hako_uint32>(frame.width * static_cast<int>(sizeof(std::uint16_t)));
+            // Each label is copied as two bytes; out.data holds uint8_t and
+            // must not be written through a uint16_t*.
+            out.data.resize(expected_size * sizeof(std::uint16_t));
+            auto* bytes = out.data.data();
+            for (std::size_t i = 0; i < expected_size; ++i) {
+                const std::int32_t id = frame.data[i];
+                if (id < -1 || id >= 0xFFFF) {
+                    std::cerr << "Failed to convert SegmentationFrame: id " << id
+                              << " does not fit LABEL_U16" << std::endl;
+                    return false;
+                }
+                const auto label = static_cast<std::uint16_t>(id);
+                std::memcpy(bytes + i * sizeof(label), &label, sizeof(label));
+            }
+            return true;
+        }
+
+        std::cerr << "Failed to convert SegmentationFrame: unsupported format '"
+                  << frame.format << "'" << std::endl;
+        return false;
+    }
 }
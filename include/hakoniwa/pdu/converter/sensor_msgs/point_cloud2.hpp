@@ -0,0 +1,48 @@
+#pragma once
+
+#include <iostream>
+#include <utility>
+
+#include "hakoniwa/pdu/converter/common.hpp"
+#include "sensor_msgs/pdu_cpptype_PointCloud2.hpp"
+#include "sensors/lidar/lidar_3d_sensor.hpp"
+
+namespace hako::robots::pdu::converter::sensor_msgs
+{
+    inline bool ToHakoPdu(
+        const hako::robots::sensor::lidar::PointCloudFrame& frame,
+        HakoCpp_PointCloud2& out)
+    {
+        const std::size_t expected_size =
+            static_cast<std::size_t>(frame.row_step) * static_cast<std::size_t>(frame.height);
+        if (frame.point_step == 0 ||
+            frame.row_step < frame.point_step * frame.width ||
+            frame.data.size() != expected_size)
+        {
+            std::cerr << "Failed to convert PointCloudFrame: data size mismatch: expected "
+                      << expected_size << ", actual " << frame.data.size() << std::endl;
+            return false;
+        }
+
+        out.header.stamp = hako::robots::pdu::converter::ToHakoTime(frame.timestamp);
+        out.header.frame_id = frame.frame_id;
+        out.height = static_cast<Hako_uint32>(frame.height);
+        out.width = static_cast<Hako_uint32>(frame.width);
+        out.fields.clear();
+        out.fields.reserve(frame.fields.size());
+        for (const auto& field : frame.fields) {
+            HakoCpp_PointField pdu_field {};
+            pdu_field.name = field.name;
+            pdu_field.offset = static_cast<Hako_uint32>(field.offset);
+            pdu_field.datatype = static_cast<Hako_uint8>(field.datatype);
+            pdu_field.count = static_cast<Hako_uint32>(field.count);
+            out.fields.push_back(std::move(pdu_field));
+        }
+        out.is_bigendian = frame.is_bigendian ? 1 : 0;
+        out.point_step = static_cast<Hako_uint32>(frame.point_step);
+        out.row_step = static_cast<Hako_uint32>(frame.row_step);
+        out.data = frame.data;
+        out.is_dense = frame.is_dense ? 1 : 0;
+        return true;
+    }
+}
@@ -73,6 +73,7 @@ public:
         : world_(std::move(world))
         , config_(std::move(config))
         , body_(world_->getRigidBody(config_.body_name))
+        , body_handle_(world_->getBodyHandle(config_.body_name))
     {
     }
 
@@ -130,20 +131,12 @@ protected:
         if (model == nullptr || data == nullptr) {
             throw std::runtime_error("MuJoCo world is not initialized");
         }
-        const int body_id = mj_name2id(model, mjOBJ_BODY, body_name().c_str());
-        if (body_id < 0) {
-            throw std::runtime_error("MuJoCo body not found: " + body_name());
-        }
-        if (model->body_jntnum[body_id] <= 0) {
-            throw std::runtime_error("MuJoCo body has no joint: " + body_name());
-        }
-        const int joint_id = model->body_jntadr[body_id];
-        if (model->jnt_type[joint_id] != mjJNT_FREE) {
+        if (body_handle_.free_qpos_adr < 0) {
             throw std::runtime_error("MuJoCo body is not backed by a free joint: " + body_name());
         }
 
-        const int qpos_adr = model->jnt_qposadr[joint_id];
-        const int qvel_adr = model->jnt_dofadr[joint_id];
+        const int qpos_adr = body_handle_.free_qpos_adr;
+        const int qvel_adr = body_handle_.free_dof_adr;
         data->qpos[qpos_adr + 0] = pose.position.x;
         data->qpos[qpos_adr + 1] = pose.position.y;
         data->qpos[qpos_adr + 2] = pose.position.z;
@@ -168,22 +161,25 @@ protected:
 
     PduRigidBodyPose build_pose() const
     {
+        const auto& state = body_->GetState();
         PduRigidBodyPose out {};
-        out.position = position();
-        out.euler = euler();
+        out.position = state.position;
+        out.euler = state.euler;
         return out;
     }
 
     PduRigidBodyVelocity build_velocity() const
     {
+        const auto& state = body_->GetState();
         PduRigidBodyVelocity out {};
-        out.linear = velocity();
-        out.angular = body_angular_velocity();
+        out.linear = state.velocity;
+        out.angular = state.body_angular_velocity;
         return out;
     }
 
     std::shared_ptr<hako::robots::physics::IWorld> world_ {};
     PduBoundRigidBodyConfig config_ {};
     std::shared_ptr<hako::robots::physics::IRigidBody> body_ {};
+    hako::robots::physics::BodyHandle body_handle_ {};
 };
 }  // namespace hakoniwa
@@ -2,11 +2,31 @@
 
 #include "primitive_types.hpp"
 #include "actuator.hpp"
+#include "physics_registry.hpp"
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace hako::robots::physics
 {
+    // Kinematic state of one body at simulation time `time`, read in one
+    // call instead of one virtual call per quantity.
+    struct RigidBodyState
+    {
+        double time = 0.0;
+        hako::robots::types::Position position;
+        hako::robots::types::Euler euler;
+        // World frame.
+        hako::robots::types::Velocity velocity;
+        hako::robots::types::Vector3 angular_velocity;
+        // Body frame.
+        hako::robots::types::BodyVelocity body_velocity;
+        hako::robots::types::BodyAngularVelocity body_angular_velocity;
+    };
     class IRigidBody
     {
     public:
@@ -17,6 +37,8 @@ namespace hako::robots::physics
         virtual hako::robots::types::EulerRate GetEulerRate() = 0;
         virtual hako::robots::types::BodyVelocity GetBodyVelocity() = 0;
         virtual hako::robots::types::BodyAngularVelocity GetBodyAngularVelocity() = 0;
+        // Valid until the next call on this body.
+        virtual const RigidBodyState& GetState() = 0;
 
         virtual void SetTorque(const std::string& joint_name, double torque) = 0;
         virtual void SetForce(const hako::robots::types::Vector3& force) = 0;
@@ -24,9 +46,65 @@ namespace hako::robots::physics
     };
     class IWorld
     {
+    public:
+        // Called between mj_step1 and mj_step2: positions, velocities and
+        // sensors are computed for the state being stepped, and ctrl (or
+        // qfrc_applied/xfrc_applied) written here drives that same step.
+        using ControlCallback = std::function<void(const mjModel* model, mjData* data)>;
     protected:
         mjModel* model = nullptr;
         mjData* data = nullptr;
+    private:
+        mutable std::mutex registry_mutex;
+        mutable std::shared_ptr<const ModelRegistry> registry;
+
+        struct ScheduledControl
+        {
+            int id;
+            std::uint64_t rate_divisor;
+            std::uint64_t first_step;
+            ControlCallback callback;
+        };
+        std::vector<ScheduledControl> control_callbacks;
+        int next_control_id = 0;
+        // Index of the next physics step taken through stepWithControl().
+        std::uint64_t control_step = 0;
+    protected:
+        // Reserves step indices for steps physics steps and returns the first.
+        std::uint64_t takeControlSteps(std::uint64_t steps)
+        {
+            const std::uint64_t first = control_step;
+            control_step += steps;
+            return first;
+        }
+        // mj_step(m, d) as physics step `step`. With no callbacks registered
+        // this is plain mj_step; otherwise the due callbacks run between
+        // mj_step1 and mj_step2, so there is no extra forward pass. RK4 has
+        // no split form (mj_step2 would integrate with Euler), so there the
+        // callbacks run before mj_step on the previous step's kinematics.
+        void stepWithControl(const mjModel* m, mjData* d, std::uint64_t step) const
+        {
+            if (control_callbacks.empty()) {
+                mj_step(m, d);
+                return;
+            }
+            if (m->opt.integrator == mjINT_RK4) {
+                runControlCallbacks(m, d, step);
+                mj_step(m, d);
+                return;
+            }
+            mj_step1(m, d);
+            runControlCallbacks(m, d, step);
+            mj_step2(m, d);
+        }
+        void runControlCallbacks(const mjModel* m, mjData* d, std::uint64_t step) const
+        {
+            for (const auto& control : control_callbacks) {
+                if ((step - control.first_step) % control.rate_divisor == 0) {
+                    control.callback(m, d);
+                }
+            }
+        }
     public:
         virtual ~IWorld()
         {
@@ -41,7 +119,55 @@ namespace hako::robots::physics
         }
         virtual mjModel *getModel() const { return model; }
         virtual mjData *getData() const { return data; }
+        // Handles for getModel(), built on first use and again after the
+        // model changes. Resolve handles once (construction, LoadConfig) and
+        // keep them; the lookups hash the name.
+        std::shared_ptr<const ModelRegistry> getRegistry() const
+        {
+            const mjModel* current = getModel();
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            if (!registry || registry->getModel() != current) {
+                registry = std::make_shared<const ModelRegistry>(current);
+            }
+            return registry;
+        }
+        BodyHandle getBodyHandle(const std::string& name) const { return getRegistry()->getBody(name); }
+        JointHandle getJointHandle(const std::string& name) const { return getRegistry()->getJoint(name); }
+        ActuatorHandle getActuatorHandle(const std::string& name) const { return getRegistry()->getActuator(name); }
+        CameraHandle getCameraHandle(const std::string& name) const { return getRegistry()->getCamera(name); }
+        SensorHandle getSensorHandle(const std::string& name) const { return getRegistry()->getSensor(name); }
+        // Registers callback to run on every rate_divisor-th physics step,
+        // starting with the next one: at a 1 ms timestep, divisor 2 runs it
+        // at 500 Hz and divisor 10 at 100 Hz. ctrl holds between runs.
+        // Returns an id for removeControlCallback(). Callbacks are added and
+        // removed between steps, not from inside a callback; a world that
+        // steps several mjData in parallel may call them concurrently.
+        int addControlCallback(ControlCallback callback, int rate_divisor = 1)
+        {
+            if (!callback) {
+                throw std::invalid_argument("Control callback is empty");
+            }
+            if (rate_divisor < 1) {
+                throw std::invalid_argument("Control rate divisor must be at least 1: " + std::to_string(rate_divisor));
+            }
+            const int id = next_control_id++;
+            control_callbacks.push_back({id, static_cast<std::uint64_t>(rate_divisor), control_step, std::move(callback)});
+            return id;
+        }
+        bool removeControlCallback(int id)
+        {
+            for (auto it = control_callbacks.begin(); it != control_callbacks.end(); ++it) {
+                if (it->id == id) {
+                    control_callbacks.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        }
+        bool hasControlCallbacks() const { return !control_callbacks.empty(); }
         virtual void loadModel(const std::string& model_file) = 0;
+        // One physics step. Worlds that step run the registered control
+        // callbacks as described for addControlCallback().
         virtual void advanceTimeStep() = 0;
         virtual std::shared_ptr<IRigidBody> getRigidBody(const std::string& model_name) = 0;
         virtual std::shared_ptr<actuator::ITorqueActuator> getTorqueActuator(const std::string& name) = 0;
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <mujoco/mujoco.h>
+
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace hako::robots::physics
+{
+    // Handles are indices into one mjModel, resolved from names once so
+    // per-step code reads and writes mjData through precomputed addresses.
+    // A default-constructed handle is invalid. Handles are only meaningful
+    // for the model whose ModelRegistry produced them.
+    struct BodyHandle
+    {
+        int id = -1;
+        int root_id = -1;
+        // qpos/qvel address of the body's free joint, or -1 if it has none.
+        int free_qpos_adr = -1;
+        int free_dof_adr = -1;
+        bool valid() const { return id >= 0; }
+    };
+    struct JointHandle
+    {
+        int id = -1;
+        int body_id = -1;
+        int type = -1;
+        int qpos_adr = -1;
+        int dof_adr = -1;
+        bool valid() const { return id >= 0; }
+    };
+    struct ActuatorHandle
+    {
+        int id = -1;
+        // Index into mjData::ctrl.
+        int ctrl_adr = -1;
+        // Joint the actuator drives, or -1 for other transmissions.
+        int joint_id = -1;
+        bool valid() const { return id >= 0; }
+    };
+    struct CameraHandle
+    {
+        int id = -1;
+        bool valid() const { return id >= 0; }
+    };
+    struct SensorHandle
+    {
+        int id = -1;
+        // Range of mjData::sensordata.
+        int adr = -1;
+        int dim = 0;
+        bool valid() const { return id >= 0; }
+    };
+
+    // Name -> handle tables for every named body, joint, actuator, camera
+    // and sensor of a model, built in one pass when the registry is created.
+    class ModelRegistry
+    {
+    private:
+        const mjModel* model;
+        std::unordered_map<std::string, BodyHandle> bodies;
+        std::unordered_map<std::string, JointHandle> joints;
+        std::unordered_map<std::string, ActuatorHandle> actuators;
+        std::unordered_map<std::string, CameraHandle> cameras;
+        std::unordered_map<std::string, SensorHandle> sensors;
+
+        template <typename Handle>
+        static Handle find(const std::unordered_map<std::string, Handle>& table, const std::string& name)
+        {
+            auto it = table.find(name);
+            return it != table.end() ? it->second : Handle {};
+        }
+        template <typename Handle>
+        static Handle get(const std::unordered_map<std::string, Handle>& table, const std::string& name, const char* kind)
+        {
+            auto it = table.find(name);
+            if (it == table.end()) {
+                throw std::runtime_error(std::string(kind) + " not found: " + name);
+            }
+            return it->second;
+        }
+        static const char* nameOf(const mjModel* m, int type, int id)
+        {
+            const char* name = mj_id2name(m, type, id);
+            return (name != nullptr && name[0] != '\0') ? name : nullptr;
+        }
+
+    public:
+        explicit ModelRegistry(const mjModel* m)
+            : model(m)
+        {
+            if (model == nullptr) {
+                throw std::runtime_error("Model registry needs a loaded model");
+            }
+            for (int id = 0; id < model->njnt; ++id) {
+                JointHandle joint;
+                joint.id = id;
+                joint.body_id = model->jnt_bodyid[id];
+                joint.type = model->jnt_type[id];
+                joint.qpos_adr = model->jnt_qposadr[id];
+                joint.dof_adr = model->jnt_dofadr[id];
+                if (const char* name = nameOf(model, mjOBJ_JOINT, id)) {
+                    joints.emplace(name, joint);
+                }
+            }
+            for (int id = 0; id < model->nbody; ++id) {
+                BodyHandle body;
+                body.id = id;
+                body.root_id = model->body_rootid[id];
+                if (model->body_jntnum[id] > 0 && model->jnt_type[model->body_jntadr[id]] == mjJNT_FREE) {
+                    body.free_qpos_adr = model->jnt_qposadr[model->body_jntadr[id]];
+                    body.free_dof_adr = model->jnt_dofadr[model->body_jntadr[id]];
+                }
+                if (const char* name = nameOf(model, mjOBJ_BODY, id)) {
+                    bodies.emplace(name, body);
+                }
+            }
+            for (int id = 0; id < model->nu; ++id) {
+                ActuatorHandle actuator;
+                actuator.id = id;
+                actuator.ctrl_adr = id;
+                if (model->actuator_trntype[id] == mjTRN_JOINT) {
+                    actuator.joint_id = model->actuator_trnid[2 * id];
+                }
+                if (const char* name = nameOf(model, mjOBJ_ACTUATOR, id)) {
+                    actuators.emplace(name, actuator);
+                }
+            }
+            for (int id = 0; id < model->ncam; ++id) {
+                if (const char* name = nameOf(model, mjOBJ_CAMERA, id)) {
+                    cameras.emplace(name, CameraHandle {id});
+                }
+            }
+            for (int id = 0; id < model->nsensor; ++id) {
+                SensorHandle sensor;
+                sensor.id = id;
+                sensor.adr = model->sensor_adr[id];
+                sensor.dim = model->sensor_dim[id];
+                if (const char* name = nameOf(model, mjOBJ_SENSOR, id)) {
+                    sensors.emplace(name, sensor);
+                }
+            }
+        }
+        const mjModel* getModel() const { return model; }
+
+        // find*() return an invalid handle for unknown names; get*() throw.
+        BodyHandle findBody(const std::string& name) const { return find(bodies, name); }
+        JointHandle findJoint(const std::string& name) const { return find(joints, name); }
+        ActuatorHandle findActuator(const std::string& name) const { return find(actuators, name); }
+        CameraHandle findCamera(const std::string& name) const { return find(cameras, name); }
+        SensorHandle findSensor(const std::string& name) const { return find(sensors, name); }
+        BodyHandle getBody(const std::string& name) const { return get(bodies, name, "Body"); }
+        JointHandle getJoint(const std::string& name) const { return get(joints, name, "Joint"); }
+        ActuatorHandle getActuator(const std::string& name) const { return get(actuators, name, "Actuator"); }
+        CameraHandle getCamera(const std::string& name) const { return get(cameras, name, "Camera"); }
+        SensorHandle getSensor(const std::string& name) const { return get(sensors, name, "Sensor"); }
+    };
+}
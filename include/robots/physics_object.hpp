@@ -37,6 +37,10 @@ namespace robots {
         hako::robots::types::BodyAngularVelocity getBodyAngularVelocity() const {
             return base->GetBodyAngularVelocity();
         }
+        // All of the above at once; valid until the next call.
+        const hako::robots::physics::RigidBodyState& getState() const {
+            return base->GetState();
+        }
     };
 }  // namespace robots
 }  // namespace hako
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 
 #include "physics.hpp"
 #include "robots/tb3/tb3_drive.hpp"
+#include "sensors/common/sensor_group.hpp"
+#include "sensors/common/snapshot_sensor_worker.hpp"
+#include "sensors/common/spsc_ring.hpp"
 #include "sensors/imu/imu_sensor.hpp"
 #include "sensors/joint_state/joint_state_sensor.hpp"
 #include "sensors/lidar/lidar_2d_sensor.hpp"
@@ -41,6 +46,7 @@ namespace hako::robots::tb3
         double max_wheel_angular_acceleration {25.0};
         double lidar_yaw_bias_deg {0.0};
         double lidar_origin_offset {0.0};
+        bool sensor_thread {false};
     };
 
     struct Tb3Command
@@ -56,10 +62,35 @@ namespace hako::robots::tb3
         double command_deadzone {0.1};
     };
 
+    // Latest sensor outputs. The *_updated flags mark the frames refreshed by
+    // the last UpdateSensors() call; frames keep their last value otherwise.
+    struct Tb3SensorFrames
+    {
+        bool imu_updated {false};
+        bool joint_state_updated {false};
+        bool odometry_updated {false};
+        bool tf_updated {false};
+        bool laser_scan_updated {false};
+        hako::robots::sensor::ImuFrame imu {};
+        hako::robots::sensor::JointStateFrame joint_state {};
+        hako::robots::sensor::OdometryFrame odometry {};
+        hako::robots::sensor::TfFrame tf {};
+        hako::robots::sensor::lidar::LaserScanFrame laser_scan {};
+        // base_scan pose read from the same world state as laser_scan, so the
+        // pair stays consistent when the scan comes from a sensor snapshot.
+        hako::robots::types::Position base_scan_position {};
+        hako::robots::types::Euler base_scan_euler {};
+    };
+
     class Tb3Robot
     {
     public:
-        Tb3Robot(std::shared_ptr<hako::robots::physics::IWorld> world, Tb3RuntimeConfig config);
+        // Sensors read sensor_world when given (e.g. a SnapshotWorldImpl of
+        // world for StartSensorThread()); otherwise they read world directly.
+        Tb3Robot(
+            std::shared_ptr<hako::robots::physics::IWorld> world,
+            Tb3RuntimeConfig config,
+            std::shared_ptr<hako::robots::physics::IWorld> sensor_world = nullptr);
         ~Tb3Robot();
 
         bool Initialize(std::string* error_message = nullptr);
@@ -71,39 +102,48 @@ namespace hako::robots::tb3
         hako::robots::types::Position GetBaseScanPosition() const;
         hako::robots::types::Euler GetBaseScanEuler() const;
 
-        bool MaybeBuildImu(
-            double sim_timestep,
-            double sim_time_sec,
-            hako::robots::sensor::ImuFrame& out);
-        bool MaybeBuildJointState(
-            double sim_timestep,
-            double sim_time_sec,
-            hako::robots::sensor::JointStateFrame& out);
-        bool MaybeBuildOdometry(
-            double sim_timestep,
-            double sim_time_sec,
-            hako::robots::sensor::OdometryFrame& out);
-        bool MaybeBuildTf(
-            double sim_timestep,
-            double sim_time_sec,
-            hako::robots::sensor::TfFrame& out);
-        bool MaybeBuildLaserScan(
-            double sim_timestep,
-            hako::robots::sensor::lidar::LaserScanFrame& out);
+        // Advance every sensor by one physics step and build the frames that
+        // are due. Sensors are scheduled by one SensorGroup, so only due
+        // sensors are touched.
+        // While the sensor thread runs it owns this call; use
+        // PublishSensorSnapshot()/PollSensorFrames() instead.
+        const Tb3SensorFrames& UpdateSensors(double sim_timestep, double sim_time_sec);
 
-        void EmitDebugLog(int step) const;
+        // Threaded sensor mode. Requires a separate sensor world. After each
+        // Step() the physics thread publishes a kinematic snapshot; the sensor
+        // thread runs UpdateSensors() on it and queues the frames that changed
+        // for PollSensorFrames(), which is called from the physics thread.
+        bool StartSensorThread(std::string* error_message = nullptr);
+        void StopSensorThread();
+        bool SensorThreadRunning() const { return sensor_worker_.Running(); }
+        void PublishSensorSnapshot(double sim_time_sec);
+        bool PollSensorFrames(Tb3SensorFrames& out);
+
+        void EmitDebugLog(int step, const Tb3SensorFrames& frames) const;
 
     private:
+        void RegisterSensors();
+        void EvaluateSensorSnapshot(double delta_sec, double stamp_sec);
+        void CaptureBaseScanPose();
+
         std::shared_ptr<hako::robots::physics::IWorld> world_;
+        std::shared_ptr<hako::robots::physics::IWorld> sensor_world_;
         Tb3RuntimeConfig config_;
         std::unique_ptr<Tb3Drive> drive_;
+        // base_scan as seen by the sensors (the snapshot in threaded mode).
+        std::shared_ptr<hako::robots::physics::IRigidBody> sensor_base_scan_;
         hako::robots::sensor::lidar::LiDAR2DSensor lidar_sensor_;
         hako::robots::sensor::ImuSensor imu_sensor_;
         hako::robots::sensor::JointStateSensor joint_state_sensor_;
         hako::robots::sensor::OdometryPublisher odom_sensor_;
         hako::robots::sensor::TfPublisher tf_sensor_;
-        hako::robots::sensor::lidar::LaserScanFrame last_laser_scan_ {};
-        hako::robots::sensor::JointStateFrame last_joint_state_frame_ {};
+        hako::robots::sensor::common::SensorGroup sensor_group_ {};
+        Tb3SensorFrames sensor_frames_ {};
+        double sensor_step_sec_ {0.0};
+        double sensor_time_sec_ {0.0};
+        hako::robots::sensor::common::SpscRing<Tb3SensorFrames, 16> frame_queue_ {};
+        std::atomic<std::uint64_t> dropped_sensor_frames_ {0};
+        hako::robots::sensor::common::SnapshotSensorWorker sensor_worker_ {};
         double last_left_wheel_target_ {0.0};
         double last_right_wheel_target_ {0.0};
         double raw_linear_velocity_ {0.0};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hako::robots::runtime
+{
+    /**
+     * @brief Fixed-size worker pool for data-parallel sensor and physics work.
+     *
+     * The pool is meant for short fork/join jobs such as splitting the beams of
+     * one LiDAR scan into contiguous chunks. ParallelFor() blocks until every
+     * chunk has been processed, and the calling thread takes part in the work,
+     * so a pool created with thread_count == 1 owns no extra threads and runs
+     * everything inline.
+     *
+     * ParallelFor() must not be called concurrently on the same pool.
+     */
+    class WorkerPool
+    {
+    public:
+        using RangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+        explicit WorkerPool(int thread_count);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /**
+         * @brief Total number of threads that execute a job, including the caller.
+         */
+        int ThreadCount() const;
+
+        /**
+         * @brief Run fn over [0, count) split into contiguous chunks.
+         *
+         * @param count Number of work items.
+         * @param min_chunk Smallest chunk handed to one thread. Jobs smaller than
+         *        this run inline on the calling thread.
+         * @param fn Callback invoked as fn(begin, end) for each chunk.
+         */
+        void ParallelFor(std::size_t count, std::size_t min_chunk, const RangeFunction& fn);
+
+    private:
+        void WorkerLoop();
+        void RunChunks();
+
+        std::vector<std::thread> workers_ {};
+        std::mutex mutex_ {};
+        std::condition_variable job_cv_ {};
+        std::condition_variable done_cv_ {};
+        const RangeFunction* job_ {nullptr};
+        std::size_t job_count_ {0};
+        std::size_t chunk_size_ {1};
+        std::size_t chunk_total_ {0};
+        std::atomic<std::size_t> next_chunk_ {0};
+        std::size_t pending_workers_ {0};
+        std::uint64_t generation_ {0};
+        bool stopping_ {false};
+    };
+}
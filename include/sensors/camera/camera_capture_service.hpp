@@ -0,0 +1,164 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <mujoco/mujoco.h>
+
+#include "physics.hpp"
+#include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/frame_pool.hpp"
+#include "sensors/camera/render_context.hpp"
+#include "sensors/common/kinematic_snapshot.hpp"
+#include "sensors/common/update_scheduler.hpp"
+
+namespace hako::robots::sensor::camera
+{
+    class MujocoCameraRenderer;
+
+    struct CameraCaptureConfig
+    {
+        std::string camera_name {};
+        CameraConfig camera {};
+        RenderBackend backend {DefaultRenderBackend()};
+        // Called on the capture thread with each new frame, before it becomes
+        // available to TryTakeLatest() (e.g. to feed an ImageFrameRecorder,
+        // which may keep a reference instead of copying).
+        std::function<void(const PooledImageFrame&)> on_frame {};
+    };
+
+    /**
+     * @brief Renders a camera on its own thread and GL context.
+     *
+     * The physics thread calls Request() while it holds its data lock. That
+     * copies the kinematic state (a KinematicSnapshot, a few KB) and returns,
+     * so the lock is held for a copy instead of a render and GPU readback.
+     * The capture thread applies the snapshot to the render world's mjData,
+     * renders and publishes the frame for TryTakeLatest(). Only what the
+     * snapshot carries is refreshed: rigid bodies, geoms, sites, cameras
+     * and lights; tendon paths, flex and skin vertices keep the render
+     * world's initial state.
+     *
+     * Only the newest request is kept: a request that arrives while the
+     * previous one is still waiting replaces it and is counted as dropped.
+     * Request() and TryTakeLatest() must be called from one thread.
+     *
+     * Frames are borrowed from an ImageFramePool and handed out by
+     * reference; a frame returns to the pool, buffers included, when its
+     * last consumer drops it. Once the consumers hold their frames, captures
+     * allocate no new ones (see GetFramePoolStats()).
+     */
+    class CameraCaptureService
+    {
+    public:
+        struct Stats
+        {
+            std::uint64_t requested {0};
+            std::uint64_t dropped {0};
+            std::uint64_t captured {0};
+            // Renders that produced no frame: errors, or a "pbo" readback
+            // pipeline that is still filling.
+            std::uint64_t empty {0};
+            // Captured frames per second of wall time since Start().
+            double capture_rate_hz {0.0};
+            // Wall time from Request() to the frame being available.
+            double last_latency_sec {0.0};
+            double mean_latency_sec {0.0};
+            double max_latency_sec {0.0};
+            // Wall time spent rendering and converting one frame.
+            double mean_render_sec {0.0};
+        };
+
+        CameraCaptureService() = default;
+        ~CameraCaptureService();
+
+        CameraCaptureService(const CameraCaptureService&) = delete;
+        CameraCaptureService& operator=(const CameraCaptureService&) = delete;
+
+        /**
+         * @brief Create the renderer and start the capture thread.
+         *
+         * The GL context is created on the calling thread (GLFW needs the
+         * main thread on some platforms) and handed to the capture thread.
+         *
+         * @param render_world World the camera renders, with the same model
+         *        layout as the live world and its own mjData (and preferably
+         *        its own mjModel, see SnapshotWorldImpl).
+         * @return false if already running, the camera config is invalid or
+         *         the renderer cannot be created.
+         */
+        bool Start(std::shared_ptr<hako::robots::physics::IWorld> render_world, const CameraCaptureConfig& config);
+
+        /**
+         * @brief Stop and join the capture thread and release the renderer.
+         */
+        void Stop();
+
+        bool Running() const { return thread_.joinable(); }
+
+        /**
+         * @brief Whether a capture is due after delta_sec of simulation time,
+         *        at the camera's update_rate_hz.
+         */
+        bool ShouldUpdate(double delta_sec);
+
+        /**
+         * @brief Copy the live kinematic state and wake the capture thread.
+         *
+         * Call with the lock that guards live_data held.
+         */
+        bool Request(const mjData* live_data);
+
+        /**
+         * @brief Move the newest captured frame into out, releasing the
+         *        frame out held before.
+         *
+         * The frame may also be referenced by on_frame consumers; modify it
+         * only while out.UseCount() is 1.
+         *
+         * @return false if no frame was captured since the last call.
+         */
+        bool TryTakeLatest(PooledImageFrame& out);
+
+        Stats GetStats() const;
+        FramePoolStats GetFramePoolStats() const { return frame_pool_.GetStats(); }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void Run();
+
+        std::shared_ptr<hako::robots::physics::IWorld> render_world_ {};
+        std::shared_ptr<MujocoCameraRenderer> renderer_ {};
+        std::unique_ptr<CameraSensor> sensor_ {};
+        std::function<void(const PooledImageFrame&)> on_frame_ {};
+        ImageConfig image_ {};
+        ImageFramePool frame_pool_ {};
+        common::UpdateScheduler scheduler_ {};
+        double period_sec_ {0.0};
+
+        // Filled by Request() without the lock, then swapped with pending_.
+        common::KinematicSnapshot request_snapshot_ {};
+
+        mutable std::mutex mutex_ {};
+        std::condition_variable ready_ {};
+        bool stopping_ {false};
+        common::KinematicSnapshot pending_ {};
+        Clock::time_point pending_time_ {};
+        bool has_pending_ {false};
+        PooledImageFrame latest_ {};
+        bool has_latest_ {false};
+        Clock::time_point start_time_ {};
+        Stats stats_ {};
+        double latency_sum_sec_ {0.0};
+        double render_sum_sec_ {0.0};
+
+        std::thread thread_ {};
+    };
+}
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/image_codecs.hpp"
 
 namespace hako::robots::sensor::camera
 {
@@ -17,8 +18,17 @@ namespace hako::robots::sensor::camera
     {
         std::string pdu_name {};
         double update_rate_hz {0.0};
+        // "sensor_msgs/Image" (default) or "sensor_msgs/CompressedImage".
+        std::string message_type {};
+        // Codec for CompressedImage output ("pdu_config.compression").
+        ImageCompressionConfig compression {};
     };
 
+    inline bool IsCompressedImagePdu(const CameraPduConfig& config)
+    {
+        return config.message_type == "sensor_msgs/CompressedImage";
+    }
+
     struct CameraProfileConfig
     {
         CameraConfig spec {};
@@ -29,6 +39,7 @@ namespace hako::robots::sensor::camera
     bool LoadCameraConfigFromJson(const std::string& path, CameraConfig& out);
     bool LoadCameraProfileConfigFromJson(const std::string& path, CameraProfileConfig& out);
     bool LoadDepthCameraConfigFromJson(const std::string& path, DepthCameraConfig& out);
+    bool LoadSegmentationCameraConfigFromJson(const std::string& path, SegmentationCameraConfig& out);
     bool LoadRgbdCameraConfigFromJson(const std::string& path, RgbdCameraConfig& out);
     bool LoadStereoCameraConfigFromJson(const std::string& path, StereoCameraConfig& out);
 }
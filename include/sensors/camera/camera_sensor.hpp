@@ -9,6 +9,7 @@
 
 #include "physics.hpp"
 #include "sensor.hpp"
+#include "sensors/camera/image_kernels.hpp"
 #include "sensors/common/update_scheduler.hpp"
 #include "sensors/noise/noise.hpp"
 
@@ -16,6 +17,8 @@ namespace hako::robots::sensor::camera
 {
     // Forward declaration
     class MujocoCameraRenderer;
+    struct CameraView;
+    struct RawCameraFrame;
 
     // Common Configuration structures
     struct ImageConfig
@@ -38,6 +41,16 @@ namespace hako::robots::sensor::camera
         double stddev = 0.0;
     };
 
+    // Pixel readback. "sync" reads each frame right after rendering it.
+    // "pbo" queues the read into one of `buffers` pixel buffer objects and
+    // returns the newest frame whose transfer was queued buffers-1 captures
+    // earlier, so the wait for the GL driver overlaps the next render.
+    struct CameraReadbackConfig
+    {
+        std::string mode = "sync";
+        int buffers = 2;
+    };
+
     // Standard Camera Config
     struct CameraConfig
     {
@@ -47,6 +60,7 @@ namespace hako::robots::sensor::camera
         ImageConfig image;
         ClipConfig clip;
         CameraNoiseConfig noise;
+        CameraReadbackConfig readback;
     };
 
     // Depth Camera Config
@@ -67,11 +81,25 @@ namespace hako::robots::sensor::camera
         DepthCameraConfig depth;
     };
 
+    // Segmentation Camera Config. image.format is LABEL_S32 or LABEL_U16,
+    // label selects the id written per pixel: "geom" or "body".
+    struct SegmentationCameraConfig
+    {
+        std::string frame_id = "camera_segmentation";
+        double update_rate_hz = 30.0;
+        double horizontal_fov = 1.047;
+        ImageConfig image{640, 480, "LABEL_S32"};
+        ClipConfig clip;
+        std::string label = "geom";
+    };
+
     struct StereoCameraConfig
     {
         CameraConfig left;
         CameraConfig right;
         double baseline = 0.0;
+        // Also render the left eye's depth and derive a DisparityFrame from it.
+        bool disparity = false;
     };
 
 
@@ -99,6 +127,38 @@ namespace hako::robots::sensor::camera
         double timestamp = 0.0;
     };
 
+    // Disparity of the left stereo image against the right one, in pixels:
+    // focal_length_px * baseline / depth, for parallel cameras offset along
+    // the image x axis. Fields follow stereo_msgs/DisparityImage.
+    struct DisparityFrame
+    {
+        int width = 0;
+        int height = 0;
+        std::string format = "DISPARITY_F32_PX";
+        std::string frame_id;
+        // NaN where the left eye's depth is outside its clip range.
+        std::vector<float> data;
+        double focal_length_px = 0.0;
+        double baseline = 0.0;
+        // Range allowed by the left clip range (far and near plane).
+        double min_disparity = 0.0;
+        double max_disparity = 0.0;
+        double timestamp = 0.0;
+    };
+
+    struct SegmentationFrame
+    {
+        int width = 0;
+        int height = 0;
+        std::string format = "LABEL_S32";
+        std::string label = "geom";
+        std::string frame_id;
+        // MuJoCo geom or body id per pixel, -1 where nothing is hit.
+        // LABEL_U16 remains a downstream serialization hint.
+        std::vector<std::int32_t> data;
+        double timestamp = 0.0;
+    };
+
     struct RGBAColor
     {
         float r = 0.0F;
@@ -107,6 +167,40 @@ namespace hako::robots::sensor::camera
         float a = 0.0F;
     };
 
+    namespace detail
+    {
+        // Pixel layout of a frame whose data size matches its dimensions.
+        inline bool ResolveFramePixelFormat(const ImageFrame& frame, PixelFormat& format)
+        {
+            if (frame.width <= 0 || frame.height <= 0 ||
+                !ParsePixelFormat(frame.format, format) ||
+                !IsValidPixelFormatWidth(format, frame.width))
+            {
+                return false;
+            }
+            const std::size_t expected_size =
+                static_cast<std::size_t>(frame.width) *
+                static_cast<std::size_t>(frame.height) *
+                static_cast<std::size_t>(PixelFormatBytesPerPixel(format));
+            return frame.data.size() == expected_size;
+        }
+
+        // BT.601 video range YUV (0-255 code values) to normalized RGB.
+        inline RGBAColor YuvToRGBAColor(float y, float u, float v)
+        {
+            const float luma = 1.164F * (y - 16.0F);
+            const float cb = u - 128.0F;
+            const float cr = v - 128.0F;
+            constexpr float kInv255 = 1.0F / 255.0F;
+            return {
+                std::clamp((luma + 1.596F * cr) * kInv255, 0.0F, 1.0F),
+                std::clamp((luma - 0.392F * cb - 0.813F * cr) * kInv255, 0.0F, 1.0F),
+                std::clamp((luma + 2.017F * cb) * kInv255, 0.0F, 1.0F),
+                1.0F
+            };
+        }
+    }
+
     inline bool TryExtractRGBAColor(
         const ImageFrame& frame,
         RGBAColor& out,
@@ -114,24 +208,8 @@ namespace hako::robots::sensor::camera
         int y = -1)
     {
         out = {};
-        if (frame.width <= 0 || frame.height <= 0) {
-            return false;
-        }
-
-        int channels = 0;
-        if (frame.format == "R8G8B8" || frame.format == "B8G8R8") {
-            channels = 3;
-        } else if (frame.format == "L8") {
-            channels = 1;
-        } else {
-            return false;
-        }
-
-        const std::size_t expected_size =
-            static_cast<std::size_t>(frame.width) *
-            static_cast<std::size_t>(frame.height) *
-            static_cast<std::size_t>(channels);
-        if (frame.data.size() != expected_size) {
+        PixelFormat format;
+        if (!detail::ResolveFramePixelFormat(frame, format)) {
             return false;
         }
 
@@ -140,33 +218,35 @@ namespace hako::robots::sensor::camera
         const std::size_t idx =
             (static_cast<std::size_t>(py) * static_cast<std::size_t>(frame.width) +
              static_cast<std::size_t>(px)) *
-            static_cast<std::size_t>(channels);
+            static_cast<std::size_t>(PixelFormatBytesPerPixel(format));
+        const std::uint8_t* p = frame.data.data() + idx;
 
         constexpr float kInv255 = 1.0F / 255.0F;
-        if (frame.format == "R8G8B8") {
-            out = {
-                static_cast<float>(frame.data[idx + 0]) * kInv255,
-                static_cast<float>(frame.data[idx + 1]) * kInv255,
-                static_cast<float>(frame.data[idx + 2]) * kInv255,
-                1.0F
-            };
+        switch (format) {
+        case PixelFormat::Rgb8:
+            out = {p[0] * kInv255, p[1] * kInv255, p[2] * kInv255, 1.0F};
             return true;
-        }
-        if (frame.format == "B8G8R8") {
-            out = {
-                static_cast<float>(frame.data[idx + 2]) * kInv255,
-                static_cast<float>(frame.data[idx + 1]) * kInv255,
-                static_cast<float>(frame.data[idx + 0]) * kInv255,
-                1.0F
-            };
+        case PixelFormat::Bgr8:
+            out = {p[2] * kInv255, p[1] * kInv255, p[0] * kInv255, 1.0F};
+            return true;
+        case PixelFormat::Rgba8:
+            out = {p[0] * kInv255, p[1] * kInv255, p[2] * kInv255, p[3] * kInv255};
+            return true;
+        case PixelFormat::Yuv422: {
+            // UYVY: the pair shares U (byte 0) and V (byte 2); Y is byte 1 or 3.
+            const std::uint8_t* pair = frame.data.data() + (idx & ~static_cast<std::size_t>(3));
+            out = detail::YuvToRGBAColor(p[1], pair[0], pair[2]);
             return true;
         }
-
-        const float luminance = static_cast<float>(frame.data[idx]) * kInv255;
+        case PixelFormat::Mono8:
+            break;
+        }
+        const float luminance = static_cast<float>(p[0]) * kInv255;
         out = {luminance, luminance, luminance, 1.0F};
         return true;
     }
 
+    // YUV422 regions are widened to whole pixel pairs.
     inline bool TryExtractAverageRGBAColor(
         const ImageFrame& frame,
         RGBAColor& out,
@@ -176,73 +256,65 @@ namespace hako::robots::sensor::camera
         int height)
     {
         out = {};
-        if (frame.width <= 0 || frame.height <= 0 || width <= 0 || height <= 0) {
-            return false;
-        }
-
-        int channels = 0;
-        if (frame.format == "R8G8B8" || frame.format == "B8G8R8") {
-            channels = 3;
-        } else if (frame.format == "L8") {
-            channels = 1;
-        } else {
-            return false;
-        }
-
-        const std::size_t expected_size =
-            static_cast<std::size_t>(frame.width) *
-            static_cast<std::size_t>(frame.height) *
-            static_cast<std::size_t>(channels);
-        if (frame.data.size() != expected_size) {
+        PixelFormat format;
+        if (width <= 0 || height <= 0 || !detail::ResolveFramePixelFormat(frame, format)) {
             return false;
         }
 
-        const int x0 = std::clamp(x, 0, frame.width);
+        int x0 = std::clamp(x, 0, frame.width);
         const int y0 = std::clamp(y, 0, frame.height);
-        const int x1 = std::clamp(x + width, 0, frame.width);
+        int x1 = std::clamp(x + width, 0, frame.width);
         const int y1 = std::clamp(y + height, 0, frame.height);
         if (x0 >= x1 || y0 >= y1) {
             return false;
         }
 
-        double r = 0.0;
-        double g = 0.0;
-        double b = 0.0;
-        std::size_t count = 0;
-        for (int py = y0; py < y1; ++py) {
-            for (int px = x0; px < x1; ++px) {
-                const std::size_t idx =
-                    (static_cast<std::size_t>(py) * static_cast<std::size_t>(frame.width) +
-                     static_cast<std::size_t>(px)) *
-                    static_cast<std::size_t>(channels);
-                if (frame.format == "R8G8B8") {
-                    r += frame.data[idx + 0];
-                    g += frame.data[idx + 1];
-                    b += frame.data[idx + 2];
-                } else if (frame.format == "B8G8R8") {
-                    r += frame.data[idx + 2];
-                    g += frame.data[idx + 1];
-                    b += frame.data[idx + 0];
-                } else {
-                    r += frame.data[idx];
-                    g += frame.data[idx];
-                    b += frame.data[idx];
-                }
-                ++count;
-            }
+        // Sum each byte lane of the region row by row; a UYVY pixel pair is
+        // one group of four lanes.
+        int stride = PixelFormatBytesPerPixel(format);
+        if (format == PixelFormat::Yuv422) {
+            x0 /= 2;
+            x1 = (x1 + 1) / 2;
+            stride = 4;
         }
-
-        if (count == 0) {
-            return false;
+        const std::size_t row_bytes =
+            static_cast<std::size_t>(frame.width) * static_cast<std::size_t>(PixelFormatBytesPerPixel(format));
+        const std::size_t groups = static_cast<std::size_t>(x1 - x0);
+        std::uint64_t sums[4] = {0, 0, 0, 0};
+        for (int py = y0; py < y1; ++py) {
+            SumInterleavedBytes(
+                frame.data.data() + static_cast<std::size_t>(py) * row_bytes +
+                    static_cast<std::size_t>(x0) * static_cast<std::size_t>(stride),
+                groups,
+                stride,
+                sums);
         }
+        const double count = static_cast<double>(groups) * static_cast<double>(y1 - y0);
+        const auto mean = [count](std::uint64_t sum) {
+            return static_cast<float>(static_cast<double>(sum) / count);
+        };
 
         constexpr float kInv255 = 1.0F / 255.0F;
-        out = {
-            static_cast<float>(r / static_cast<double>(count)) * kInv255,
-            static_cast<float>(g / static_cast<double>(count)) * kInv255,
-            static_cast<float>(b / static_cast<double>(count)) * kInv255,
-            1.0F
-        };
+        switch (format) {
+        case PixelFormat::Rgb8:
+            out = {mean(sums[0]) * kInv255, mean(sums[1]) * kInv255, mean(sums[2]) * kInv255, 1.0F};
+            return true;
+        case PixelFormat::Bgr8:
+            out = {mean(sums[2]) * kInv255, mean(sums[1]) * kInv255, mean(sums[0]) * kInv255, 1.0F};
+            return true;
+        case PixelFormat::Rgba8:
+            out = {
+                mean(sums[0]) * kInv255, mean(sums[1]) * kInv255, mean(sums[2]) * kInv255, mean(sums[3]) * kInv255};
+            return true;
+        case PixelFormat::Yuv422:
+            // The conversion is affine, so converting the mean is the mean colour.
+            out = detail::YuvToRGBAColor(0.5F * (mean(sums[1]) + mean(sums[3])), mean(sums[0]), mean(sums[2]));
+            return true;
+        case PixelFormat::Mono8:
+            break;
+        }
+        const float luminance = mean(sums[0]) * kInv255;
+        out = {luminance, luminance, luminance, 1.0F};
         return true;
     }
 
@@ -329,6 +401,16 @@ namespace hako::robots::sensor::camera
         virtual void Capture(ImageFrame& rgb_out, DepthFrame& depth_out) = 0;
     };
 
+    // Interface for a segmentation (object id) camera sensor
+    class ISegmentationCameraSensor : public CameraSensorBase
+    {
+    public:
+        virtual ~ISegmentationCameraSensor() = default;
+        virtual bool LoadConfig(const SegmentationCameraConfig& config) = 0;
+        virtual const SegmentationCameraConfig& GetConfig() const = 0;
+        virtual void Capture(SegmentationFrame& out) = 0;
+    };
+
     class IStereoCameraSensor : public CameraSensorBase
     {
     public:
@@ -336,11 +418,26 @@ namespace hako::robots::sensor::camera
         virtual bool LoadConfig(const StereoCameraConfig& config) = 0;
         virtual const StereoCameraConfig& GetConfig() const = 0;
         virtual void Capture(ImageFrame& left_out, ImageFrame& right_out) = 0;
+        // disparity_out is cleared unless StereoCameraConfig::disparity is set.
+        virtual void Capture(ImageFrame& left_out, ImageFrame& right_out, DisparityFrame& disparity_out) = 0;
+    };
+
+
+    // Camera sensor whose views can be rendered by a shared pass together
+    // with other cameras (see CameraTilePass). AppendViews() adds the views
+    // of one capture in a fixed order; the concrete sensor's FinishTiles()
+    // overload builds its frames from the rendered views in that order, or
+    // clears them when passed nullptr.
+    class ITiledCameraSensor
+    {
+    public:
+        virtual ~ITiledCameraSensor() = default;
+        virtual std::size_t AppendViews(std::vector<CameraView>& views) const = 0;
     };
 
 
     // --- Concrete Implementation ---
-    class CameraSensor : public ICameraSensor
+    class CameraSensor : public ICameraSensor, public ITiledCameraSensor
     {
     public:
         CameraSensor(std::shared_ptr<MujocoCameraRenderer> renderer, const std::string& camera_name);
@@ -350,13 +447,19 @@ namespace hako::robots::sensor::camera
         bool LoadConfig(const CameraConfig& config) override;
         const CameraConfig& GetConfig() const override;
         void Capture(ImageFrame& out) override;
+        // Tiled views are always read back synchronously (readback.mode is
+        // ignored).
+        std::size_t AppendViews(std::vector<CameraView>& views) const override;
+        void FinishTiles(const RawCameraFrame* views, ImageFrame& out) const;
     private:
         std::shared_ptr<MujocoCameraRenderer> renderer_;
         std::string camera_name_;
+        // Resolved once in the constructor.
+        hako::robots::physics::CameraHandle camera_;
         CameraConfig config_;
     };
 
-    class DepthCameraSensor : public IDepthCameraSensor
+    class DepthCameraSensor : public IDepthCameraSensor, public ITiledCameraSensor
     {
     public:
         DepthCameraSensor(std::shared_ptr<MujocoCameraRenderer> renderer, const std::string& camera_name);
@@ -366,13 +469,18 @@ namespace hako::robots::sensor::camera
         bool LoadConfig(const DepthCameraConfig& config) override;
         const DepthCameraConfig& GetConfig() const override;
         void Capture(DepthFrame& out) override;
+        std::size_t AppendViews(std::vector<CameraView>& views) const override;
+        void FinishTiles(const RawCameraFrame* views, DepthFrame& out) const;
     private:
         std::shared_ptr<MujocoCameraRenderer> renderer_;
         std::string camera_name_;
+        // Resolved once in the constructor.
+        hako::robots::physics::CameraHandle camera_;
         DepthCameraConfig config_;
+        std::unique_ptr<RawCameraFrame> raw_;
     };
 
-    class RgbdCameraSensor : public IRgbdCameraSensor
+    class RgbdCameraSensor : public IRgbdCameraSensor, public ITiledCameraSensor
     {
     public:
         RgbdCameraSensor(std::shared_ptr<MujocoCameraRenderer> renderer, const std::string& camera_name);
@@ -382,13 +490,46 @@ namespace hako::robots::sensor::camera
         bool LoadConfig(const RgbdCameraConfig& config) override;
         const RgbdCameraConfig& GetConfig() const override;
         void Capture(ImageFrame& rgb_out, DepthFrame& depth_out) override;
+        std::size_t AppendViews(std::vector<CameraView>& views) const override;
+        void FinishTiles(const RawCameraFrame* views, ImageFrame& rgb_out, DepthFrame& depth_out) const;
     private:
         std::shared_ptr<MujocoCameraRenderer> renderer_;
         std::string camera_name_;
+        // Resolved once in the constructor.
+        hako::robots::physics::CameraHandle camera_;
         RgbdCameraConfig config_;
+        std::unique_ptr<RawCameraFrame> raw_;
+    };
+
+    // Labels come from MuJoCo's segmentation rendering mode, so each pixel is
+    // the exact id of the object it shows. Added to a CameraTilePass, the
+    // labels are rendered from the same scene update as the other cameras.
+    class SegmentationCameraSensor : public ISegmentationCameraSensor, public ITiledCameraSensor
+    {
+    public:
+        SegmentationCameraSensor(std::shared_ptr<MujocoCameraRenderer> renderer, const std::string& camera_name);
+        ~SegmentationCameraSensor() override;
+
+        bool LoadConfig(const std::string& path);
+        bool LoadConfig(const SegmentationCameraConfig& config) override;
+        const SegmentationCameraConfig& GetConfig() const override;
+        void Capture(SegmentationFrame& out) override;
+        std::size_t AppendViews(std::vector<CameraView>& views) const override;
+        void FinishTiles(const RawCameraFrame* views, SegmentationFrame& out) const;
+
+    private:
+        std::shared_ptr<MujocoCameraRenderer> renderer_;
+        std::string camera_name_;
+        // Resolved once in the constructor.
+        hako::robots::physics::CameraHandle camera_;
+        SegmentationCameraConfig config_;
+        // geom id -> body id, filled by LoadConfig() for label "body".
+        std::vector<std::int32_t> geom_body_ids_;
+        std::vector<CameraView> views_;
+        std::vector<RawCameraFrame> raw_views_;
     };
 
-    class StereoCameraSensor : public IStereoCameraSensor
+    class StereoCameraSensor : public IStereoCameraSensor, public ITiledCameraSensor
     {
     public:
         StereoCameraSensor(
@@ -400,12 +541,26 @@ namespace hako::robots::sensor::camera
         bool LoadConfig(const std::string& path);
         bool LoadConfig(const StereoCameraConfig& config) override;
         const StereoCameraConfig& GetConfig() const override;
+        // Both eyes are rendered from one scene update and read back together;
+        // with disparity enabled the left eye's depth comes from the same readback.
         void Capture(ImageFrame& left_out, ImageFrame& right_out) override;
+        void Capture(ImageFrame& left_out, ImageFrame& right_out, DisparityFrame& disparity_out) override;
+        std::size_t AppendViews(std::vector<CameraView>& views) const override;
+        void FinishTiles(const RawCameraFrame* views, ImageFrame& left_out, ImageFrame& right_out) const;
+        void FinishTiles(
+            const RawCameraFrame* views,
+            ImageFrame& left_out,
+            ImageFrame& right_out,
+            DisparityFrame& disparity_out) const;
 
     private:
         std::shared_ptr<MujocoCameraRenderer> renderer_;
         std::string left_camera_name_;
         std::string right_camera_name_;
+        hako::robots::physics::CameraHandle left_camera_;
+        hako::robots::physics::CameraHandle right_camera_;
         StereoCameraConfig config_;
+        std::vector<CameraView> views_;
+        std::vector<RawCameraFrame> raw_views_;
     };
 }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hako::robots::sensor::camera
+{
+    // Placement of one camera view inside the offscreen framebuffer. x/y are
+    // the bottom-left corner in OpenGL window coordinates; atlas numbers the
+    // readback pass the tile belongs to.
+    struct CameraTile
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        int atlas = 0;
+    };
+
+    // Place tiles (width/height set by the caller) on shelves of an
+    // atlas_width x atlas_height framebuffer, tallest first. Tiles that do not
+    // fit on the current atlas start a new one, i.e. a further readback pass.
+    // Returns false if a tile is empty or larger than the framebuffer.
+    bool LayoutCameraTiles(int atlas_width, int atlas_height, std::vector<CameraTile>& tiles);
+
+    // Number of atlases used by a layout, and the extent of one of them that
+    // must be read back to cover all its tiles.
+    int CountCameraTileAtlases(const std::vector<CameraTile>& tiles);
+    void GetCameraTileAtlasExtent(const std::vector<CameraTile>& tiles, int atlas, int& width, int& height);
+
+    // Copy a tile out of a bottom-up atlas readback into a top-down image.
+    template <typename T>
+    void CopyCameraTileRows(const T* atlas, int atlas_width, int channels, const CameraTile& tile, T* top_down)
+    {
+        const std::size_t atlas_row = static_cast<std::size_t>(atlas_width) * static_cast<std::size_t>(channels);
+        const std::size_t tile_row = static_cast<std::size_t>(tile.width) * static_cast<std::size_t>(channels);
+        const std::size_t column = static_cast<std::size_t>(tile.x) * static_cast<std::size_t>(channels);
+        for (int row = 0; row < tile.height; ++row) {
+            const std::size_t source_row = static_cast<std::size_t>(tile.y + tile.height - 1 - row);
+            std::copy_n(
+                atlas + source_row * atlas_row + column,
+                tile_row,
+                top_down + static_cast<std::size_t>(row) * tile_row);
+        }
+    }
+
+    // Decode a tile of a bottom-up RGB atlas drawn in MuJoCo's segmentation
+    // mode with mjRND_IDCOLOR into top-down labels. A pixel holds segid + 1
+    // as r | g << 8 | b << 16, 0 being the background; segid_to_label maps a
+    // segid to its label. Background and segids outside the table give -1.
+    void DecodeSegmentationTile(
+        const std::uint8_t* atlas_rgb,
+        int atlas_width,
+        const CameraTile& tile,
+        const std::vector<int>& segid_to_label,
+        std::int32_t* top_down);
+}
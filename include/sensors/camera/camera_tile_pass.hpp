@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/mujoco_camera_renderer.hpp"
+
+namespace hako::robots::sensor::camera
+{
+    /**
+     * @brief Renders the views of several camera sensors in one pass.
+     *
+     * Each due sensor is added with Add(); Render() then builds the MuJoCo
+     * scene once for the current mjData, draws every view into its own tile
+     * of the renderer's offscreen buffer and reads the tiles back together
+     * (see MujocoCameraRenderer::RenderViews). Afterwards each sensor builds
+     * its frames from its slice with its FinishTiles() overload:
+     *
+     *     pass.Clear();
+     *     const int front = pass.Add(front_camera);
+     *     const int stereo = pass.Add(stereo_camera);
+     *     pass.Render();
+     *     front_camera.FinishTiles(pass.Views(front), front_frame);
+     *     stereo_camera.FinishTiles(pass.Views(stereo), left_frame, right_frame);
+     *
+     * All sensors must use the renderer the pass was created with, and
+     * mjData must not change between Render() and the FinishTiles() calls.
+     * Not thread-safe.
+     */
+    class CameraTilePass
+    {
+    public:
+        explicit CameraTilePass(std::shared_ptr<MujocoCameraRenderer> renderer);
+
+        /**
+         * @brief Forget the sensors added for the previous pass.
+         */
+        void Clear();
+
+        /**
+         * @brief Queue the views of one capture of a sensor.
+         *
+         * @return Handle for Views().
+         */
+        int Add(const ITiledCameraSensor& sensor);
+
+        /**
+         * @brief Render and read back all queued views.
+         *
+         * @return false if the renderer rejected the views; Views() then
+         *         returns nullptr for every handle.
+         */
+        bool Render();
+
+        /**
+         * @brief Rendered views of the sensor added as handle, in the order
+         *        the sensor appended them, or nullptr if not rendered.
+         */
+        const RawCameraFrame* Views(int handle) const;
+
+        std::size_t ViewCount() const { return views_.size(); }
+
+    private:
+        std::shared_ptr<MujocoCameraRenderer> renderer_;
+        std::vector<CameraView> views_;
+        // First view index of each added sensor.
+        std::vector<std::size_t> offsets_;
+        std::vector<RawCameraFrame> frames_;
+        bool rendered_ = false;
+    };
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hako::robots::sensor::camera
+{
+    // zlib levels: 0 stores the data, 1 is the fastest LZ77 search and 9 the
+    // most thorough one.
+    constexpr int kDeflateStoreLevel = 0;
+    constexpr int kDeflateFastestLevel = 1;
+    constexpr int kDeflateBestLevel = 9;
+
+    // CRC-32 (IEEE 802.3, as in PNG chunks and gzip), slicing-by-8.
+    // Pass the previous result as crc to continue a running checksum.
+    std::uint32_t Crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0);
+
+    // Adler-32 (zlib stream trailer). Pass the previous result as adler to
+    // continue a running checksum.
+    std::uint32_t Adler32(const std::uint8_t* data, std::size_t size, std::uint32_t adler = 1);
+
+    // Compress data into a zlib stream (RFC 1950/1951) with greedy or lazy
+    // LZ77 matching and dynamic Huffman blocks; blocks that would not shrink
+    // are stored. level is clamped to 0-9. out is overwritten.
+    void ZlibCompress(const std::uint8_t* data, std::size_t size, int level, std::vector<std::uint8_t>& out);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hako::robots::sensor::camera
+{
+    // Conversion of mjr_readPixels depth samples to metric distances.
+    struct DepthKernelParams
+    {
+        // Effective clip planes of the projection that produced the samples (m).
+        float znear = 0.0F;
+        float zfar = 0.0F;
+        // Sensor range (m); distances outside it are invalid.
+        float clip_near = 0.0F;
+        float clip_far = 0.0F;
+        // mjDEPTH_ZEROFAR: 1 at the near plane, 0 at the far plane.
+        bool reversed = false;
+    };
+
+    // Fused linearize + clip pass: out[i] is the distance in meters, or NaN
+    // outside [clip_near, clip_far]. out may alias samples.
+    void LinearizeDepthMeters(const float* samples, std::size_t count, const DepthKernelParams& params, float* out);
+
+    // Fused linearize + clip + DEPTH_U16_MM quantization: out[i] is the
+    // rounded distance in millimeters, or 0 when invalid or above 65535.
+    void LinearizeDepthMillimeters(
+        const float* samples, std::size_t count, const DepthKernelParams& params, std::uint16_t* out);
+
+    // DEPTH_U16_MM quantization of metric depth, with the same rules.
+    void QuantizeDepthMillimeters(const float* meters, std::size_t count, std::uint16_t* out);
+
+    // Same, stored as 2 * count little-endian bytes, for quantizing straight
+    // into a byte buffer such as a 16UC1 image payload.
+    void QuantizeDepthMillimeters(const float* meters, std::size_t count, std::uint8_t* out);
+
+    namespace detail
+    {
+        // Portable versions used when no SIMD kernel applies; exposed for
+        // tests and benchmarks.
+        void LinearizeDepthMetersScalar(
+            const float* samples, std::size_t count, const DepthKernelParams& params, float* out);
+        void LinearizeDepthMillimetersScalar(
+            const float* samples, std::size_t count, const DepthKernelParams& params, std::uint16_t* out);
+        void QuantizeDepthMillimetersScalar(const float* meters, std::size_t count, std::uint16_t* out);
+    }
+}
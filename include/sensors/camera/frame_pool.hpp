@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sensors/camera/camera_sensor.hpp"
+
+namespace hako::robots::sensor::camera
+{
+    struct FramePoolStats
+    {
+        // Acquire() calls, and how many of them got an idle frame back.
+        std::uint64_t acquired {0};
+        std::uint64_t reused {0};
+        // Frames created because no idle frame of the key existed. Constant
+        // in steady state: every capture reuses a frame and its buffers.
+        std::uint64_t allocated {0};
+        std::uint64_t released {0};
+        // Frames currently borrowed, and idle frames kept for reuse.
+        std::size_t live {0};
+        std::size_t idle {0};
+    };
+
+    template <typename Frame>
+    class FramePool;
+
+    /**
+     * @brief Reference-counted handle to a frame borrowed from a FramePool.
+     *
+     * Copies share the frame; the frame goes back to the pool, with its
+     * buffers and their capacity, when the last handle is reset or
+     * destroyed. A frame handed to several consumers (sender, encoder,
+     * recorder) is read-only for all of them; only a holder whose UseCount()
+     * is 1 may modify it. Handles may outlive their pool.
+     */
+    template <typename Frame>
+    class PooledFrame
+    {
+    public:
+        PooledFrame() = default;
+        ~PooledFrame() { Reset(); }
+
+        PooledFrame(const PooledFrame& other) : slot_(other.slot_)
+        {
+            if (slot_ != nullptr) {
+                slot_->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        PooledFrame(PooledFrame&& other) noexcept : slot_(std::exchange(other.slot_, nullptr)) {}
+
+        PooledFrame& operator=(const PooledFrame& other)
+        {
+            if (this != &other) {
+                PooledFrame(other).Swap(*this);
+            }
+            return *this;
+        }
+
+        PooledFrame& operator=(PooledFrame&& other) noexcept
+        {
+            if (this != &other) {
+                Reset();
+                slot_ = std::exchange(other.slot_, nullptr);
+            }
+            return *this;
+        }
+
+        void Swap(PooledFrame& other) noexcept { std::swap(slot_, other.slot_); }
+
+        /**
+         * @brief Drop this reference; the last one returns the frame.
+         */
+        void Reset()
+        {
+            if (slot_ != nullptr && slot_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                slot_->core->Return(slot_);
+            }
+            slot_ = nullptr;
+        }
+
+        Frame* get() const { return slot_ != nullptr ? &slot_->frame : nullptr; }
+        Frame& operator*() const { return slot_->frame; }
+        Frame* operator->() const { return &slot_->frame; }
+        explicit operator bool() const { return slot_ != nullptr; }
+
+        long UseCount() const
+        {
+            return slot_ != nullptr ? static_cast<long>(slot_->refs.load(std::memory_order_acquire)) : 0;
+        }
+
+    private:
+        friend class FramePool<Frame>;
+        using Slot = typename FramePool<Frame>::Slot;
+
+        explicit PooledFrame(Slot* slot) : slot_(slot) {}
+
+        Slot* slot_ {nullptr};
+    };
+
+    /**
+     * @brief Recycles frames, and the buffers inside them, per resolution
+     *        and format.
+     *
+     * Acquire() returns an idle frame last used with the same width, height
+     * and format, so filling it again resizes its buffers to the size they
+     * already have instead of allocating. Only when no such frame is idle is
+     * a new one created, which GetStats() counts in `allocated`: once every
+     * stage of a capture pipeline holds the frames it needs, that counter
+     * stops moving.
+     *
+     * Thread-safe: frames may be acquired on one thread and released on any
+     * other. Keys are compared, not hashed; a pool serves a handful of
+     * camera streams.
+     */
+    template <typename Frame>
+    class FramePool
+    {
+    public:
+        FramePool() : core_(new Core()) {}
+
+        ~FramePool()
+        {
+            // Idle frames are freed now, borrowed ones when their last
+            // handle is released.
+            std::vector<Slot*> idle;
+            {
+                std::lock_guard<std::mutex> lock(core_->mutex);
+                core_->closed = true;
+                for (auto& bucket : core_->buckets) {
+                    idle.insert(idle.end(), bucket.idle.begin(), bucket.idle.end());
+                    bucket.idle.clear();
+                }
+            }
+            for (Slot* slot : idle) {
+                delete slot;
+                core_->Unref();
+            }
+            core_->Unref();
+        }
+
+        FramePool(const FramePool&) = delete;
+        FramePool& operator=(const FramePool&) = delete;
+
+        /**
+         * @brief Borrow a frame for images of this width, height and format.
+         *
+         * A reused frame keeps whatever the previous user left in it; the
+         * caller overwrites the fields it needs.
+         */
+        PooledFrame<Frame> Acquire(int width, int height, const std::string& format)
+        {
+            Slot* slot = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(core_->mutex);
+                ++core_->stats.acquired;
+                Bucket& bucket = core_->FindBucket(width, height, format);
+                if (!bucket.idle.empty()) {
+                    slot = bucket.idle.back();
+                    bucket.idle.pop_back();
+                    ++core_->stats.reused;
+                    --core_->stats.idle;
+                } else {
+                    ++core_->stats.allocated;
+                    core_->refs.fetch_add(1, std::memory_order_relaxed);
+                }
+                ++core_->stats.live;
+                if (slot == nullptr) {
+                    slot = new Slot();
+                    slot->core = core_;
+                    slot->bucket = static_cast<std::size_t>(&bucket - core_->buckets.data());
+                }
+            }
+            slot->refs.store(1, std::memory_order_relaxed);
+            return PooledFrame<Frame>(slot);
+        }
+
+        FramePoolStats GetStats() const
+        {
+            std::lock_guard<std::mutex> lock(core_->mutex);
+            return core_->stats;
+        }
+
+    private:
+        friend class PooledFrame<Frame>;
+        struct Core;
+
+        struct Slot
+        {
+            Frame frame {};
+            std::atomic<std::uint32_t> refs {0};
+            Core* core {nullptr};
+            std::size_t bucket {0};
+        };
+
+        struct Bucket
+        {
+            int width {0};
+            int height {0};
+            std::string format {};
+            std::vector<Slot*> idle {};
+        };
+
+        // Shared by the pool and its slots so that handles can outlive the
+        // pool; freed with the last of them.
+        struct Core
+        {
+            std::mutex mutex {};
+            std::vector<Bucket> buckets {};
+            FramePoolStats stats {};
+            bool closed {false};
+            std::atomic<std::size_t> refs {1};
+
+            Bucket& FindBucket(int width, int height, const std::string& format)
+            {
+                for (auto& bucket : buckets) {
+                    if (bucket.width == width && bucket.height == height && bucket.format == format) {
+                        return bucket;
+                    }
+                }
+                Bucket& bucket = buckets.emplace_back();
+                bucket.width = width;
+                bucket.height = height;
+                bucket.format = format;
+                return bucket;
+            }
+
+            void Return(Slot* slot)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++stats.released;
+                    --stats.live;
+                    if (!closed) {
+                        buckets[slot->bucket].idle.push_back(slot);
+                        ++stats.idle;
+                        return;
+                    }
+                }
+                delete slot;
+                Unref();
+            }
+
+            void Unref()
+            {
+                if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    delete this;
+                }
+            }
+        };
+
+        Core* core_;
+    };
+
+    using ImageFramePool = FramePool<ImageFrame>;
+    using PooledImageFrame = PooledFrame<ImageFrame>;
+    using DepthFramePool = FramePool<DepthFrame>;
+    using PooledDepthFrame = PooledFrame<DepthFrame>;
+}
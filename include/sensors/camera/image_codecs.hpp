@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sensors/camera/camera_sensor.hpp"
+
+namespace hako::robots::sensor::camera
+{
+    // Still-image codecs for sensor_msgs/CompressedImage output.
+    enum class ImageCodec
+    {
+        Jpeg, // baseline JPEG, 4:2:0 chroma for colour frames; lossy
+        Png,  // PNG through the image_frame_writer encoder; lossless
+        Qoi,  // "Quite OK Image" format; lossless and much faster than PNG
+    };
+
+    // Per-camera compression settings ("pdu_config.compression" in the
+    // camera JSON).
+    struct ImageCompressionConfig
+    {
+        std::string codec = "jpeg";
+        // 1 (smallest) to 100 (best), IJG quality scaling.
+        int jpeg_quality = 80;
+    };
+
+    struct CompressedImageFrame
+    {
+        // CompressedImage format string: "jpeg", "png" or "qoi".
+        std::string format;
+        std::string frame_id;
+        std::vector<uint8_t> data;
+        double timestamp = 0.0;
+    };
+
+    bool ParseImageCodec(const std::string& name, ImageCodec& out);
+    const char* ImageCodecName(ImageCodec codec);
+
+    // False for an unknown codec or a JPEG quality outside 1-100.
+    bool ValidateImageCompressionConfig(const ImageCompressionConfig& config);
+
+    // The codecs take R8G8B8, B8G8R8, R8G8B8A8 and L8 frames; YUV422 is
+    // rejected. out is resized in place so a reused buffer keeps its capacity.
+    bool EncodeJpeg(const ImageFrame& frame, int quality, std::vector<uint8_t>& out);
+    bool EncodeQoi(const ImageFrame& frame, std::vector<uint8_t>& out);
+
+    // Encode frame with config.codec and copy its header fields.
+    bool CompressImageFrame(
+        const ImageFrame& frame,
+        const ImageCompressionConfig& config,
+        CompressedImageFrame& out);
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/frame_pool.hpp"
+#include "sensors/camera/image_codecs.hpp"
+
+namespace hako::robots::sensor::camera
+{
+    /**
+     * @brief Compresses camera frames on dedicated encoder threads.
+     *
+     * The publishing thread hands a captured frame to Submit(), which swaps
+     * its pixel buffer into a bounded queue and returns at once; the frame
+     * gets a recycled buffer back, so steady-state capture does not allocate.
+     * A pooled frame is queued by reference instead, and returns to its
+     * FramePool once encoded.
+     * Encoder threads compress queued frames with the configured codec, and
+     * TryTakeLatest() returns the newest finished frame, skipping older ones
+     * that finished late.
+     *
+     * When the queue is full Submit() drops the frame and counts it rather
+     * than waiting, so a slow codec lowers the published rate instead of
+     * stalling physics.
+     */
+    class ImageCompressionWorker
+    {
+    public:
+        struct Stats
+        {
+            std::uint64_t submitted {0};
+            std::uint64_t dropped {0};
+            std::uint64_t encoded {0};
+            std::uint64_t failed {0};
+        };
+
+        ImageCompressionWorker() = default;
+        ~ImageCompressionWorker();
+
+        ImageCompressionWorker(const ImageCompressionWorker&) = delete;
+        ImageCompressionWorker& operator=(const ImageCompressionWorker&) = delete;
+
+        /**
+         * @brief Start the encoder threads.
+         *
+         * @param config Codec settings; validated here.
+         * @param threads Number of encoder threads (at least 1).
+         * @param queue_capacity Frames that may wait for an encoder (at least 1).
+         * @return false if already running or an argument is invalid.
+         */
+        bool Start(const ImageCompressionConfig& config, std::size_t threads = 1, std::size_t queue_capacity = 2);
+
+        /**
+         * @brief Stop and join the encoder threads. Queued frames are discarded.
+         */
+        void Stop();
+
+        bool Running() const { return !threads_.empty(); }
+
+        /**
+         * @brief Queue frame for compression.
+         *
+         * On success frame.data is swapped for a recycled buffer whose
+         * contents are unspecified.
+         *
+         * @return false if the worker is stopped or the queue is full.
+         */
+        bool Submit(ImageFrame& frame);
+
+        /**
+         * @brief Queue a reference to a pooled frame for compression.
+         *
+         * The frame is only read, so it may be shared with other consumers.
+         *
+         * @return false if the worker is stopped, frame is empty or the
+         *         queue is full.
+         */
+        bool Submit(const PooledImageFrame& frame);
+
+        /**
+         * @brief Take the newest compressed frame not taken yet.
+         *
+         * out.data is swapped with the result buffer, so passing the same
+         * out each time keeps both buffers' capacity.
+         *
+         * @return false if nothing new was encoded since the last call.
+         */
+        bool TryTakeLatest(CompressedImageFrame& out);
+
+        Stats GetStats() const;
+
+    private:
+        struct Job
+        {
+            std::uint64_t sequence {0};
+            ImageFrame frame {};
+            // Set instead of frame by Submit(const PooledImageFrame&).
+            PooledImageFrame pooled {};
+        };
+
+        // Claims the next queue slot; the caller holds mutex_ and fills it.
+        Job* PushJob();
+
+        void Run();
+
+        ImageCompressionConfig config_ {};
+        std::size_t queue_capacity_ {0};
+        std::size_t thread_count_ {0};
+        mutable std::mutex mutex_ {};
+        std::condition_variable ready_ {};
+        // Fixed ring of queue_capacity_ jobs; slots keep their buffers.
+        std::vector<Job> queue_ {};
+        std::size_t queue_head_ {0};
+        std::size_t queue_size_ {0};
+        // Pixel buffers of encoded frames, handed back to Submit() callers.
+        std::vector<std::vector<std::uint8_t>> spare_buffers_ {};
+        CompressedImageFrame latest_ {};
+        std::uint64_t latest_sequence_ {0};
+        bool latest_pending_ {false};
+        std::uint64_t next_sequence_ {0};
+        bool stopping_ {false};
+        Stats stats_ {};
+        std::vector<std::thread> threads_ {};
+    };
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/frame_pool.hpp"
+#include "sensors/camera/image_frame_writer.hpp"
+
+namespace hako::robots::sensor::camera
+{
+    struct ImageFrameRecorderConfig
+    {
+        // Frames go to <directory>/<stream>/<index>.png, index counting from 0
+        // per stream.
+        std::filesystem::path directory {};
+        // Frames waiting for a writer; Submit() drops frames beyond this.
+        std::size_t queue_capacity {8};
+        std::size_t writer_threads {1};
+        int compression_level {kDefaultPngCompressionLevel};
+    };
+
+    /**
+     * @brief Records camera frames to PNG files on background writer threads.
+     *
+     * Submit() copies the frame into a recycled buffer and queues it, so the
+     * capture thread never waits for encoding or the disk. A pooled frame is
+     * queued by reference without a copy. When the writers
+     * fall behind and the queue is full the frame is dropped and counted; the
+     * stream index still advances, so gaps in the file numbers show where
+     * frames were lost.
+     */
+    class ImageFrameRecorder
+    {
+    public:
+        struct Stats
+        {
+            std::uint64_t submitted {0};
+            std::uint64_t dropped {0};
+            std::uint64_t written {0};
+            std::uint64_t failed {0};
+            std::uint64_t bytes_written {0};
+        };
+
+        ImageFrameRecorder() = default;
+        ~ImageFrameRecorder();
+
+        ImageFrameRecorder(const ImageFrameRecorder&) = delete;
+        ImageFrameRecorder& operator=(const ImageFrameRecorder&) = delete;
+
+        /**
+         * @brief Create the output directory and start the writer threads.
+         *
+         * @return false if already running, the configuration is invalid or
+         *         the directory cannot be created.
+         */
+        bool Start(const ImageFrameRecorderConfig& config);
+
+        /**
+         * @brief Write the frames still queued, then join the writers.
+         */
+        void Stop();
+
+        bool Running() const { return !threads_.empty(); }
+
+        /**
+         * @brief Queue a copy of frame for <directory>/<stream>.
+         *
+         * @return false if the recorder is stopped, the frame is empty, the
+         *         queue is full or stream is not a plain directory name (empty,
+         *         containing '/', '\\', ':' or "..").
+         */
+        bool Submit(const std::string& stream, const ImageFrame& frame);
+
+        /**
+         * @brief Queue a reference to a pooled frame for <directory>/<stream>.
+         *
+         * The frame is only read; it returns to its pool once written.
+         */
+        bool Submit(const std::string& stream, const PooledImageFrame& frame);
+
+        Stats GetStats() const;
+
+    private:
+        struct Job
+        {
+            std::filesystem::path path {};
+            ImageFrame frame {};
+            // Set instead of frame by Submit(stream, const PooledImageFrame&).
+            PooledImageFrame pooled {};
+        };
+
+        // Hand out the next index of stream, registering it on first use.
+        // Rejects names that would escape config_.directory. Needs mutex_.
+        bool NextFrameIndex(const std::string& stream, std::uint64_t& index);
+        std::filesystem::path FramePath(const std::string& stream, std::uint64_t index) const;
+
+        void Run();
+
+        ImageFrameRecorderConfig config_ {};
+        mutable std::mutex mutex_ {};
+        std::condition_variable ready_ {};
+        std::deque<Job> queue_ {};
+        // Pixel buffers of written frames, reused by Submit().
+        std::vector<std::vector<std::uint8_t>> spare_buffers_ {};
+        std::map<std::string, std::uint64_t> stream_indices_ {};
+        // Invalid stream names already reported, so each is logged once.
+        std::set<std::string> rejected_streams_ {};
+        bool stopping_ {false};
+        Stats stats_ {};
+        std::vector<std::thread> threads_ {};
+    };
+}
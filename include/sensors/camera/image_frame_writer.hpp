@@ -2,11 +2,25 @@
 
 #include "sensors/camera/camera_sensor.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <vector>
 
 namespace hako::robots::sensor::camera
 {
+    // zlib level used for PNG output unless the caller picks one: the
+    // fastest search already removes most of the redundancy after filtering.
+    constexpr int kDefaultPngCompressionLevel = 1;
+
+    // PNG bytes of an R8G8B8, B8G8R8, R8G8B8A8 or L8 frame. Rows are filtered
+    // and deflated with compression_level (0 stores, 1-9 as in zlib).
+    bool EncodeImageFrameToPng(
+        const ImageFrame& frame,
+        std::vector<uint8_t>& out,
+        int compression_level = kDefaultPngCompressionLevel);
+
     bool WriteImageFrameToPng(
         const ImageFrame& frame,
-        const std::filesystem::path& path);
+        const std::filesystem::path& path,
+        int compression_level = kDefaultPngCompressionLevel);
 }
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hako::robots::sensor::camera
+{
+    // Pixel layouts of ImageConfig::format.
+    enum class PixelFormat
+    {
+        Rgb8,   // "R8G8B8"
+        Bgr8,   // "B8G8R8"
+        Mono8,  // "L8"
+        Rgba8,  // "R8G8B8A8", alpha 255
+        Yuv422, // "YUV422", UYVY byte order, BT.601 video range
+    };
+
+    // False for a format name the camera encoders do not produce.
+    bool ParsePixelFormat(const std::string& name, PixelFormat& out);
+
+    // Bytes per pixel in a row: 3, 3, 1, 4 and 2 (a U or V byte plus a Y byte).
+    int PixelFormatBytesPerPixel(PixelFormat format);
+
+    // YUV422 shares chroma between pixel pairs, so its width must be even.
+    inline bool IsValidPixelFormatWidth(PixelFormat format, int width)
+    {
+        return format != PixelFormat::Yuv422 || width % 2 == 0;
+    }
+
+    // Convert one row of `width` packed RGB pixels into `format`. dst holds
+    // width * PixelFormatBytesPerPixel(format) bytes and must not overlap rgb.
+    // Mono8 is BT.601 luma in 8-bit fixed point:
+    //   Y = (77 R + 150 G + 29 B + 128) >> 8
+    void ConvertRgbRow(const std::uint8_t* rgb, int width, PixelFormat format, std::uint8_t* dst);
+
+    // Copy `rows` rows of row_bytes each from src (stride src_stride) to the
+    // packed dst in reverse order: OpenGL bottom-up readback to top-down.
+    void FlipRows(
+        const std::uint8_t* src, std::size_t src_stride, std::size_t row_bytes, int rows, std::uint8_t* dst);
+
+    // sums[c] += data[g * stride + c] over `groups` interleaved groups of
+    // `stride` bytes (1 to 4), e.g. one row span of an RGB region with
+    // stride 3. sums is not cleared, so rows can be accumulated.
+    void SumInterleavedBytes(const std::uint8_t* data, std::size_t groups, int stride, std::uint64_t* sums);
+
+    namespace detail
+    {
+        // Portable versions used when no SIMD kernel applies; exposed for
+        // tests and benchmarks.
+        void ConvertRgbRowScalar(const std::uint8_t* rgb, int width, PixelFormat format, std::uint8_t* dst);
+        void SumInterleavedBytesScalar(
+            const std::uint8_t* data, std::size_t groups, int stride, std::uint64_t* sums);
+    }
+}
@@ -1,12 +1,14 @@
 #pragma once
 
-#include "sensors/camera/glfw_manager.hpp"
+#include "sensors/camera/camera_tile_layout.hpp"
+#include "sensors/camera/render_context.hpp"
 #include "physics.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 #include <mujoco/mujoco.h>
-#include <GLFW/glfw3.h>
 
 namespace hako::robots::sensor::camera
 {
@@ -20,19 +22,50 @@ namespace hako::robots::sensor::camera
         double znear = 0.0;
         double zfar = 0.0;
         int depth_map = mjDEPTH_ZERONEAR;
+        // Geom id per pixel, top-down rows; -1 where no geom is visible
+        // (background, or a decor object such as a site).
+        std::vector<std::int32_t> segmentation;
+    };
+
+    // One camera rendered by MujocoCameraRenderer::RenderViews().
+    struct CameraView
+    {
+        // Resolved once with MujocoCameraRenderer::FindCamera(); the name is
+        // only used in messages.
+        hako::robots::physics::CameraHandle camera;
+        std::string camera_name;
+        int width = 0;
+        int height = 0;
+        double hfov_rad = 0.0;
+        double clip_near_m = 0.0;
+        double clip_far_m = 0.0;
+        bool need_rgb = true;
+        bool need_depth = false;
+        bool need_segmentation = false;
     };
 
     class MujocoCameraRenderer
     {
     public:
+        // Own context from DefaultRenderBackend().
         MujocoCameraRenderer(std::shared_ptr<hako::robots::physics::IWorld> world);
+        // create_hidden_window=false renders with the GLFW context current on
+        // the calling thread (the viewer's), see MujocoRenderRuntime.
         MujocoCameraRenderer(
             std::shared_ptr<hako::robots::physics::IWorld> world,
             bool create_hidden_window);
+        MujocoCameraRenderer(
+            std::shared_ptr<hako::robots::physics::IWorld> world,
+            RenderBackend backend);
         ~MujocoCameraRenderer();
 
+        // Resolve a camera name once, when a sensor is set up; the Render*()
+        // calls take the handle. Reports and returns an invalid handle for
+        // an unknown name, which the Render*() calls then reject.
+        hako::robots::physics::CameraHandle FindCamera(const std::string& camera_name) const;
+
         bool Render(
-            const std::string& camera_name,
+            const hako::robots::physics::CameraHandle& camera,
             int width,
             int height,
             double hfov_rad,
@@ -43,15 +76,111 @@ namespace hako::robots::sensor::camera
             RawCameraFrame& out
         );
 
+        // Render and read back RGB only, without the vertical flip. On success
+        // bottom_up_rgb points at width*height*3 bytes owned by the renderer,
+        // bottom row first, valid until the next Render*() call. Callers that
+        // convert the image anyway can flip during that pass (EncodeImageRows).
+        bool RenderRgbBottomUp(
+            const hako::robots::physics::CameraHandle& camera,
+            int width,
+            int height,
+            double hfov_rad,
+            double clip_near_m,
+            double clip_far_m,
+            const uint8_t*& bottom_up_rgb,
+            double& timestamp
+        );
+
+        // Pipelined readback through buffer_count (2 or 3) pixel buffer
+        // objects. The current frame is rendered and its transfer queued; the
+        // frame returned is the one queued buffer_count-1 calls earlier, with
+        // its own data->time as timestamp. While the pipeline fills, the call
+        // succeeds with bottom_up_rgb == nullptr. Otherwise bottom_up_rgb
+        // points into a mapped buffer that stays valid until the next
+        // Render*() call on this renderer.
+        bool RenderRgbPipelined(
+            const hako::robots::physics::CameraHandle& camera,
+            int width,
+            int height,
+            double hfov_rad,
+            double clip_near_m,
+            double clip_far_m,
+            int buffer_count,
+            const uint8_t*& bottom_up_rgb,
+            double& timestamp
+        );
+
+        // Render several cameras from the same physics state. The scene is
+        // built once, each view is drawn into its own viewport tile of the
+        // offscreen buffer and the tiles are read back together, one
+        // mjr_readPixels per filled buffer. out[i] receives view i exactly
+        // like Render() would (top-down rows, own clip range). Fails without
+        // rendering if a camera is unknown or a view exceeds the buffer.
+        //
+        // Views with need_segmentation are drawn a second time from the same
+        // scene in MuJoCo's segmentation mode (mjRND_SEGMENT|mjRND_IDCOLOR):
+        // flat colours without lighting, textures or multisample blending,
+        // so every pixel decodes to exactly one scene object.
+        bool RenderViews(const std::vector<CameraView>& views, std::vector<RawCameraFrame>& out);
+
+        // Model the renderer draws, e.g. to map rendered geom ids to bodies.
+        const mjModel* GetModel() const { return world_->getModel(); }
+
+        // Detach the renderer's own context from the calling thread so that
+        // another thread can render with it; every Render*() call makes it
+        // current again. No-op when rendering with the caller's context.
+        void ReleaseContext();
+
     private:
+        struct PixelBufferApi;
+
+        void InitializeMujocoContext();
+        void MakeContextCurrent();
+        bool LoadPixelBufferApi();
+        bool BeginOffscreen();
+        void UnmapPixelBuffer();
+        void ReleasePixelBuffers();
+
+        void DrawViewTiles(
+            const std::vector<CameraView>& views,
+            int atlas,
+            bool segmentation_pass,
+            std::vector<RawCameraFrame>& out);
+        void BuildSegmentationTable();
+
+        bool RenderScene(
+            const hako::robots::physics::CameraHandle& camera,
+            int width,
+            int height,
+            double hfov_rad,
+            double clip_near_m,
+            double clip_far_m,
+            RawCameraFrame& out
+        );
+
         std::shared_ptr<hako::robots::physics::IWorld> world_;
-        GlfwManager& glfw_manager_;
-        GLFWwindow* window_ = nullptr;
-        bool owns_window_ = false;
+        // Null when rendering with the caller's current context.
+        std::unique_ptr<IRenderContext> context_;
         
         mjvScene scn_{};
         mjrContext con_{};
         mjvCamera cam_{};
         mjvOption opt_{};
+        // mjr_readPixels targets, sized once and reused across frames.
+        std::vector<uint8_t> read_rgb_;
+        std::vector<float> read_depth_;
+        std::vector<CameraTile> view_tiles_;
+        std::vector<int> view_cam_ids_;
+        // Scene geom segid -> model geom id (-1 for decor), rebuilt per scene.
+        std::vector<int> segid_to_geom_;
+
+        // Pixel buffer objects for RenderRgbPipelined(), used as a ring.
+        std::unique_ptr<PixelBufferApi> pbo_api_;
+        std::vector<unsigned int> pbo_ids_;
+        std::vector<double> pbo_timestamps_;
+        int pbo_width_ = 0;
+        int pbo_height_ = 0;
+        std::size_t pbo_queued_ = 0;
+        int mapped_pbo_ = -1;
     };
 }
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace hako::robots::sensor::camera
+{
+    // Window system used to create the OpenGL context of a camera renderer.
+    // Glfw needs a display (X11/Wayland/Cocoa); Egl and Osmesa do not.
+    enum class RenderBackend
+    {
+        Glfw,
+        Egl,
+        Osmesa
+    };
+
+    // OpenGL context owned by one MujocoCameraRenderer. MuJoCo renders into
+    // its own offscreen framebuffer, so the context needs no visible surface.
+    // A context is used by one thread at a time; a renderer per worker thread
+    // gets a context per worker.
+    class IRenderContext
+    {
+    public:
+        virtual ~IRenderContext() = default;
+        virtual RenderBackend Backend() const = 0;
+        // Make the context current on the calling thread.
+        virtual void MakeCurrent() = 0;
+        // Detach the context from the calling thread if it is current there,
+        // so another thread can make it current.
+        virtual void ReleaseCurrent() = 0;
+        // GL entry point lookup through the backend's loader, or nullptr.
+        virtual void* GetProcAddress(const char* name) const = 0;
+    };
+
+    // Accepts "glfw", "egl" and "osmesa".
+    bool ParseRenderBackend(const std::string& name, RenderBackend& out);
+    const char* RenderBackendName(RenderBackend backend);
+    // Whether the backend was compiled in (HAKO_RENDER_WITH_EGL/OSMESA).
+    bool IsRenderBackendAvailable(RenderBackend backend);
+    // HAKO_RENDER_BACKEND from the environment if set and available,
+    // otherwise the build default (HAKO_CAMERA_RENDER_BACKEND).
+    RenderBackend DefaultRenderBackend();
+
+    // Create a context and make it current on the calling thread. Throws
+    // std::runtime_error if the backend is unavailable or fails.
+    std::unique_ptr<IRenderContext> CreateRenderContext(RenderBackend backend);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include <mujoco/mujoco.h>
+
+namespace hako::robots::sensor::common
+{
+    /**
+     * @brief Copy of the mjData fields that sensors read after a step.
+     *
+     * Only kinematic state is kept: joint state (qpos, qvel), body frames
+     * (xpos, xquat, xmat, xipos, ximat), geom and site frames used by ray
+     * casts, camera and light frames used by mjv_updateScene(), and the
+     * velocity terms mj_objectVelocity() needs (cvel, subtree_com). Buffers
+     * are sized on the first Capture() and reused.
+     */
+    struct KinematicSnapshot
+    {
+        double time {0.0};
+        double stamp_sec {0.0};
+        std::vector<mjtNum> qpos {};
+        std::vector<mjtNum> qvel {};
+        std::vector<mjtNum> xpos {};
+        std::vector<mjtNum> xquat {};
+        std::vector<mjtNum> xmat {};
+        std::vector<mjtNum> xipos {};
+        std::vector<mjtNum> ximat {};
+        std::vector<mjtNum> geom_xpos {};
+        std::vector<mjtNum> geom_xmat {};
+        std::vector<mjtNum> site_xpos {};
+        std::vector<mjtNum> site_xmat {};
+        std::vector<mjtNum> cam_xpos {};
+        std::vector<mjtNum> cam_xmat {};
+        std::vector<mjtNum> light_xpos {};
+        std::vector<mjtNum> light_xdir {};
+        std::vector<mjtNum> cvel {};
+        std::vector<mjtNum> subtree_com {};
+
+        // Copy the kinematic fields of data into the snapshot.
+        void Capture(const mjModel* model, const mjData* data);
+
+        // Write the snapshot into data, which must have been made for model.
+        // Returns false if the snapshot was never captured for this model size.
+        bool ApplyTo(const mjModel* model, mjData* data) const;
+    };
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+namespace hako::robots::sensor::common
+{
+    /**
+     * @brief Ray sensor whose rays can be cast by an external pass.
+     *
+     * A ray sensor measurement is split into three phases so that several
+     * sensors can share one cast pass (see SensorGroup):
+     *
+     * 1. PrepareRayBatch() reads the sensor pose from the current mjData,
+     *    rotates the ray table into world space and returns the ray count.
+     * 2. CastRayBatch(begin, end) casts rays [begin, end) of that batch.
+     *    Calls with disjoint ranges may run concurrently; they only read
+     *    mjModel/mjData and write per-ray slots owned by the sensor.
+     * 3. The sensor builds its frame from the cast results with its own
+     *    FinishRayBatch(frame) overload.
+     *
+     * mjData must not change between phase 1 and phase 3.
+     */
+    class IRayBatchSensor
+    {
+    public:
+        virtual ~IRayBatchSensor() = default;
+
+        /**
+         * @brief Snapshot the sensor pose and build world-space rays.
+         *
+         * @return Number of rays in the batch, or 0 if the sensor cannot
+         *         measure (no model, unresolved frame, empty ray table).
+         */
+        virtual std::size_t PrepareRayBatch() = 0;
+
+        /**
+         * @brief Cast rays [begin, end) of the prepared batch.
+         */
+        virtual void CastRayBatch(std::size_t begin, std::size_t end) = 0;
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <mujoco/mujoco.h>
+
+namespace hako::robots::sensor::common
+{
+    /**
+     * @brief Shared mj_ray front end for ray based sensors.
+     *
+     * Ray sensors must not see the robot they are mounted on. Instead of
+     * walking the body parent chain after every hit, Configure() classifies
+     * every geom once as "self" (inside the exclude body subtree) or
+     * "environment" and picks the cheapest filter that mj_ray can apply by
+     * itself:
+     *
+     * - GeomGroup: the self geoms use geom groups that no environment geom
+     *   uses, so a geomgroup mask hides the whole robot in one mj_ray call.
+     * - BodyExclude: all self geoms belong to one body, so mj_ray's
+     *   bodyexclude argument is enough.
+     * - Mask: the subtree cannot be expressed with mj_ray filters. Self hits
+     *   are skipped with a precomputed per-geom mask and the ray is re-cast
+     *   just past the hit.
+     * - None: nothing to exclude.
+     *
+     * Cast() is const and only reads mjModel/mjData, so one caster may be
+     * shared by several threads casting against the same state.
+     */
+    class RayCaster
+    {
+    public:
+        enum class SelfFilter
+        {
+            None,
+            GeomGroup,
+            BodyExclude,
+            Mask
+        };
+
+        /**
+         * @brief Classify geoms for the given model.
+         *
+         * @param model Model the caster is used with.
+         * @param exclude_root_body Root body of the subtree to ignore, or -1.
+         * @param origin_body Body the rays start from, or -1. In Mask mode it is
+         *        passed as bodyexclude so that rays leaving the sensor housing
+         *        do not need a retry.
+         */
+        void Configure(const mjModel* model, int exclude_root_body, int origin_body = -1);
+
+        /**
+         * @brief Step used to move the origin past a self hit in Mask mode.
+         */
+        void SetRetryEpsilon(mjtNum epsilon) { retry_epsilon_ = epsilon; }
+
+        /**
+         * @brief Cast one ray and return the distance to the first non-self geom.
+         *
+         * @param origin Ray origin in world coordinates.
+         * @param dir Unit ray direction in world coordinates.
+         * @param max_distance Hits at or beyond this distance are reported as no hit.
+         * @param geom_id Optional output for the hit geom id (-1 on no hit).
+         * @return Distance from origin, or a negative value on no hit.
+         */
+        mjtNum Cast(
+            const mjModel* model,
+            const mjData* data,
+            const mjtNum* origin,
+            const mjtNum* dir,
+            mjtNum max_distance,
+            int* geom_id = nullptr) const;
+
+        SelfFilter Filter() const { return filter_; }
+        const mjModel* ConfiguredModel() const { return model_; }
+        bool IsSelfGeom(int geom_id) const;
+
+    private:
+        static constexpr int kMaxSelfHits = 16;
+
+        const mjModel* model_ {nullptr};
+        SelfFilter filter_ {SelfFilter::None};
+        int body_exclude_ {-1};
+        std::array<mjtByte, mjNGROUP> geomgroup_ {};
+        std::vector<std::uint8_t> self_geom_ {};
+        mjtNum retry_epsilon_ {1.0e-4};
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <mujoco/mujoco.h>
+
+#include "sensor.hpp"
+#include "sensors/common/ray_batch.hpp"
+#include "runtime/worker_pool.hpp"
+
+namespace hako::robots::sensor::common
+{
+    /**
+     * @brief Schedules many sensors on one timeline and evaluates the due ones.
+     *
+     * Instead of polling every sensor's UpdateScheduler on every physics step,
+     * the group keeps the next due time of each registered entry in a min-heap
+     * and Step() only touches entries whose time has come. The timing matches
+     * UpdateScheduler started with StartReady(): an entry is due on the first
+     * step, then every period, at most once per step, with late steps carried
+     * over instead of dropped.
+     *
+     * Entries that are ray sensors (IRayBatchSensor) are measured together:
+     * every due ray sensor prepares its rays, all rays are cast in one pass
+     * over the same mjData (split across the group's WorkerPool), and only
+     * then are the on_due callbacks run, in registration order. The callback
+     * of a ray sensor is expected to call its FinishRayBatch(frame).
+     *
+     * The group does not call ShouldUpdate() on the registered sensors; it
+     * replaces their own schedulers. Not thread-safe.
+     */
+    class SensorGroup
+    {
+    public:
+        using Callback = std::function<void()>;
+
+        /**
+         * @param ray_threads Threads for the shared ray pass, including the caller.
+         * @param min_rays_per_thread Smallest ray chunk handed to one thread.
+         */
+        explicit SensorGroup(int ray_threads = 1, std::size_t min_rays_per_thread = 64);
+
+        SensorGroup(const SensorGroup&) = delete;
+        SensorGroup& operator=(const SensorGroup&) = delete;
+
+        /**
+         * @brief Change the thread count of the shared ray pass.
+         */
+        void SetRayThreads(int ray_threads, std::size_t min_rays_per_thread);
+
+        /**
+         * @brief Register an entry with an explicit period.
+         *
+         * @param period_sec Update period. Values <= 0 make the entry due on every step.
+         * @param on_due Called on each step the entry is due.
+         * @param rays Optional ray sensor measured in the shared ray pass before on_due.
+         * @return Entry index.
+         */
+        int Add(double period_sec, Callback on_due, IRayBatchSensor* rays = nullptr);
+
+        /**
+         * @brief Register a sensor using its GetUpdatePeriodSec().
+         */
+        int Add(const ISensor& sensor, Callback on_due, IRayBatchSensor* rays = nullptr)
+        {
+            return Add(sensor.GetUpdatePeriodSec(), std::move(on_due), rays);
+        }
+
+        /**
+         * @brief Register a state publisher using its GetUpdatePeriodSec().
+         */
+        int Add(const IStatePublisher& publisher, Callback on_due)
+        {
+            return Add(publisher.GetUpdatePeriodSec(), std::move(on_due));
+        }
+
+        /**
+         * @brief Remove every entry and restart the timeline.
+         */
+        void Clear();
+
+        /**
+         * @brief Restart the timeline; every entry is due on the next step.
+         */
+        void Reset();
+
+        /**
+         * @brief Advance the timeline and evaluate the entries that are due.
+         *
+         * @return Number of entries evaluated on this step.
+         */
+        std::size_t Step(double delta_sec);
+
+        /**
+         * @brief Whether entry index was evaluated by the last Step().
+         */
+        bool WasDue(int index) const;
+
+        /**
+         * @brief Time of the earliest pending entry, relative to the timeline start.
+         */
+        double NextDueSec() const;
+
+        double NowSec() const { return now_sec_; }
+        std::size_t Size() const { return entries_.size(); }
+
+    private:
+        struct Entry
+        {
+            double period_sec {0.0};
+            double next_due_sec {0.0};
+            Callback on_due {};
+            IRayBatchSensor* rays {nullptr};
+            bool due {false};
+        };
+
+        // (next_due_sec, entry index), ordered as a min-heap.
+        using HeapItem = std::pair<double, int>;
+
+        void PushHeap(int index);
+        void CastDueRays();
+
+        std::vector<Entry> entries_ {};
+        std::vector<HeapItem> heap_ {};
+        double now_sec_ {0.0};
+        std::size_t min_rays_per_thread_ {64};
+        std::unique_ptr<runtime::WorkerPool> ray_pool_ {};
+        // Per-step scratch buffers, reused across steps.
+        std::vector<int> due_ {};
+        std::vector<IRayBatchSensor*> ray_sources_ {};
+        std::vector<std::size_t> ray_offsets_ {};
+    };
+}
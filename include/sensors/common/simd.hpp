@@ -0,0 +1,34 @@
+#pragma once
+
+// Instruction set selection for the sensor pixel kernels.
+//
+// The library is built without -mavx2 so that one binary runs everywhere.
+// On x86 with GCC/Clang the AVX2 kernels are compiled per function with
+// HAKO_SIMD_TARGET_AVX2 and chosen at run time with SimdAvx2Enabled(); MSVC
+// only gets them when the whole build targets AVX2 (/arch:AVX2). NEON is
+// part of every AArch64 CPU and needs no dispatch.
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define HAKO_SIMD_AVX2 1
+#define HAKO_SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#include <immintrin.h>
+#define HAKO_SIMD_AVX2 1
+#define HAKO_SIMD_TARGET_AVX2
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define HAKO_SIMD_NEON 1
+#endif
+
+namespace hako::robots::sensor::common
+{
+    // False when the CPU lacks AVX2/FMA or HAKO_SENSOR_SIMD=scalar is set.
+    bool SimdAvx2Enabled();
+    // False when HAKO_SENSOR_SIMD=scalar is set or NEON is not compiled in.
+    bool SimdNeonEnabled();
+    // "avx2", "neon" or "scalar": the kernels the dispatching functions use.
+    const char* SimdIsaName();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include <mujoco/mujoco.h>
+
+#include "sensors/common/kinematic_snapshot.hpp"
+#include "sensors/common/spsc_ring.hpp"
+
+namespace hako::robots::sensor::common
+{
+    /**
+     * @brief Evaluates sensors on a kinematic snapshot in a dedicated thread.
+     *
+     * The physics thread calls Publish() after each step. It copies the
+     * kinematic state into one of two snapshot slots (a double buffer handed
+     * over through a lock-free SpscRing) and returns immediately. The worker
+     * thread applies the oldest snapshot to its own view mjData, frees the
+     * slot, and then runs the evaluate callback, which reads sensors bound to
+     * the view data while physics keeps stepping on the live data.
+     *
+     * If the worker is still busy with both slots, Publish() drops the
+     * snapshot and counts it; the next evaluate call receives the full time
+     * elapsed since the last evaluated snapshot as its delta, so period based
+     * schedulers (SensorGroup) carry the missed time over.
+     *
+     * Publish() must be called from one thread only.
+     */
+    class SnapshotSensorWorker
+    {
+    public:
+        /**
+         * @brief Called on the worker thread after a snapshot was applied.
+         *
+         * @param delta_sec Simulation time since the previously evaluated snapshot.
+         * @param stamp_sec Stamp passed to Publish() with this snapshot.
+         */
+        using Evaluate = std::function<void(double delta_sec, double stamp_sec)>;
+
+        struct Stats
+        {
+            std::uint64_t published {0};
+            std::uint64_t dropped {0};
+            std::uint64_t evaluated {0};
+        };
+
+        SnapshotSensorWorker() = default;
+        ~SnapshotSensorWorker();
+
+        SnapshotSensorWorker(const SnapshotSensorWorker&) = delete;
+        SnapshotSensorWorker& operator=(const SnapshotSensorWorker&) = delete;
+
+        /**
+         * @brief Start the worker thread.
+         *
+         * @param model Model shared by the live and the view data.
+         * @param view_data mjData the sensors read; written by the worker only.
+         * @param evaluate Sensor evaluation run for each snapshot.
+         * @return false if already running or an argument is missing.
+         */
+        bool Start(const mjModel* model, mjData* view_data, Evaluate evaluate);
+
+        /**
+         * @brief Stop and join the worker. Pending snapshots are discarded.
+         */
+        void Stop();
+
+        bool Running() const { return thread_.joinable(); }
+
+        /**
+         * @brief Copy the live kinematic state for the worker.
+         *
+         * @return false if the snapshot was dropped because both slots are busy.
+         */
+        bool Publish(const mjData* live_data, double stamp_sec);
+
+        Stats GetStats() const;
+
+    private:
+        void Run();
+
+        const mjModel* model_ {nullptr};
+        mjData* view_data_ {nullptr};
+        Evaluate evaluate_ {};
+        SpscRing<KinematicSnapshot, 2> snapshots_ {};
+        // Bumped on every Publish()/Stop(); the worker waits on it.
+        std::atomic<std::uint64_t> signal_ {0};
+        std::atomic<bool> stopping_ {false};
+        std::atomic<std::uint64_t> published_ {0};
+        std::atomic<std::uint64_t> dropped_ {0};
+        std::atomic<std::uint64_t> evaluated_ {0};
+        std::thread thread_ {};
+    };
+}
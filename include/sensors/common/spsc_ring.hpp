@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace hako::robots::sensor::common
+{
+    /**
+     * @brief Lock-free single-producer / single-consumer ring of fixed slots.
+     *
+     * Slots are written and read in place so that their buffers (vectors in a
+     * frame, arrays in a snapshot) are reused instead of reallocated:
+     *
+     *     if (T* slot = ring.WriteSlot()) { fill(*slot); ring.CommitWrite(); }
+     *     if (T* slot = ring.ReadSlot())  { use(*slot);  ring.CommitRead();  }
+     *
+     * Exactly one thread may write and one thread may read. All Capacity
+     * slots are usable; WriteSlot() returns nullptr while the ring is full.
+     */
+    template <typename T, std::size_t Capacity>
+    class SpscRing
+    {
+        static_assert(Capacity > 0, "SpscRing needs at least one slot");
+
+    public:
+        /**
+         * @brief Free slot to fill, or nullptr if the reader lags behind.
+         */
+        T* WriteSlot()
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (head - tail_.load(std::memory_order_acquire) == Capacity) {
+                return nullptr;
+            }
+            return &slots_[head % Capacity];
+        }
+
+        /**
+         * @brief Hand the slot returned by WriteSlot() to the reader.
+         */
+        void CommitWrite()
+        {
+            head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Oldest committed slot, or nullptr if the ring is empty.
+         */
+        T* ReadSlot()
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (head_.load(std::memory_order_acquire) == tail) {
+                return nullptr;
+            }
+            return &slots_[tail % Capacity];
+        }
+
+        /**
+         * @brief Give the slot returned by ReadSlot() back to the writer.
+         */
+        void CommitRead()
+        {
+            tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        std::size_t Size() const
+        {
+            return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+        }
+
+        static constexpr std::size_t GetCapacity() { return Capacity; }
+
+    private:
+        std::array<T, Capacity> slots_ {};
+        // Written by the producer only; on its own cache line.
+        alignas(64) std::atomic<std::size_t> head_ {0};
+        // Written by the consumer only.
+        alignas(64) std::atomic<std::size_t> tail_ {0};
+    };
+}
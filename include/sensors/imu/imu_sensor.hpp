@@ -61,6 +61,7 @@ namespace hako::robots::sensor
 
         std::shared_ptr<hako::robots::physics::IWorld> world_;
         std::shared_ptr<hako::robots::physics::IRigidBody> source_body_;
+        hako::robots::physics::BodyHandle source_body_handle_ {};
         ImuConfig config_ {};
         common::UpdateScheduler scheduler_ {};
         hako::robots::types::BodyVelocity prev_body_velocity_ {};
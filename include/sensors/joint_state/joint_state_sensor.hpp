@@ -54,7 +54,7 @@ namespace hako::robots::sensor
 
         std::shared_ptr<hako::robots::physics::IWorld> world_;
         JointStateConfig config_ {};
-        std::vector<int> joint_ids_ {};
+        std::vector<hako::robots::physics::JointHandle> joints_ {};
         common::UpdateScheduler scheduler_ {};
     };
 }
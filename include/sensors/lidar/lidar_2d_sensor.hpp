@@ -6,44 +6,16 @@
 
 #include "physics.hpp"
 #include "sensor.hpp"
+#include "sensors/common/ray_batch.hpp"
+#include "sensors/common/ray_caster.hpp"
 #include "sensors/common/update_scheduler.hpp"
+#include "runtime/worker_pool.hpp"
+#include "sensors/lidar/lidar_beam_table.hpp"
+#include "sensors/lidar/lidar_config.hpp"
 #include "sensors/noise/noise.hpp"
 
 namespace hako::robots::sensor::lidar
 {
-    struct DetectionDistance
-    {
-        double min {0.0};
-        double max {0.0};
-    };
-
-    struct BlindPaddingRange
-    {
-        int size {0};
-        double value {0.0};
-        bool enabled {false};
-    };
-
-    struct AngleRange
-    {
-        double min_deg {0.0};
-        double max_deg {0.0};
-        bool ascending_order_of_data {true};
-        double resolution_deg {1.0};
-        int scan_frequency_hz {10};
-        BlindPaddingRange blind_padding {};
-    };
-
-    struct DistanceAccuracy
-    {
-        DetectionDistance range {};
-        bool distance_dependent {false};
-        double percentage {0.0};
-        double stddev {0.0};
-        std::string noise_distribution {"Gaussian"};
-        double precision {0.0};
-    };
-
     struct LiDAR2DConfig
     {
         OutputBinding output {};
@@ -51,6 +23,7 @@ namespace hako::robots::sensor::lidar
         DetectionDistance detection_distance {};
         AngleRange angle_range {};
         std::vector<DistanceAccuracy> distance_accuracy {};
+        ScanEngineConfig scan_engine {};
         double yaw_bias_deg {0.0};
         double origin_offset_m {0.0};
     };
@@ -80,9 +53,20 @@ namespace hako::robots::sensor::lidar
 
         // Capture one full scan frame according to the current config.
         virtual void Scan(LaserScanFrame& out) = 0;
+
+        // Advance the sensor by one physics step. Returns true when a complete
+        // frame was written to out. The default is ShouldUpdate() + Scan().
+        virtual bool Update(double delta_sec, LaserScanFrame& out)
+        {
+            if (!ShouldUpdate(delta_sec)) {
+                return false;
+            }
+            Scan(out);
+            return true;
+        }
     };
 
-    class LiDAR2DSensor : public ILidar2DSensor
+    class LiDAR2DSensor : public ILidar2DSensor, public common::IRayBatchSensor
     {
     public:
         LiDAR2DSensor(
@@ -97,17 +81,30 @@ namespace hako::robots::sensor::lidar
         double GetUpdatePeriodSec() const override;
         bool ShouldUpdate(double delta_sec) override;
         void Scan(LaserScanFrame& out) override;
+        bool Update(double delta_sec, LaserScanFrame& out) override;
+
+        // Ray batch phases (see common::IRayBatchSensor). Scan() is
+        // PrepareRayBatch() + CastRayBatch() on the sensor's own pool +
+        // FinishRayBatch(). The batch always covers the full sweep.
+        std::size_t PrepareRayBatch() override;
+        void CastRayBatch(std::size_t begin, std::size_t end) override;
+        void FinishRayBatch(LaserScanFrame& out);
 
     private:
         float CastRay(
             const mjModel* model,
-            mjData* data,
+            const mjData* data,
             const mjtNum* sensor_pos,
-            int body_exclude,
-            double base_yaw_rad,
-            double degree_yaw) const;
+            mjtNum dir_x,
+            mjtNum dir_y) const;
+        bool BeginBatch();
+        void CastBeams(std::size_t begin, std::size_t end);
+        bool AdvanceSweep(double delta_sec, LaserScanFrame& out);
         void ApplyBlindPadding(std::vector<float>& ranges) const;
         void RebuildNoisePipeline();
+        void RebuildWorkerPool();
+        void RebuildBeamTable();
+        bool ResolveBodyIds(const mjModel* model);
 
         std::shared_ptr<hako::robots::physics::IWorld> world_;
         std::shared_ptr<hako::robots::physics::IRigidBody> sensor_body_;
@@ -116,5 +113,24 @@ namespace hako::robots::sensor::lidar
         LiDAR2DConfig config_ {};
         common::UpdateScheduler scheduler_ {};
         noise::RangeNoisePipeline noise_pipeline_;
+        std::unique_ptr<runtime::WorkerPool> worker_pool_ {};
+        LiDARBeamTable beam_table_ {};
+        common::RayCaster ray_caster_ {};
+        // Body ids resolved for resolved_model_; refreshed if the world reloads.
+        const mjModel* resolved_model_ {nullptr};
+        int sensor_body_id_ {-1};
+        int exclude_body_id_ {-1};
+        // Per-scan scratch buffers, reused across scans.
+        std::vector<mjtNum> beam_dir_x_ {};
+        std::vector<mjtNum> beam_dir_y_ {};
+        std::vector<float> raw_ranges_ {};
+        // Model, data and origin the current batch is cast against.
+        const mjModel* batch_model_ {nullptr};
+        const mjData* batch_data_ {nullptr};
+        mjtNum batch_origin_[3] {0.0, 0.0, 0.0};
+        // Incremental sweep state: time into the current sweep and the number
+        // of beams already cast for it.
+        double sweep_elapsed_sec_ {0.0};
+        std::size_t sweep_cast_count_ {0};
     };
 }
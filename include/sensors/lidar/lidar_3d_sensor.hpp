@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "physics.hpp"
+#include "sensor.hpp"
+#include "sensors/common/ray_batch.hpp"
+#include "sensors/common/ray_caster.hpp"
+#include "sensors/common/update_scheduler.hpp"
+#include "runtime/worker_pool.hpp"
+#include "sensors/lidar/lidar_config.hpp"
+#include "sensors/noise/noise.hpp"
+
+namespace hako::robots::sensor::lidar
+{
+    // One laser of a spinning multi-channel LiDAR.
+    //
+    // vertical_angle_deg is the elevation of the laser (positive up).
+    // azimuth_offset_deg is a fixed horizontal correction for that laser.
+    // firing_time_offset_us is the time from the start of a firing block until
+    // the laser fires; the head keeps spinning meanwhile, so it also shifts the
+    // beam azimuth by 360 * ScanFrequency * offset degrees.
+    struct LiDARChannel
+    {
+        double vertical_angle_deg {0.0};
+        double azimuth_offset_deg {0.0};
+        double firing_time_offset_us {0.0};
+    };
+
+    struct LiDAR3DConfig
+    {
+        OutputBinding output {};
+        std::string frame_id {"lidar"};
+        DetectionDistance detection_distance {};
+        // Horizontal sweep. Resolution is the azimuth step of one firing block.
+        AngleRange angle_range {};
+        std::vector<LiDARChannel> channels {};
+        std::vector<DistanceAccuracy> distance_accuracy {};
+        ScanEngineConfig scan_engine {};
+    };
+
+    // sensor_msgs/PointField equivalent.
+    struct PointField
+    {
+        static constexpr std::uint8_t kUint16 = 4;
+        static constexpr std::uint8_t kFloat32 = 7;
+
+        std::string name {};
+        std::uint32_t offset {0};
+        std::uint8_t datatype {kFloat32};
+        std::uint32_t count {1};
+    };
+
+    // sensor_msgs/PointCloud2 equivalent.
+    //
+    // LiDAR3DSensor produces an organized cloud: height is the channel count,
+    // width is the number of firing blocks per sweep, and every point has the
+    // layout described by fields (x, y, z, intensity, time, ring). Beams
+    // without a valid return keep their slot with NaN coordinates, so
+    // is_dense is false. Coordinates are in the sensor frame (frame_id).
+    struct PointCloudFrame
+    {
+        std::string frame_id {"lidar"};
+        double timestamp {0.0};
+        std::uint32_t height {0};
+        std::uint32_t width {0};
+        std::vector<PointField> fields {};
+        bool is_bigendian {false};
+        std::uint32_t point_step {0};
+        std::uint32_t row_step {0};
+        std::vector<std::uint8_t> data {};
+        bool is_dense {false};
+    };
+
+    class ILidar3DSensor : public ISensor
+    {
+    public:
+        virtual ~ILidar3DSensor() = default;
+
+        virtual bool LoadConfig(const std::string& config_path) = 0;
+        virtual const LiDAR3DConfig& GetConfig() const = 0;
+
+        // Capture one full sweep according to the current config.
+        virtual void Scan(PointCloudFrame& out) = 0;
+    };
+
+    class LiDAR3DSensor : public ILidar3DSensor, public common::IRayBatchSensor
+    {
+    public:
+        LiDAR3DSensor(
+            std::shared_ptr<hako::robots::physics::IWorld> world,
+            std::string sensor_body_name = "lidar_link",
+            std::string exclude_body_name = "base_footprint");
+
+        bool LoadConfig(const std::string& config_path) override;
+        const LiDAR3DConfig& GetConfig() const override;
+        void Reset() override;
+        double GetUpdatePeriodSec() const override;
+        bool ShouldUpdate(double delta_sec) override;
+        void Scan(PointCloudFrame& out) override;
+
+        // Ray batch phases (see common::IRayBatchSensor). Scan() is
+        // PrepareRayBatch() + CastRayBatch() on the sensor's own pool +
+        // FinishRayBatch().
+        std::size_t PrepareRayBatch() override;
+        void CastRayBatch(std::size_t begin, std::size_t end) override;
+        void FinishRayBatch(PointCloudFrame& out);
+
+        int ColumnCount() const { return column_count_; }
+        int ChannelCount() const { return static_cast<int>(config_.channels.size()); }
+
+    private:
+        void RebuildBeamTable();
+        void RebuildWorkerPool();
+        bool ResolveBodyIds(const mjModel* model);
+        void RotateBeams(const mjtNum* sensor_mat);
+        void CastBeams();
+        void PackPoints(PointCloudFrame& out) const;
+
+        std::shared_ptr<hako::robots::physics::IWorld> world_;
+        std::string sensor_body_name_;
+        std::string exclude_body_name_;
+        LiDAR3DConfig config_ {};
+        common::UpdateScheduler scheduler_ {};
+        noise::RangeNoisePipeline noise_pipeline_;
+        std::unique_ptr<runtime::WorkerPool> worker_pool_ {};
+        common::RayCaster ray_caster_ {};
+        const mjModel* resolved_model_ {nullptr};
+        int sensor_body_id_ {-1};
+        int exclude_body_id_ {-1};
+
+        // Beam tables, channel-major (index = channel * column_count_ + column).
+        int column_count_ {0};
+        std::vector<mjtNum> local_x_ {};
+        std::vector<mjtNum> local_y_ {};
+        std::vector<mjtNum> local_z_ {};
+        std::vector<float> beam_time_ {};
+        // Per-scan scratch buffers, reused across scans.
+        std::vector<mjtNum> world_x_ {};
+        std::vector<mjtNum> world_y_ {};
+        std::vector<mjtNum> world_z_ {};
+        std::vector<float> ranges_ {};
+        // Model, data and origin the current batch is cast against.
+        const mjModel* batch_model_ {nullptr};
+        const mjData* batch_data_ {nullptr};
+        mjtNum batch_origin_[3] {0.0, 0.0, 0.0};
+    };
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace hako::robots::sensor::lidar
+{
+    /**
+     * @brief Precomputed horizontal beam directions of one LiDAR sweep.
+     *
+     * The table stores the unit direction of every beam in the sensor frame as
+     * two flat arrays (structure of arrays). It is built once per config, and
+     * each scan only rotates it by the current body yaw with Rotate(), which is
+     * a plain multiply-add loop the compiler can vectorize.
+     */
+    class LiDARBeamTable
+    {
+    public:
+        /**
+         * @brief Number of beams for an angle range, at least 1.
+         */
+        static int RayCount(double min_deg, double max_deg, double resolution_deg);
+
+        /**
+         * @brief Rebuild the table.
+         *
+         * Beams start at min_deg (ascending) or max_deg (descending) and step by
+         * resolution_deg. yaw_bias_deg is added to every beam.
+         */
+        void Build(
+            double min_deg,
+            double max_deg,
+            double resolution_deg,
+            bool ascending_order_of_data,
+            double yaw_bias_deg);
+
+        std::size_t Size() const { return local_cos_.size(); }
+        bool Empty() const { return local_cos_.empty(); }
+
+        /**
+         * @brief Rotate every beam by yaw_rad about +Z.
+         *
+         * @param out_x Receives Size() world-frame x components.
+         * @param out_y Receives Size() world-frame y components.
+         */
+        void Rotate(double yaw_rad, double* out_x, double* out_y) const;
+
+        /**
+         * @brief Rotate beams [begin, end) only; out_x/out_y are indexed by beam.
+         */
+        void Rotate(double yaw_rad, std::size_t begin, std::size_t end, double* out_x, double* out_y) const;
+
+    private:
+        std::vector<double> local_cos_ {};
+        std::vector<double> local_sin_ {};
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "sensors/common/json_utils.hpp"
+#include "sensors/noise/noise.hpp"
+
+namespace hako::robots::sensor::lidar
+{
+    struct DetectionDistance
+    {
+        double min {0.0};
+        double max {0.0};
+    };
+
+    struct BlindPaddingRange
+    {
+        int size {0};
+        double value {0.0};
+        bool enabled {false};
+    };
+
+    struct AngleRange
+    {
+        double min_deg {0.0};
+        double max_deg {0.0};
+        bool ascending_order_of_data {true};
+        double resolution_deg {1.0};
+        int scan_frequency_hz {10};
+        BlindPaddingRange blind_padding {};
+    };
+
+    struct DistanceAccuracy
+    {
+        DetectionDistance range {};
+        bool distance_dependent {false};
+        double percentage {0.0};
+        double stddev {0.0};
+        std::string noise_distribution {"Gaussian"};
+        double precision {0.0};
+    };
+
+    // Ray casting engine settings. threads == 1 keeps the whole scan on the
+    // calling thread; larger values split the beams into chunks on a worker
+    // pool. The result is identical for every thread count.
+    //
+    // incremental == true ("Mode": "incremental") spreads one sweep over the
+    // physics steps of a scan period: every step casts only the beams the
+    // rotating head reaches in that step, from the pose of that step.
+    struct ScanEngineConfig
+    {
+        int threads {1};
+        int min_beams_per_thread {64};
+        bool incremental {false};
+    };
+
+    // Profile blocks shared by the 2D and 3D LiDAR JSON specs. Distances in
+    // DetectionDistance / DistanceAccuracy are millimeters in JSON and meters
+    // after reading.
+    void ReadDetectionDistance(const common::json& spec_root, DetectionDistance& out);
+    void ReadAngleRange(const common::json& spec_root, AngleRange& out);
+    std::vector<DistanceAccuracy> ReadDistanceAccuracy(const common::json& spec_root);
+    void ReadScanEngine(const common::json& spec_root, ScanEngineConfig& out);
+
+    void BuildRangeNoisePipeline(
+        const std::vector<DistanceAccuracy>& distance_accuracy,
+        noise::RangeNoisePipeline& pipeline);
+}
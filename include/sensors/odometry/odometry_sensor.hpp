@@ -50,6 +50,7 @@ namespace hako::robots::sensor
     private:
         std::shared_ptr<hako::robots::physics::IWorld> world_;
         std::shared_ptr<hako::robots::physics::IRigidBody> source_body_;
+        hako::robots::physics::BodyHandle source_body_handle_ {};
         OdometryConfig config_ {};
         common::UpdateScheduler scheduler_ {};
     };
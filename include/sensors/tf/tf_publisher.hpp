@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "physics.hpp"
 #include "sensor.hpp"
@@ -54,7 +55,22 @@ namespace hako::robots::sensor
         std::shared_ptr<hako::robots::physics::IWorld> world_;
         TfConfig config_ {};
         common::UpdateScheduler scheduler_ {};
-        std::unordered_map<std::string, std::shared_ptr<hako::robots::physics::IRigidBody>> body_cache_ {};
+        struct BoundBody
+        {
+            std::shared_ptr<hako::robots::physics::IRigidBody> body {};
+            hako::robots::physics::BodyHandle handle {};
+        };
+        // config_.transforms resolved once in LoadConfig, so Build() does no
+        // name lookups. A null child skips the transform; a null parent
+        // publishes the child's world pose.
+        struct BoundTransform
+        {
+            const BoundBody* child {nullptr};
+            const BoundBody* parent {nullptr};
+        };
+
+        std::unordered_map<std::string, BoundBody> body_cache_ {};
         std::unordered_map<std::string, std::string> child_to_body_ {};
+        std::vector<BoundTransform> bound_transforms_ {};
     };
 }
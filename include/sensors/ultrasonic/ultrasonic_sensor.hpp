@@ -3,11 +3,13 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <array>
 
 #include "physics.hpp"
 #include "sensor.hpp"
+#include "sensors/common/ray_batch.hpp"
+#include "sensors/common/ray_caster.hpp"
 #include "sensors/common/update_scheduler.hpp"
+#include "runtime/worker_pool.hpp"
 #include "sensors/noise/noise.hpp"
 
 namespace hako::robots::sensor::ultrasonic
@@ -120,6 +122,26 @@ namespace hako::robots::sensor::ultrasonic
         int ray_count {1};
     };
 
+    /**
+     * @brief Ray casting options for the cone.
+     *
+     * Semantics:
+     * - threads:
+     *     Number of threads that cast the cone rays, including the caller.
+     *     1 casts every ray on the calling thread.
+     *
+     * - min_rays_per_thread:
+     *     Smallest number of rays handed to one thread. Cones with fewer rays
+     *     than this are cast inline.
+     *
+     * The measurement is identical for any thread count.
+     */
+    struct RayEngine
+    {
+        int threads {1};
+        int min_rays_per_thread {16};
+    };
+
     /**
      * @brief MJCF binding information for resolving the sensor in the simulation world.
      *
@@ -220,6 +242,7 @@ namespace hako::robots::sensor::ultrasonic
         DistanceRange detection_distance {};
         std::vector<DistanceAccuracy> distance_accuracy {};
         Cone cone {};
+        RayEngine ray_engine {};
         double update_rate_hz {10.0};
         MjcfBinding mjcf_binding {};
         UltrasonicPduConfig pdu_config {};
@@ -384,7 +407,7 @@ namespace hako::robots::sensor::ultrasonic
      * - noise pipeline,
      * - runtime body references.
      */
-    class UltrasonicSensor : public IUltrasonicSensor
+    class UltrasonicSensor : public IUltrasonicSensor, public common::IRayBatchSensor
     {
     public:
         /**
@@ -462,8 +485,9 @@ namespace hako::robots::sensor::ultrasonic
          *
          * Expected runtime algorithm:
          * 1. Read current sensor origin and orientation from the resolved runtime frame.
-         * 2. Transform precomputed local ray directions into world coordinates.
-         * 3. Cast rays into the physics world.
+         * 2. Transform precomputed local ray directions into world coordinates
+         *    in one pass over the whole cone.
+         * 3. Cast rays into the physics world, split across config_.ray_engine.threads.
          * 4. Select the nearest valid projected hit.
          * 5. Apply detection distance limits.
          * 6. Apply configured noise and precision.
@@ -473,7 +497,45 @@ namespace hako::robots::sensor::ultrasonic
          */
         void Measure(UltrasonicFrame& out) override;
 
+        /**
+         * @brief Snapshot the sensor frame and rotate the cone into world space.
+         *
+         * First phase of common::IRayBatchSensor. Measure() runs all three
+         * phases on the sensor's own pool; a SensorGroup runs them with a
+         * shared ray pass.
+         *
+         * @return Number of cone rays, or 0 if the sensor cannot measure.
+         */
+        std::size_t PrepareRayBatch() override;
+
+        /**
+         * @brief Cast cone rays [begin, end) of the prepared batch.
+         */
+        void CastRayBatch(std::size_t begin, std::size_t end) override;
+
+        /**
+         * @brief Reduce the cast rays to one frame (steps 4-7 of Measure()).
+         *
+         * Produces an INVALID frame if the last PrepareRayBatch() returned 0.
+         */
+        void FinishRayBatch(UltrasonicFrame& out);
+
     private:
+        /**
+         * @brief Create, resize or drop worker_pool_ to match config_.ray_engine.
+         */
+        void RebuildWorkerPool();
+
+        /**
+         * @brief Rotate every local cone direction by sensor_mat into ray_dirs_world_.
+         */
+        void RotateRays(const mjtNum* sensor_mat);
+
+        /**
+         * @brief Cast every ray of the prepared batch, split across worker_pool_.
+         */
+        void CastRays();
+
         /**
          * @brief Physics world used by this sensor.
          */
@@ -538,12 +600,47 @@ namespace hako::robots::sensor::ultrasonic
           * detect its own body.
          */
         int body_exclude_id_ {-1};
+        /**
+         * @brief Ray front end that hides the body_exclude_id_ subtree.
+         */
+        common::RayCaster ray_caster_ {};
+        /**
+         * @brief Optional pool for casting the cone rays in parallel.
+         *
+         * Null when config_.ray_engine.threads is 1.
+         */
+        std::unique_ptr<runtime::WorkerPool> worker_pool_ {};
         /**
          * @brief Precomputed local ray directions for cone approximation.
          *
-         * Each ray direction is a unit vector in the sensor's local frame.
-         * The number of rays is determined by config_.cone.ray_count.
+         * Each ray direction is a unit vector in the sensor's local frame,
+         * stored as separate x/y/z arrays so that the per-measurement rotation
+         * is a flat loop. The number of rays is determined by
+         * config_.cone.ray_count.
+         *
+         * Because the directions are unit vectors and the sensor frame is a
+         * rotation, ray_local_x_[i] is also the cosine between ray i and the
+         * measurement axis.
+         */
+        std::vector<mjtNum> ray_local_x_ {};
+        std::vector<mjtNum> ray_local_y_ {};
+        std::vector<mjtNum> ray_local_z_ {};
+        /**
+         * @brief Per-measurement scratch buffers, sized in LoadConfig().
+         *
+         * ray_dirs_world_ holds the world directions as packed xyz triples
+         * (the layout mj_ray expects) and ray_hits_ the hit distance of each
+         * ray (negative on no hit). Measure() does not allocate.
+         */
+        std::vector<mjtNum> ray_dirs_world_ {};
+        std::vector<mjtNum> ray_hits_ {};
+        /**
+         * @brief Model, data and origin the current batch is cast against.
+         *
+         * batch_model_ is null when the last PrepareRayBatch() failed.
          */
-        std::vector<std::array<double, 3>> ray_dirs_local_ {};
+        const mjModel* batch_model_ {nullptr};
+        const mjData* batch_data_ {nullptr};
+        mjtNum batch_origin_[3] {0.0, 0.0, 0.0};
     };
 }
@@ -2,8 +2,10 @@
 
 #include "actuator.hpp"
 #include <mujoco/mujoco.h>
+#include "physics_registry.hpp"
 #include "primitive_types.hpp"
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 namespace hako::robots::actuator::impl
@@ -13,18 +15,18 @@ namespace hako::robots::actuator::impl
     private:
         mjModel* model;
         mjData* data;
-        int actuator_id;
+        int ctrl_adr;
     public:
-        TorqueActuatorImpl(mjModel* m, mjData* d, const std::string& actuator_name): model(m), data(d)
+        TorqueActuatorImpl(mjModel* m, mjData* d, const hako::robots::physics::ActuatorHandle& actuator)
+            : model(m), data(d), ctrl_adr(actuator.ctrl_adr)
         {
-            actuator_id = mj_name2id(model, mjOBJ_ACTUATOR, actuator_name.c_str());
-            if (actuator_id < 0) {
-                throw std::runtime_error("Actuator not found: " + actuator_name);
+            if (!actuator.valid()) {
+                throw std::runtime_error("Invalid actuator handle");
             }
         }
         void SetTorque(double torque) override
         {
-            data->ctrl[actuator_id] = torque;
+            data->ctrl[ctrl_adr] = torque;
         }
     };
 }
@@ -116,13 +116,14 @@ public:
         hako::robots::controller::ForkliftController& controller,
         const HakoniwaMujocoContext::ControlState& control_state)
     {
+        const auto& state = controller.getForklift().getState();
         HakoCpp_Twist forklift_pos_data {};
-        forklift_pos_data.linear.x = controller.getForklift().getPosition().x;
-        forklift_pos_data.linear.y = controller.getForklift().getPosition().y;
-        forklift_pos_data.linear.z = controller.getForklift().getPosition().z;
-        forklift_pos_data.angular.x = controller.getForklift().getEuler().x;
-        forklift_pos_data.angular.y = controller.getForklift().getEuler().y;
-        forklift_pos_data.angular.z = controller.getForklift().getEuler().z;
+        forklift_pos_data.linear.x = state.position.x;
+        forklift_pos_data.linear.y = state.position.y;
+        forklift_pos_data.linear.z = state.position.z;
+        forklift_pos_data.angular.x = state.euler.x;
+        forklift_pos_data.angular.y = state.euler.y;
+        forklift_pos_data.angular.z = state.euler.z;
         (void)forklift_pos_.flush(forklift_pos_data);
 
         HakoCpp_Float64 lift_pos_data {};
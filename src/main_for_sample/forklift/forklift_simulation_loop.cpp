@@ -177,6 +177,34 @@ int ForkliftSimulationLoop::run()
         controller.setVelocityCommand(0.0, 0.0);
         controller.setLiftTarget(0.0);
         controller.set_delta_pos(simulation_timestep * get_motion_gain());
+        // HAKO_FORKLIFT_CONTROL_DIVISOR=N runs the controller inside the
+        // physics step (between mj_step1 and mj_step2) every N steps, on the
+        // state being stepped. Unset or 0 keeps update() before each step.
+        const int control_divisor = std::max(0, get_env_int("HAKO_FORKLIFT_CONTROL_DIVISOR", 0));
+        bool controller_in_step = false;
+        struct ControlCallbackRegistration {
+            hako::robots::physics::IWorld& world;
+            int id;
+            ~ControlCallbackRegistration()
+            {
+                if (id >= 0) {
+                    world.removeControlCallback(id);
+                }
+            }
+        } control_registration {*world_, -1};
+        if (control_divisor > 0) {
+            controller.set_control_period(simulation_timestep * control_divisor);
+            // Standby steps zero ctrl and must not run the controller.
+            control_registration.id = world_->addControlCallback(
+                [&controller, &controller_in_step](const mjModel*, mjData*) {
+                    if (controller_in_step) {
+                        controller.update();
+                    }
+                },
+                control_divisor);
+            std::cout << "[INFO] Forklift controller runs in the physics step every "
+                      << control_divisor << " step(s)" << std::endl;
+        }
         HakoniwaMujocoContext mujoco_ctx(world_, "./tmp/hakoniwa-forklift-unit.state");
         const bool rd_lite_enabled = (get_env_int("HAKO_RD_LITE_ENABLE", 0) != 0);
         const bool local_state_enabled = (get_env_int("HAKO_LOCAL_STATE_ENABLE", rd_lite_enabled ? 0 : 1) != 0);
@@ -340,8 +368,14 @@ int ForkliftSimulationLoop::run()
                     }
                 }
 
-                controller.update();
-                world_->advanceTimeStep();
+                if (control_divisor > 0) {
+                    controller_in_step = true;
+                    world_->advanceTimeStep();
+                    controller_in_step = false;
+                } else {
+                    controller.update();
+                    world_->advanceTimeStep();
+                }
 
                 control_state.target_linear_velocity = controller.getTargetLinearVel();
                 control_state.target_yaw_rate = controller.getTargetYawRate();
@@ -361,8 +395,9 @@ int ForkliftSimulationLoop::run()
                 if (trace_logger.restore_debug_enabled() && restored &&
                     (sim_time_sec_from_resume >= -1e-9) &&
                     (sim_time_sec_from_resume <= trace_logger.restore_debug_window_sec())) {
-                    const auto body_v = controller.getForklift().getBodyVelocity();
-                    const auto body_w = controller.getForklift().getBodyAngularVelocity();
+                    const auto& state = controller.getForklift().getState();
+                    const auto& body_v = state.body_velocity;
+                    const auto& body_w = state.body_angular_velocity;
                     ForkliftRestoreDebugSample s {};
                     s.restored = restored;
                     s.step = step_count;
@@ -388,10 +423,11 @@ int ForkliftSimulationLoop::run()
                     trace_logger.log_restore_debug(s);
                 }
                 if ((step_count % trace_logger.trace_every_steps()) == 0) {
-                    const auto p = controller.getForklift().getPosition();
-                    const auto e = controller.getForklift().getEuler();
-                    const auto v = controller.getForklift().getBodyVelocity();
-                    const auto w = controller.getForklift().getBodyAngularVelocity();
+                    const auto& state = controller.getForklift().getState();
+                    const auto& p = state.position;
+                    const auto& e = state.euler;
+                    const auto& v = state.body_velocity;
+                    const auto& w = state.body_angular_velocity;
                     const auto l = controller.getForklift().getLiftPosition();
                     ForkliftTraceSample s {};
                     s.restored = restored;
@@ -424,8 +460,9 @@ int ForkliftSimulationLoop::run()
                 }
                 if (local_state_enabled && mujoco_ctx.should_autosave(step_count)) {
                     (void)mujoco_ctx.save_forklift_state_with_control(&control_state);
-                    const auto p = controller.getForklift().getPosition();
-                    const auto e = controller.getForklift().getEuler();
+                    const auto& state = controller.getForklift().getState();
+                    const auto& p = state.position;
+                    const auto& e = state.euler;
                     const auto l = controller.getForklift().getLiftPosition();
                     ForkliftRecoveryAutosaveSample s {};
                     s.step = control_state.sim_step;
@@ -150,13 +150,14 @@ public:
     {}
 
     void flush() {
+        const auto& state = obj.getState();
         HakoCpp_Twist pos_data{};
-        pos_data.linear.x = obj.getPosition().x;
-        pos_data.linear.y = obj.getPosition().y;
-        pos_data.linear.z = obj.getPosition().z;
-        pos_data.angular.x = obj.getEuler().x;
-        pos_data.angular.y = obj.getEuler().y;
-        pos_data.angular.z = obj.getEuler().z;
+        pos_data.linear.x = state.position.x;
+        pos_data.linear.y = state.position.y;
+        pos_data.linear.z = state.position.z;
+        pos_data.angular.x = state.euler.x;
+        pos_data.angular.y = state.euler.y;
+        pos_data.angular.z = state.euler.z;
         (void)pos_.flush(pos_data);
     }
 };
@@ -218,12 +219,13 @@ static int my_manual_timing_control(hako_asset_context_t* context)
                 world->advanceTimeStep();
 
                 //flush pos of forklift
-                forklift_pos_data.linear.x = controller.getForklift().getPosition().x;
-                forklift_pos_data.linear.y = controller.getForklift().getPosition().y;
-                forklift_pos_data.linear.z = controller.getForklift().getPosition().z;
-                forklift_pos_data.angular.x = controller.getForklift().getEuler().x;
-                forklift_pos_data.angular.y = controller.getForklift().getEuler().y;
-                forklift_pos_data.angular.z = controller.getForklift().getEuler().z;
+                const auto& forklift_state = controller.getForklift().getState();
+                forklift_pos_data.linear.x = forklift_state.position.x;
+                forklift_pos_data.linear.y = forklift_state.position.y;
+                forklift_pos_data.linear.z = forklift_state.position.z;
+                forklift_pos_data.angular.x = forklift_state.euler.x;
+                forklift_pos_data.angular.y = forklift_state.euler.y;
+                forklift_pos_data.angular.z = forklift_state.euler.z;
                 forklift_pos.flush(forklift_pos_data);
 
                 //flush pos of lift
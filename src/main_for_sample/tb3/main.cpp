@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 #include <thread>
+#include <utility>
 
 #include <mujoco/mujoco.h>
 
@@ -27,9 +28,13 @@
 #include "robots/tb3/tb3_runtime_config_loader.hpp"
 #include "runtime/hakoniwa_asset_lifecycle.hpp"
 
+#include "hakoniwa/pdu/adapter/sensor_msgs/compressed_image.hpp"
 #include "hakoniwa/pdu/adapter/sensor_msgs/image.hpp"
+#include "sensors/camera/camera_capture_service.hpp"
 #include "sensors/camera/camera_config_loader.hpp"
 #include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/image_compression_worker.hpp"
+#include "sensors/camera/image_frame_recorder.hpp"
 #include "sensors/camera/mujoco_camera_renderer.hpp"
 
 #ifndef HAKO_TB3_VIEWER_DISABLED_BY_DEFAULT
@@ -44,8 +49,18 @@ std::string lidar_config_override_path;
 using hako::robots::tb3::Tb3RuntimeConfig;
 
 std::unique_ptr<hako::robots::pdu::adapter::sensor_msgs::ImagePduAdapter> image_adapter;
-std::unique_ptr<hako::robots::sensor::camera::CameraSensor> camera_sensor;
-std::optional<hako::robots::sensor::camera::ImageFrame> latest_camera_frame;
+// Set instead of image_adapter when pdu_config selects sensor_msgs/CompressedImage.
+std::unique_ptr<hako::robots::pdu::adapter::sensor_msgs::CompressedImagePduAdapter> compressed_image_adapter;
+std::unique_ptr<hako::robots::sensor::camera::ImageCompressionWorker> image_compression_worker;
+hako::robots::sensor::camera::CompressedImageFrame compressed_camera_frame;
+// Renders the camera on its own thread and GL context from a state snapshot
+// taken in the physics loop, so data_mutex is not held during readback.
+std::unique_ptr<hako::robots::sensor::camera::CameraCaptureService> camera_capture;
+// Pooled: the frame returns to the capture service's pool once the sender,
+// encoder and recorder are done with it.
+hako::robots::sensor::camera::PooledImageFrame latest_camera_frame;
+// Started when HAKO_TB3_CAMERA_RECORD_DIR is set; records every captured frame.
+std::unique_ptr<hako::robots::sensor::camera::ImageFrameRecorder> camera_recorder;
 std::atomic_bool render_running {true};
 hako::robots::config::AssetManifest asset_manifest;
 Tb3RuntimeConfig runtime;
@@ -92,7 +107,6 @@ std::optional<hakoniwa::pdu::PduKey> make_manifest_pdu_key(
 static bool initialize_camera(
     std::shared_ptr<hako::robots::physics::IWorld> world,
     hakoniwa::pdu::Endpoint& endpoint,
-    MujocoRenderRuntime& render_runtime,
     const std::string& config_path)
 {
     hako::robots::sensor::camera::CameraProfileConfig profile {};
@@ -111,16 +125,50 @@ static bool initialize_camera(
     if (!image_key.has_value()) {
         return false;
     }
-    image_adapter = std::make_unique<hako::robots::pdu::adapter::sensor_msgs::ImagePduAdapter>(
-        endpoint,
-        *image_key);
-
-    auto sensor_renderer = render_runtime.CreateCameraRenderer(world);
-    camera_sensor = std::make_unique<hako::robots::sensor::camera::CameraSensor>(
-        sensor_renderer,
-        camera_name);
-    if (!camera_sensor->LoadConfig(profile.spec)) {
-        std::cerr << "[ERROR] Failed to validate camera config: "
+    const bool compressed = hako::robots::sensor::camera::IsCompressedImagePdu(profile.pdu_config);
+    if (compressed) {
+        compressed_image_adapter =
+            std::make_unique<hako::robots::pdu::adapter::sensor_msgs::CompressedImagePduAdapter>(
+                endpoint,
+                *image_key);
+        image_compression_worker = std::make_unique<hako::robots::sensor::camera::ImageCompressionWorker>();
+        if (!image_compression_worker->Start(profile.pdu_config.compression)) {
+            std::cerr << "[ERROR] Failed to start camera image compression: "
+                      << config_path << std::endl;
+            return false;
+        }
+    } else {
+        image_adapter = std::make_unique<hako::robots::pdu::adapter::sensor_msgs::ImagePduAdapter>(
+            endpoint,
+            *image_key);
+    }
+
+    const char* record_dir = std::getenv("HAKO_TB3_CAMERA_RECORD_DIR");
+    if (record_dir != nullptr && record_dir[0] != '\0') {
+        hako::robots::sensor::camera::ImageFrameRecorderConfig record_config {};
+        record_config.directory = record_dir;
+        camera_recorder = std::make_unique<hako::robots::sensor::camera::ImageFrameRecorder>();
+        if (!camera_recorder->Start(record_config)) {
+            std::cerr << "[ERROR] Failed to start camera recording: " << record_dir << std::endl;
+            return false;
+        }
+        std::cout << "[INFO] TB3 camera recording to " << record_dir << std::endl;
+    }
+
+    hako::robots::sensor::camera::CameraCaptureConfig capture_config {};
+    capture_config.camera_name = camera_name;
+    capture_config.camera = profile.spec;
+    if (camera_recorder != nullptr) {
+        capture_config.on_frame = [camera_name](const hako::robots::sensor::camera::PooledImageFrame& frame) {
+            camera_recorder->Submit(camera_name, frame);
+        };
+    }
+    // The render world owns a model copy: the renderer overrides camera
+    // fovy and clip planes per frame, which must not race with physics.
+    auto render_world = std::make_shared<hako::robots::physics::impl::SnapshotWorldImpl>(world, true);
+    camera_capture = std::make_unique<hako::robots::sensor::camera::CameraCaptureService>();
+    if (!camera_capture->Start(render_world, capture_config)) {
+        std::cerr << "[ERROR] Failed to start camera capture: "
                   << config_path << std::endl;
         return false;
     }
@@ -130,18 +178,9 @@ static bool initialize_camera(
               << " pdu=" << image_key->robot << "/" << image_key->pdu
               << " sensor_rate_hz=" << profile.spec.update_rate_hz
               << " pdu_config_rate_hz=" << profile.pdu_config.update_rate_hz
+              << " compression=" << (compressed ? profile.pdu_config.compression.codec : "none")
+              << " render_backend=" << hako::robots::sensor::camera::RenderBackendName(capture_config.backend)
               << std::endl;
-
-    render_runtime.SetPreRenderCallback([]() {
-        if (camera_sensor == nullptr) {
-            return;
-        }
-        hako::robots::sensor::camera::ImageFrame frame {};
-        camera_sensor->Capture(frame);
-        if (!frame.data.empty()) {
-            latest_camera_frame = std::move(frame);
-        }
-    });
     return true;
 }
 
@@ -149,13 +188,26 @@ static int run_manual_timing_control(hakoniwa::pdu::Endpoint& endpoint)
 {
     const double sim_timestep  = world->getModel()->opt.timestep;
     const hako_time_t delta_time_usec = static_cast<hako_time_t>(sim_timestep * 1e6);
-    hako::robots::tb3::Tb3Robot tb3(world, runtime);
+    // With HAKO_TB3_SENSOR_THREAD=1 the sensors read a snapshot world that a
+    // worker thread refreshes after each step, so physics does not wait for them.
+    std::shared_ptr<hako::robots::physics::IWorld> sensor_world;
+    if (runtime.sensor_thread) {
+        sensor_world = std::make_shared<hako::robots::physics::impl::SnapshotWorldImpl>(world);
+    }
+    hako::robots::tb3::Tb3Robot tb3(world, runtime, sensor_world);
 
     std::string tb3_error;
     if (!tb3.Initialize(&tb3_error)) {
         std::cerr << "ERROR: " << tb3_error << std::endl;
         return -1;
     }
+    if (runtime.sensor_thread) {
+        if (!tb3.StartSensorThread(&tb3_error)) {
+            std::cerr << "ERROR: " << tb3_error << std::endl;
+            return -1;
+        }
+        std::cout << "[INFO] TB3 sensors run on a snapshot worker thread." << std::endl;
+    }
 
     hako::robots::tb3::Tb3HakoniwaAdapter tb3_io(endpoint, asset_manifest, runtime);
     std::string io_error;
@@ -192,14 +244,37 @@ static int run_manual_timing_control(hakoniwa::pdu::Endpoint& endpoint)
         }
     }
 
-    hako::robots::sensor::ImuFrame imu_frame {};
-    hako::robots::sensor::lidar::LaserScanFrame laser_scan_frame {};
-    hako::robots::sensor::JointStateFrame joint_state_frame {};
-    hako::robots::sensor::OdometryFrame odom_frame {};
-    hako::robots::sensor::TfFrame tf_frame {};
-
     int step = 0;
     hako::robots::tb3::Tb3Command command {};
+    hako::robots::tb3::Tb3SensorFrames sensor_frames {};
+    const auto publish_sensor_frames = [&](const hako::robots::tb3::Tb3SensorFrames& frames) {
+        if (frames.imu_updated) {
+            (void)tb3_io.PublishImu(frames.imu);
+        }
+        if (frames.joint_state_updated) {
+            (void)tb3_io.PublishJointState(frames.joint_state);
+        }
+
+        if (frames.odometry_updated) {
+            (void)tb3_io.PublishOdometry(frames.odometry);
+        }
+        if (frames.tf_updated) {
+            (void)tb3_io.PublishTf(frames.tf);
+        }
+
+        // --- LiDAR スキャン（lidar_period_sec 周期） ---
+        // Unity: EventTick() — update_cycle ごとに Scan() → FlushNamedPdu()
+        if (frames.laser_scan_updated) {
+            (void)tb3_io.PublishLaserScan(frames.laser_scan);
+
+            // base_scan_pos も同じタイミングでだけ送る。姿勢はスキャンと
+            // 同じ world 状態（sensor thread 時は snapshot）から取得したもの。
+            (void)tb3_io.PublishBaseScanPose(frames.base_scan_position, frames.base_scan_euler);
+        }
+    };
+    // Frames shown by the debug log: the robot's own frames in synchronous
+    // mode, the last polled frames in sensor-thread mode.
+    const hako::robots::tb3::Tb3SensorFrames* latest_frames = &sensor_frames;
 
     while (running_flag) {
         auto start = std::chrono::steady_clock::now();
@@ -219,42 +294,58 @@ static int run_manual_timing_control(hakoniwa::pdu::Endpoint& endpoint)
             (void)tb3_io.PublishBasePose(tb3.GetBasePosition(), tb3.GetBaseEuler());
 
             const double sim_time_sec = static_cast<double>(hako_asset_simulation_time()) / 1.0e6;
-            if (tb3.MaybeBuildImu(sim_timestep, sim_time_sec, imu_frame)) {
-                (void)tb3_io.PublishImu(imu_frame);
-            }
-            if (tb3.MaybeBuildJointState(sim_timestep, sim_time_sec, joint_state_frame)) {
-                (void)tb3_io.PublishJointState(joint_state_frame);
-            }
-
-            if (tb3.MaybeBuildOdometry(sim_timestep, sim_time_sec, odom_frame)) {
-                (void)tb3_io.PublishOdometry(odom_frame);
-            }
-            if (tb3.MaybeBuildTf(sim_timestep, sim_time_sec, tf_frame)) {
-                (void)tb3_io.PublishTf(tf_frame);
+            if (tb3.SensorThreadRunning()) {
+                // Hand this step's state to the sensor thread and publish
+                // whatever frames it finished since the last step.
+                tb3.PublishSensorSnapshot(sim_time_sec);
+                while (tb3.PollSensorFrames(sensor_frames)) {
+                    publish_sensor_frames(sensor_frames);
+                }
+            } else {
+                latest_frames = &tb3.UpdateSensors(sim_timestep, sim_time_sec);
+                publish_sensor_frames(*latest_frames);
             }
-
-            // --- LiDAR スキャン（lidar_period_sec 周期） ---
-            // Unity: EventTick() — update_cycle ごとに Scan() → FlushNamedPdu()
-            if (tb3.MaybeBuildLaserScan(sim_timestep, laser_scan_frame)) {
-                (void)tb3_io.PublishLaserScan(laser_scan_frame);
-
-                // base_scan_pos も同じタイミングでだけ送る
-                (void)tb3_io.PublishBaseScanPose(tb3.GetBaseScanPosition(), tb3.GetBaseScanEuler());
+            if (lifecycle != nullptr &&
+                lifecycle->IsReady() &&
+                camera_capture != nullptr)
+            {
+                // Only a state copy happens under data_mutex; the capture
+                // thread renders it while physics keeps stepping.
+                if (camera_capture->ShouldUpdate(sim_timestep)) {
+                    (void)camera_capture->Request(world->getData());
+                }
+                if (camera_capture->TryTakeLatest(latest_camera_frame)) {
+                    bool sent = true;
+                    if (image_compression_worker != nullptr) {
+                        // Hand the frame to the encoder threads; a full
+                        // queue drops the frame rather than stalling the step.
+                        (void)image_compression_worker->Submit(latest_camera_frame);
+                    } else if (image_adapter != nullptr) {
+                        // Lending the buffer to the PDU modifies the frame, so
+                        // only while the recorder does not share it.
+                        sent = latest_camera_frame.UseCount() == 1
+                                   ? image_adapter->send_in_place(*latest_camera_frame)
+                                   : image_adapter->send(*latest_camera_frame);
+                    }
+                    if (!sent) {
+                        std::cerr << "[WARN] Failed to send camera image PDU." << std::endl;
+                    }
+                    // Back to the pool now rather than at the next frame.
+                    latest_camera_frame.Reset();
+                }
             }
             if (lifecycle != nullptr &&
                 lifecycle->IsReady() &&
-                camera_sensor != nullptr &&
-                image_adapter != nullptr &&
-                latest_camera_frame.has_value() &&
-                camera_sensor->ShouldUpdate(sim_timestep) &&
-                !image_adapter->send(*latest_camera_frame))
+                compressed_image_adapter != nullptr &&
+                image_compression_worker->TryTakeLatest(compressed_camera_frame) &&
+                !compressed_image_adapter->send_in_place(compressed_camera_frame))
             {
-                std::cerr << "[WARN] Failed to send camera image PDU." << std::endl;
+                std::cerr << "[WARN] Failed to send compressed camera image PDU." << std::endl;
             }
 
             // --- デバッグログ（500ステップごと） ---
             if ((step % 500) == 0) {
-                tb3.EmitDebugLog(step);
+                tb3.EmitDebugLog(step, *latest_frames);
                 for (std::size_t index = 0; index < mirrored_bodies.size(); ++index) {
                     const auto position = mirrored_bodies[index]->position();
                     const auto euler = mirrored_bodies[index]->euler();
@@ -287,6 +378,7 @@ static int run_manual_timing_control(hakoniwa::pdu::Endpoint& endpoint)
         }
     }
 
+    tb3.StopSensorThread();
     return 0;
 }
 
@@ -365,27 +457,21 @@ int main(int argc, const char* argv[])
 #else
     constexpr bool viewer_enabled = false;
 #endif
-    const bool render_required = viewer_enabled || camera_enabled;
-
-    render_running.store(render_required);
+    // The camera renders through its own capture service, so the render
+    // runtime is only needed for the viewer window.
+    render_running.store(viewer_enabled);
     std::unique_ptr<MujocoRenderRuntime> render_runtime;
-    if (render_required) {
+    if (viewer_enabled) {
         render_runtime = std::make_unique<MujocoRenderRuntime>(
             world->getModel(),
             world->getData(),
             render_running,
             data_mutex,
-#if USE_VIEWER
-            MujocoRenderWindowMode::Visible
-#else
-            MujocoRenderWindowMode::Hidden
-#endif
-        );
+            MujocoRenderWindowMode::Visible);
     }
 
     if (camera_enabled) {
-        if (render_runtime == nullptr ||
-            !initialize_camera(world, asset_lifecycle.Endpoint(), *render_runtime, runtime.camera_config))
+        if (!initialize_camera(world, asset_lifecycle.Endpoint(), runtime.camera_config))
         {
             std::cerr << "[ERROR] Failed to initialize camera." << std::endl;
             running_flag = false;
@@ -394,6 +480,10 @@ int main(int argc, const char* argv[])
             asset_lifecycle.StopAndClose();
             return 1;
         }
+        // Creating the capture context replaced the viewer's current one.
+        if (render_runtime != nullptr) {
+            render_runtime->MakeContextCurrent();
+        }
     } else {
         std::cout << "[INFO] TB3 camera disabled: no color_camera component in manifest." << std::endl;
     }
@@ -417,8 +507,49 @@ int main(int argc, const char* argv[])
     running_flag = false;
     render_running.store(false);
     sim_thread.join();
-    camera_sensor.reset();
+    if (camera_capture != nullptr) {
+        // Stopped first: its capture thread feeds camera_recorder.
+        camera_capture->Stop();
+        const auto stats = camera_capture->GetStats();
+        const auto pool = camera_capture->GetFramePoolStats();
+        std::cout << "[INFO] TB3 camera capture:"
+                  << " requested=" << stats.requested
+                  << " captured=" << stats.captured
+                  << " dropped=" << stats.dropped
+                  << " rate_hz=" << stats.capture_rate_hz
+                  << " mean_latency_ms=" << stats.mean_latency_sec * 1000.0
+                  << " max_latency_ms=" << stats.max_latency_sec * 1000.0
+                  << " mean_render_ms=" << stats.mean_render_sec * 1000.0
+                  << " frames_allocated=" << pool.allocated
+                  << " frames_reused=" << pool.reused
+                  << std::endl;
+    }
+    if (image_compression_worker != nullptr) {
+        const auto stats = image_compression_worker->GetStats();
+        std::cout << "[INFO] TB3 camera compression:"
+                  << " submitted=" << stats.submitted
+                  << " encoded=" << stats.encoded
+                  << " dropped=" << stats.dropped
+                  << " failed=" << stats.failed
+                  << std::endl;
+        image_compression_worker->Stop();
+    }
+    if (camera_recorder != nullptr) {
+        camera_recorder->Stop();
+        const auto stats = camera_recorder->GetStats();
+        std::cout << "[INFO] TB3 camera recording:"
+                  << " submitted=" << stats.submitted
+                  << " written=" << stats.written
+                  << " dropped=" << stats.dropped
+                  << " failed=" << stats.failed
+                  << " bytes=" << stats.bytes_written
+                  << std::endl;
+    }
+    camera_capture.reset();
+    camera_recorder.reset();
     image_adapter.reset();
+    compressed_image_adapter.reset();
+    image_compression_worker.reset();
     asset_lifecycle.StopAndClose();
     lifecycle = nullptr;
     std::cout << "[INFO] TB3 simulation completed successfully." << std::endl;
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "physics/physics_impl.hpp"
+#include "runtime/worker_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hako {
+namespace robots {
+namespace physics {
+namespace impl {
+
+    // env_count copies of one scene: a single mjModel shared by env_count
+    // mjData, all stepped together on a WorkerPool. getData() is environment
+    // 0, so code written for one world drives the first environment; the
+    // others are reached through getEnvData() or a BatchedWorldEnvironment.
+    //
+    // The model is only read while stepping. A renderer that writes model
+    // fields (MujocoCameraRenderer) needs its own copy, e.g. a
+    // SnapshotWorldImpl with copy_model set on an environment view.
+    class BatchedWorld : public IWorld
+    {
+    public:
+        // Called on a pool thread before each step of one environment, e.g.
+        // to run that environment's controller and write its ctrl.
+        using ControlFunction = std::function<void(std::size_t env, mjData* env_data)>;
+
+    private:
+        std::size_t env_count;
+        // env_data[0] is also IWorld::data, which the base class frees.
+        std::vector<mjData*> env_data;
+        hako::robots::runtime::WorkerPool pool;
+        // Built once so stepping does not allocate a std::function per call;
+        // reads the arguments of the advanceTimeSteps() call in progress.
+        hako::robots::runtime::WorkerPool::RangeFunction step_range;
+        int pending_steps = 0;
+        std::uint64_t pending_first_step = 0;
+        const ControlFunction* pending_control = nullptr;
+
+        void stepRange(std::size_t begin, std::size_t end)
+        {
+            for (std::size_t env = begin; env < end; ++env) {
+                mjData* env_state = env_data[env];
+                for (int step = 0; step < pending_steps; ++step) {
+                    if (*pending_control) {
+                        (*pending_control)(env, env_state);
+                    }
+                    stepWithControl(model, env_state, pending_first_step + static_cast<std::uint64_t>(step));
+                }
+            }
+        }
+
+    public:
+        // thread_count includes the calling thread; 1 steps inline.
+        BatchedWorld(std::size_t env_count, int thread_count)
+            : env_count(env_count)
+            , pool(thread_count)
+            , step_range([this](std::size_t begin, std::size_t end) { stepRange(begin, end); })
+        {
+            if (env_count == 0) {
+                throw std::invalid_argument("Batched world needs at least one environment");
+            }
+        }
+        virtual ~BatchedWorld()
+        {
+            for (std::size_t env = 1; env < env_data.size(); ++env) {
+                mj_deleteData(env_data[env]);
+            }
+        }
+        void loadModel(const std::string& model_file) override
+        {
+            if (model) {
+                throw std::runtime_error("Batched world model already loaded");
+            }
+            model = loadModelCached(model_file);
+            if (!model) {
+                throw std::runtime_error("Model loading failed");
+            }
+            env_data.reserve(env_count);
+            for (std::size_t env = 0; env < env_count; ++env) {
+                mjData* env_state = mj_makeData(model);
+                if (!env_state) {
+                    throw std::runtime_error("Batched world data allocation failed");
+                }
+                env_data.push_back(env_state);
+                if (env == 0) {
+                    data = env_state;
+                }
+                mj_forward(model, env_state);
+            }
+        }
+        void advanceTimeStep() override
+        {
+            advanceTimeSteps(1);
+        }
+        // Steps every environment steps times. Each pool thread takes whole
+        // environments, so one fork/join covers all of them. control runs
+        // before each step; callbacks from addControlCallback() run inside
+        // it, on pool threads, with the same rate schedule in every
+        // environment.
+        void advanceTimeSteps(int steps, const ControlFunction& control = {})
+        {
+            if (!model) {
+                throw std::runtime_error("Batched world model not loaded");
+            }
+            pending_steps = steps;
+            pending_first_step = takeControlSteps(static_cast<std::uint64_t>(steps > 0 ? steps : 0));
+            pending_control = &control;
+            pool.ParallelFor(env_count, 1, step_range);
+            pending_control = nullptr;
+        }
+        // Back to the model's initial state, e.g. when an episode ends.
+        void resetEnv(std::size_t env)
+        {
+            mjData* env_state = getEnvData(env);
+            mj_resetData(model, env_state);
+            mj_forward(model, env_state);
+        }
+        std::size_t getEnvCount() const { return env_count; }
+        int getThreadCount() const { return pool.ThreadCount(); }
+        mjData* getEnvData(std::size_t env) const
+        {
+            if (env >= env_data.size()) {
+                throw std::out_of_range("Batched world environment out of range: " + std::to_string(env));
+            }
+            return env_data[env];
+        }
+        std::shared_ptr<IRigidBody> getRigidBody(const std::string& model_name) override
+        {
+            return std::make_shared<RigidBodyImpl>(model, data, getBodyHandle(model_name));
+        }
+        std::shared_ptr<actuator::ITorqueActuator> getTorqueActuator(const std::string& name) override {
+            return std::make_shared<actuator::impl::TorqueActuatorImpl>(model, data, getActuatorHandle(name));
+        }
+        std::shared_ptr<actuator::IJointActuator> createJointActuator() override {
+            return std::make_shared<actuator::impl::JointActuatorImpl>(model, data);
+        }
+        std::shared_ptr<actuator::INamedActuator> createNamedActuator() override {
+            return std::make_shared<actuator::impl::NamedActuatorImpl>(model, data);
+        }
+        std::shared_ptr<actuator::IJointTrajectoryActuator> createJointTrajectoryActuator() override {
+            return std::make_shared<actuator::impl::JointTrajectoryActuatorImpl>(model, data);
+        }
+    };
+    // One environment of a BatchedWorld as an IWorld: rigid bodies,
+    // actuators and sensors bound to it read and write that environment's
+    // mjData. Stepping stays with the batch.
+    class BatchedWorldEnvironment : public IWorld
+    {
+    private:
+        std::shared_ptr<BatchedWorld> batch;
+        mjData* env_state;
+    public:
+        BatchedWorldEnvironment(std::shared_ptr<BatchedWorld> batched_world, std::size_t env)
+            : batch(std::move(batched_world))
+        {
+            if (!batch || !batch->getModel()) {
+                throw std::runtime_error("Batched world environment needs a loaded batched world");
+            }
+            env_state = batch->getEnvData(env);
+        }
+        virtual ~BatchedWorldEnvironment() {}
+        // Model and data stay owned by the batch.
+        mjModel *getModel() const override { return batch->getModel(); }
+        mjData *getData() const override { return env_state; }
+        void loadModel(const std::string&) override
+        {
+            throw std::runtime_error("Batched world environment shares the batch model");
+        }
+        void advanceTimeStep() override
+        {
+            throw std::runtime_error("Batched world environments are stepped by their batch");
+        }
+        std::shared_ptr<IRigidBody> getRigidBody(const std::string& model_name) override
+        {
+            return std::make_shared<RigidBodyImpl>(getModel(), env_state, getBodyHandle(model_name));
+        }
+        std::shared_ptr<actuator::ITorqueActuator> getTorqueActuator(const std::string& name) override {
+            return std::make_shared<actuator::impl::TorqueActuatorImpl>(getModel(), env_state, getActuatorHandle(name));
+        }
+        std::shared_ptr<actuator::IJointActuator> createJointActuator() override {
+            return std::make_shared<actuator::impl::JointActuatorImpl>(getModel(), env_state);
+        }
+        std::shared_ptr<actuator::INamedActuator> createNamedActuator() override {
+            return std::make_shared<actuator::impl::NamedActuatorImpl>(getModel(), env_state);
+        }
+        std::shared_ptr<actuator::IJointTrajectoryActuator> createJointTrajectoryActuator() override {
+            return std::make_shared<actuator::impl::JointTrajectoryActuatorImpl>(getModel(), env_state);
+        }
+    };
+}  // namespace impl
+}  // namespace physics
+}  // namespace robots
+}  // namespace hako
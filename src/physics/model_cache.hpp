@@ -0,0 +1,269 @@
+#pragma once
+
+#include <mujoco/mujoco.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <regex>
+#include <set>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hako {
+namespace robots {
+namespace physics {
+namespace impl {
+
+    struct ModelCacheResult
+    {
+        bool enabled = false;
+        bool hit = false;
+        // A compiled model was written for the next start.
+        bool stored = false;
+        std::string key;
+        std::filesystem::path path;
+    };
+
+    // Compiled mjModel files (mj_saveModel) keyed by a content hash of the
+    // MJCF, every file it includes or references (meshes, textures,
+    // height fields, skins) and the MuJoCo version. A warm start maps the
+    // file and loads it with mj_loadModelBuffer instead of parsing and
+    // compiling the XML.
+    //
+    // References are found by scanning the XML text for file attributes and
+    // resolving them against the compiler meshdir/texturedir/assetdir, so
+    // assets pulled in by plugins are not part of the key.
+    class ModelCache
+    {
+    private:
+        std::filesystem::path directory;
+
+        static constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;
+        static constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+        static void hashBytes(std::uint64_t& hash, const void* bytes, std::size_t size)
+        {
+            const auto* p = static_cast<const unsigned char*>(bytes);
+            for (std::size_t i = 0; i < size; ++i) {
+                hash = (hash ^ p[i]) * kFnvPrime;
+            }
+        }
+        static void hashString(std::uint64_t& hash, const std::string& value)
+        {
+            const std::uint64_t size = value.size();
+            hashBytes(hash, &size, sizeof(size));
+            hashBytes(hash, value.data(), value.size());
+        }
+        static bool readFile(const std::filesystem::path& path, std::string& out)
+        {
+            std::ifstream ifs(path, std::ios::binary);
+            if (!ifs) {
+                return false;
+            }
+            out.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+            return true;
+        }
+        static std::vector<std::string> attributeValues(const std::string& xml, const std::regex& pattern)
+        {
+            std::vector<std::string> values;
+            for (auto it = std::sregex_iterator(xml.begin(), xml.end(), pattern); it != std::sregex_iterator(); ++it) {
+                values.push_back((*it)[1].str());
+            }
+            return values;
+        }
+
+    public:
+        explicit ModelCache(std::filesystem::path cache_directory)
+            : directory(std::move(cache_directory))
+        {
+        }
+        // HAKO_MODEL_CACHE_DIR, or empty (no caching) when unset.
+        static std::filesystem::path directoryFromEnvironment()
+        {
+            const char* env = std::getenv("HAKO_MODEL_CACHE_DIR");
+            if (env == nullptr || env[0] == '\0') {
+                return {};
+            }
+            return env;
+        }
+        bool enabled() const { return !directory.empty(); }
+        const std::filesystem::path& getDirectory() const { return directory; }
+
+        // The model file, then every included or referenced file that
+        // exists, in document order. Includes are scanned recursively.
+        static std::vector<std::filesystem::path> referencedFiles(const std::string& model_file)
+        {
+            static const std::regex include_pattern("<include[^>]*\\bfile\\s*=\\s*\"([^\"]*)\"");
+            static const std::regex file_pattern("\\bfile[a-z]*\\s*=\\s*\"([^\"]*)\"");
+            static const std::regex dir_pattern("\\b(?:meshdir|texturedir|assetdir)\\s*=\\s*\"([^\"]*)\"");
+
+            const std::filesystem::path root(model_file);
+            const std::filesystem::path base_dir = root.parent_path();
+            std::vector<std::filesystem::path> files {root};
+            std::vector<std::string> texts;
+            std::set<std::filesystem::path> seen {root.lexically_normal()};
+            // MuJoCo resolves nested includes against the top-level file.
+            for (std::size_t i = 0; i < files.size(); ++i) {
+                std::string xml;
+                if (!readFile(files[i], xml)) {
+                    continue;
+                }
+                for (const auto& include : attributeValues(xml, include_pattern)) {
+                    const std::filesystem::path path = (base_dir / include).lexically_normal();
+                    if (seen.insert(path).second) {
+                        files.push_back(path);
+                    }
+                }
+                texts.push_back(std::move(xml));
+            }
+
+            std::vector<std::filesystem::path> search_dirs {base_dir};
+            for (const auto& xml : texts) {
+                for (const auto& dir : attributeValues(xml, dir_pattern)) {
+                    search_dirs.push_back(base_dir / dir);
+                }
+            }
+            for (const auto& xml : texts) {
+                for (const auto& value : attributeValues(xml, file_pattern)) {
+                    for (const auto& dir : search_dirs) {
+                        const std::filesystem::path path = (dir / value).lexically_normal();
+                        std::error_code ec;
+                        if (std::filesystem::is_regular_file(path, ec) && seen.insert(path).second) {
+                            files.push_back(path);
+                        }
+                    }
+                }
+            }
+            return files;
+        }
+        // 16 hex digits; empty if the model file cannot be read.
+        static std::string keyFor(const std::string& model_file)
+        {
+            std::uint64_t hash = kFnvOffset;
+            hashString(hash, mj_versionString());
+            const std::uint64_t num_size = sizeof(mjtNum);
+            hashBytes(hash, &num_size, sizeof(num_size));
+            const std::filesystem::path base_dir = std::filesystem::path(model_file).parent_path();
+            std::string content;
+            for (const auto& file : referencedFiles(model_file)) {
+                if (!readFile(file, content)) {
+                    return {};
+                }
+                hashString(hash, file.lexically_relative(base_dir).generic_string());
+                hashString(hash, content);
+            }
+            char key[17];
+            std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+            return key;
+        }
+        std::filesystem::path pathFor(const std::string& model_file, const std::string& key) const
+        {
+            return directory / (std::filesystem::path(model_file).stem().string() + "-" + key + ".mjb");
+        }
+        // Loads a cached model, or nullptr (a miss, or an unreadable entry).
+        static mjModel* loadCompiled(const std::filesystem::path& path)
+        {
+#if !defined(_WIN32)
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return nullptr;
+            }
+            struct stat st {};
+            mjModel* loaded = nullptr;
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                const auto size = static_cast<std::size_t>(st.st_size);
+                void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    loaded = mj_loadModelBuffer(mapped, static_cast<int>(size));
+                    ::munmap(mapped, size);
+                }
+            }
+            ::close(fd);
+            return loaded;
+#else
+            std::string buffer;
+            if (!readFile(path, buffer) || buffer.empty()) {
+                return nullptr;
+            }
+            return mj_loadModelBuffer(buffer.data(), static_cast<int>(buffer.size()));
+#endif
+        }
+        // Written to a temporary name and renamed, so a concurrent start
+        // never maps a partial file.
+        bool store(const mjModel* compiled, const std::filesystem::path& path) const
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(directory, ec);
+            if (ec) {
+                std::cerr << "WARNING: cannot create model cache directory " << directory << ": " << ec.message() << std::endl;
+                return false;
+            }
+            std::filesystem::path temp = path;
+            temp += ".tmp" + std::to_string(std::random_device {}());
+            mj_saveModel(compiled, temp.string().c_str(), nullptr, 0);
+            std::filesystem::rename(temp, path, ec);
+            if (ec) {
+                std::filesystem::remove(temp, ec);
+                std::cerr << "WARNING: cannot write model cache " << path << std::endl;
+                return false;
+            }
+            return true;
+        }
+        // mj_loadXML through the cache; nullptr only if the XML fails to load.
+        mjModel* load(const std::string& model_file, ModelCacheResult* result = nullptr) const
+        {
+            ModelCacheResult local;
+            ModelCacheResult& out = result ? *result : local;
+            out = ModelCacheResult {};
+            out.enabled = enabled();
+            if (out.enabled) {
+                out.key = keyFor(model_file);
+            }
+            if (!out.key.empty()) {
+                out.path = pathFor(model_file, out.key);
+                if (mjModel* cached = loadCompiled(out.path)) {
+                    out.hit = true;
+                    return cached;
+                }
+            }
+            mjModel* compiled = mj_loadXML(model_file.c_str(), nullptr, nullptr, 0);
+            if (compiled && !out.key.empty()) {
+                out.stored = store(compiled, out.path);
+            }
+            return compiled;
+        }
+    };
+
+    // Loads model_file through the HAKO_MODEL_CACHE_DIR cache, if set, and
+    // reports whether the compiled model came from the cache.
+    inline mjModel* loadModelCached(const std::string& model_file)
+    {
+        const ModelCache cache(ModelCache::directoryFromEnvironment());
+        ModelCacheResult result;
+        mjModel* loaded = cache.load(model_file, &result);
+        if (loaded && result.hit) {
+            std::cout << "[INFO] Model cache hit: " << model_file << " (" << result.path.string() << ")" << std::endl;
+        } else if (loaded && result.stored) {
+            std::cout << "[INFO] Model cache miss, stored: " << result.path.string() << std::endl;
+        }
+        return loaded;
+    }
+}  // namespace impl
+}  // namespace physics
+}  // namespace robots
+}  // namespace hako
@@ -5,10 +5,13 @@
 #include "actuator/joint_actuator_impl.hpp"
 #include "actuator/named_actuator_impl.hpp"
 #include "actuator/joint_trajectory_actuator_impl.hpp"
+#include "physics/model_cache.hpp"
 
 #include <cmath>
+#include <cstring>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
 
 namespace hako {
 namespace robots {
@@ -21,7 +24,17 @@ namespace impl {
         mjModel* model;
         mjData* data;
         int body_id;
+        int root_id;
         std::unordered_map<std::string, int> joint_id_map;
+
+        // Everything the cached state is derived from: time, then the body's
+        // xpos, xmat and cvel and its tree's subtree_com. Same inputs mean the
+        // same state, so writers that restore state and call mj_forward
+        // without advancing time never see a stale cache.
+        static constexpr int kStateInputs = 1 + 3 + 9 + 6 + 3;
+        mjtNum state_inputs[kStateInputs] = {};
+        bool state_valid = false;
+        RigidBodyState state;
         int getJointId(const std::string& joint_name) {
             auto it = joint_id_map.find(joint_name);
             if (it != joint_id_map.end()) {
@@ -79,13 +92,58 @@ namespace impl {
     
             return body_vel;
         }
+        // Computes the whole state at most once per step: one
+        // mj_objectVelocity in the world frame, rotated into the body frame
+        // the way mj_objectVelocity(..., 1) does it. For mjOBJ_BODY that is
+        // the inertial frame (ximat), which differs from xmat when the body
+        // has a rotated <inertial> or non-aligned principal axes.
+        const RigidBodyState& refreshState()
+        {
+            mjtNum inputs[kStateInputs];
+            inputs[0] = data->time;
+            std::memcpy(inputs + 1, &data->xpos[3 * body_id], 3 * sizeof(mjtNum));
+            std::memcpy(inputs + 4, &data->xmat[9 * body_id], 9 * sizeof(mjtNum));
+            std::memcpy(inputs + 13, &data->cvel[6 * body_id], 6 * sizeof(mjtNum));
+            std::memcpy(inputs + 19, &data->subtree_com[3 * root_id], 3 * sizeof(mjtNum));
+            if (state_valid && std::memcmp(inputs, state_inputs, sizeof(inputs)) == 0) {
+                return state;
+            }
+            std::memcpy(state_inputs, inputs, sizeof(inputs));
+            state_valid = true;
+
+            const mjtNum* mat = &data->xmat[9 * body_id];
+            state.time = data->time;
+            state.position.x = inputs[1];
+            state.position.y = inputs[2];
+            state.position.z = inputs[3];
+            mat2euler(mat, state.euler);
+
+            mjtNum world_velocity[6] = {};
+            mjtNum body_velocity[6] = {};
+            mj_objectVelocity(model, data, mjOBJ_BODY, body_id, world_velocity, 0);
+            const mjtNum* inertial_mat = &data->ximat[9 * body_id];
+            mju_mulMatTVec3(body_velocity, inertial_mat, world_velocity);
+            mju_mulMatTVec3(body_velocity + 3, inertial_mat, world_velocity + 3);
+            state.angular_velocity.x = world_velocity[0];
+            state.angular_velocity.y = world_velocity[1];
+            state.angular_velocity.z = world_velocity[2];
+            state.velocity.x = world_velocity[3];
+            state.velocity.y = world_velocity[4];
+            state.velocity.z = world_velocity[5];
+            state.body_angular_velocity.x = body_velocity[0];
+            state.body_angular_velocity.y = body_velocity[1];
+            state.body_angular_velocity.z = body_velocity[2];
+            state.body_velocity.x = body_velocity[3];
+            state.body_velocity.y = body_velocity[4];
+            state.body_velocity.z = body_velocity[5];
+            return state;
+        }
     public:
-        RigidBodyImpl(mjModel* model, mjData* data, const std::string& model_name)
-            : model(model), data(data)
+        RigidBodyImpl(mjModel* model, mjData* data, const BodyHandle& body)
+            : model(model), data(data), body_id(body.id), root_id(body.root_id)
         {
-            body_id = mj_name2id(model, mjOBJ_BODY, model_name.c_str());
-            if (body_id < 0) {
-                throw std::runtime_error("Body not found: " + model_name);
+            if (!body.valid()) {
+                throw std::runtime_error("Invalid body handle");
             }
         }
         virtual ~RigidBodyImpl() override {}
@@ -100,20 +158,11 @@ namespace impl {
         }
         hako::robots::types::Euler GetEuler() override
         {
-            hako::robots::types::Euler euler;
-            const mjtNum* mat = &(data->xmat[9 * body_id]);
-            mat2euler(mat, euler);
-            return euler;
+            return refreshState().euler;
         }
         hako::robots::types::Velocity GetVelocity() override
         {
-            mjtNum object_velocity[6] = {};
-            mj_objectVelocity(model, data, mjOBJ_BODY, body_id, object_velocity, 0);
-            hako::robots::types::Velocity vel;
-            vel.x = object_velocity[3];
-            vel.y = object_velocity[4];
-            vel.z = object_velocity[5];
-            return vel;
+            return refreshState().velocity;
         }
         hako::robots::types::EulerRate GetEulerRate() override
         {
@@ -123,23 +172,15 @@ namespace impl {
         }
         hako::robots::types::BodyVelocity GetBodyVelocity() override
         {
-            mjtNum object_velocity[6] = {};
-            mj_objectVelocity(model, data, mjOBJ_BODY, body_id, object_velocity, 1);
-            hako::robots::types::BodyVelocity body_vel;
-            body_vel.x = object_velocity[3];
-            body_vel.y = object_velocity[4];
-            body_vel.z = object_velocity[5];
-            return body_vel;
+            return refreshState().body_velocity;
         }
         hako::robots::types::BodyAngularVelocity GetBodyAngularVelocity() override
         {
-            mjtNum object_velocity[6] = {};
-            mj_objectVelocity(model, data, mjOBJ_BODY, body_id, object_velocity, 1);
-            hako::robots::types::BodyAngularVelocity angular_vel;
-            angular_vel.x = object_velocity[0];
-            angular_vel.y = object_velocity[1];
-            angular_vel.z = object_velocity[2];
-            return angular_vel;
+            return refreshState().body_angular_velocity;
+        }
+        const RigidBodyState& GetState() override
+        {
+            return refreshState();
         }
         void SetTorque(const std::string& joint_name, double torque) override
         {
@@ -158,9 +199,11 @@ namespace impl {
     public:
         WorldImpl() {}
         virtual ~WorldImpl() {}
+        // Compiled models are reused across starts when HAKO_MODEL_CACHE_DIR
+        // is set (see ModelCache).
         void loadModel(const std::string& model_file) override
         {
-            model = mj_loadXML(model_file.c_str(), nullptr, nullptr, 0);
+            model = loadModelCached(model_file);
             if (!model) {
                 throw std::runtime_error("Model loading failed");
             }
@@ -169,14 +212,14 @@ namespace impl {
         }
         void advanceTimeStep() override
         {
-            mj_step(model, data);
+            stepWithControl(model, data, takeControlSteps(1));
         }
         std::shared_ptr<IRigidBody> getRigidBody(const std::string& model_name) override
         {
-            return std::make_shared<RigidBodyImpl>(model, data, model_name);
+            return std::make_shared<RigidBodyImpl>(model, data, getBodyHandle(model_name));
         }
         std::shared_ptr<actuator::ITorqueActuator> getTorqueActuator(const std::string& name) override {
-            return std::make_shared<actuator::impl::TorqueActuatorImpl>(model, data, name);
+            return std::make_shared<actuator::impl::TorqueActuatorImpl>(model, data, getActuatorHandle(name));
         }
         std::shared_ptr<actuator::IJointActuator> createJointActuator() override {
             return std::make_shared<actuator::impl::JointActuatorImpl>(model, data);
@@ -187,7 +230,55 @@ namespace impl {
         std::shared_ptr<actuator::IJointTrajectoryActuator> createJointTrajectoryActuator() override {
             return std::make_shared<actuator::impl::JointTrajectoryActuatorImpl>(model, data);
         }
-        
+
+    };
+    // Read-only view of another world's model with its own mjData. Sensors
+    // bound to it read whatever state is written into that data (e.g. a
+    // KinematicSnapshot), so they can run while the source world steps.
+    // copy_model gives the view a private mjModel copy, for readers that
+    // write model fields while rendering (MujocoCameraRenderer overrides
+    // camera fovy and clip planes per frame).
+    class SnapshotWorldImpl : public IWorld
+    {
+    private:
+        std::shared_ptr<IWorld> source;
+    public:
+        explicit SnapshotWorldImpl(std::shared_ptr<IWorld> source_world, bool copy_model = false)
+            : source(std::move(source_world))
+        {
+            if (!source || !source->getModel() || !source->getData()) {
+                throw std::runtime_error("Snapshot world needs a loaded source world");
+            }
+            // Unless copied, the model stays owned by the source world.
+            if (copy_model) {
+                model = mj_copyModel(nullptr, source->getModel());
+                if (!model) {
+                    throw std::runtime_error("Snapshot model copy failed");
+                }
+            }
+            data = mj_makeData(source->getModel());
+            if (!data) {
+                throw std::runtime_error("Snapshot data allocation failed");
+            }
+            mj_copyData(data, source->getModel(), source->getData());
+        }
+        virtual ~SnapshotWorldImpl() {}
+        mjModel *getModel() const override { return model ? model : source->getModel(); }
+        void loadModel(const std::string&) override
+        {
+            throw std::runtime_error("Snapshot world shares the source model");
+        }
+        void advanceTimeStep() override
+        {
+            throw std::runtime_error("Snapshot world cannot be stepped");
+        }
+        std::shared_ptr<IRigidBody> getRigidBody(const std::string& model_name) override
+        {
+            return std::make_shared<RigidBodyImpl>(getModel(), data, getBodyHandle(model_name));
+        }
+        std::shared_ptr<actuator::ITorqueActuator> getTorqueActuator(const std::string&) override {
+            return nullptr;
+        }
     };
 }  // namespace impl
 }  // namespace physics
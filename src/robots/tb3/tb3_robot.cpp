@@ -20,19 +20,27 @@ namespace
 
 }
 
-Tb3Robot::Tb3Robot(std::shared_ptr<hako::robots::physics::IWorld> world, Tb3RuntimeConfig config)
+Tb3Robot::Tb3Robot(
+    std::shared_ptr<hako::robots::physics::IWorld> world,
+    Tb3RuntimeConfig config,
+    std::shared_ptr<hako::robots::physics::IWorld> sensor_world)
     : world_(std::move(world))
+    , sensor_world_(sensor_world != nullptr ? std::move(sensor_world) : world_)
     , config_(std::move(config))
     , drive_(std::make_unique<Tb3Drive>(world_))
-    , lidar_sensor_(world_, "base_scan", "base_footprint")
-    , imu_sensor_(world_)
-    , joint_state_sensor_(world_)
-    , odom_sensor_(world_)
-    , tf_sensor_(world_)
+    , sensor_base_scan_(sensor_world_->getRigidBody("base_scan"))
+    , lidar_sensor_(sensor_world_, "base_scan", "base_footprint")
+    , imu_sensor_(sensor_world_)
+    , joint_state_sensor_(sensor_world_)
+    , odom_sensor_(sensor_world_)
+    , tf_sensor_(sensor_world_)
 {
 }
 
-Tb3Robot::~Tb3Robot() = default;
+Tb3Robot::~Tb3Robot()
+{
+    StopSensorThread();
+}
 
 bool Tb3Robot::Initialize(std::string* error_message)
 {
@@ -61,9 +69,76 @@ bool Tb3Robot::Initialize(std::string* error_message)
         }
         return false;
     }
+    RegisterSensors();
     return true;
 }
 
+void Tb3Robot::RegisterSensors()
+{
+    using hako::robots::sensor::lidar::LaserScanFrame;
+
+    sensor_group_.Clear();
+    const auto& engine = lidar_sensor_.GetConfig().scan_engine;
+    sensor_group_.SetRayThreads(engine.threads, static_cast<std::size_t>(engine.min_beams_per_thread));
+
+    sensor_group_.Add(imu_sensor_, [this]() {
+        auto& out = sensor_frames_.imu;
+        imu_sensor_.Build(out);
+        out.header.frame_id = imu_sensor_.GetConfig().frame_id;
+        out.header.stamp_sec = sensor_time_sec_;
+        sensor_frames_.imu_updated = true;
+    });
+    sensor_group_.Add(joint_state_sensor_, [this]() {
+        auto& out = sensor_frames_.joint_state;
+        out = {};
+        joint_state_sensor_.Build(out);
+        out.header.frame_id = "";
+        out.header.stamp_sec = sensor_time_sec_;
+        sensor_frames_.joint_state_updated = true;
+    });
+    sensor_group_.Add(odom_sensor_, [this]() {
+        auto& out = sensor_frames_.odometry;
+        odom_sensor_.Build(out);
+        out.header.frame_id = odom_sensor_.GetConfig().frame_id;
+        out.header.stamp_sec = sensor_time_sec_;
+        sensor_frames_.odometry_updated = true;
+    });
+    sensor_group_.Add(tf_sensor_, [this]() {
+        auto& out = sensor_frames_.tf;
+        tf_sensor_.Build(out);
+        for (auto& transform : out.transforms) {
+            transform.header.stamp_sec = sensor_time_sec_;
+        }
+        sensor_frames_.tf_updated = true;
+    });
+
+    if (engine.incremental) {
+        // A rolling-shutter sweep casts a slice on every physics step.
+        sensor_group_.Add(0.0, [this]() {
+            sensor_frames_.laser_scan_updated =
+                lidar_sensor_.Update(sensor_step_sec_, sensor_frames_.laser_scan);
+            if (sensor_frames_.laser_scan_updated) {
+                CaptureBaseScanPose();
+            }
+        });
+    } else {
+        sensor_group_.Add(
+            lidar_sensor_,
+            [this]() {
+                lidar_sensor_.FinishRayBatch(sensor_frames_.laser_scan);
+                CaptureBaseScanPose();
+                sensor_frames_.laser_scan_updated = true;
+            },
+            &lidar_sensor_);
+    }
+}
+
+void Tb3Robot::CaptureBaseScanPose()
+{
+    sensor_frames_.base_scan_position = sensor_base_scan_->GetPosition();
+    sensor_frames_.base_scan_euler = sensor_base_scan_->GetEuler();
+}
+
 void Tb3Robot::ApplyCommand(const Tb3Command& command)
 {
     raw_linear_velocity_ = std::clamp(
@@ -139,85 +214,88 @@ hako::robots::types::Euler Tb3Robot::GetBaseScanEuler() const
     return drive_->BaseScanEuler();
 }
 
-bool Tb3Robot::MaybeBuildImu(
-    double sim_timestep,
-    double sim_time_sec,
-    hako::robots::sensor::ImuFrame& out)
+const Tb3SensorFrames& Tb3Robot::UpdateSensors(double sim_timestep, double sim_time_sec)
 {
-    if (!imu_sensor_.ShouldUpdate(sim_timestep)) {
-        return false;
-    }
-    imu_sensor_.Build(out);
-    out.header.frame_id = imu_sensor_.GetConfig().frame_id;
-    out.header.stamp_sec = sim_time_sec;
-    return true;
+    sensor_frames_.imu_updated = false;
+    sensor_frames_.joint_state_updated = false;
+    sensor_frames_.odometry_updated = false;
+    sensor_frames_.tf_updated = false;
+    sensor_frames_.laser_scan_updated = false;
+    sensor_step_sec_ = sim_timestep;
+    sensor_time_sec_ = sim_time_sec;
+    sensor_group_.Step(sim_timestep);
+    return sensor_frames_;
 }
 
-bool Tb3Robot::MaybeBuildJointState(
-    double sim_timestep,
-    double sim_time_sec,
-    hako::robots::sensor::JointStateFrame& out)
+bool Tb3Robot::StartSensorThread(std::string* error_message)
 {
-    if (!joint_state_sensor_.ShouldUpdate(sim_timestep)) {
+    if (sensor_world_ == world_) {
+        if (error_message != nullptr) {
+            *error_message = "sensor thread needs a separate sensor world";
+        }
+        return false;
+    }
+    if (!sensor_worker_.Start(
+            world_->getModel(),
+            sensor_world_->getData(),
+            [this](double delta_sec, double stamp_sec) { EvaluateSensorSnapshot(delta_sec, stamp_sec); }))
+    {
+        if (error_message != nullptr) {
+            *error_message = "failed to start TB3 sensor thread";
+        }
         return false;
     }
-    last_joint_state_frame_ = {};
-    joint_state_sensor_.Build(last_joint_state_frame_);
-    last_joint_state_frame_.header.frame_id = "";
-    last_joint_state_frame_.header.stamp_sec = sim_time_sec;
-    out = last_joint_state_frame_;
     return true;
 }
 
-bool Tb3Robot::MaybeBuildOdometry(
-    double sim_timestep,
-    double sim_time_sec,
-    hako::robots::sensor::OdometryFrame& out)
+void Tb3Robot::StopSensorThread()
 {
-    if (!odom_sensor_.ShouldUpdate(sim_timestep)) {
-        return false;
-    }
-    odom_sensor_.Build(out);
-    out.header.frame_id = odom_sensor_.GetConfig().frame_id;
-    out.header.stamp_sec = sim_time_sec;
-    return true;
+    sensor_worker_.Stop();
 }
 
-bool Tb3Robot::MaybeBuildTf(
-    double sim_timestep,
-    double sim_time_sec,
-    hako::robots::sensor::TfFrame& out)
+void Tb3Robot::PublishSensorSnapshot(double sim_time_sec)
 {
-    if (!tf_sensor_.ShouldUpdate(sim_timestep)) {
+    (void)sensor_worker_.Publish(world_->getData(), sim_time_sec);
+}
+
+bool Tb3Robot::PollSensorFrames(Tb3SensorFrames& out)
+{
+    Tb3SensorFrames* slot = frame_queue_.ReadSlot();
+    if (slot == nullptr) {
         return false;
     }
-    tf_sensor_.Build(out);
-    for (auto& transform : out.transforms) {
-        transform.header.stamp_sec = sim_time_sec;
-    }
+    // Swap instead of copy so the scan and joint buffers circulate between
+    // the queue and the caller without reallocating.
+    std::swap(out, *slot);
+    frame_queue_.CommitRead();
     return true;
 }
 
-bool Tb3Robot::MaybeBuildLaserScan(
-    double sim_timestep,
-    hako::robots::sensor::lidar::LaserScanFrame& out)
+void Tb3Robot::EvaluateSensorSnapshot(double delta_sec, double stamp_sec)
 {
-    if (!lidar_sensor_.ShouldUpdate(sim_timestep)) {
-        return false;
+    const auto& frames = UpdateSensors(delta_sec, stamp_sec);
+    if (!frames.imu_updated && !frames.joint_state_updated && !frames.odometry_updated &&
+        !frames.tf_updated && !frames.laser_scan_updated)
+    {
+        return;
     }
-    lidar_sensor_.Scan(out);
-    last_laser_scan_ = out;
-    out = last_laser_scan_;
-    return true;
+    Tb3SensorFrames* slot = frame_queue_.WriteSlot();
+    if (slot == nullptr) {
+        dropped_sensor_frames_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    *slot = frames;
+    frame_queue_.CommitWrite();
 }
 
-void Tb3Robot::EmitDebugLog(int step) const
+void Tb3Robot::EmitDebugLog(int step, const Tb3SensorFrames& frames) const
 {
     float lidar_min = std::numeric_limits<float>::infinity();
     float lidar_max = 0.0F;
     int lidar_hits = 0;
-    for (float v : last_laser_scan_.ranges) {
-        if (v >= last_laser_scan_.range_min && v < last_laser_scan_.range_max) {
+    const auto& laser_scan = frames.laser_scan;
+    for (float v : laser_scan.ranges) {
+        if (v >= laser_scan.range_min && v < laser_scan.range_max) {
             lidar_min = std::min(lidar_min, v);
             lidar_max = std::max(lidar_max, v);
             ++lidar_hits;
@@ -225,14 +303,11 @@ void Tb3Robot::EmitDebugLog(int step) const
     }
     const auto pos = drive_->BasePosition();
     const auto body_vel = drive_->BaseBodyVelocity();
-    const double left_joint_pos =
-        (last_joint_state_frame_.position.size() > 0) ? last_joint_state_frame_.position[0] : 0.0;
-    const double right_joint_pos =
-        (last_joint_state_frame_.position.size() > 1) ? last_joint_state_frame_.position[1] : 0.0;
-    const double left_joint_vel =
-        (last_joint_state_frame_.velocity.size() > 0) ? last_joint_state_frame_.velocity[0] : 0.0;
-    const double right_joint_vel =
-        (last_joint_state_frame_.velocity.size() > 1) ? last_joint_state_frame_.velocity[1] : 0.0;
+    const auto& joint_state = frames.joint_state;
+    const double left_joint_pos = (joint_state.position.size() > 0) ? joint_state.position[0] : 0.0;
+    const double right_joint_pos = (joint_state.position.size() > 1) ? joint_state.position[1] : 0.0;
+    const double left_joint_vel = (joint_state.velocity.size() > 0) ? joint_state.velocity[0] : 0.0;
+    const double right_joint_vel = (joint_state.velocity.size() > 1) ? joint_state.velocity[1] : 0.0;
     std::cout << "[TB3] step=" << step
               << " pos=(" << pos.x << ", " << pos.y << ", " << pos.z << ")"
               << " body_vx=" << body_vel.x
@@ -244,7 +319,13 @@ void Tb3Robot::EmitDebugLog(int step) const
               << " joint_vel=(" << left_joint_vel << ", " << right_joint_vel << ")"
               << " lidar_hits=" << lidar_hits
               << " lidar_min=" << (std::isfinite(lidar_min) ? lidar_min : -1.0F)
-              << " lidar_max=" << lidar_max
-              << std::endl;
+              << " lidar_max=" << lidar_max;
+    if (sensor_worker_.Running()) {
+        const auto stats = sensor_worker_.GetStats();
+        std::cout << " sensor_snapshots=" << stats.evaluated << "/" << stats.published
+                  << " dropped_snapshots=" << stats.dropped
+                  << " dropped_frames=" << dropped_sensor_frames_.load(std::memory_order_relaxed);
+    }
+    std::cout << std::endl;
 }
 }
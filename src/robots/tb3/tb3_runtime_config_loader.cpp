@@ -155,6 +155,7 @@ Tb3RuntimeConfig LoadTb3RuntimeConfig(
     config.mirror_bindings_config = resolve_repo_path(
         get_env_string("HAKO_TB3_MIRROR_BINDINGS_PATH", ""));
     config.start_conductor = get_env_string("HAKO_TB3_DISABLE_CONDUCTOR_START", "") != "1";
+    config.sensor_thread = get_env_string("HAKO_TB3_SENSOR_THREAD", "") == "1";
     config.asset_name = get_env_string("HAKO_ASSET_NAME", "tb3_sim");
     config.asset_config_path = get_env_string("HAKO_ASSET_CONFIG_PATH", manifest.pdu_def);
     return config;
@@ -0,0 +1,113 @@
+#include "runtime/worker_pool.hpp"
+
+#include <algorithm>
+
+namespace hako::robots::runtime
+{
+namespace
+{
+// Hand out a few chunks per thread so uneven work (e.g. rays that hit mesh
+// geoms next to rays that hit nothing) still balances across the pool.
+constexpr std::size_t kChunksPerThread = 4;
+}
+
+WorkerPool::WorkerPool(int thread_count)
+{
+    const int worker_count = std::max(1, thread_count) - 1;
+    workers_.reserve(static_cast<std::size_t>(worker_count));
+    for (int i = 0; i < worker_count; ++i) {
+        workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    job_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+int WorkerPool::ThreadCount() const
+{
+    return static_cast<int>(workers_.size()) + 1;
+}
+
+void WorkerPool::ParallelFor(std::size_t count, std::size_t min_chunk, const RangeFunction& fn)
+{
+    if (count == 0) {
+        return;
+    }
+    min_chunk = std::max<std::size_t>(1, min_chunk);
+    if (workers_.empty() || count <= min_chunk) {
+        fn(0, count);
+        return;
+    }
+
+    const std::size_t target_chunks = static_cast<std::size_t>(ThreadCount()) * kChunksPerThread;
+    const std::size_t chunk_size = std::max(min_chunk, (count + target_chunks - 1) / target_chunks);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        job_count_ = count;
+        chunk_size_ = chunk_size;
+        chunk_total_ = (count + chunk_size - 1) / chunk_size;
+        next_chunk_.store(0);
+        pending_workers_ = workers_.size();
+        ++generation_;
+    }
+    job_cv_.notify_all();
+
+    RunChunks();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return pending_workers_ == 0; });
+    job_ = nullptr;
+}
+
+void WorkerPool::WorkerLoop()
+{
+    std::uint64_t seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            job_cv_.wait(lock, [this, seen_generation]() {
+                return stopping_ || generation_ != seen_generation;
+            });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+
+        RunChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_workers_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
+
+void WorkerPool::RunChunks()
+{
+    for (;;) {
+        const std::size_t chunk = next_chunk_.fetch_add(1);
+        if (chunk >= chunk_total_) {
+            return;
+        }
+        const std::size_t begin = chunk * chunk_size_;
+        const std::size_t end = std::min(job_count_, begin + chunk_size_);
+        (*job_)(begin, end);
+    }
+}
+}
@@ -0,0 +1,193 @@
+#include "sensors/camera/camera_capture_service.hpp"
+
+#include "sensors/camera/mujoco_camera_renderer.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <utility>
+
+namespace hako::robots::sensor::camera
+{
+CameraCaptureService::~CameraCaptureService()
+{
+    Stop();
+}
+
+bool CameraCaptureService::Start(
+    std::shared_ptr<hako::robots::physics::IWorld> render_world,
+    const CameraCaptureConfig& config)
+{
+    if (Running()) {
+        std::cerr << "ERROR: CameraCaptureService::Start: service is already running" << std::endl;
+        return false;
+    }
+    if (!render_world || render_world->getModel() == nullptr || render_world->getData() == nullptr) {
+        std::cerr << "ERROR: CameraCaptureService::Start: a loaded render world is required" << std::endl;
+        return false;
+    }
+    try {
+        renderer_ = std::make_shared<MujocoCameraRenderer>(render_world, config.backend);
+        sensor_ = std::make_unique<CameraSensor>(renderer_, config.camera_name);
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: CameraCaptureService::Start: " << e.what() << std::endl;
+        sensor_.reset();
+        renderer_.reset();
+        return false;
+    }
+    if (!sensor_->LoadConfig(config.camera)) {
+        std::cerr << "ERROR: CameraCaptureService::Start: invalid camera config for '"
+                  << config.camera_name << "'" << std::endl;
+        sensor_.reset();
+        renderer_.reset();
+        return false;
+    }
+    // The context was made current here; the capture thread takes it over.
+    renderer_->ReleaseContext();
+
+    render_world_ = std::move(render_world);
+    on_frame_ = config.on_frame;
+    image_ = config.camera.image;
+    period_sec_ = config.camera.update_rate_hz > 0.0 ? 1.0 / config.camera.update_rate_hz : 0.0;
+    scheduler_.StartReady(period_sec_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = false;
+        has_pending_ = false;
+        has_latest_ = false;
+        latest_.Reset();
+        stats_ = Stats {};
+        latency_sum_sec_ = 0.0;
+        render_sum_sec_ = 0.0;
+        start_time_ = Clock::now();
+    }
+    thread_ = std::thread([this]() { Run(); });
+    return true;
+}
+
+void CameraCaptureService::Stop()
+{
+    if (!Running()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_one();
+    thread_.join();
+    // The capture thread released the context, so the GL resources can be
+    // freed from here.
+    sensor_.reset();
+    renderer_.reset();
+    render_world_.reset();
+}
+
+bool CameraCaptureService::ShouldUpdate(double delta_sec)
+{
+    return scheduler_.ShouldUpdate(delta_sec, period_sec_);
+}
+
+bool CameraCaptureService::Request(const mjData* live_data)
+{
+    if (!Running() || live_data == nullptr) {
+        return false;
+    }
+    request_snapshot_.Capture(render_world_->getModel(), live_data);
+    const auto now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.requested;
+        if (has_pending_) {
+            ++stats_.dropped;
+        }
+        std::swap(pending_, request_snapshot_);
+        pending_time_ = now;
+        has_pending_ = true;
+    }
+    ready_.notify_one();
+    return true;
+}
+
+bool CameraCaptureService::TryTakeLatest(PooledImageFrame& out)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!has_latest_) {
+        return false;
+    }
+    out = std::move(latest_);
+    has_latest_ = false;
+    return true;
+}
+
+CameraCaptureService::Stats CameraCaptureService::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    const double elapsed_sec = std::chrono::duration<double>(Clock::now() - start_time_).count();
+    if (elapsed_sec > 0.0) {
+        stats.capture_rate_hz = static_cast<double>(stats.captured) / elapsed_sec;
+    }
+    if (stats.captured > 0) {
+        stats.mean_latency_sec = latency_sum_sec_ / static_cast<double>(stats.captured);
+    }
+    const std::uint64_t rendered = stats.captured + stats.empty;
+    if (rendered > 0) {
+        stats.mean_render_sec = render_sum_sec_ / static_cast<double>(rendered);
+    }
+    return stats;
+}
+
+void CameraCaptureService::Run()
+{
+    auto* model = render_world_->getModel();
+    auto* data = render_world_->getData();
+    common::KinematicSnapshot snapshot {};
+    PooledImageFrame frame {};
+    while (true) {
+        Clock::time_point requested_at {};
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return stopping_ || has_pending_; });
+            if (stopping_) {
+                break;
+            }
+            std::swap(snapshot, pending_);
+            requested_at = pending_time_;
+            has_pending_ = false;
+        }
+        if (!snapshot.ApplyTo(model, data)) {
+            std::cerr << "ERROR: CameraCaptureService::Run: snapshot does not match the render world" << std::endl;
+            continue;
+        }
+
+        const auto render_start = Clock::now();
+        frame = frame_pool_.Acquire(image_.width, image_.height, image_.format);
+        sensor_->Capture(*frame);
+        const bool captured = !frame->data.empty();
+        if (captured && on_frame_) {
+            on_frame_(frame);
+        }
+        const auto done = Clock::now();
+        if (!captured) {
+            frame.Reset();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        render_sum_sec_ += std::chrono::duration<double>(done - render_start).count();
+        if (!captured) {
+            ++stats_.empty;
+            continue;
+        }
+        const double latency_sec = std::chrono::duration<double>(done - requested_at).count();
+        ++stats_.captured;
+        stats_.last_latency_sec = latency_sec;
+        stats_.max_latency_sec = std::max(stats_.max_latency_sec, latency_sec);
+        latency_sum_sec_ += latency_sec;
+        // A frame that was not taken goes back to the pool.
+        latest_ = std::move(frame);
+        has_latest_ = true;
+    }
+    renderer_->ReleaseContext();
+}
+}
@@ -95,6 +95,22 @@ bool RequireNumberField(const json& root, const char* key, const std::string& pa
     return true;
 }
 
+bool RequireBoolField(const json& root, const char* key, const std::string& path, bool& out)
+{
+    if (!root.contains(key)) {
+        std::cerr << "Failed to load camera config JSON: missing field '" << key
+                  << "' in '" << path << "'" << std::endl;
+        return false;
+    }
+    if (!root.at(key).is_boolean()) {
+        std::cerr << "Failed to load camera config JSON: field '" << key
+                  << "' must be a boolean in '" << path << "'" << std::endl;
+        return false;
+    }
+    out = root.at(key).get<bool>();
+    return true;
+}
+
 bool RequireUpdateRateHzField(const json& root, const std::string& path, double& out)
 {
     if (root.contains("update_rate_hz")) {
@@ -137,6 +153,26 @@ void LoadNoiseConfigIfPresent(const json& root, CameraNoiseConfig& out)
     }
 }
 
+bool LoadReadbackConfigIfPresent(const json& root, const std::string& path, CameraReadbackConfig& out)
+{
+    if (!root.contains("readback")) {
+        return true;
+    }
+    if (!root.at("readback").is_object()) {
+        std::cerr << "Failed to load camera config JSON: field 'readback' must be an object in '"
+                  << path << "'" << std::endl;
+        return false;
+    }
+    const auto& readback = root.at("readback");
+    if (readback.contains("mode") && !RequireStringField(readback, "mode", path + ":readback", out.mode)) {
+        return false;
+    }
+    if (readback.contains("buffers") && !RequireIntField(readback, "buffers", path + ":readback", out.buffers)) {
+        return false;
+    }
+    return true;
+}
+
 bool ParseCameraConfigJson(const json& root, const std::string& path, CameraConfig& out)
 {
     const json* spec = &root;
@@ -188,6 +224,9 @@ bool ParseCameraConfigJson(const json& root, const std::string& path, CameraConf
     }
 
     LoadNoiseConfigIfPresent(*spec, config.noise);
+    if (!LoadReadbackConfigIfPresent(*spec, spec_path, config.readback)) {
+        return false;
+    }
     out = config;
     return true;
 }
@@ -210,12 +249,41 @@ void LoadCameraMjcfBindingIfPresent(const json& root, CameraMjcfBinding& out)
     }
 }
 
-void LoadCameraPduConfigIfPresent(const json& root, CameraPduConfig& out)
+bool LoadCameraPduConfigIfPresent(const json& root, const std::string& path, CameraPduConfig& out)
 {
     hako::robots::config::ReadPduConfig(
         root,
         out.pdu_name,
-        out.update_rate_hz);
+        out.update_rate_hz,
+        &out.message_type);
+    if (!out.message_type.empty() &&
+        out.message_type != "sensor_msgs/Image" &&
+        !IsCompressedImagePdu(out))
+    {
+        std::cerr << "Failed to load camera config JSON: unsupported pdu_config.message_type '"
+                  << out.message_type << "' in '" << path << "'" << std::endl;
+        return false;
+    }
+    const json* pdu_config = hako::robots::config::FindObject(root, "pdu_config");
+    if (pdu_config == nullptr || !pdu_config->contains("compression")) {
+        return true;
+    }
+    const std::string compression_path = path + ":pdu_config";
+    json compression;
+    if (!RequireObjectField(*pdu_config, "compression", compression_path, compression)) {
+        return false;
+    }
+    if (compression.contains("codec") &&
+        !RequireStringField(compression, "codec", compression_path + ":compression", out.compression.codec))
+    {
+        return false;
+    }
+    if (compression.contains("jpeg_quality") &&
+        !RequireIntField(compression, "jpeg_quality", compression_path + ":compression", out.compression.jpeg_quality))
+    {
+        return false;
+    }
+    return ValidateImageCompressionConfig(out.compression);
 }
 
 bool ParseDepthCameraConfigJson(const json& root, const std::string& path, DepthCameraConfig& out)
@@ -272,6 +340,63 @@ bool ParseDepthCameraConfigJson(const json& root, const std::string& path, Depth
     out = config;
     return true;
 }
+
+bool ParseSegmentationCameraConfigJson(const json& root, const std::string& path, SegmentationCameraConfig& out)
+{
+    const json* spec = &root;
+    std::string spec_path = path;
+    if (root.contains("spec")) {
+        if (!root.at("spec").is_object()) {
+            std::cerr << "Failed to load segmentation camera config JSON: field 'spec' must be an object in '"
+                      << path << "'" << std::endl;
+            return false;
+        }
+        spec = &root.at("spec");
+        spec_path = path + ":spec";
+    }
+
+    SegmentationCameraConfig config {};
+    if (!RequireStringField(*spec, "frame_id", spec_path, config.frame_id)) {
+        return false;
+    }
+    if (!RequireUpdateRateHzField(*spec, spec_path, config.update_rate_hz)) {
+        return false;
+    }
+    if (!RequireNumberField(*spec, "horizontal_fov", spec_path, config.horizontal_fov)) {
+        return false;
+    }
+    if (spec->contains("label") && !RequireStringField(*spec, "label", spec_path, config.label)) {
+        return false;
+    }
+
+    json image;
+    if (!RequireObjectField(*spec, "image", spec_path, image)) {
+        return false;
+    }
+    if (!RequireIntField(image, "width", spec_path + ":image", config.image.width)) {
+        return false;
+    }
+    if (!RequireIntField(image, "height", spec_path + ":image", config.image.height)) {
+        return false;
+    }
+    if (!RequireStringField(image, "format", spec_path + ":image", config.image.format)) {
+        return false;
+    }
+
+    json clip;
+    if (!RequireObjectField(*spec, "clip", spec_path, clip)) {
+        return false;
+    }
+    if (!RequireNumberField(clip, "near", spec_path + ":clip", config.clip.near)) {
+        return false;
+    }
+    if (!RequireNumberField(clip, "far", spec_path + ":clip", config.clip.far)) {
+        return false;
+    }
+
+    out = config;
+    return true;
+}
 }
 
 bool LoadCameraConfigFromJson(const std::string& path, CameraConfig& out)
@@ -295,7 +420,9 @@ bool LoadCameraProfileConfigFromJson(const std::string& path, CameraProfileConfi
         return false;
     }
     LoadCameraMjcfBindingIfPresent(root, config.mjcf_binding);
-    LoadCameraPduConfigIfPresent(root, config.pdu_config);
+    if (!LoadCameraPduConfigIfPresent(root, path, config.pdu_config)) {
+        return false;
+    }
     out = config;
     return true;
 }
@@ -309,6 +436,15 @@ bool LoadDepthCameraConfigFromJson(const std::string& path, DepthCameraConfig& o
     return ParseDepthCameraConfigJson(root, path, out);
 }
 
+bool LoadSegmentationCameraConfigFromJson(const std::string& path, SegmentationCameraConfig& out)
+{
+    json root;
+    if (!LoadRootJson(path, root)) {
+        return false;
+    }
+    return ParseSegmentationCameraConfigJson(root, path, out);
+}
+
 bool LoadRgbdCameraConfigFromJson(const std::string& path, RgbdCameraConfig& out)
 {
     json root;
@@ -375,6 +511,11 @@ bool LoadStereoCameraConfigFromJson(const std::string& path, StereoCameraConfig&
     }
 
     StereoCameraConfig config {};
+    if (config_root->contains("disparity") &&
+        !RequireBoolField(*config_root, "disparity", path, config.disparity))
+    {
+        return false;
+    }
     for (size_t i = 0; i < 2; ++i) {
         if (!cameras.at(i).is_object()) {
             std::cerr << "Failed to load camera config JSON: cameras[" << i
@@ -1,75 +1,95 @@
 #include "sensors/camera/camera_encoding_utils.hpp"
+#include "sensors/camera/depth_kernels.hpp"
+#include "sensors/camera/image_kernels.hpp"
 #include "sensors/camera/mujoco_camera_renderer.hpp"
+#include <cmath>
 #include <vector>
 #include <string>
 #include <cstddef> // for size_t
-#include <cmath> // for isnan, NAN
-#include <limits> // for std::numeric_limits
+#include <cstring> // for memcpy
 
 namespace hako::robots::sensor::camera
 {
 
-bool EncodeImage(const RawCameraFrame& raw, const CameraConfig& config, ImageFrame& out)
+bool EncodeImageRows(
+    const uint8_t* rgb,
+    int width,
+    int height,
+    bool bottom_up,
+    double timestamp,
+    const CameraConfig& config,
+    ImageFrame& out)
 {
-    out.width = raw.width;
-    out.height = raw.height;
+    out.width = width;
+    out.height = height;
     out.format = config.image.format;
     out.frame_id = config.frame_id;
-    out.timestamp = raw.timestamp;
+    out.timestamp = timestamp;
 
-    if (config.image.format == "R8G8B8") {
-        out.channels = 3;
-        out.data = raw.rgb;
-        return true;
+    PixelFormat format;
+    if (!ParsePixelFormat(config.image.format, format) || !IsValidPixelFormatWidth(format, width)) {
+        return false; // Unsupported format
     }
-    if (config.image.format == "B8G8R8") {
-        out.channels = 3;
-        out.data.resize(raw.rgb.size());
-        for (size_t i = 0; i < raw.rgb.size(); i += 3) {
-            out.data[i + 0] = raw.rgb[i + 2]; // B
-            out.data[i + 1] = raw.rgb[i + 1]; // G
-            out.data[i + 2] = raw.rgb[i + 0]; // R
+    const int channels = PixelFormatBytesPerPixel(format);
+    out.channels = channels;
+
+    const size_t src_row_size = static_cast<size_t>(width) * 3;
+    const size_t dst_row_size = static_cast<size_t>(width) * static_cast<size_t>(channels);
+    out.data.resize(dst_row_size * static_cast<size_t>(height));
+
+    if (format == PixelFormat::Rgb8) {
+        if (bottom_up) {
+            FlipRows(rgb, src_row_size, src_row_size, height, out.data.data());
+        } else if (!out.data.empty()) {
+            std::memcpy(out.data.data(), rgb, dst_row_size * static_cast<size_t>(height));
         }
         return true;
     }
-    if (config.image.format == "L8") {
-        out.channels = 1;
-        out.data.resize(raw.width * raw.height);
-        for (int i = 0; i < raw.width * raw.height; ++i) {
-            const uint8_t r = raw.rgb[i * 3 + 0];
-            const uint8_t g = raw.rgb[i * 3 + 1];
-            const uint8_t b = raw.rgb[i * 3 + 2];
-            out.data[i] = static_cast<uint8_t>(0.299 * r + 0.587 * g + 0.114 * b);
-        }
-        return true;
+    for (int y = 0; y < height; ++y) {
+        const int src_y = bottom_up ? (height - 1 - y) : y;
+        ConvertRgbRow(
+            rgb + static_cast<size_t>(src_y) * src_row_size,
+            width,
+            format,
+            out.data.data() + static_cast<size_t>(y) * dst_row_size);
     }
-    return false; // Unsupported format
+    return true;
 }
 
-namespace {
-    /*
-     * Converts `mjr_readPixels` depth samples to metric distances for the current
-     * offscreen MuJoCo render path.
-     *
-     * Contract:
-     * - `buffer` is treated as an OpenGL-style depth buffer in the [0, 1] range.
-     * - `znear` / `zfar` are the effective clip-plane distances in meters used by the OpenGL projection.
-     *
-     * Validation status:
-     * - This conversion has been smoke-tested against fixed-camera box scenes at 0.2/0.5/1/2/5/9 m.
-     * - Center and several off-center pixels were checked, along with multiple horizontal FOV settings
-     *   and clip-range masking behavior.
-     *
-     * Caveat:
-     * - It is still not fully validated for arbitrary scenes such as oblique geometry, extreme camera setups,
-     *   or alternate depth-map conventions.
-     */
-    void LinearizeDepthBuffer(std::vector<float>& buffer, double znear, double zfar) {
-        for (size_t i = 0; i < buffer.size(); ++i) {
-            const double z_ndc = 2.0 * static_cast<double>(buffer[i]) - 1.0;
-            buffer[i] = static_cast<float>((2.0 * znear * zfar) / (zfar + znear - z_ndc * (zfar - znear)));
-        }
+bool EncodeImage(const RawCameraFrame& raw, const CameraConfig& config, ImageFrame& out)
+{
+    return EncodeImageRows(raw.rgb.data(), raw.width, raw.height, false, raw.timestamp, config, out);
+}
+
+/*
+ * Converts `mjr_readPixels` depth samples to metric distances for the current
+ * offscreen MuJoCo render path.
+ *
+ * Contract:
+ * - Samples are OpenGL-style window depth values in the [0, 1] range,
+ *   0 at the near plane (mjDEPTH_ZERONEAR) or at the far plane (mjDEPTH_ZEROFAR).
+ * - `znear` / `zfar` are the effective clip-plane distances in meters used by the OpenGL projection.
+ *
+ * Validation status:
+ * - This conversion has been smoke-tested against fixed-camera box scenes at 0.2/0.5/1/2/5/9 m.
+ * - Center and several off-center pixels were checked, along with multiple horizontal FOV settings
+ *   and clip-range masking behavior.
+ *
+ * Caveat:
+ * - It is still not fully validated for arbitrary scenes such as oblique geometry or extreme camera setups.
+ *   The reversed (mjDEPTH_ZEROFAR) mapping is covered by unit tests only.
+ */
+bool MakeDepthKernelParams(const RawCameraFrame& raw, const ClipConfig& clip, DepthKernelParams& params)
+{
+    if (raw.depth_map != mjDEPTH_ZERONEAR && raw.depth_map != mjDEPTH_ZEROFAR) {
+        return false;
     }
+    params.znear = static_cast<float>(raw.znear);
+    params.zfar = static_cast<float>(raw.zfar);
+    params.clip_near = static_cast<float>(clip.near);
+    params.clip_far = static_cast<float>(clip.far);
+    params.reversed = raw.depth_map == mjDEPTH_ZEROFAR;
+    return true;
 }
 
 bool EncodeDepth(const RawCameraFrame& raw, const DepthCameraConfig& config, DepthFrame& out)
@@ -84,24 +104,61 @@ bool EncodeDepth(const RawCameraFrame& raw, const DepthCameraConfig& config, Dep
         return false;
     }
 
-    out.data = raw.depth_buffer;
-    // `mjr_readPixels` depth samples are treated as OpenGL depth-buffer values.
-    // Reversed depth maps are not handled here yet.
-    if (raw.depth_map != mjDEPTH_ZERONEAR) {
+    DepthKernelParams params;
+    if (!MakeDepthKernelParams(raw, config.clip, params)) {
         return false;
     }
-    LinearizeDepthBuffer(out.data, raw.znear, raw.zfar);
+    // One pass from the readback buffer into out.data (resized in place):
+    // linearize, then NaN outside the sensor's clip range.
+    out.data.resize(raw.depth_buffer.size());
+    LinearizeDepthMeters(raw.depth_buffer.data(), raw.depth_buffer.size(), params, out.data.data());
 
-    // Apply the sensor's specific clipping planes
-    const float nan_val = std::numeric_limits<float>::quiet_NaN();
-    for (size_t i = 0; i < out.data.size(); ++i) {
-        if (out.data[i] < config.clip.near || out.data[i] > config.clip.far) {
-            out.data[i] = nan_val;
-        }
+    // If the requested format is DEPTH_U16_MM, this layer still returns float meters.
+    // Conversion to uint16 millimeters belongs to downstream PDU serialization
+    // (or EncodeDepthMillimeters() for callers that want it directly).
+    return true;
+}
+
+bool EncodeDepthMillimeters(const RawCameraFrame& raw, const DepthCameraConfig& config, std::uint16_t* out)
+{
+    DepthKernelParams params;
+    if (!MakeDepthKernelParams(raw, config.clip, params)) {
+        return false;
     }
+    LinearizeDepthMillimeters(raw.depth_buffer.data(), raw.depth_buffer.size(), params, out);
+    return true;
+}
 
-    // If the requested format is DEPTH_U16_MM, this layer still returns float meters.
-    // Conversion to uint16 millimeters belongs to downstream PDU serialization.
+bool EncodeDisparity(const RawCameraFrame& raw, const StereoCameraConfig& config, DisparityFrame& out)
+{
+    const CameraConfig& left = config.left;
+    out.width = raw.width;
+    out.height = raw.height;
+    out.format = "DISPARITY_F32_PX";
+    out.frame_id = left.frame_id;
+    out.timestamp = raw.timestamp;
+    out.focal_length_px = 0.5 * static_cast<double>(raw.width) / std::tan(0.5 * left.horizontal_fov);
+    out.baseline = config.baseline;
+    out.min_disparity = out.focal_length_px * config.baseline / left.clip.far;
+    out.max_disparity = out.focal_length_px * config.baseline / left.clip.near;
+
+    DepthKernelParams params;
+    if (raw.width <= 0 || raw.height <= 0 || !MakeDepthKernelParams(raw, left.clip, params)) {
+        return false;
+    }
+    const std::size_t count = raw.depth_buffer.size();
+    if (count != static_cast<std::size_t>(raw.width) * static_cast<std::size_t>(raw.height)) {
+        return false;
+    }
+    // Linearize into out.data, then a branch-free divide in place; clipped
+    // samples are NaN and stay NaN.
+    out.data.resize(count);
+    float* disparity = out.data.data();
+    LinearizeDepthMeters(raw.depth_buffer.data(), count, params, disparity);
+    const float numerator = static_cast<float>(out.focal_length_px * config.baseline);
+    for (std::size_t i = 0; i < count; ++i) {
+        disparity[i] = numerator / disparity[i];
+    }
     return true;
 }
 
@@ -126,4 +183,18 @@ void ClearDepthFrame(DepthFrame& out)
     out.timestamp = 0.0;
 }
 
+void ClearDisparityFrame(DisparityFrame& out)
+{
+    out.width = 0;
+    out.height = 0;
+    out.format.clear();
+    out.frame_id.clear();
+    out.data.clear();
+    out.focal_length_px = 0.0;
+    out.baseline = 0.0;
+    out.min_disparity = 0.0;
+    out.max_disparity = 0.0;
+    out.timestamp = 0.0;
+}
+
 }
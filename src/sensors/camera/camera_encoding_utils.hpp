@@ -6,9 +6,31 @@ namespace hako::robots::sensor::camera
 {
     // Forward declaration from mujoco_camera_renderer.hpp
     struct RawCameraFrame;
+    struct DepthKernelParams;
 
     bool EncodeImage(const RawCameraFrame& raw, const CameraConfig& config, ImageFrame& out);
+    // Convert packed RGB rows into config.image.format in one pass. With
+    // bottom_up set the rows are flipped on the way (OpenGL readback order).
+    // out.data is resized in place, so a reused frame does not reallocate.
+    bool EncodeImageRows(
+        const uint8_t* rgb,
+        int width,
+        int height,
+        bool bottom_up,
+        double timestamp,
+        const CameraConfig& config,
+        ImageFrame& out);
     bool EncodeDepth(const RawCameraFrame& raw, const DepthCameraConfig& config, DepthFrame& out);
+    // Depth straight to DEPTH_U16_MM: out needs raw.depth_buffer.size()
+    // entries; clipped or out-of-range samples become 0.
+    bool EncodeDepthMillimeters(const RawCameraFrame& raw, const DepthCameraConfig& config, std::uint16_t* out);
+    // Kernel parameters for raw's depth map and clip planes and the sensor
+    // clip range. False for an unknown depth map convention.
+    bool MakeDepthKernelParams(const RawCameraFrame& raw, const ClipConfig& clip, DepthKernelParams& params);
+    // Disparity from the left eye's depth buffer (raw), with the left eye's
+    // field of view and clip range and the stereo baseline.
+    bool EncodeDisparity(const RawCameraFrame& raw, const StereoCameraConfig& config, DisparityFrame& out);
     void ClearImageFrame(ImageFrame& out);
     void ClearDepthFrame(DepthFrame& out);
+    void ClearDisparityFrame(DisparityFrame& out);
 }
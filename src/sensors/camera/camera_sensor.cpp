@@ -20,6 +20,7 @@ CameraSensor::CameraSensor(std::shared_ptr<MujocoCameraRenderer> renderer, const
     if (!renderer) {
         throw std::invalid_argument("Renderer is null");
     }
+    camera_ = renderer_->FindCamera(camera_name_);
 }
 
 CameraSensor::~CameraSensor()
@@ -58,13 +59,22 @@ bool CameraSensor::LoadConfig(const CameraConfig& config)
                   << ", far=" << config.clip.far << std::endl;
         return false;
     }
-    if (config.image.format != "R8G8B8" &&
-        config.image.format != "B8G8R8" &&
-        config.image.format != "L8")
+    PixelFormat pixel_format;
+    if (!ParsePixelFormat(config.image.format, pixel_format) ||
+        !IsValidPixelFormatWidth(pixel_format, config.image.width))
     {
         std::cerr << "Invalid camera image format: " << config.image.format << std::endl;
         return false;
     }
+    if (config.readback.mode != "sync" && config.readback.mode != "pbo") {
+        std::cerr << "Invalid camera readback mode: " << config.readback.mode << std::endl;
+        return false;
+    }
+    if (config.readback.mode == "pbo" && (config.readback.buffers < 2 || config.readback.buffers > 3)) {
+        std::cerr << "Invalid camera readback buffers: " << config.readback.buffers
+                  << " (pbo readback uses 2 or 3)" << std::endl;
+        return false;
+    }
 
     config_ = config;
     StartScheduler(config_.update_rate_hz);
@@ -78,27 +88,83 @@ const CameraConfig& CameraSensor::GetConfig() const
 
 void CameraSensor::Capture(ImageFrame& out)
 {
-    RawCameraFrame raw;
-    bool success = renderer_->Render(
-        camera_name_,
-        config_.image.width,
-        config_.image.height,
-        config_.horizontal_fov,
-        config_.clip.near,
-        config_.clip.far,
-        true,   // need_rgb
-        false,  // need_depth
-        raw
-    );
+    // The renderer keeps the readback buffer; the vertical flip and the
+    // format conversion are done in one pass straight into out.data.
+    const uint8_t* bottom_up_rgb = nullptr;
+    double timestamp = 0.0;
+    bool success = false;
+    if (config_.readback.mode == "pbo") {
+        // The returned frame is an earlier render; timestamp is its own
+        // data->time, not the current one.
+        success = renderer_->RenderRgbPipelined(
+            camera_,
+            config_.image.width,
+            config_.image.height,
+            config_.horizontal_fov,
+            config_.clip.near,
+            config_.clip.far,
+            config_.readback.buffers,
+            bottom_up_rgb,
+            timestamp
+        );
+    } else {
+        success = renderer_->RenderRgbBottomUp(
+            camera_,
+            config_.image.width,
+            config_.image.height,
+            config_.horizontal_fov,
+            config_.clip.near,
+            config_.clip.far,
+            bottom_up_rgb,
+            timestamp
+        );
+    }
 
-    if (!success) {
+    if (!success || bottom_up_rgb == nullptr) {
+        // bottom_up_rgb stays null while a pbo pipeline is still filling.
         ClearImageFrame(out);
         return;
     }
 
     // TODO: apply noise from config_.noise after the image noise contract is finalized.
 
-    if (!EncodeImage(raw, config_, out)) {
+    if (!EncodeImageRows(
+            bottom_up_rgb,
+            config_.image.width,
+            config_.image.height,
+            true,
+            timestamp,
+            config_,
+            out))
+    {
+        std::cerr << "Unsupported camera image format: " << config_.image.format << std::endl;
+        ClearImageFrame(out);
+    }
+}
+
+std::size_t CameraSensor::AppendViews(std::vector<CameraView>& views) const
+{
+    CameraView view;
+    view.camera = camera_;
+    view.camera_name = camera_name_;
+    view.width = config_.image.width;
+    view.height = config_.image.height;
+    view.hfov_rad = config_.horizontal_fov;
+    view.clip_near_m = config_.clip.near;
+    view.clip_far_m = config_.clip.far;
+    view.need_rgb = true;
+    view.need_depth = false;
+    views.push_back(view);
+    return 1;
+}
+
+void CameraSensor::FinishTiles(const RawCameraFrame* views, ImageFrame& out) const
+{
+    if (views == nullptr) {
+        ClearImageFrame(out);
+        return;
+    }
+    if (!EncodeImage(views[0], config_, out)) {
         std::cerr << "Unsupported camera image format: " << config_.image.format << std::endl;
         ClearImageFrame(out);
     }
@@ -0,0 +1,86 @@
+#include "sensors/camera/camera_tile_layout.hpp"
+
+#include <numeric>
+
+namespace hako::robots::sensor::camera
+{
+bool LayoutCameraTiles(int atlas_width, int atlas_height, std::vector<CameraTile>& tiles)
+{
+    std::vector<std::size_t> order(tiles.size());
+    std::iota(order.begin(), order.end(), std::size_t {0});
+    std::stable_sort(order.begin(), order.end(), [&tiles](std::size_t a, std::size_t b) {
+        return tiles[a].height > tiles[b].height;
+    });
+
+    int atlas = 0;
+    int cursor_x = 0;
+    int shelf_y = 0;
+    int shelf_height = 0;
+    for (std::size_t index : order) {
+        CameraTile& tile = tiles[index];
+        if (tile.width <= 0 || tile.height <= 0 || tile.width > atlas_width || tile.height > atlas_height) {
+            return false;
+        }
+        if (cursor_x + tile.width > atlas_width) {
+            shelf_y += shelf_height;
+            cursor_x = 0;
+            shelf_height = 0;
+        }
+        if (shelf_y + tile.height > atlas_height) {
+            ++atlas;
+            cursor_x = 0;
+            shelf_y = 0;
+            shelf_height = 0;
+        }
+        tile.x = cursor_x;
+        tile.y = shelf_y;
+        tile.atlas = atlas;
+        cursor_x += tile.width;
+        shelf_height = std::max(shelf_height, tile.height);
+    }
+    return true;
+}
+
+int CountCameraTileAtlases(const std::vector<CameraTile>& tiles)
+{
+    int count = 0;
+    for (const auto& tile : tiles) {
+        count = std::max(count, tile.atlas + 1);
+    }
+    return count;
+}
+
+void GetCameraTileAtlasExtent(const std::vector<CameraTile>& tiles, int atlas, int& width, int& height)
+{
+    width = 0;
+    height = 0;
+    for (const auto& tile : tiles) {
+        if (tile.atlas != atlas) {
+            continue;
+        }
+        width = std::max(width, tile.x + tile.width);
+        height = std::max(height, tile.y + tile.height);
+    }
+}
+
+void DecodeSegmentationTile(
+    const std::uint8_t* atlas_rgb, int atlas_width, const CameraTile& tile,
+    const std::vector<int>& segid_to_label, std::int32_t* top_down)
+{
+    const std::size_t atlas_row = static_cast<std::size_t>(atlas_width) * 3;
+    const std::uint32_t table_size = static_cast<std::uint32_t>(segid_to_label.size());
+    for (int row = 0; row < tile.height; ++row) {
+        const std::size_t source_row = static_cast<std::size_t>(tile.y + tile.height - 1 - row);
+        const std::uint8_t* src = atlas_rgb + source_row * atlas_row + static_cast<std::size_t>(tile.x) * 3;
+        std::int32_t* dst = top_down + static_cast<std::size_t>(row) * static_cast<std::size_t>(tile.width);
+        for (int col = 0; col < tile.width; ++col, src += 3) {
+            const std::uint32_t id = static_cast<std::uint32_t>(src[0]) |
+                                     (static_cast<std::uint32_t>(src[1]) << 8) |
+                                     (static_cast<std::uint32_t>(src[2]) << 16);
+            // id - 1 wraps for the background and fails the range check.
+            const std::uint32_t segid = id - 1U;
+            dst[col] = segid < table_size ? segid_to_label[segid] : -1;
+        }
+    }
+}
+}
@@ -0,0 +1,45 @@
+#include "sensors/camera/camera_tile_pass.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace hako::robots::sensor::camera
+{
+CameraTilePass::CameraTilePass(std::shared_ptr<MujocoCameraRenderer> renderer)
+    : renderer_(std::move(renderer))
+{
+    if (!renderer_) {
+        throw std::invalid_argument("Renderer is null");
+    }
+}
+
+void CameraTilePass::Clear()
+{
+    // Frames keep their buffers so the next pass does not reallocate.
+    views_.clear();
+    offsets_.clear();
+    rendered_ = false;
+}
+
+int CameraTilePass::Add(const ITiledCameraSensor& sensor)
+{
+    offsets_.push_back(views_.size());
+    sensor.AppendViews(views_);
+    rendered_ = false;
+    return static_cast<int>(offsets_.size()) - 1;
+}
+
+bool CameraTilePass::Render()
+{
+    rendered_ = renderer_->RenderViews(views_, frames_);
+    return rendered_;
+}
+
+const RawCameraFrame* CameraTilePass::Views(int handle) const
+{
+    if (!rendered_ || handle < 0 || static_cast<std::size_t>(handle) >= offsets_.size()) {
+        return nullptr;
+    }
+    return frames_.data() + offsets_[static_cast<std::size_t>(handle)];
+}
+}
@@ -0,0 +1,720 @@
+#include "sensors/camera/deflate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+namespace hako::robots::sensor::camera
+{
+namespace
+{
+// ---------------------------------------------------------------------------
+// Checksums
+
+using Crc32Tables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+// tables[k][b] is the CRC of byte b followed by k zero bytes, so eight input
+// bytes are folded with eight independent lookups per step.
+Crc32Tables MakeCrc32Tables()
+{
+    Crc32Tables tables {};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1U) ? (0xedb88320U ^ (c >> 1U)) : (c >> 1U);
+        }
+        tables[0][i] = c;
+    }
+    for (std::size_t k = 1; k < 8; ++k) {
+        for (std::size_t i = 0; i < 256; ++i) {
+            const std::uint32_t previous = tables[k - 1][i];
+            tables[k][i] = (previous >> 8U) ^ tables[0][previous & 0xffU];
+        }
+    }
+    return tables;
+}
+
+inline std::uint32_t LoadLe32(const std::uint8_t* p)
+{
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8U) |
+           (static_cast<std::uint32_t>(p[2]) << 16U) | (static_cast<std::uint32_t>(p[3]) << 24U);
+}
+
+// ---------------------------------------------------------------------------
+// DEFLATE (RFC 1951)
+
+constexpr int kWindowSize = 32768;
+constexpr int kWindowMask = kWindowSize - 1;
+constexpr int kHashBits = 15;
+constexpr int kMinMatch = 3;
+constexpr int kMaxMatch = 258;
+constexpr int kLitLenCodes = 286;
+constexpr int kDistCodes = 30;
+constexpr int kCodeLengthCodes = 19;
+constexpr int kMaxCodeBits = 15;
+constexpr int kMaxCodeLengthBits = 7;
+// Symbols per block before its Huffman tables are rebuilt.
+constexpr std::size_t kBlockSymbols = 1U << 15U;
+constexpr std::size_t kStoredBlockMax = 65535;
+
+constexpr std::array<std::uint16_t, 29> kLengthBase {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<std::uint8_t, 29> kLengthExtra {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<std::uint16_t, 30> kDistBase {
+    1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+    193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<std::uint8_t, 30> kDistExtra {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+constexpr std::array<std::uint8_t, kCodeLengthCodes> kCodeLengthOrder {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// Length symbol index (0-28, i.e. code 257 + index) for match lengths 0-258.
+std::array<std::uint8_t, kMaxMatch + 1> MakeLengthCodes()
+{
+    std::array<std::uint8_t, kMaxMatch + 1> codes {};
+    for (int code = 0; code < 29; ++code) {
+        const int first = kLengthBase[static_cast<std::size_t>(code)];
+        const int count = code == 28 ? 1 : 1 << kLengthExtra[static_cast<std::size_t>(code)];
+        for (int length = first; length < first + count && length <= kMaxMatch; ++length) {
+            codes[static_cast<std::size_t>(length)] = static_cast<std::uint8_t>(code);
+        }
+    }
+    // 258 has its own code rather than being 227 + 31.
+    codes[kMaxMatch] = 28;
+    return codes;
+}
+
+inline int DistanceCode(int distance)
+{
+    if (distance <= 4) {
+        return distance - 1;
+    }
+    const auto x = static_cast<unsigned>(distance - 1);
+    const int high_bit = static_cast<int>(std::bit_width(x)) - 1;
+    return 2 * high_bit + static_cast<int>((x >> (high_bit - 1)) & 1U);
+}
+
+struct LevelParams
+{
+    // Search a quarter of the chain once a match this long is in hand.
+    int good_length;
+    // Lazy levels: skip the lazy search after a match this long.
+    // Greedy levels: only index the inside of matches up to this long.
+    int max_lazy;
+    // Stop searching at a match this long.
+    int nice_length;
+    int max_chain;
+    bool lazy;
+};
+
+// zlib's configuration table: greedy matching up to level 3, lazy above.
+constexpr std::array<LevelParams, 10> kLevels {{
+    {0, 0, 0, 0, false},
+    {4, 4, 8, 4, false},
+    {4, 5, 16, 8, false},
+    {4, 6, 32, 32, false},
+    {4, 4, 16, 16, true},
+    {8, 16, 32, 32, true},
+    {8, 16, 128, 128, true},
+    {8, 32, 128, 256, true},
+    {32, 128, kMaxMatch, 1024, true},
+    {32, kMaxMatch, kMaxMatch, 4096, true},
+}};
+
+struct Symbol
+{
+    std::uint16_t length_or_literal; // literal byte when distance is 0
+    std::uint16_t distance;
+};
+
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& out) : out_(out) {}
+
+    // Append the low `count` bits of value, least significant bit first.
+    void Put(std::uint32_t value, int count)
+    {
+        bits_ |= static_cast<std::uint64_t>(value) << count_;
+        count_ += count;
+        if (count_ >= 32) {
+            const auto word = static_cast<std::uint32_t>(bits_);
+            out_.insert(
+                out_.end(),
+                {static_cast<std::uint8_t>(word), static_cast<std::uint8_t>(word >> 8U),
+                 static_cast<std::uint8_t>(word >> 16U), static_cast<std::uint8_t>(word >> 24U)});
+            bits_ >>= 32U;
+            count_ -= 32;
+        }
+    }
+
+    void AlignToByte()
+    {
+        while (count_ > 0) {
+            out_.push_back(static_cast<std::uint8_t>(bits_));
+            bits_ >>= 8U;
+            count_ = count_ > 8 ? count_ - 8 : 0;
+        }
+        bits_ = 0;
+    }
+
+    std::vector<std::uint8_t>& Bytes() { return out_; }
+
+private:
+    std::vector<std::uint8_t>& out_;
+    std::uint64_t bits_ {0};
+    int count_ {0};
+};
+
+// Huffman code lengths no longer than `limit` for the non-zero frequencies.
+// At least two symbols must be used, so the resulting code is complete.
+void BuildCodeLengths(const std::uint32_t* freq, int symbols, int limit, std::uint8_t* lengths)
+{
+    std::fill(lengths, lengths + symbols, std::uint8_t {0});
+    std::vector<std::pair<std::uint32_t, int>> leaves;
+    for (int i = 0; i < symbols; ++i) {
+        if (freq[i] != 0) {
+            leaves.emplace_back(freq[i], i);
+        }
+    }
+    const std::size_t m = leaves.size();
+    std::sort(leaves.begin(), leaves.end());
+
+    // Two-queue Huffman construction over the sorted leaves; internal nodes
+    // are created in non-decreasing weight order.
+    std::vector<std::uint64_t> weight(2 * m - 1);
+    std::vector<std::size_t> parent(2 * m - 1, 0);
+    for (std::size_t i = 0; i < m; ++i) {
+        weight[i] = leaves[i].first;
+    }
+    std::size_t next_leaf = 0;
+    std::size_t next_internal = m;
+    for (std::size_t node = m; node < 2 * m - 1; ++node) {
+        std::size_t picked[2];
+        for (auto& pick : picked) {
+            if (next_leaf < m && (next_internal >= node || weight[next_leaf] <= weight[next_internal])) {
+                pick = next_leaf++;
+            } else {
+                pick = next_internal++;
+            }
+        }
+        weight[node] = weight[picked[0]] + weight[picked[1]];
+        parent[picked[0]] = node;
+        parent[picked[1]] = node;
+    }
+    std::vector<int> depth(2 * m - 1, 0);
+    std::vector<int> count_per_length(2 * m + 1, 0);
+    for (std::size_t i = 2 * m - 1; i-- > 0;) {
+        if (i != 2 * m - 2) {
+            depth[i] = depth[parent[i]] + 1;
+        }
+        if (i < m) {
+            ++count_per_length[static_cast<std::size_t>(depth[i])];
+        }
+    }
+
+    // Fold lengths beyond the limit back in and rebalance until the Kraft sum
+    // is exact again (the miniz approach); the rarest symbols stay longest.
+    std::vector<int> num_codes(static_cast<std::size_t>(limit) + 2, 0);
+    for (std::size_t length = 1; length < count_per_length.size(); ++length) {
+        num_codes[std::min<std::size_t>(length, static_cast<std::size_t>(limit))] += count_per_length[length];
+    }
+    std::uint32_t total = 0;
+    for (int length = limit; length > 0; --length) {
+        total += static_cast<std::uint32_t>(num_codes[static_cast<std::size_t>(length)]) << (limit - length);
+    }
+    while (total != (1U << limit)) {
+        --num_codes[static_cast<std::size_t>(limit)];
+        for (int length = limit - 1; length > 0; --length) {
+            if (num_codes[static_cast<std::size_t>(length)] != 0) {
+                --num_codes[static_cast<std::size_t>(length)];
+                num_codes[static_cast<std::size_t>(length) + 1] += 2;
+                break;
+            }
+        }
+        --total;
+    }
+
+    std::size_t leaf = 0;
+    for (int length = limit; length > 0; --length) {
+        for (int i = 0; i < num_codes[static_cast<std::size_t>(length)]; ++i) {
+            lengths[leaves[leaf++].second] = static_cast<std::uint8_t>(length);
+        }
+    }
+}
+
+// Canonical codes, bit-reversed for the LSB-first DEFLATE bit order.
+void BuildCodes(const std::uint8_t* lengths, int symbols, std::uint16_t* codes)
+{
+    int count[kMaxCodeBits + 1] {};
+    for (int i = 0; i < symbols; ++i) {
+        ++count[lengths[i]];
+    }
+    count[0] = 0;
+    int next[kMaxCodeBits + 2] {};
+    for (int bits = 1; bits <= kMaxCodeBits; ++bits) {
+        next[bits + 1] = (next[bits] + count[bits]) << 1;
+    }
+    for (int i = 0; i < symbols; ++i) {
+        const int length = lengths[i];
+        if (length == 0) {
+            codes[i] = 0;
+            continue;
+        }
+        const auto code = static_cast<unsigned>(next[length]++);
+        unsigned reversed = 0;
+        for (int bit = 0; bit < length; ++bit) {
+            reversed |= ((code >> bit) & 1U) << (length - 1 - bit);
+        }
+        codes[i] = static_cast<std::uint16_t>(reversed);
+    }
+}
+
+// Make sure a code has at least two symbols so every Huffman code is
+// complete (some inflaters reject a single-symbol code).
+void EnsureTwoSymbols(std::uint32_t* freq, int symbols)
+{
+    int used = 0;
+    for (int i = 0; i < symbols && used < 2; ++i) {
+        used += freq[i] != 0 ? 1 : 0;
+    }
+    for (int i = 0; i < symbols && used < 2; ++i) {
+        if (freq[i] == 0) {
+            freq[i] = 1;
+            ++used;
+        }
+    }
+}
+
+class Deflater
+{
+public:
+    Deflater(const std::uint8_t* data, std::size_t size, int level, BitWriter& writer)
+        : data_(data), size_(size), params_(kLevels[static_cast<std::size_t>(level)]), writer_(writer)
+    {
+    }
+
+    void Run()
+    {
+        if (params_.max_chain == 0) {
+            WriteStored(data_, size_, true);
+            return;
+        }
+        head_.assign(std::size_t {1} << kHashBits, -1);
+        prev_.assign(kWindowSize, -1);
+        symbols_.reserve(kBlockSymbols);
+        if (params_.lazy) {
+            CompressLazy();
+        } else {
+            CompressGreedy();
+        }
+        FlushBlock(true);
+    }
+
+private:
+    static const std::array<std::uint8_t, kMaxMatch + 1>& LengthCodes()
+    {
+        static const std::array<std::uint8_t, kMaxMatch + 1> codes = MakeLengthCodes();
+        return codes;
+    }
+
+    std::size_t Hash(std::size_t pos) const
+    {
+        const std::uint32_t v = static_cast<std::uint32_t>(data_[pos]) |
+                                (static_cast<std::uint32_t>(data_[pos + 1]) << 8U) |
+                                (static_cast<std::uint32_t>(data_[pos + 2]) << 16U);
+        return static_cast<std::size_t>((v * 2654435761U) >> (32 - kHashBits));
+    }
+
+    // Insert pos into the hash chains and return the previous chain head.
+    std::int64_t Insert(std::size_t pos)
+    {
+        const std::size_t h = Hash(pos);
+        const std::int64_t candidate = head_[h];
+        prev_[pos & kWindowMask] = candidate;
+        head_[h] = static_cast<std::int64_t>(pos);
+        return candidate;
+    }
+
+    static int MatchLength(const std::uint8_t* a, const std::uint8_t* b, int max_length)
+    {
+        int length = 0;
+        while (length + 8 <= max_length) {
+            std::uint64_t x;
+            std::uint64_t y;
+            std::memcpy(&x, a + length, 8);
+            std::memcpy(&y, b + length, 8);
+            const std::uint64_t diff = x ^ y;
+            if (diff != 0) {
+                if constexpr (std::endian::native == std::endian::little) {
+                    return length + (std::countr_zero(diff) >> 3);
+                } else {
+                    return length + (std::countl_zero(diff) >> 3);
+                }
+            }
+            length += 8;
+        }
+        while (length < max_length && a[length] == b[length]) {
+            ++length;
+        }
+        return length;
+    }
+
+    // Longest match for pos that is longer than `shorter_than_this`, or 0.
+    int LongestMatch(std::size_t pos, std::int64_t candidate, int shorter_than_this, int& distance) const
+    {
+        const int max_length = static_cast<int>(std::min<std::size_t>(kMaxMatch, size_ - pos));
+        int best = shorter_than_this;
+        if (best >= max_length) {
+            return 0;
+        }
+        const std::uint8_t* current = data_ + pos;
+        const auto oldest = static_cast<std::int64_t>(pos) - kWindowSize;
+        int chain = shorter_than_this >= params_.good_length ? params_.max_chain >> 2 : params_.max_chain;
+        int found = 0;
+        while (candidate >= 0 && candidate > oldest && chain-- > 0) {
+            const std::uint8_t* match = data_ + candidate;
+            if (match[best] == current[best] && match[0] == current[0] && match[1] == current[1]) {
+                const int length = MatchLength(match, current, max_length);
+                if (length > best) {
+                    best = length;
+                    found = length;
+                    distance = static_cast<int>(static_cast<std::int64_t>(pos) - candidate);
+                    if (length >= params_.nice_length || length >= max_length) {
+                        break;
+                    }
+                }
+            }
+            candidate = prev_[static_cast<std::size_t>(candidate) & kWindowMask];
+        }
+        return found >= kMinMatch ? found : 0;
+    }
+
+    void InsertRange(std::size_t begin, std::size_t end)
+    {
+        for (std::size_t q = begin; q < end && q + kMinMatch <= size_; ++q) {
+            Insert(q);
+        }
+    }
+
+    void EmitLiteral(std::uint8_t literal)
+    {
+        symbols_.push_back({literal, 0});
+        ++lit_freq_[literal];
+        ++block_bytes_;
+        if (symbols_.size() >= kBlockSymbols) {
+            FlushBlock(false);
+        }
+    }
+
+    void EmitMatch(int length, int distance)
+    {
+        symbols_.push_back({static_cast<std::uint16_t>(length), static_cast<std::uint16_t>(distance)});
+        ++lit_freq_[257 + LengthCodes()[static_cast<std::size_t>(length)]];
+        ++dist_freq_[DistanceCode(distance)];
+        block_bytes_ += static_cast<std::size_t>(length);
+        if (symbols_.size() >= kBlockSymbols) {
+            FlushBlock(false);
+        }
+    }
+
+    void CompressGreedy()
+    {
+        std::size_t pos = 0;
+        while (pos < size_) {
+            int length = 0;
+            int distance = 0;
+            if (pos + kMinMatch <= size_) {
+                const std::int64_t candidate = Insert(pos);
+                length = LongestMatch(pos, candidate, kMinMatch - 1, distance);
+            }
+            if (length >= kMinMatch) {
+                EmitMatch(length, distance);
+                if (length <= params_.max_lazy) {
+                    InsertRange(pos + 1, pos + static_cast<std::size_t>(length));
+                }
+                pos += static_cast<std::size_t>(length);
+            } else {
+                EmitLiteral(data_[pos]);
+                ++pos;
+            }
+        }
+    }
+
+    // zlib-style lazy evaluation: a match found at pos - 1 is only taken if
+    // the match starting at pos is not longer.
+    void CompressLazy()
+    {
+        std::size_t pos = 0;
+        int previous_length = 0;
+        int previous_distance = 0;
+        bool pending = false;
+        while (pos < size_) {
+            int length = 0;
+            int distance = 0;
+            if (pos + kMinMatch <= size_) {
+                const std::int64_t candidate = Insert(pos);
+                if (previous_length < params_.max_lazy) {
+                    length = LongestMatch(
+                        pos, candidate, std::max(previous_length, kMinMatch - 1), distance);
+                }
+            }
+            if (previous_length >= kMinMatch && length <= previous_length) {
+                EmitMatch(previous_length, previous_distance);
+                const std::size_t match_end = pos - 1 + static_cast<std::size_t>(previous_length);
+                InsertRange(pos + 1, match_end);
+                pos = match_end;
+                previous_length = 0;
+                pending = false;
+                continue;
+            }
+            if (pending) {
+                EmitLiteral(data_[pos - 1]);
+            }
+            pending = true;
+            previous_length = length;
+            previous_distance = distance;
+            ++pos;
+        }
+        if (pending) {
+            EmitLiteral(data_[pos - 1]);
+        }
+    }
+
+    void WriteStored(const std::uint8_t* data, std::size_t size, bool final_block)
+    {
+        std::size_t offset = 0;
+        do {
+            const std::size_t chunk = std::min(kStoredBlockMax, size - offset);
+            const bool last = final_block && offset + chunk == size;
+            writer_.Put(last ? 1U : 0U, 3);
+            writer_.AlignToByte();
+            const auto len = static_cast<std::uint16_t>(chunk);
+            const auto nlen = static_cast<std::uint16_t>(~len);
+            auto& bytes = writer_.Bytes();
+            bytes.insert(
+                bytes.end(),
+                {static_cast<std::uint8_t>(len), static_cast<std::uint8_t>(len >> 8U),
+                 static_cast<std::uint8_t>(nlen), static_cast<std::uint8_t>(nlen >> 8U)});
+            bytes.insert(bytes.end(), data + offset, data + offset + chunk);
+            offset += chunk;
+        } while (offset < size);
+    }
+
+    void FlushBlock(bool final_block)
+    {
+        lit_freq_[256] = 1; // end of block
+        EnsureTwoSymbols(lit_freq_.data(), kLitLenCodes);
+        EnsureTwoSymbols(dist_freq_.data(), kDistCodes);
+
+        std::array<std::uint8_t, kLitLenCodes> lit_lengths {};
+        std::array<std::uint8_t, kDistCodes> dist_lengths {};
+        BuildCodeLengths(lit_freq_.data(), kLitLenCodes, kMaxCodeBits, lit_lengths.data());
+        BuildCodeLengths(dist_freq_.data(), kDistCodes, kMaxCodeBits, dist_lengths.data());
+
+        int hlit = kLitLenCodes;
+        while (hlit > 257 && lit_lengths[static_cast<std::size_t>(hlit) - 1] == 0) {
+            --hlit;
+        }
+        int hdist = kDistCodes;
+        while (hdist > 1 && dist_lengths[static_cast<std::size_t>(hdist) - 1] == 0) {
+            --hdist;
+        }
+
+        // Run-length encode both length lists with code-length symbols 16-18.
+        std::vector<std::uint8_t> all_lengths(lit_lengths.begin(), lit_lengths.begin() + hlit);
+        all_lengths.insert(all_lengths.end(), dist_lengths.begin(), dist_lengths.begin() + hdist);
+        std::vector<std::pair<std::uint8_t, std::uint8_t>> rle; // symbol, extra value
+        std::array<std::uint32_t, kCodeLengthCodes> cl_freq {};
+        const auto emit = [&](int symbol, int extra) {
+            rle.emplace_back(static_cast<std::uint8_t>(symbol), static_cast<std::uint8_t>(extra));
+            ++cl_freq[static_cast<std::size_t>(symbol)];
+        };
+        for (std::size_t i = 0; i < all_lengths.size();) {
+            const std::uint8_t current = all_lengths[i];
+            std::size_t run = 1;
+            while (i + run < all_lengths.size() && all_lengths[i + run] == current) {
+                ++run;
+            }
+            i += run;
+            if (current == 0) {
+                while (run >= 11) {
+                    const std::size_t take = std::min<std::size_t>(run, 138);
+                    emit(18, static_cast<int>(take - 11));
+                    run -= take;
+                }
+                if (run >= 3) {
+                    emit(17, static_cast<int>(run - 3));
+                    run = 0;
+                }
+            } else {
+                emit(current, 0);
+                --run;
+                while (run >= 3) {
+                    const std::size_t take = std::min<std::size_t>(run, 6);
+                    emit(16, static_cast<int>(take - 3));
+                    run -= take;
+                }
+            }
+            for (; run > 0; --run) {
+                emit(current, 0);
+            }
+        }
+        EnsureTwoSymbols(cl_freq.data(), kCodeLengthCodes);
+        std::array<std::uint8_t, kCodeLengthCodes> cl_lengths {};
+        BuildCodeLengths(cl_freq.data(), kCodeLengthCodes, kMaxCodeLengthBits, cl_lengths.data());
+        int hclen = kCodeLengthCodes;
+        while (hclen > 4 && cl_lengths[kCodeLengthOrder[static_cast<std::size_t>(hclen) - 1]] == 0) {
+            --hclen;
+        }
+
+        // Compare the dynamic block with storing the bytes as they are.
+        std::uint64_t dynamic_bits = 3 + 5 + 5 + 4 + 3 * static_cast<std::uint64_t>(hclen);
+        for (const auto& [symbol, extra] : rle) {
+            (void)extra;
+            dynamic_bits += cl_lengths[symbol];
+            dynamic_bits += symbol == 16 ? 2 : symbol == 17 ? 3 : symbol == 18 ? 7 : 0;
+        }
+        for (const auto& symbol : symbols_) {
+            if (symbol.distance == 0) {
+                dynamic_bits += lit_lengths[symbol.length_or_literal];
+            } else {
+                const std::size_t length_code = LengthCodes()[symbol.length_or_literal];
+                const auto dist_code = static_cast<std::size_t>(DistanceCode(symbol.distance));
+                dynamic_bits += lit_lengths[257 + length_code] + kLengthExtra[length_code];
+                dynamic_bits += dist_lengths[dist_code] + kDistExtra[dist_code];
+            }
+        }
+        dynamic_bits += lit_lengths[256];
+        const std::size_t stored_chunks = std::max<std::size_t>(1, (block_bytes_ + kStoredBlockMax - 1) / kStoredBlockMax);
+        const std::uint64_t stored_bits = 8 * (static_cast<std::uint64_t>(block_bytes_) + 5 * stored_chunks + 1);
+
+        if (stored_bits <= dynamic_bits) {
+            WriteStored(data_ + block_start_, block_bytes_, final_block);
+        } else {
+            std::array<std::uint16_t, kLitLenCodes> lit_codes {};
+            std::array<std::uint16_t, kDistCodes> dist_codes {};
+            std::array<std::uint16_t, kCodeLengthCodes> cl_codes {};
+            BuildCodes(lit_lengths.data(), kLitLenCodes, lit_codes.data());
+            BuildCodes(dist_lengths.data(), kDistCodes, dist_codes.data());
+            BuildCodes(cl_lengths.data(), kCodeLengthCodes, cl_codes.data());
+
+            writer_.Put(final_block ? 1U : 0U, 1);
+            writer_.Put(2, 2); // dynamic Huffman
+            writer_.Put(static_cast<std::uint32_t>(hlit - 257), 5);
+            writer_.Put(static_cast<std::uint32_t>(hdist - 1), 5);
+            writer_.Put(static_cast<std::uint32_t>(hclen - 4), 4);
+            for (int i = 0; i < hclen; ++i) {
+                writer_.Put(cl_lengths[kCodeLengthOrder[static_cast<std::size_t>(i)]], 3);
+            }
+            for (const auto& [symbol, extra] : rle) {
+                writer_.Put(cl_codes[symbol], cl_lengths[symbol]);
+                if (symbol == 16) {
+                    writer_.Put(extra, 2);
+                } else if (symbol == 17) {
+                    writer_.Put(extra, 3);
+                } else if (symbol == 18) {
+                    writer_.Put(extra, 7);
+                }
+            }
+            for (const auto& symbol : symbols_) {
+                if (symbol.distance == 0) {
+                    writer_.Put(lit_codes[symbol.length_or_literal], lit_lengths[symbol.length_or_literal]);
+                    continue;
+                }
+                const std::size_t length_code = LengthCodes()[symbol.length_or_literal];
+                writer_.Put(lit_codes[257 + length_code], lit_lengths[257 + length_code]);
+                writer_.Put(symbol.length_or_literal - kLengthBase[length_code], kLengthExtra[length_code]);
+                const auto dist_code = static_cast<std::size_t>(DistanceCode(symbol.distance));
+                writer_.Put(dist_codes[dist_code], dist_lengths[dist_code]);
+                writer_.Put(symbol.distance - kDistBase[dist_code], kDistExtra[dist_code]);
+            }
+            writer_.Put(lit_codes[256], lit_lengths[256]);
+        }
+
+        block_start_ += block_bytes_;
+        block_bytes_ = 0;
+        symbols_.clear();
+        lit_freq_.fill(0);
+        dist_freq_.fill(0);
+    }
+
+    const std::uint8_t* data_;
+    std::size_t size_;
+    LevelParams params_;
+    BitWriter& writer_;
+    std::vector<std::int64_t> head_ {};
+    std::vector<std::int64_t> prev_ {};
+    std::vector<Symbol> symbols_ {};
+    std::array<std::uint32_t, kLitLenCodes> lit_freq_ {};
+    std::array<std::uint32_t, kDistCodes> dist_freq_ {};
+    std::size_t block_start_ {0};
+    std::size_t block_bytes_ {0};
+};
+}
+
+std::uint32_t Crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc)
+{
+    static const Crc32Tables tables = MakeCrc32Tables();
+    crc = ~crc;
+    while (size >= 8) {
+        const std::uint32_t one = crc ^ LoadLe32(data);
+        const std::uint32_t two = LoadLe32(data + 4);
+        crc = tables[7][one & 0xffU] ^ tables[6][(one >> 8U) & 0xffU] ^ tables[5][(one >> 16U) & 0xffU] ^
+              tables[4][one >> 24U] ^ tables[3][two & 0xffU] ^ tables[2][(two >> 8U) & 0xffU] ^
+              tables[1][(two >> 16U) & 0xffU] ^ tables[0][two >> 24U];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        crc = tables[0][(crc ^ *data++) & 0xffU] ^ (crc >> 8U);
+    }
+    return ~crc;
+}
+
+std::uint32_t Adler32(const std::uint8_t* data, std::size_t size, std::uint32_t adler)
+{
+    constexpr std::uint32_t kMod = 65521U;
+    // Largest n with 255 n (n + 1) / 2 + (n + 1) (kMod - 1) < 2^32, so the
+    // sums only need reducing once per chunk.
+    constexpr std::size_t kChunk = 5552;
+    std::uint32_t a = adler & 0xffffU;
+    std::uint32_t b = adler >> 16U;
+    while (size > 0) {
+        const std::size_t chunk = std::min(size, kChunk);
+        size -= chunk;
+        for (std::size_t i = 0; i < chunk; ++i) {
+            a += data[i];
+            b += a;
+        }
+        data += chunk;
+        a %= kMod;
+        b %= kMod;
+    }
+    return (b << 16U) | a;
+}
+
+void ZlibCompress(const std::uint8_t* data, std::size_t size, int level, std::vector<std::uint8_t>& out)
+{
+    level = std::clamp(level, kDeflateStoreLevel, kDeflateBestLevel);
+    out.clear();
+    out.reserve(size / 2 + 64);
+    // CMF 0x78: deflate with a 32 KiB window. FLG carries the level hint and
+    // makes the header a multiple of 31.
+    out.push_back(0x78);
+    out.push_back(level <= 1 ? 0x01 : level <= 5 ? 0x5e : level == 6 ? 0x9c : 0xda);
+
+    BitWriter writer(out);
+    Deflater(data, size, level, writer).Run();
+    writer.AlignToByte();
+
+    const std::uint32_t adler = Adler32(data, size);
+    out.insert(
+        out.end(),
+        {static_cast<std::uint8_t>(adler >> 24U), static_cast<std::uint8_t>(adler >> 16U),
+         static_cast<std::uint8_t>(adler >> 8U), static_cast<std::uint8_t>(adler)});
+}
+}
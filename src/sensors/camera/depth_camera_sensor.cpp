@@ -16,11 +16,12 @@ namespace hako::robots::sensor::camera
 {
 
 DepthCameraSensor::DepthCameraSensor(std::shared_ptr<MujocoCameraRenderer> renderer, const std::string& camera_name)
-    : renderer_(renderer), camera_name_(camera_name)
+    : renderer_(renderer), camera_name_(camera_name), raw_(std::make_unique<RawCameraFrame>())
 {
     if (!renderer) {
         throw std::invalid_argument("Renderer is null");
     }
+    camera_ = renderer_->FindCamera(camera_name_);
 }
 
 DepthCameraSensor::~DepthCameraSensor() = default;
@@ -74,9 +75,10 @@ const DepthCameraConfig& DepthCameraSensor::GetConfig() const
 
 void DepthCameraSensor::Capture(DepthFrame& out)
 {
-    RawCameraFrame raw;
+    // raw_ keeps its readback buffers from one capture to the next.
+    RawCameraFrame& raw = *raw_;
     const bool success = renderer_->Render(
-        camera_name_,
+        camera_,
         config_.image.width,
         config_.image.height,
         config_.horizontal_fov,
@@ -99,4 +101,32 @@ void DepthCameraSensor::Capture(DepthFrame& out)
     }
 }
 
+std::size_t DepthCameraSensor::AppendViews(std::vector<CameraView>& views) const
+{
+    CameraView view;
+    view.camera = camera_;
+    view.camera_name = camera_name_;
+    view.width = config_.image.width;
+    view.height = config_.image.height;
+    view.hfov_rad = config_.horizontal_fov;
+    view.clip_near_m = config_.clip.near;
+    view.clip_far_m = config_.clip.far;
+    view.need_rgb = false;
+    view.need_depth = true;
+    views.push_back(view);
+    return 1;
+}
+
+void DepthCameraSensor::FinishTiles(const RawCameraFrame* views, DepthFrame& out) const
+{
+    if (views == nullptr) {
+        ClearDepthFrame(out);
+        return;
+    }
+    if (!EncodeDepth(views[0], config_, out)) {
+        std::cerr << "Failed to encode depth frame" << std::endl;
+        ClearDepthFrame(out);
+    }
+}
+
 }
@@ -0,0 +1,303 @@
+#include "sensors/camera/depth_kernels.hpp"
+#include "sensors/common/simd.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace hako::robots::sensor::camera
+{
+namespace
+{
+// With window depth d the OpenGL perspective projection gives
+//   z = n*f / (f - d*(f - n))      (mjDEPTH_ZERONEAR)
+//   z = n*f / (n + d*(f - n))      (mjDEPTH_ZEROFAR)
+// Near the far plane f - d*(f - n) cancels badly in float, so the first form
+// is evaluated as n*f / (n + (1 - d)*(f - n)): 1 - d is exact for d >= 0.5
+// and every other term is positive. Both become
+//   t = t_offset + d*t_scale,  z = numerator / (n + t*range)
+// with t_scale = +-1, i.e. two multiply-adds and a divide per sample.
+struct DepthCoefficients
+{
+    float numerator;
+    float znear;
+    float range;
+    float t_offset;
+    float t_scale;
+};
+
+DepthCoefficients MakeCoefficients(const DepthKernelParams& params)
+{
+    const float range = params.zfar - params.znear;
+    const float numerator = params.znear * params.zfar;
+    if (params.reversed) {
+        return {numerator, params.znear, range, 0.0F, 1.0F};
+    }
+    return {numerator, params.znear, range, 1.0F, -1.0F};
+}
+
+constexpr float kMaxMillimeters = static_cast<float>(std::numeric_limits<std::uint16_t>::max());
+
+inline float LinearizeSample(float sample, const DepthCoefficients& k, const DepthKernelParams& params)
+{
+    const float t = k.t_offset + sample * k.t_scale;
+    const float depth = k.numerator / (k.znear + t * k.range);
+    // Written so that NaN stays NaN, like the comparisons in the SIMD kernels.
+    if (depth < params.clip_near || depth > params.clip_far) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    return depth;
+}
+
+inline std::uint16_t QuantizeSample(float meters)
+{
+    const float mm = std::floor(meters * 1000.0F + 0.5F);
+    if (!(mm > 0.0F && mm <= kMaxMillimeters)) {
+        return 0;
+    }
+    return static_cast<std::uint16_t>(mm);
+}
+
+#if defined(HAKO_SIMD_AVX2)
+HAKO_SIMD_TARGET_AVX2
+inline __m256 LinearizeAvx2(__m256 sample, const DepthCoefficients& k, __m256 lo, __m256 hi)
+{
+    const __m256 t = _mm256_fmadd_ps(sample, _mm256_set1_ps(k.t_scale), _mm256_set1_ps(k.t_offset));
+    const __m256 denominator = _mm256_fmadd_ps(t, _mm256_set1_ps(k.range), _mm256_set1_ps(k.znear));
+    const __m256 depth = _mm256_div_ps(_mm256_set1_ps(k.numerator), denominator);
+    const __m256 outside = _mm256_or_ps(
+        _mm256_cmp_ps(depth, lo, _CMP_LT_OQ),
+        _mm256_cmp_ps(depth, hi, _CMP_GT_OQ));
+    return _mm256_blendv_ps(depth, _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN()), outside);
+}
+
+HAKO_SIMD_TARGET_AVX2
+inline void StoreMillimetersAvx2(__m256 meters, void* out)
+{
+    const __m256 mm = _mm256_floor_ps(_mm256_fmadd_ps(meters, _mm256_set1_ps(1000.0F), _mm256_set1_ps(0.5F)));
+    const __m256 valid = _mm256_and_ps(
+        _mm256_cmp_ps(mm, _mm256_setzero_ps(), _CMP_GT_OQ),
+        _mm256_cmp_ps(mm, _mm256_set1_ps(kMaxMillimeters), _CMP_LE_OQ));
+    const __m256i values = _mm256_cvttps_epi32(_mm256_and_ps(mm, valid));
+    const __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+}
+
+HAKO_SIMD_TARGET_AVX2
+std::size_t LinearizeDepthMetersAvx2(
+    const float* samples, std::size_t count, const DepthCoefficients& k, const DepthKernelParams& params, float* out)
+{
+    const __m256 lo = _mm256_set1_ps(params.clip_near);
+    const __m256 hi = _mm256_set1_ps(params.clip_far);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 depth = LinearizeAvx2(_mm256_loadu_ps(samples + i), k, lo, hi);
+        _mm256_storeu_ps(out + i, depth);
+    }
+    return i;
+}
+
+HAKO_SIMD_TARGET_AVX2
+std::size_t LinearizeDepthMillimetersAvx2(
+    const float* samples, std::size_t count, const DepthCoefficients& k, const DepthKernelParams& params,
+    std::uint16_t* out)
+{
+    const __m256 lo = _mm256_set1_ps(params.clip_near);
+    const __m256 hi = _mm256_set1_ps(params.clip_far);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 depth = LinearizeAvx2(_mm256_loadu_ps(samples + i), k, lo, hi);
+        StoreMillimetersAvx2(depth, out + i);
+    }
+    return i;
+}
+
+HAKO_SIMD_TARGET_AVX2
+std::size_t QuantizeDepthMillimetersAvx2(const float* meters, std::size_t count, std::uint16_t* out)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        StoreMillimetersAvx2(_mm256_loadu_ps(meters + i), out + i);
+    }
+    return i;
+}
+
+// _mm_storeu_si128 may store into any buffer, so bytes need no copy.
+HAKO_SIMD_TARGET_AVX2
+std::size_t QuantizeDepthMillimeterBytesAvx2(const float* meters, std::size_t count, std::uint8_t* out)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        StoreMillimetersAvx2(_mm256_loadu_ps(meters + i), out + 2 * i);
+    }
+    return i;
+}
+#endif
+
+#if defined(HAKO_SIMD_NEON)
+inline float32x4_t LinearizeNeon(float32x4_t sample, const DepthCoefficients& k, float32x4_t lo, float32x4_t hi)
+{
+    const float32x4_t t = vfmaq_f32(vdupq_n_f32(k.t_offset), sample, vdupq_n_f32(k.t_scale));
+    const float32x4_t denominator = vfmaq_f32(vdupq_n_f32(k.znear), t, vdupq_n_f32(k.range));
+    const float32x4_t depth = vdivq_f32(vdupq_n_f32(k.numerator), denominator);
+    const uint32x4_t outside = vorrq_u32(vcltq_f32(depth, lo), vcgtq_f32(depth, hi));
+    return vbslq_f32(outside, vdupq_n_f32(std::numeric_limits<float>::quiet_NaN()), depth);
+}
+
+inline void StoreMillimetersNeon(float32x4_t meters, std::uint16_t* out)
+{
+    const float32x4_t mm = vrndmq_f32(vfmaq_f32(vdupq_n_f32(0.5F), meters, vdupq_n_f32(1000.0F)));
+    const uint32x4_t valid = vandq_u32(vcgtq_f32(mm, vdupq_n_f32(0.0F)), vcleq_f32(mm, vdupq_n_f32(kMaxMillimeters)));
+    const uint32x4_t values = vcvtq_u32_f32(vbslq_f32(valid, mm, vdupq_n_f32(0.0F)));
+    vst1_u16(out, vmovn_u32(values));
+}
+
+// Byte-buffer variant of StoreMillimetersNeon; lanes land in memory order.
+inline void StoreMillimeterBytesNeon(float32x4_t meters, std::uint8_t* out)
+{
+    const float32x4_t mm = vrndmq_f32(vfmaq_f32(vdupq_n_f32(0.5F), meters, vdupq_n_f32(1000.0F)));
+    const uint32x4_t valid = vandq_u32(vcgtq_f32(mm, vdupq_n_f32(0.0F)), vcleq_f32(mm, vdupq_n_f32(kMaxMillimeters)));
+    const uint32x4_t values = vcvtq_u32_f32(vbslq_f32(valid, mm, vdupq_n_f32(0.0F)));
+    vst1_u8(out, vreinterpret_u8_u16(vmovn_u32(values)));
+}
+
+std::size_t LinearizeDepthMetersNeon(
+    const float* samples, std::size_t count, const DepthCoefficients& k, const DepthKernelParams& params, float* out)
+{
+    const float32x4_t lo = vdupq_n_f32(params.clip_near);
+    const float32x4_t hi = vdupq_n_f32(params.clip_far);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, LinearizeNeon(vld1q_f32(samples + i), k, lo, hi));
+    }
+    return i;
+}
+
+std::size_t LinearizeDepthMillimetersNeon(
+    const float* samples, std::size_t count, const DepthCoefficients& k, const DepthKernelParams& params,
+    std::uint16_t* out)
+{
+    const float32x4_t lo = vdupq_n_f32(params.clip_near);
+    const float32x4_t hi = vdupq_n_f32(params.clip_far);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        StoreMillimetersNeon(LinearizeNeon(vld1q_f32(samples + i), k, lo, hi), out + i);
+    }
+    return i;
+}
+
+std::size_t QuantizeDepthMillimetersNeon(const float* meters, std::size_t count, std::uint16_t* out)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        StoreMillimetersNeon(vld1q_f32(meters + i), out + i);
+    }
+    return i;
+}
+
+std::size_t QuantizeDepthMillimeterBytesNeon(const float* meters, std::size_t count, std::uint8_t* out)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        StoreMillimeterBytesNeon(vld1q_f32(meters + i), out + 2 * i);
+    }
+    return i;
+}
+#endif
+}
+
+namespace detail
+{
+void LinearizeDepthMetersScalar(const float* samples, std::size_t count, const DepthKernelParams& params, float* out)
+{
+    const DepthCoefficients k = MakeCoefficients(params);
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = LinearizeSample(samples[i], k, params);
+    }
+}
+
+void LinearizeDepthMillimetersScalar(
+    const float* samples, std::size_t count, const DepthKernelParams& params, std::uint16_t* out)
+{
+    const DepthCoefficients k = MakeCoefficients(params);
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = QuantizeSample(LinearizeSample(samples[i], k, params));
+    }
+}
+
+void QuantizeDepthMillimetersScalar(const float* meters, std::size_t count, std::uint16_t* out)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = QuantizeSample(meters[i]);
+    }
+}
+}
+
+// Each dispatcher runs the vector kernel over whole vectors and leaves the
+// tail (fewer than 8 or 4 samples) to the scalar loop.
+void LinearizeDepthMeters(const float* samples, std::size_t count, const DepthKernelParams& params, float* out)
+{
+    std::size_t done = 0;
+#if defined(HAKO_SIMD_AVX2)
+    if (common::SimdAvx2Enabled()) {
+        done = LinearizeDepthMetersAvx2(samples, count, MakeCoefficients(params), params, out);
+    }
+#elif defined(HAKO_SIMD_NEON)
+    if (common::SimdNeonEnabled()) {
+        done = LinearizeDepthMetersNeon(samples, count, MakeCoefficients(params), params, out);
+    }
+#endif
+    detail::LinearizeDepthMetersScalar(samples + done, count - done, params, out + done);
+}
+
+void LinearizeDepthMillimeters(
+    const float* samples, std::size_t count, const DepthKernelParams& params, std::uint16_t* out)
+{
+    std::size_t done = 0;
+#if defined(HAKO_SIMD_AVX2)
+    if (common::SimdAvx2Enabled()) {
+        done = LinearizeDepthMillimetersAvx2(samples, count, MakeCoefficients(params), params, out);
+    }
+#elif defined(HAKO_SIMD_NEON)
+    if (common::SimdNeonEnabled()) {
+        done = LinearizeDepthMillimetersNeon(samples, count, MakeCoefficients(params), params, out);
+    }
+#endif
+    detail::LinearizeDepthMillimetersScalar(samples + done, count - done, params, out + done);
+}
+
+void QuantizeDepthMillimeters(const float* meters, std::size_t count, std::uint16_t* out)
+{
+    std::size_t done = 0;
+#if defined(HAKO_SIMD_AVX2)
+    if (common::SimdAvx2Enabled()) {
+        done = QuantizeDepthMillimetersAvx2(meters, count, out);
+    }
+#elif defined(HAKO_SIMD_NEON)
+    if (common::SimdNeonEnabled()) {
+        done = QuantizeDepthMillimetersNeon(meters, count, out);
+    }
+#endif
+    detail::QuantizeDepthMillimetersScalar(meters + done, count - done, out + done);
+}
+
+// The vector stores write the host's byte order; both AVX2 (x86-64) and the
+// NEON targets built here (aarch64) are little-endian.
+void QuantizeDepthMillimeters(const float* meters, std::size_t count, std::uint8_t* out)
+{
+    std::size_t done = 0;
+#if defined(HAKO_SIMD_AVX2)
+    if (common::SimdAvx2Enabled()) {
+        done = QuantizeDepthMillimeterBytesAvx2(meters, count, out);
+    }
+#elif defined(HAKO_SIMD_NEON)
+    if (common::SimdNeonEnabled()) {
+        done = QuantizeDepthMillimeterBytesNeon(meters, count, out);
+    }
+#endif
+    for (std::size_t i = done; i < count; ++i) {
+        const std::uint16_t mm = QuantizeSample(meters[i]);
+        out[2 * i] = static_cast<std::uint8_t>(mm & 0xFFU);
+        out[2 * i + 1] = static_cast<std::uint8_t>(mm >> 8U);
+    }
+}
+}
@@ -0,0 +1,643 @@
+#include "sensors/camera/image_codecs.hpp"
+#include "sensors/camera/image_frame_writer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+namespace hako::robots::sensor::camera
+{
+namespace
+{
+// Byte offsets of R, G, B (and alpha) inside one pixel of an RGB-like frame.
+struct PixelLayout
+{
+    int bytes_per_pixel;
+    int r;
+    int g;
+    int b;
+    int a; // -1 without alpha
+};
+
+bool ResolveLayout(const ImageFrame& frame, PixelFormat& format, PixelLayout& layout)
+{
+    if (frame.width <= 0 || frame.height <= 0 || !ParsePixelFormat(frame.format, format)) {
+        return false;
+    }
+    switch (format) {
+    case PixelFormat::Rgb8:
+        layout = {3, 0, 1, 2, -1};
+        break;
+    case PixelFormat::Bgr8:
+        layout = {3, 2, 1, 0, -1};
+        break;
+    case PixelFormat::Rgba8:
+        layout = {4, 0, 1, 2, 3};
+        break;
+    case PixelFormat::Mono8:
+        layout = {1, 0, 0, 0, -1};
+        break;
+    case PixelFormat::Yuv422:
+        return false;
+    }
+    const std::size_t expected =
+        static_cast<std::size_t>(frame.width) * static_cast<std::size_t>(frame.height) *
+        static_cast<std::size_t>(layout.bytes_per_pixel);
+    return frame.data.size() == expected;
+}
+
+// ---------------------------------------------------------------------------
+// Baseline JPEG (ITU T.81) with the Annex K tables.
+
+constexpr std::array<std::uint8_t, 64> kZigzag {
+    0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6,  7,  14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+};
+
+// Quantization tables K.1 and K.2 in natural order.
+constexpr std::array<std::uint8_t, 64> kLumaQuant {
+    16, 11, 10, 16, 24,  40,  51,  61,  12, 12, 14, 19, 26,  58,  60,  55,
+    14, 13, 16, 24, 40,  57,  69,  56,  14, 17, 22, 29, 51,  87,  80,  62,
+    18, 22, 37, 56, 68,  109, 103, 77,  24, 35, 55, 64, 81,  104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99,
+};
+constexpr std::array<std::uint8_t, 64> kChromaQuant {
+    17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99,
+    24, 26, 56, 99, 99, 99, 99, 99, 47, 66, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+};
+
+// Huffman tables K.3 to K.6: code counts per length 1-16, then symbols.
+constexpr std::array<std::uint8_t, 16> kLumaDcBits {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+constexpr std::array<std::uint8_t, 12> kDcValues {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+constexpr std::array<std::uint8_t, 16> kChromaDcBits {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
+constexpr std::array<std::uint8_t, 16> kLumaAcBits {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+constexpr std::array<std::uint8_t, 162> kLumaAcValues {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+    0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa,
+};
+constexpr std::array<std::uint8_t, 16> kChromaAcBits {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+constexpr std::array<std::uint8_t, 162> kChromaAcValues {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+    0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+    0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+    0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+    0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa,
+};
+
+struct HuffmanCode
+{
+    std::uint16_t code = 0;
+    std::uint8_t length = 0;
+};
+
+using HuffmanTable = std::array<HuffmanCode, 256>;
+
+// Canonical codes from the code counts (T.81 Annex C).
+template <std::size_t N>
+HuffmanTable BuildHuffmanTable(const std::array<std::uint8_t, 16>& bits, const std::array<std::uint8_t, N>& values)
+{
+    HuffmanTable table {};
+    std::uint16_t code = 0;
+    std::size_t k = 0;
+    for (int length = 1; length <= 16; ++length) {
+        for (int i = 0; i < bits[static_cast<std::size_t>(length - 1)]; ++i, ++k) {
+            table[values[k]] = {code, static_cast<std::uint8_t>(length)};
+            ++code;
+        }
+        code = static_cast<std::uint16_t>(code << 1);
+    }
+    return table;
+}
+
+struct JpegTables
+{
+    HuffmanTable luma_dc;
+    HuffmanTable luma_ac;
+    HuffmanTable chroma_dc;
+    HuffmanTable chroma_ac;
+};
+
+const JpegTables& HuffmanTables()
+{
+    static const JpegTables tables {
+        BuildHuffmanTable(kLumaDcBits, kDcValues),
+        BuildHuffmanTable(kLumaAcBits, kLumaAcValues),
+        BuildHuffmanTable(kChromaDcBits, kDcValues),
+        BuildHuffmanTable(kChromaAcBits, kChromaAcValues),
+    };
+    return tables;
+}
+
+// IJG quality scaling of a base table, in natural order.
+std::array<std::uint8_t, 64> ScaleQuantTable(const std::array<std::uint8_t, 64>& base, int quality)
+{
+    const int scale = quality < 50 ? 5000 / quality : 200 - 2 * quality;
+    std::array<std::uint8_t, 64> out {};
+    for (std::size_t i = 0; i < 64; ++i) {
+        out[i] = static_cast<std::uint8_t>(std::clamp((base[i] * scale + 50) / 100, 1, 255));
+    }
+    return out;
+}
+
+// Reciprocal divisors for the AAN DCT, whose outputs carry a per-frequency
+// scale factor that is folded into the quantization step.
+std::array<float, 64> MakeDivisors(const std::array<std::uint8_t, 64>& quant)
+{
+    constexpr std::array<double, 8> kAanScale {
+        1.0, 1.387039845, 1.306562965, 1.175875602, 1.0, 0.785694958, 0.541196100, 0.275899379};
+    std::array<float, 64> out {};
+    for (std::size_t row = 0; row < 8; ++row) {
+        for (std::size_t col = 0; col < 8; ++col) {
+            out[row * 8 + col] = static_cast<float>(1.0 / (quant[row * 8 + col] * kAanScale[row] * kAanScale[col] * 8.0));
+        }
+    }
+    return out;
+}
+
+// In-place forward DCT of 8 values spaced `stride` apart (AAN, as in the
+// IJG float DCT).
+inline void Dct8(float* d, int stride)
+{
+    const float tmp0 = d[0] + d[7 * stride];
+    const float tmp7 = d[0] - d[7 * stride];
+    const float tmp1 = d[stride] + d[6 * stride];
+    const float tmp6 = d[stride] - d[6 * stride];
+    const float tmp2 = d[2 * stride] + d[5 * stride];
+    const float tmp5 = d[2 * stride] - d[5 * stride];
+    const float tmp3 = d[3 * stride] + d[4 * stride];
+    const float tmp4 = d[3 * stride] - d[4 * stride];
+
+    float tmp10 = tmp0 + tmp3;
+    const float tmp13 = tmp0 - tmp3;
+    float tmp11 = tmp1 + tmp2;
+    float tmp12 = tmp1 - tmp2;
+    d[0] = tmp10 + tmp11;
+    d[4 * stride] = tmp10 - tmp11;
+    const float z1 = (tmp12 + tmp13) * 0.707106781F;
+    d[2 * stride] = tmp13 + z1;
+    d[6 * stride] = tmp13 - z1;
+
+    tmp10 = tmp4 + tmp5;
+    tmp11 = tmp5 + tmp6;
+    tmp12 = tmp6 + tmp7;
+    const float z5 = (tmp10 - tmp12) * 0.382683433F;
+    const float z2 = 0.541196100F * tmp10 + z5;
+    const float z4 = 1.306562965F * tmp12 + z5;
+    const float z3 = tmp11 * 0.707106781F;
+    const float z11 = tmp7 + z3;
+    const float z13 = tmp7 - z3;
+    d[5 * stride] = z13 + z2;
+    d[3 * stride] = z13 - z2;
+    d[stride] = z11 + z4;
+    d[7 * stride] = z11 - z4;
+}
+
+class JpegBitWriter
+{
+public:
+    explicit JpegBitWriter(std::vector<std::uint8_t>& out) : out_(out) {}
+
+    void Put(std::uint32_t bits, int length)
+    {
+        buffer_ = (buffer_ << length) | (bits & ((1U << length) - 1U));
+        count_ += length;
+        while (count_ >= 8) {
+            const auto byte = static_cast<std::uint8_t>(buffer_ >> (count_ - 8));
+            out_.push_back(byte);
+            if (byte == 0xFF) {
+                out_.push_back(0x00); // byte stuffing
+            }
+            count_ -= 8;
+        }
+    }
+
+    void Put(const HuffmanCode& code) { Put(code.code, code.length); }
+
+    // Pad the last byte with 1 bits.
+    void Flush()
+    {
+        if (count_ > 0) {
+            Put(0x7F, 8 - count_);
+        }
+    }
+
+private:
+    std::vector<std::uint8_t>& out_;
+    std::uint32_t buffer_ = 0;
+    int count_ = 0;
+};
+
+// Category (bit count) and the value bits of a DC difference or AC level.
+inline int Magnitude(int value, std::uint32_t& bits)
+{
+    const int absolute = value < 0 ? -value : value;
+    int category = 0;
+    while ((absolute >> category) != 0) {
+        ++category;
+    }
+    bits = static_cast<std::uint32_t>(value < 0 ? value - 1 : value);
+    return category;
+}
+
+// DCT, quantize and entropy code one 8x8 block of level-shifted samples.
+void EncodeBlock(
+    float* block,
+    const std::array<float, 64>& divisors,
+    const HuffmanTable& dc,
+    const HuffmanTable& ac,
+    int& previous_dc,
+    JpegBitWriter& writer)
+{
+    for (int row = 0; row < 8; ++row) {
+        Dct8(block + row * 8, 1);
+    }
+    for (int col = 0; col < 8; ++col) {
+        Dct8(block + col, 8);
+    }
+
+    int quantized[64];
+    for (std::size_t i = 0; i < 64; ++i) {
+        const std::size_t natural = kZigzag[i];
+        quantized[i] = static_cast<int>(std::lround(block[natural] * divisors[natural]));
+    }
+
+    std::uint32_t bits = 0;
+    const int diff = quantized[0] - previous_dc;
+    previous_dc = quantized[0];
+    const int dc_category = Magnitude(diff, bits);
+    writer.Put(dc[static_cast<std::size_t>(dc_category)]);
+    if (dc_category > 0) {
+        writer.Put(bits, dc_category);
+    }
+
+    int run = 0;
+    for (int i = 1; i < 64; ++i) {
+        if (quantized[i] == 0) {
+            ++run;
+            continue;
+        }
+        while (run > 15) {
+            writer.Put(ac[0xF0]); // ZRL: sixteen zeros
+            run -= 16;
+        }
+        const int category = Magnitude(quantized[i], bits);
+        writer.Put(ac[static_cast<std::size_t>((run << 4) | category)]);
+        writer.Put(bits, category);
+        run = 0;
+    }
+    if (run > 0) {
+        writer.Put(ac[0x00]); // EOB
+    }
+}
+
+void AppendBe16(std::vector<std::uint8_t>& out, int value)
+{
+    out.push_back(static_cast<std::uint8_t>((value >> 8) & 0xFF));
+    out.push_back(static_cast<std::uint8_t>(value & 0xFF));
+}
+
+template <std::size_t N>
+void AppendHuffmanSegment(
+    std::vector<std::uint8_t>& out, int table_class_id, const std::array<std::uint8_t, 16>& bits,
+    const std::array<std::uint8_t, N>& values)
+{
+    out.push_back(0xFF);
+    out.push_back(0xC4);
+    AppendBe16(out, static_cast<int>(2 + 1 + 16 + N));
+    out.push_back(static_cast<std::uint8_t>(table_class_id));
+    out.insert(out.end(), bits.begin(), bits.end());
+    out.insert(out.end(), values.begin(), values.end());
+}
+
+void AppendQuantSegment(std::vector<std::uint8_t>& out, int id, const std::array<std::uint8_t, 64>& quant)
+{
+    out.push_back(0xFF);
+    out.push_back(0xDB);
+    AppendBe16(out, 2 + 1 + 64);
+    out.push_back(static_cast<std::uint8_t>(id));
+    for (std::size_t i = 0; i < 64; ++i) {
+        out.push_back(quant[kZigzag[i]]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// QOI (https://qoiformat.org/qoi-specification.pdf)
+
+struct QoiPixel
+{
+    std::uint8_t r = 0;
+    std::uint8_t g = 0;
+    std::uint8_t b = 0;
+    std::uint8_t a = 255;
+
+    bool operator==(const QoiPixel& other) const
+    {
+        return r == other.r && g == other.g && b == other.b && a == other.a;
+    }
+};
+
+inline std::size_t QoiHash(const QoiPixel& p)
+{
+    return static_cast<std::size_t>((p.r * 3 + p.g * 5 + p.b * 7 + p.a * 11) % 64);
+}
+
+void AppendBe32(std::vector<std::uint8_t>& out, std::uint32_t value)
+{
+    out.push_back(static_cast<std::uint8_t>(value >> 24));
+    out.push_back(static_cast<std::uint8_t>(value >> 16));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+}
+
+bool ParseImageCodec(const std::string& name, ImageCodec& out)
+{
+    if (name == "jpeg") {
+        out = ImageCodec::Jpeg;
+    } else if (name == "png") {
+        out = ImageCodec::Png;
+    } else if (name == "qoi") {
+        out = ImageCodec::Qoi;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* ImageCodecName(ImageCodec codec)
+{
+    switch (codec) {
+    case ImageCodec::Jpeg:
+        return "jpeg";
+    case ImageCodec::Png:
+        return "png";
+    case ImageCodec::Qoi:
+        return "qoi";
+    }
+    return "";
+}
+
+bool ValidateImageCompressionConfig(const ImageCompressionConfig& config)
+{
+    ImageCodec codec;
+    if (!ParseImageCodec(config.codec, codec)) {
+        std::cerr << "Invalid image compression codec: " << config.codec
+                  << " (expected jpeg, png or qoi)" << std::endl;
+        return false;
+    }
+    if (codec == ImageCodec::Jpeg && (config.jpeg_quality < 1 || config.jpeg_quality > 100)) {
+        std::cerr << "Invalid JPEG quality: " << config.jpeg_quality << " (expected 1 to 100)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool EncodeJpeg(const ImageFrame& frame, int quality, std::vector<uint8_t>& out)
+{
+    PixelFormat format;
+    PixelLayout layout {};
+    if (!ResolveLayout(frame, format, layout) || quality < 1 || quality > 100) {
+        return false;
+    }
+    const bool grey = format == PixelFormat::Mono8;
+    const int width = frame.width;
+    const int height = frame.height;
+    if (width > 65535 || height > 65535) {
+        return false;
+    }
+
+    const auto luma_quant = ScaleQuantTable(kLumaQuant, quality);
+    const auto chroma_quant = ScaleQuantTable(kChromaQuant, quality);
+    const auto luma_divisors = MakeDivisors(luma_quant);
+    const auto chroma_divisors = MakeDivisors(chroma_quant);
+    const JpegTables& huffman = HuffmanTables();
+
+    out.clear();
+    // SOI and a JFIF APP0 segment.
+    out.insert(out.end(), {0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 'J', 'F', 'I', 'F', 0x00,
+                           0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00});
+    AppendQuantSegment(out, 0, luma_quant);
+    if (!grey) {
+        AppendQuantSegment(out, 1, chroma_quant);
+    }
+
+    // SOF0: Y sampled 2x2 (1x1 for grey), Cb and Cr 1x1.
+    const int components = grey ? 1 : 3;
+    out.push_back(0xFF);
+    out.push_back(0xC0);
+    AppendBe16(out, 8 + 3 * components);
+    out.push_back(8);
+    AppendBe16(out, height);
+    AppendBe16(out, width);
+    out.push_back(static_cast<std::uint8_t>(components));
+    out.insert(out.end(), {1, static_cast<std::uint8_t>(grey ? 0x11 : 0x22), 0});
+    if (!grey) {
+        out.insert(out.end(), {2, 0x11, 1, 3, 0x11, 1});
+    }
+
+    AppendHuffmanSegment(out, 0x00, kLumaDcBits, kDcValues);
+    AppendHuffmanSegment(out, 0x10, kLumaAcBits, kLumaAcValues);
+    if (!grey) {
+        AppendHuffmanSegment(out, 0x01, kChromaDcBits, kDcValues);
+        AppendHuffmanSegment(out, 0x11, kChromaAcBits, kChromaAcValues);
+    }
+
+    // SOS
+    out.push_back(0xFF);
+    out.push_back(0xDA);
+    AppendBe16(out, 6 + 2 * components);
+    out.push_back(static_cast<std::uint8_t>(components));
+    out.insert(out.end(), {1, 0x00});
+    if (!grey) {
+        out.insert(out.end(), {2, 0x11, 3, 0x11});
+    }
+    out.insert(out.end(), {0, 63, 0});
+
+    // Rough size guess so the entropy data rarely reallocates.
+    out.reserve(out.size() + static_cast<std::size_t>(width) * static_cast<std::size_t>(height) / 4);
+
+    JpegBitWriter writer(out);
+    const std::uint8_t* pixels = frame.data.data();
+    const auto bpp = static_cast<std::size_t>(layout.bytes_per_pixel);
+    // Edge MCUs repeat the last row and column.
+    const auto pixel_at = [&](int x, int y) {
+        const int cx = std::min(x, width - 1);
+        const int cy = std::min(y, height - 1);
+        return pixels + (static_cast<std::size_t>(cy) * static_cast<std::size_t>(width) + static_cast<std::size_t>(cx)) * bpp;
+    };
+
+    int dc_y = 0;
+    int dc_cb = 0;
+    int dc_cr = 0;
+    float block[64];
+    if (grey) {
+        for (int by = 0; by < height; by += 8) {
+            for (int bx = 0; bx < width; bx += 8) {
+                for (int y = 0; y < 8; ++y) {
+                    for (int x = 0; x < 8; ++x) {
+                        block[y * 8 + x] = static_cast<float>(pixel_at(bx + x, by + y)[0]) - 128.0F;
+                    }
+                }
+                EncodeBlock(block, luma_divisors, huffman.luma_dc, huffman.luma_ac, dc_y, writer);
+            }
+        }
+    } else {
+        float luma[256];
+        float cb[256];
+        float cr[256];
+        for (int my = 0; my < height; my += 16) {
+            for (int mx = 0; mx < width; mx += 16) {
+                for (int y = 0; y < 16; ++y) {
+                    for (int x = 0; x < 16; ++x) {
+                        const std::uint8_t* p = pixel_at(mx + x, my + y);
+                        const float r = p[layout.r];
+                        const float g = p[layout.g];
+                        const float b = p[layout.b];
+                        luma[y * 16 + x] = 0.299F * r + 0.587F * g + 0.114F * b - 128.0F;
+                        cb[y * 16 + x] = -0.168736F * r - 0.331264F * g + 0.5F * b;
+                        cr[y * 16 + x] = 0.5F * r - 0.418688F * g - 0.081312F * b;
+                    }
+                }
+                for (int quadrant = 0; quadrant < 4; ++quadrant) {
+                    const int ox = (quadrant & 1) * 8;
+                    const int oy = (quadrant >> 1) * 8;
+                    for (int y = 0; y < 8; ++y) {
+                        for (int x = 0; x < 8; ++x) {
+                            block[y * 8 + x] = luma[(oy + y) * 16 + ox + x];
+                        }
+                    }
+                    EncodeBlock(block, luma_divisors, huffman.luma_dc, huffman.luma_ac, dc_y, writer);
+                }
+                // 4:2:0 chroma: mean of each 2x2 pixel group.
+                for (const auto& [plane, dc] : {std::pair<const float*, int*>{cb, &dc_cb}, {cr, &dc_cr}}) {
+                    for (int y = 0; y < 8; ++y) {
+                        for (int x = 0; x < 8; ++x) {
+                            const int i = (2 * y) * 16 + 2 * x;
+                            block[y * 8 + x] = 0.25F * (plane[i] + plane[i + 1] + plane[i + 16] + plane[i + 17]);
+                        }
+                    }
+                    EncodeBlock(block, chroma_divisors, huffman.chroma_dc, huffman.chroma_ac, *dc, writer);
+                }
+            }
+        }
+    }
+    writer.Flush();
+    out.push_back(0xFF);
+    out.push_back(0xD9); // EOI
+    return true;
+}
+
+bool EncodeQoi(const ImageFrame& frame, std::vector<uint8_t>& out)
+{
+    PixelFormat format;
+    PixelLayout layout {};
+    if (!ResolveLayout(frame, format, layout)) {
+        return false;
+    }
+    const bool alpha = layout.a >= 0;
+    const std::size_t count = static_cast<std::size_t>(frame.width) * static_cast<std::size_t>(frame.height);
+
+    out.clear();
+    out.reserve(14 + count * (alpha ? 5 : 4) + 8);
+    out.insert(out.end(), {'q', 'o', 'i', 'f'});
+    AppendBe32(out, static_cast<std::uint32_t>(frame.width));
+    AppendBe32(out, static_cast<std::uint32_t>(frame.height));
+    out.push_back(alpha ? 4 : 3);
+    out.push_back(0); // sRGB with linear alpha
+
+    std::array<QoiPixel, 64> index {};
+    for (auto& entry : index) {
+        entry.a = 0;
+    }
+    QoiPixel previous {};
+    int run = 0;
+    const std::uint8_t* p = frame.data.data();
+    const auto bpp = static_cast<std::size_t>(layout.bytes_per_pixel);
+    for (std::size_t i = 0; i < count; ++i, p += bpp) {
+        QoiPixel pixel {p[layout.r], p[layout.g], p[layout.b], alpha ? p[layout.a] : std::uint8_t {255}};
+        if (pixel == previous) {
+            ++run;
+            if (run == 62 || i + 1 == count) {
+                out.push_back(static_cast<std::uint8_t>(0xC0 | (run - 1))); // QOI_OP_RUN
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back(static_cast<std::uint8_t>(0xC0 | (run - 1)));
+            run = 0;
+        }
+
+        const std::size_t hash = QoiHash(pixel);
+        if (index[hash] == pixel) {
+            out.push_back(static_cast<std::uint8_t>(hash)); // QOI_OP_INDEX
+        } else {
+            index[hash] = pixel;
+            if (pixel.a == previous.a) {
+                const int dr = static_cast<std::int8_t>(pixel.r - previous.r);
+                const int dg = static_cast<std::int8_t>(pixel.g - previous.g);
+                const int db = static_cast<std::int8_t>(pixel.b - previous.b);
+                const int dr_dg = dr - dg;
+                const int db_dg = db - dg;
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    out.push_back(static_cast<std::uint8_t>(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+                    out.push_back(static_cast<std::uint8_t>(0x80 | (dg + 32)));
+                    out.push_back(static_cast<std::uint8_t>((dr_dg + 8) << 4 | (db_dg + 8)));
+                } else {
+                    out.insert(out.end(), {0xFE, pixel.r, pixel.g, pixel.b});
+                }
+            } else {
+                out.insert(out.end(), {0xFF, pixel.r, pixel.g, pixel.b, pixel.a});
+            }
+        }
+        previous = pixel;
+    }
+    out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+    return true;
+}
+
+bool CompressImageFrame(
+    const ImageFrame& frame,
+    const ImageCompressionConfig& config,
+    CompressedImageFrame& out)
+{
+    ImageCodec codec;
+    if (!ParseImageCodec(config.codec, codec)) {
+        return false;
+    }
+    out.format = ImageCodecName(codec);
+    out.frame_id = frame.frame_id;
+    out.timestamp = frame.timestamp;
+    switch (codec) {
+    case ImageCodec::Jpeg:
+        return EncodeJpeg(frame, config.jpeg_quality, out.data);
+    case ImageCodec::Png:
+        return EncodeImageFrameToPng(frame, out.data);
+    case ImageCodec::Qoi:
+        return EncodeQoi(frame, out.data);
+    }
+    return false;
+}
+}
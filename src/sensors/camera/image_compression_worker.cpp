@@ -0,0 +1,192 @@
+#include "sensors/camera/image_compression_worker.hpp"
+
+#include <iostream>
+#include <utility>
+
+namespace hako::robots::sensor::camera
+{
+ImageCompressionWorker::~ImageCompressionWorker()
+{
+    Stop();
+}
+
+bool ImageCompressionWorker::Start(
+    const ImageCompressionConfig& config, std::size_t threads, std::size_t queue_capacity)
+{
+    if (Running()) {
+        std::cerr << "ERROR: ImageCompressionWorker::Start: worker is already running" << std::endl;
+        return false;
+    }
+    if (threads == 0 || queue_capacity == 0) {
+        std::cerr << "ERROR: ImageCompressionWorker::Start: threads and queue capacity must be positive" << std::endl;
+        return false;
+    }
+    if (!ValidateImageCompressionConfig(config)) {
+        return false;
+    }
+    config_ = config;
+    queue_capacity_ = queue_capacity;
+    thread_count_ = threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() != queue_capacity) {
+            queue_.clear();
+            queue_.resize(queue_capacity);
+        }
+        queue_head_ = 0;
+        queue_size_ = 0;
+        stopping_ = false;
+        latest_pending_ = false;
+        latest_sequence_ = 0;
+        next_sequence_ = 0;
+        stats_ = Stats {};
+    }
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this]() { Run(); });
+    }
+    return true;
+}
+
+void ImageCompressionWorker::Stop()
+{
+    if (!Running()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (; queue_size_ > 0; --queue_size_) {
+            queue_[queue_head_].pooled.Reset();
+            queue_head_ = (queue_head_ + 1) % queue_.size();
+        }
+    }
+    ready_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+}
+
+bool ImageCompressionWorker::Submit(ImageFrame& frame)
+{
+    if (!Running()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Job* slot = PushJob();
+        if (slot == nullptr) {
+            return false;
+        }
+        Job& job = *slot;
+        job.frame.width = frame.width;
+        job.frame.height = frame.height;
+        job.frame.channels = frame.channels;
+        job.frame.format = frame.format;
+        job.frame.frame_id = frame.frame_id;
+        job.frame.timestamp = frame.timestamp;
+        job.frame.data.swap(frame.data);
+        if (!spare_buffers_.empty()) {
+            frame.data.swap(spare_buffers_.back());
+            spare_buffers_.pop_back();
+        }
+    }
+    ready_.notify_one();
+    return true;
+}
+
+bool ImageCompressionWorker::Submit(const PooledImageFrame& frame)
+{
+    if (!Running() || !frame) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Job* job = PushJob();
+        if (job == nullptr) {
+            return false;
+        }
+        job->pooled = frame;
+    }
+    ready_.notify_one();
+    return true;
+}
+
+ImageCompressionWorker::Job* ImageCompressionWorker::PushJob()
+{
+    ++stats_.submitted;
+    if (queue_size_ >= queue_.size()) {
+        ++stats_.dropped;
+        return nullptr;
+    }
+    Job& job = queue_[(queue_head_ + queue_size_) % queue_.size()];
+    ++queue_size_;
+    job.sequence = ++next_sequence_;
+    return &job;
+}
+
+bool ImageCompressionWorker::TryTakeLatest(CompressedImageFrame& out)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!latest_pending_) {
+        return false;
+    }
+    out.format = latest_.format;
+    out.frame_id = latest_.frame_id;
+    out.timestamp = latest_.timestamp;
+    out.data.swap(latest_.data);
+    latest_pending_ = false;
+    return true;
+}
+
+ImageCompressionWorker::Stats ImageCompressionWorker::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void ImageCompressionWorker::Run()
+{
+    Job job {};
+    CompressedImageFrame encoded {};
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return stopping_ || queue_size_ > 0; });
+            if (stopping_) {
+                return;
+            }
+            // Swapped, not moved, so the slot keeps this thread's old buffers.
+            std::swap(job, queue_[queue_head_]);
+            queue_head_ = (queue_head_ + 1) % queue_.size();
+            --queue_size_;
+        }
+
+        const bool ok = CompressImageFrame(job.pooled ? *job.pooled : job.frame, config_, encoded);
+        // Back to the pool before taking the lock.
+        job.pooled.Reset();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        // One spare per queue slot and encoder covers every frame in flight.
+        // Pooled jobs leave no buffer here.
+        if (job.frame.data.capacity() > 0 && spare_buffers_.size() < queue_capacity_ + thread_count_) {
+            spare_buffers_.emplace_back().swap(job.frame.data);
+        }
+        if (!ok) {
+            ++stats_.failed;
+            continue;
+        }
+        ++stats_.encoded;
+        // With several encoders a newer frame may already be published.
+        if (job.sequence > latest_sequence_) {
+            latest_sequence_ = job.sequence;
+            latest_.format = encoded.format;
+            latest_.frame_id = encoded.frame_id;
+            latest_.timestamp = encoded.timestamp;
+            latest_.data.swap(encoded.data);
+            latest_pending_ = true;
+        }
+    }
+}
+}
@@ -0,0 +1,220 @@
+#include "sensors/camera/image_frame_recorder.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <utility>
+
+namespace hako::robots::sensor::camera
+{
+namespace
+{
+// A stream name becomes one directory under config_.directory, so it must not
+// be able to name a different directory or climb out of it.
+bool IsValidStreamName(const std::string& stream)
+{
+    return !stream.empty() && stream != "." && stream.find("..") == std::string::npos &&
+           stream.find_first_of("/\\:") == std::string::npos;
+}
+}
+
+ImageFrameRecorder::~ImageFrameRecorder()
+{
+    Stop();
+}
+
+bool ImageFrameRecorder::Start(const ImageFrameRecorderConfig& config)
+{
+    if (Running()) {
+        std::cerr << "ERROR: ImageFrameRecorder::Start: recorder is already running" << std::endl;
+        return false;
+    }
+    if (config.directory.empty() || config.queue_capacity == 0 || config.writer_threads == 0) {
+        std::cerr << "ERROR: ImageFrameRecorder::Start: directory, queue capacity and writer threads are required"
+                  << std::endl;
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(config.directory, error);
+    if (error) {
+        std::cerr << "ERROR: ImageFrameRecorder::Start: cannot create '" << config.directory.string()
+                  << "': " << error.message() << std::endl;
+        return false;
+    }
+    config_ = config;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = false;
+        stats_ = Stats {};
+        stream_indices_.clear();
+        rejected_streams_.clear();
+    }
+    threads_.reserve(config_.writer_threads);
+    for (std::size_t i = 0; i < config_.writer_threads; ++i) {
+        threads_.emplace_back([this]() { Run(); });
+    }
+    return true;
+}
+
+void ImageFrameRecorder::Stop()
+{
+    if (!Running()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+}
+
+bool ImageFrameRecorder::Submit(const std::string& stream, const ImageFrame& frame)
+{
+    if (!Running() || frame.data.empty()) {
+        return false;
+    }
+    std::vector<std::uint8_t> buffer;
+    std::uint64_t index = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!NextFrameIndex(stream, index)) {
+            return false;
+        }
+        ++stats_.submitted;
+        if (stopping_ || queue_.size() >= config_.queue_capacity) {
+            ++stats_.dropped;
+            return false;
+        }
+        if (!spare_buffers_.empty()) {
+            buffer.swap(spare_buffers_.back());
+            spare_buffers_.pop_back();
+        }
+    }
+
+    // Copy outside the lock; a recycled buffer already has the capacity.
+    buffer.assign(frame.data.begin(), frame.data.end());
+
+    Job job {};
+    job.path = FramePath(stream, index);
+    job.frame.width = frame.width;
+    job.frame.height = frame.height;
+    job.frame.channels = frame.channels;
+    job.frame.format = frame.format;
+    job.frame.frame_id = frame.frame_id;
+    job.frame.timestamp = frame.timestamp;
+    job.frame.data.swap(buffer);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Another producer may have filled the queue during the copy.
+        if (queue_.size() >= config_.queue_capacity) {
+            ++stats_.dropped;
+            spare_buffers_.emplace_back().swap(job.frame.data);
+            return false;
+        }
+        queue_.push_back(std::move(job));
+    }
+    ready_.notify_one();
+    return true;
+}
+
+bool ImageFrameRecorder::Submit(const std::string& stream, const PooledImageFrame& frame)
+{
+    if (!Running() || !frame || frame->data.empty()) {
+        return false;
+    }
+    Job job {};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::uint64_t index = 0;
+        if (!NextFrameIndex(stream, index)) {
+            return false;
+        }
+        ++stats_.submitted;
+        if (stopping_ || queue_.size() >= config_.queue_capacity) {
+            ++stats_.dropped;
+            return false;
+        }
+        job.path = FramePath(stream, index);
+        job.pooled = frame;
+        queue_.push_back(std::move(job));
+    }
+    ready_.notify_one();
+    return true;
+}
+
+bool ImageFrameRecorder::NextFrameIndex(const std::string& stream, std::uint64_t& index)
+{
+    auto it = stream_indices_.find(stream);
+    if (it == stream_indices_.end()) {
+        if (!IsValidStreamName(stream)) {
+            if (rejected_streams_.insert(stream).second) {
+                std::cerr << "ERROR: ImageFrameRecorder::Submit: invalid stream name '" << stream
+                          << "': it must be a plain directory name" << std::endl;
+            }
+            return false;
+        }
+        it = stream_indices_.emplace(stream, 0).first;
+    }
+    index = it->second++;
+    return true;
+}
+
+std::filesystem::path ImageFrameRecorder::FramePath(const std::string& stream, std::uint64_t index) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%06llu.png", static_cast<unsigned long long>(index));
+    return config_.directory / stream / name;
+}
+
+ImageFrameRecorder::Stats ImageFrameRecorder::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void ImageFrameRecorder::Run()
+{
+    Job job {};
+    std::vector<std::uint8_t> png;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return; // stopping and drained
+            }
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        bool ok = EncodeImageFrameToPng(job.pooled ? *job.pooled : job.frame, png, config_.compression_level);
+        job.pooled.Reset();
+        if (ok) {
+            std::error_code error;
+            std::filesystem::create_directories(job.path.parent_path(), error);
+            std::ofstream ofs(job.path, std::ios::binary);
+            ofs.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+            ok = ofs.good();
+        }
+        if (!ok) {
+            std::cerr << "ERROR: ImageFrameRecorder::Run: failed to write '" << job.path.string() << "'" << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (job.frame.data.capacity() > 0 && spare_buffers_.size() < config_.queue_capacity) {
+            spare_buffers_.emplace_back().swap(job.frame.data);
+        }
+        if (ok) {
+            ++stats_.written;
+            stats_.bytes_written += png.size();
+        } else {
+            ++stats_.failed;
+        }
+    }
+}
+}
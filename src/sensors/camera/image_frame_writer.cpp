@@ -1,47 +1,17 @@
 #include "sensors/camera/image_frame_writer.hpp"
+#include "sensors/camera/deflate.hpp"
 
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <utility>
 #include <vector>
 
 namespace hako::robots::sensor::camera
 {
 namespace
 {
-uint32_t crc32_update(uint32_t crc, const uint8_t* data, size_t size)
-{
-    static uint32_t table[256] {};
-    static bool initialized = false;
-    if (!initialized) {
-        for (uint32_t i = 0; i < 256; ++i) {
-            uint32_t c = i;
-            for (int k = 0; k < 8; ++k) {
-                c = (c & 1U) ? (0xedb88320U ^ (c >> 1U)) : (c >> 1U);
-            }
-            table[i] = c;
-        }
-        initialized = true;
-    }
-
-    crc = crc ^ 0xffffffffU;
-    for (size_t i = 0; i < size; ++i) {
-        crc = table[(crc ^ data[i]) & 0xffU] ^ (crc >> 8U);
-    }
-    return crc ^ 0xffffffffU;
-}
-
-uint32_t adler32(const std::vector<uint8_t>& data)
-{
-    constexpr uint32_t kMod = 65521U;
-    uint32_t a = 1U;
-    uint32_t b = 0U;
-    for (uint8_t byte : data) {
-        a = (a + byte) % kMod;
-        b = (b + a) % kMod;
-    }
-    return (b << 16U) | a;
-}
-
 void append_be32(std::vector<uint8_t>& out, uint32_t value)
 {
     out.push_back(static_cast<uint8_t>((value >> 24U) & 0xffU));
@@ -60,83 +30,174 @@ void append_chunk(
     png.insert(png.end(), type, type + 4);
     png.insert(png.end(), payload.begin(), payload.end());
 
-    const uint32_t crc = crc32_update(
-        0U,
-        png.data() + type_offset,
-        4 + payload.size());
+    const uint32_t crc = Crc32(png.data() + type_offset, 4 + payload.size());
     append_be32(png, crc);
 }
 
-std::vector<uint8_t> zlib_store(const std::vector<uint8_t>& data)
+inline uint32_t filtered_cost(uint8_t value)
+{
+    return value < 128U ? value : 256U - value;
+}
+
+// Filter one scanline with the filter (None, Sub, Up, Average or Paeth)
+// whose output has the smallest sum of absolute signed bytes, the libpng
+// heuristic. All five candidates come out of one pass over the row into
+// scratch (4 * row_size bytes). prior is the previous unfiltered row, or
+// nullptr for the first one. dst receives the filter type byte followed by
+// row_size bytes.
+void filter_row(
+    const uint8_t* __restrict row,
+    const uint8_t* __restrict prior,
+    size_t row_size,
+    size_t bpp,
+    uint8_t* __restrict scratch,
+    uint8_t* __restrict dst)
 {
-    std::vector<uint8_t> out;
-    out.push_back(0x78);
-    out.push_back(0x01);
-
-    size_t offset = 0;
-    while (offset < data.size()) {
-        const size_t remaining = data.size() - offset;
-        const uint16_t block_size = static_cast<uint16_t>(
-            remaining > 65535U ? 65535U : remaining);
-        const bool final_block = (offset + block_size) == data.size();
-
-        out.push_back(final_block ? 0x01 : 0x00);
-        out.push_back(static_cast<uint8_t>(block_size & 0xffU));
-        out.push_back(static_cast<uint8_t>((block_size >> 8U) & 0xffU));
-        const uint16_t nlen = static_cast<uint16_t>(~block_size);
-        out.push_back(static_cast<uint8_t>(nlen & 0xffU));
-        out.push_back(static_cast<uint8_t>((nlen >> 8U) & 0xffU));
-        out.insert(out.end(), data.begin() + static_cast<long>(offset),
-                   data.begin() + static_cast<long>(offset + block_size));
-        offset += block_size;
+    uint8_t* sub = scratch;
+    uint8_t* up = scratch + row_size;
+    uint8_t* average = scratch + 2 * row_size;
+    uint8_t* paeth = scratch + 3 * row_size;
+    uint64_t cost[5] {};
+
+    if (prior == nullptr) {
+        // Up, Average and Paeth reduce to None and Sub on the first row.
+        for (size_t i = 0; i < row_size; ++i) {
+            const uint8_t left = i >= bpp ? row[i - bpp] : 0;
+            sub[i] = static_cast<uint8_t>(row[i] - left);
+            cost[0] += filtered_cost(row[i]);
+            cost[1] += filtered_cost(sub[i]);
+        }
+        cost[2] = cost[3] = cost[4] = UINT64_MAX;
+    } else {
+        for (size_t i = 0; i < bpp && i < row_size; ++i) {
+            sub[i] = row[i];
+            up[i] = static_cast<uint8_t>(row[i] - prior[i]);
+            average[i] = static_cast<uint8_t>(row[i] - (prior[i] >> 1U));
+            paeth[i] = up[i];
+        }
+        // Sub, Up and Average vectorize; Paeth's select is kept apart.
+        for (size_t i = bpp; i < row_size; ++i) {
+            const uint8_t a = row[i - bpp];
+            const uint8_t b = prior[i];
+            sub[i] = static_cast<uint8_t>(row[i] - a);
+            up[i] = static_cast<uint8_t>(row[i] - b);
+            average[i] = static_cast<uint8_t>(row[i] - ((a + b) >> 1));
+        }
+        for (size_t i = bpp; i < row_size; ++i) {
+            const int a = row[i - bpp];
+            const int b = prior[i];
+            const int c = prior[i - bpp];
+            const int pa = std::abs(b - c);
+            const int pb = std::abs(a - c);
+            const int pc = std::abs(a + b - 2 * c);
+            const int near_bc = pb <= pc ? b : c;
+            const int predictor = (pa <= pb && pa <= pc) ? a : near_bc;
+            paeth[i] = static_cast<uint8_t>(row[i] - predictor);
+        }
+        for (size_t i = 0; i < row_size; ++i) {
+            cost[0] += filtered_cost(row[i]);
+            cost[1] += filtered_cost(sub[i]);
+            cost[2] += filtered_cost(up[i]);
+            cost[3] += filtered_cost(average[i]);
+            cost[4] += filtered_cost(paeth[i]);
+        }
     }
 
-    append_be32(out, adler32(data));
-    return out;
+    uint8_t best = 0;
+    for (uint8_t type = 1; type < 5; ++type) {
+        if (cost[type] < cost[best]) {
+            best = type;
+        }
+    }
+    dst[0] = best;
+    std::memcpy(dst + 1, best == 0 ? row : scratch + (best - 1) * row_size, row_size);
 }
 }
 
-bool WriteImageFrameToPng(
-    const ImageFrame& frame,
-    const std::filesystem::path& path)
+bool EncodeImageFrameToPng(const ImageFrame& frame, std::vector<uint8_t>& out, int compression_level)
 {
-    if (frame.width <= 0 || frame.height <= 0 || frame.channels != 3 ||
-        frame.format != "R8G8B8" ||
-        frame.data.size() != static_cast<size_t>(frame.width * frame.height * 3)) {
+    PixelFormat format;
+    if (frame.width <= 0 || frame.height <= 0 || !ParsePixelFormat(frame.format, format) ||
+        format == PixelFormat::Yuv422) {
         return false;
     }
-
-    if (!path.parent_path().empty()) {
-        std::filesystem::create_directories(path.parent_path());
+    const size_t channels = static_cast<size_t>(PixelFormatBytesPerPixel(format));
+    const size_t row_size = static_cast<size_t>(frame.width) * channels;
+    if (frame.data.size() != row_size * static_cast<size_t>(frame.height)) {
+        return false;
     }
 
-    std::vector<uint8_t> raw;
-    raw.reserve(static_cast<size_t>((frame.width * 3 + 1) * frame.height));
+    // PNG has no BGR layout, so B8G8R8 rows are swapped back to RGB first.
+    // Each row is then filtered against the previous (unfiltered) row.
+    std::vector<uint8_t> raw((row_size + 1) * static_cast<size_t>(frame.height));
+    std::vector<uint8_t> rows[2] = {std::vector<uint8_t>(row_size), std::vector<uint8_t>(row_size)};
+    std::vector<uint8_t> scratch(4 * row_size);
     for (int y = 0; y < frame.height; ++y) {
-        raw.push_back(0);
-        const size_t row_offset = static_cast<size_t>(y * frame.width * 3);
-        raw.insert(
-            raw.end(),
-            frame.data.begin() + static_cast<long>(row_offset),
-            frame.data.begin() + static_cast<long>(row_offset + frame.width * 3));
+        const uint8_t* row = frame.data.data() + static_cast<size_t>(y) * row_size;
+        if (format == PixelFormat::Bgr8) {
+            uint8_t* rgb = rows[y & 1].data();
+            for (size_t x = 0; x < row_size; x += 3) {
+                rgb[x] = row[x + 2];
+                rgb[x + 1] = row[x + 1];
+                rgb[x + 2] = row[x];
+            }
+            row = rgb;
+        }
+        const uint8_t* prior = nullptr;
+        if (y > 0) {
+            prior = format == PixelFormat::Bgr8
+                ? rows[(y - 1) & 1].data()
+                : frame.data.data() + static_cast<size_t>(y - 1) * row_size;
+        }
+        filter_row(
+            row,
+            prior,
+            row_size,
+            channels,
+            scratch.data(),
+            raw.data() + static_cast<size_t>(y) * (row_size + 1));
+    }
+
+    // IHDR colour type: 0 grey, 2 RGB, 6 RGBA.
+    uint8_t color_type = 2;
+    if (format == PixelFormat::Mono8) {
+        color_type = 0;
+    } else if (format == PixelFormat::Rgba8) {
+        color_type = 6;
     }
 
-    std::vector<uint8_t> png {
-        0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'
-    };
+    out.assign({0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'});
 
     std::vector<uint8_t> ihdr;
     append_be32(ihdr, static_cast<uint32_t>(frame.width));
     append_be32(ihdr, static_cast<uint32_t>(frame.height));
     ihdr.push_back(8);
-    ihdr.push_back(2);
+    ihdr.push_back(color_type);
     ihdr.push_back(0);
     ihdr.push_back(0);
     ihdr.push_back(0);
-    append_chunk(png, "IHDR", ihdr);
+    append_chunk(out, "IHDR", ihdr);
 
-    append_chunk(png, "IDAT", zlib_store(raw));
-    append_chunk(png, "IEND", {});
+    std::vector<uint8_t> idat;
+    ZlibCompress(raw.data(), raw.size(), compression_level, idat);
+    append_chunk(out, "IDAT", idat);
+    append_chunk(out, "IEND", {});
+    return true;
+}
+
+bool WriteImageFrameToPng(
+    const ImageFrame& frame,
+    const std::filesystem::path& path,
+    int compression_level)
+{
+    std::vector<uint8_t> png;
+    if (!EncodeImageFrameToPng(frame, png, compression_level)) {
+        return false;
+    }
+
+    if (!path.parent_path().empty()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
 
     std::ofstream ofs(path, std::ios::binary);
     if (!ofs.is_open()) {
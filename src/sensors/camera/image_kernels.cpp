@@ -0,0 +1,529 @@
+#include "sensors/camera/image_kernels.hpp"
+#include "sensors/common/simd.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace hako::robots::sensor::camera
+{
+namespace
+{
+// BT.601 weights in 8-bit fixed point; they sum to 256 so white stays 255.
+constexpr int kLumaR = 77;
+constexpr int kLumaG = 150;
+constexpr int kLumaB = 29;
+
+inline std::uint8_t Luma(const std::uint8_t* px)
+{
+    return static_cast<std::uint8_t>((kLumaR * px[0] + kLumaG * px[1] + kLumaB * px[2] + 128) >> 8);
+}
+
+// BT.601 video range RGB -> UYVY for one pixel pair. The chroma of a pair is
+// taken from the sum of both pixels, hence the extra bit in its shift. The
+// results stay within 16-235 (Y) and 16-240 (U, V), so no clamping is needed.
+void RgbPairToUyvy(const std::uint8_t* px, std::uint8_t* dst)
+{
+    const int r0 = px[0], g0 = px[1], b0 = px[2];
+    const int r1 = px[3], g1 = px[4], b1 = px[5];
+    const int r = r0 + r1, g = g0 + g1, b = b0 + b1;
+    dst[0] = static_cast<std::uint8_t>(((-38 * r - 74 * g + 112 * b + 256) >> 9) + 128);
+    dst[1] = static_cast<std::uint8_t>(((66 * r0 + 129 * g0 + 25 * b0 + 128) >> 8) + 16);
+    dst[2] = static_cast<std::uint8_t>(((112 * r - 94 * g - 18 * b + 256) >> 9) + 128);
+    dst[3] = static_cast<std::uint8_t>(((66 * r1 + 129 * g1 + 25 * b1 + 128) >> 8) + 16);
+}
+
+void RgbToBgrScalar(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    for (int x = 0; x < width; ++x, rgb += 3, dst += 3) {
+        dst[0] = rgb[2];
+        dst[1] = rgb[1];
+        dst[2] = rgb[0];
+    }
+}
+
+void RgbToMono8Scalar(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    for (int x = 0; x < width; ++x, rgb += 3) {
+        dst[x] = Luma(rgb);
+    }
+}
+
+void RgbToRgbaScalar(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    for (int x = 0; x < width; ++x, rgb += 3, dst += 4) {
+        dst[0] = rgb[0];
+        dst[1] = rgb[1];
+        dst[2] = rgb[2];
+        dst[3] = 255;
+    }
+}
+
+void RgbToYuv422Scalar(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    for (int x = 0; x + 1 < width; x += 2, rgb += 6, dst += 4) {
+        RgbPairToUyvy(rgb, dst);
+    }
+}
+
+#if defined(HAKO_SIMD_AVX2)
+using ShuffleMask = std::array<std::int8_t, 16>;
+
+// Byte shuffle that swaps R and B of the five pixels in a 16-byte block;
+// the last byte is left over and rewritten by the next block.
+constexpr ShuffleMask MakeBgrMask()
+{
+    ShuffleMask mask {};
+    for (int i = 0; i < 15; ++i) {
+        mask[i] = static_cast<std::int8_t>(3 * (i / 3) + 2 - i % 3);
+    }
+    mask[15] = -128;
+    return mask;
+}
+
+// Gathers `channel` of 16 RGB pixels from the 16-byte block `block` of 48.
+constexpr ShuffleMask MakePlanarMask(int channel, int block)
+{
+    ShuffleMask mask {};
+    for (int p = 0; p < 16; ++p) {
+        const int source = 3 * p + channel;
+        mask[p] = static_cast<std::int8_t>(source / 16 == block ? source % 16 : -128);
+    }
+    return mask;
+}
+
+// Spreads four RGB pixels into RGBx.
+constexpr ShuffleMask MakeRgbaMask()
+{
+    ShuffleMask mask {};
+    for (int i = 0; i < 16; ++i) {
+        mask[i] = static_cast<std::int8_t>(i % 4 == 3 ? -128 : 3 * (i / 4) + i % 4);
+    }
+    return mask;
+}
+
+constexpr ShuffleMask kBgrMask = MakeBgrMask();
+constexpr ShuffleMask kRgbaMask = MakeRgbaMask();
+constexpr std::array<std::array<ShuffleMask, 3>, 3> kPlanarMasks {{
+    {MakePlanarMask(0, 0), MakePlanarMask(0, 1), MakePlanarMask(0, 2)},
+    {MakePlanarMask(1, 0), MakePlanarMask(1, 1), MakePlanarMask(1, 2)},
+    {MakePlanarMask(2, 0), MakePlanarMask(2, 1), MakePlanarMask(2, 2)},
+}};
+
+// Lane masks selecting the bytes of one channel from a 32-byte load at
+// offset load*32 into data with `stride` interleaved channels. For stride 3
+// the pattern repeats every three loads, otherwise every load.
+struct SumMasks
+{
+    std::uint8_t bytes[3][4][32];
+};
+
+constexpr SumMasks MakeSumMasks(int stride)
+{
+    SumMasks masks {};
+    for (int load = 0; load < 3; ++load) {
+        for (int channel = 0; channel < 4; ++channel) {
+            for (int i = 0; i < 32; ++i) {
+                masks.bytes[load][channel][i] = (load * 32 + i) % stride == channel ? 0xFF : 0x00;
+            }
+        }
+    }
+    return masks;
+}
+
+constexpr std::array<SumMasks, 4> kSumMasks {
+    MakeSumMasks(1), MakeSumMasks(2), MakeSumMasks(3), MakeSumMasks(4)};
+
+HAKO_SIMD_TARGET_AVX2
+inline __m256i BroadcastMask(const ShuffleMask& mask)
+{
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mask.data())));
+}
+
+HAKO_SIMD_TARGET_AVX2
+inline __m256i LoadLanes(const std::uint8_t* low, const std::uint8_t* high)
+{
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(low))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(high)),
+        1);
+}
+
+// Ten pixels per step: five in each 128-bit lane. A step reads and writes
+// 31 bytes, so it needs one pixel beyond the ten it converts.
+HAKO_SIMD_TARGET_AVX2
+int RgbToBgrAvx2(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    const __m256i mask = BroadcastMask(kBgrMask);
+    int x = 0;
+    for (; x + 11 <= width; x += 10) {
+        const std::uint8_t* src = rgb + 3 * x;
+        std::uint8_t* out = dst + 3 * x;
+        const __m256i swapped = _mm256_shuffle_epi8(LoadLanes(src, src + 15), mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(swapped));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 15), _mm256_extracti128_si256(swapped, 1));
+    }
+    return x;
+}
+
+// The weighted sum peaks at 65408, so unsigned 16-bit lanes suffice.
+HAKO_SIMD_TARGET_AVX2
+inline __m256i LumaAvx2(__m256i r, __m256i g, __m256i b)
+{
+    __m256i sum = _mm256_add_epi16(
+        _mm256_mullo_epi16(r, _mm256_set1_epi16(kLumaR)), _mm256_mullo_epi16(g, _mm256_set1_epi16(kLumaG)));
+    sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(b, _mm256_set1_epi16(kLumaB)));
+    return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(128)), 8);
+}
+
+// 32 pixels per step: each lane deinterleaves 16 pixels into R, G and B
+// bytes, which are widened to 16 bits for the weighted sum.
+HAKO_SIMD_TARGET_AVX2
+int RgbToMono8Avx2(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    __m256i masks[3][3];
+    for (int c = 0; c < 3; ++c) {
+        for (int b = 0; b < 3; ++b) {
+            masks[c][b] = BroadcastMask(kPlanarMasks[c][b]);
+        }
+    }
+    const __m256i zero = _mm256_setzero_si256();
+
+    int x = 0;
+    for (; x + 32 <= width; x += 32) {
+        const std::uint8_t* src = rgb + 3 * x;
+        const __m256i blocks[3] = {
+            LoadLanes(src, src + 48),
+            LoadLanes(src + 16, src + 64),
+            LoadLanes(src + 32, src + 80),
+        };
+        __m256i planes[3];
+        for (int c = 0; c < 3; ++c) {
+            planes[c] = _mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_shuffle_epi8(blocks[0], masks[c][0]),
+                    _mm256_shuffle_epi8(blocks[1], masks[c][1])),
+                _mm256_shuffle_epi8(blocks[2], masks[c][2]));
+        }
+        const __m256i low = LumaAvx2(
+            _mm256_unpacklo_epi8(planes[0], zero),
+            _mm256_unpacklo_epi8(planes[1], zero),
+            _mm256_unpacklo_epi8(planes[2], zero));
+        const __m256i high = LumaAvx2(
+            _mm256_unpackhi_epi8(planes[0], zero),
+            _mm256_unpackhi_epi8(planes[1], zero),
+            _mm256_unpackhi_epi8(planes[2], zero));
+        // Per lane: unpacklo holds pixels 0-7, unpackhi 8-15, so the pack
+        // restores pixel order.
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), _mm256_packus_epi16(low, high));
+    }
+    return x;
+}
+
+// Eight pixels per step, four per lane; a lane reads 16 of its 12 bytes, so
+// the step needs two pixels beyond the eight it converts.
+HAKO_SIMD_TARGET_AVX2
+int RgbToRgbaAvx2(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    const __m256i mask = BroadcastMask(kRgbaMask);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000U));
+    int x = 0;
+    for (; x + 10 <= width; x += 8) {
+        const std::uint8_t* src = rgb + 3 * x;
+        const __m256i rgba = _mm256_or_si256(_mm256_shuffle_epi8(LoadLanes(src, src + 12), mask), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * x), rgba);
+    }
+    return x;
+}
+
+// _mm256_sad_epu8 against zero adds each group of eight masked bytes into a
+// 64-bit lane, so the per-channel accumulators cannot overflow.
+HAKO_SIMD_TARGET_AVX2
+std::size_t SumInterleavedBytesAvx2(
+    const std::uint8_t* data, std::size_t groups, int stride, std::uint64_t* sums)
+{
+    const SumMasks& table = kSumMasks[static_cast<std::size_t>(stride - 1)];
+    const int loads = stride == 3 ? 3 : 1;
+    const std::size_t step_bytes = static_cast<std::size_t>(32 * loads);
+    const std::size_t bytes = groups * static_cast<std::size_t>(stride);
+
+    __m256i masks[3][4];
+    __m256i acc[4];
+    for (int c = 0; c < stride; ++c) {
+        for (int l = 0; l < loads; ++l) {
+            masks[l][c] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.bytes[l][c]));
+        }
+        acc[c] = _mm256_setzero_si256();
+    }
+    const __m256i zero = _mm256_setzero_si256();
+
+    std::size_t offset = 0;
+    for (; offset + step_bytes <= bytes; offset += step_bytes) {
+        for (int l = 0; l < loads; ++l) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + 32 * l));
+            for (int c = 0; c < stride; ++c) {
+                acc[c] = _mm256_add_epi64(acc[c], _mm256_sad_epu8(_mm256_and_si256(v, masks[l][c]), zero));
+            }
+        }
+    }
+    for (int c = 0; c < stride; ++c) {
+        alignas(32) std::uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc[c]);
+        sums[c] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    return offset / static_cast<std::size_t>(stride);
+}
+#endif
+
+#if defined(HAKO_SIMD_NEON)
+int RgbToBgrNeon(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x3_t px = vld3q_u8(rgb + 3 * x);
+        const uint8x16_t r = px.val[0];
+        px.val[0] = px.val[2];
+        px.val[2] = r;
+        vst3q_u8(dst + 3 * x, px);
+    }
+    return x;
+}
+
+int RgbToMono8Neon(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    const uint8x8_t weight_r = vdup_n_u8(kLumaR);
+    const uint8x8_t weight_g = vdup_n_u8(kLumaG);
+    const uint8x8_t weight_b = vdup_n_u8(kLumaB);
+    const uint16x8_t round = vdupq_n_u16(128);
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16x3_t px = vld3q_u8(rgb + 3 * x);
+        uint16x8_t low = vmlal_u8(round, vget_low_u8(px.val[0]), weight_r);
+        low = vmlal_u8(low, vget_low_u8(px.val[1]), weight_g);
+        low = vmlal_u8(low, vget_low_u8(px.val[2]), weight_b);
+        uint16x8_t high = vmlal_u8(round, vget_high_u8(px.val[0]), weight_r);
+        high = vmlal_u8(high, vget_high_u8(px.val[1]), weight_g);
+        high = vmlal_u8(high, vget_high_u8(px.val[2]), weight_b);
+        vst1q_u8(dst + x, vcombine_u8(vshrn_n_u16(low, 8), vshrn_n_u16(high, 8)));
+    }
+    return x;
+}
+
+int RgbToRgbaNeon(const std::uint8_t* rgb, int width, std::uint8_t* dst)
+{
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16x3_t px = vld3q_u8(rgb + 3 * x);
+        uint8x16x4_t rgba;
+        rgba.val[0] = px.val[0];
+        rgba.val[1] = px.val[1];
+        rgba.val[2] = px.val[2];
+        rgba.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + 4 * x, rgba);
+    }
+    return x;
+}
+
+// Pairwise widening adds into 32-bit lanes; flushed to the 64-bit sums
+// before a lane can reach 2^32 (1020 per step).
+template <int Stride>
+std::size_t SumInterleavedBytesNeon(const std::uint8_t* data, std::size_t groups, std::uint64_t* sums)
+{
+    constexpr std::size_t kFlushSteps = 1U << 20;
+    std::size_t g = 0;
+    while (g + 16 <= groups) {
+        uint32x4_t acc[Stride];
+        for (int c = 0; c < Stride; ++c) {
+            acc[c] = vdupq_n_u32(0);
+        }
+        for (std::size_t step = 0; step < kFlushSteps && g + 16 <= groups; ++step, g += 16) {
+            const std::uint8_t* src = data + g * Stride;
+            uint8x16_t v[Stride];
+            if constexpr (Stride == 1) {
+                v[0] = vld1q_u8(src);
+            } else if constexpr (Stride == 2) {
+                const uint8x16x2_t px = vld2q_u8(src);
+                v[0] = px.val[0];
+                v[1] = px.val[1];
+            } else if constexpr (Stride == 3) {
+                const uint8x16x3_t px = vld3q_u8(src);
+                v[0] = px.val[0];
+                v[1] = px.val[1];
+                v[2] = px.val[2];
+            } else {
+                const uint8x16x4_t px = vld4q_u8(src);
+                v[0] = px.val[0];
+                v[1] = px.val[1];
+                v[2] = px.val[2];
+                v[3] = px.val[3];
+            }
+            for (int c = 0; c < Stride; ++c) {
+                acc[c] = vpadalq_u16(acc[c], vpaddlq_u8(v[c]));
+            }
+        }
+        for (int c = 0; c < Stride; ++c) {
+            sums[c] += vaddlvq_u32(acc[c]);
+        }
+    }
+    return g;
+}
+#endif
+
+int ConvertRgbRowSimd(const std::uint8_t* rgb, int width, PixelFormat format, std::uint8_t* dst)
+{
+#if defined(HAKO_SIMD_AVX2)
+    if (common::SimdAvx2Enabled()) {
+        switch (format) {
+        case PixelFormat::Bgr8:
+            return RgbToBgrAvx2(rgb, width, dst);
+        case PixelFormat::Mono8:
+            return RgbToMono8Avx2(rgb, width, dst);
+        case PixelFormat::Rgba8:
+            return RgbToRgbaAvx2(rgb, width, dst);
+        default:
+            return 0;
+        }
+    }
+#elif defined(HAKO_SIMD_NEON)
+    if (common::SimdNeonEnabled()) {
+        switch (format) {
+        case PixelFormat::Bgr8:
+            return RgbToBgrNeon(rgb, width, dst);
+        case PixelFormat::Mono8:
+            return RgbToMono8Neon(rgb, width, dst);
+        case PixelFormat::Rgba8:
+            return RgbToRgbaNeon(rgb, width, dst);
+        default:
+            return 0;
+        }
+    }
+#endif
+    (void)rgb;
+    (void)width;
+    (void)format;
+    (void)dst;
+    return 0;
+}
+}
+
+bool ParsePixelFormat(const std::string& name, PixelFormat& out)
+{
+    if (name == "R8G8B8") {
+        out = PixelFormat::Rgb8;
+    } else if (name == "B8G8R8") {
+        out = PixelFormat::Bgr8;
+    } else if (name == "L8") {
+        out = PixelFormat::Mono8;
+    } else if (name == "R8G8B8A8") {
+        out = PixelFormat::Rgba8;
+    } else if (name == "YUV422") {
+        out = PixelFormat::Yuv422;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int PixelFormatBytesPerPixel(PixelFormat format)
+{
+    switch (format) {
+    case PixelFormat::Rgb8:
+    case PixelFormat::Bgr8:
+        return 3;
+    case PixelFormat::Mono8:
+        return 1;
+    case PixelFormat::Rgba8:
+        return 4;
+    case PixelFormat::Yuv422:
+        return 2;
+    }
+    return 0;
+}
+
+namespace detail
+{
+void ConvertRgbRowScalar(const std::uint8_t* rgb, int width, PixelFormat format, std::uint8_t* dst)
+{
+    switch (format) {
+    case PixelFormat::Rgb8:
+        std::memcpy(dst, rgb, static_cast<std::size_t>(width) * 3);
+        break;
+    case PixelFormat::Bgr8:
+        RgbToBgrScalar(rgb, width, dst);
+        break;
+    case PixelFormat::Mono8:
+        RgbToMono8Scalar(rgb, width, dst);
+        break;
+    case PixelFormat::Rgba8:
+        RgbToRgbaScalar(rgb, width, dst);
+        break;
+    case PixelFormat::Yuv422:
+        RgbToYuv422Scalar(rgb, width, dst);
+        break;
+    }
+}
+
+void SumInterleavedBytesScalar(const std::uint8_t* data, std::size_t groups, int stride, std::uint64_t* sums)
+{
+    for (std::size_t g = 0; g < groups; ++g, data += stride) {
+        for (int c = 0; c < stride; ++c) {
+            sums[c] += data[c];
+        }
+    }
+}
+}
+
+// The dispatchers run the vector kernel over whole steps and leave the rest
+// of the row to the scalar loop. RGB8 is a plain copy and YUV422 stays scalar.
+void ConvertRgbRow(const std::uint8_t* rgb, int width, PixelFormat format, std::uint8_t* dst)
+{
+    const int done = ConvertRgbRowSimd(rgb, width, format, dst);
+    const int bytes_per_pixel = PixelFormatBytesPerPixel(format);
+    detail::ConvertRgbRowScalar(
+        rgb + static_cast<std::size_t>(done) * 3,
+        width - done,
+        format,
+        dst + static_cast<std::size_t>(done) * static_cast<std::size_t>(bytes_per_pixel));
+}
+
+void FlipRows(const std::uint8_t* src, std::size_t src_stride, std::size_t row_bytes, int rows, std::uint8_t* dst)
+{
+    for (int y = 0; y < rows; ++y) {
+        std::memcpy(
+            dst + static_cast<std::size_t>(y) * row_bytes,
+            src + static_cast<std::size_t>(rows - 1 - y) * src_stride,
+            row_bytes);
+    }
+}
+
+void SumInterleavedBytes(const std::uint8_t* data, std::size_t groups, int stride, std::uint64_t* sums)
+{
+    if (stride < 1 || stride > 4) {
+        return;
+    }
+    std::size_t done = 0;
+#if defined(HAKO_SIMD_AVX2)
+    if (common::SimdAvx2Enabled()) {
+        done = SumInterleavedBytesAvx2(data, groups, stride, sums);
+    }
+#elif defined(HAKO_SIMD_NEON)
+    if (common::SimdNeonEnabled()) {
+        switch (stride) {
+        case 1:
+            done = SumInterleavedBytesNeon<1>(data, groups, sums);
+            break;
+        case 2:
+            done = SumInterleavedBytesNeon<2>(data, groups, sums);
+            break;
+        case 3:
+            done = SumInterleavedBytesNeon<3>(data, groups, sums);
+            break;
+        default:
+            done = SumInterleavedBytesNeon<4>(data, groups, sums);
+            break;
+        }
+    }
+#endif
+    detail::SumInterleavedBytesScalar(
+        data + done * static_cast<std::size_t>(stride), groups - done, stride, sums);
+}
+}
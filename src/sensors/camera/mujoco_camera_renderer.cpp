@@ -1,5 +1,8 @@
 #include "sensors/camera/mujoco_camera_renderer.hpp"
+#include "sensors/camera/glfw_manager.hpp"
+#include "sensors/camera/image_kernels.hpp"
 #include <stdexcept>
+#include <cstddef>
 #include <iostream>
 #include <cmath>
 #include <cstring>
@@ -10,6 +13,36 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+// Buffer object (GL 1.5) declarations for the pixel buffer path. The GL
+// headers only guarantee GL 1.1 (the Windows SDK has no glext.h), so the
+// enums and entry point types are declared here and the functions are
+// loaded at run time.
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_READ_ONLY
+#define GL_READ_ONLY 0x88B8
+#endif
+#if defined(_WIN32)
+#define HAKO_GL_APIENTRY __stdcall
+#else
+#define HAKO_GL_APIENTRY
+#endif
+
+namespace
+{
+using GlSizeIPtr = std::ptrdiff_t;
+using GlGenBuffersProc = void (HAKO_GL_APIENTRY*)(GLsizei n, GLuint* buffers);
+using GlDeleteBuffersProc = void (HAKO_GL_APIENTRY*)(GLsizei n, const GLuint* buffers);
+using GlBindBufferProc = void (HAKO_GL_APIENTRY*)(GLenum target, GLuint buffer);
+using GlBufferDataProc = void (HAKO_GL_APIENTRY*)(GLenum target, GlSizeIPtr size, const void* data, GLenum usage);
+using GlMapBufferProc = void* (HAKO_GL_APIENTRY*)(GLenum target, GLenum access);
+using GlUnmapBufferProc = GLboolean (HAKO_GL_APIENTRY*)(GLenum target);
+}
+
 namespace hako::robots::sensor::camera
 {
 namespace
@@ -78,8 +111,56 @@ private:
     float original_zfar_;
     bool active_;
 };
+
+// Switches the scene to segmentation rendering with ids encoded in the
+// colour (see DecodeSegmentationTile) and restores the flags afterwards.
+class SceneSegmentationGuard
+{
+public:
+    explicit SceneSegmentationGuard(mjvScene& scene)
+        : scene_(scene),
+          original_segment_(scene.flags[mjRND_SEGMENT]),
+          original_idcolor_(scene.flags[mjRND_IDCOLOR])
+    {
+        scene_.flags[mjRND_SEGMENT] = 1;
+        scene_.flags[mjRND_IDCOLOR] = 1;
+    }
+
+    ~SceneSegmentationGuard()
+    {
+        scene_.flags[mjRND_SEGMENT] = original_segment_;
+        scene_.flags[mjRND_IDCOLOR] = original_idcolor_;
+    }
+
+    SceneSegmentationGuard(const SceneSegmentationGuard&) = delete;
+    SceneSegmentationGuard& operator=(const SceneSegmentationGuard&) = delete;
+
+private:
+    mjvScene& scene_;
+    mjtByte original_segment_;
+    mjtByte original_idcolor_;
+};
+
+mjtNum VerticalFovDeg(double hfov_rad, int width, int height)
+{
+    const double vfov_rad = 2.0 * std::atan(std::tan(hfov_rad / 2.0) * (height / static_cast<double>(width)));
+    return static_cast<mjtNum>(vfov_rad * 180.0 / M_PI);
+}
 }
 
+// Buffer object entry points resolved through the context's loader. With
+// EGL or OSMesa the libGL exports do not reach the current context.
+struct MujocoCameraRenderer::PixelBufferApi
+{
+    GlGenBuffersProc gen_buffers = nullptr;
+    GlDeleteBuffersProc delete_buffers = nullptr;
+    GlBindBufferProc bind_buffer = nullptr;
+    GlBufferDataProc buffer_data = nullptr;
+    GlMapBufferProc map_buffer = nullptr;
+    GlUnmapBufferProc unmap_buffer = nullptr;
+    decltype(&glFlush) flush = nullptr;
+};
+
 MujocoCameraRenderer::MujocoCameraRenderer(std::shared_ptr<hako::robots::physics::IWorld> world)
     : MujocoCameraRenderer(std::move(world), true)
 {
@@ -88,29 +169,36 @@ MujocoCameraRenderer::MujocoCameraRenderer(std::shared_ptr<hako::robots::physics
 MujocoCameraRenderer::MujocoCameraRenderer(
     std::shared_ptr<hako::robots::physics::IWorld> world,
     bool create_hidden_window)
-    : world_(world), glfw_manager_(GlfwManager::getInstance()), window_(nullptr)
+    : world_(world)
 {
     if (!world) {
         throw std::invalid_argument("World is null");
     }
     if (create_hidden_window) {
-        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-        window_ = glfwCreateWindow(1, 1, "Offscreen", nullptr, nullptr);
-        if (!window_) {
-            throw std::runtime_error(
-                "Failed to create hidden GLFW window for MuJoCo offscreen rendering. "
-                "Ensure an OpenGL-capable display/GPU context is available."
-            );
-        }
-        owns_window_ = true;
-        glfwMakeContextCurrent(window_);
+        context_ = CreateRenderContext(DefaultRenderBackend());
     } else if (glfwGetCurrentContext() == nullptr) {
         throw std::runtime_error(
             "MujocoCameraRenderer was asked to use the current OpenGL context, "
             "but no GLFW context is current."
         );
     }
+    InitializeMujocoContext();
+}
 
+MujocoCameraRenderer::MujocoCameraRenderer(
+    std::shared_ptr<hako::robots::physics::IWorld> world,
+    RenderBackend backend)
+    : world_(world)
+{
+    if (!world) {
+        throw std::invalid_argument("World is null");
+    }
+    context_ = CreateRenderContext(backend);
+    InitializeMujocoContext();
+}
+
+void MujocoCameraRenderer::InitializeMujocoContext()
+{
     auto* model = world_->getModel();
     mjv_defaultCamera(&cam_);
     mjv_defaultOption(&opt_);
@@ -122,28 +210,87 @@ MujocoCameraRenderer::MujocoCameraRenderer(
 
 MujocoCameraRenderer::~MujocoCameraRenderer()
 {
+    MakeContextCurrent();
+    if (!pbo_ids_.empty()) {
+        ReleasePixelBuffers();
+    }
     mjv_freeScene(&scn_);
     mjr_freeContext(&con_);
-    if (owns_window_ && window_) {
-        glfwDestroyWindow(window_);
+    // context_ is destroyed after the MuJoCo resources living in it.
+}
+
+void MujocoCameraRenderer::MakeContextCurrent()
+{
+    if (context_) {
+        context_->MakeCurrent();
     }
 }
 
-bool MujocoCameraRenderer::Render(
-    const std::string& camera_name, int width, int height, double hfov_rad,
-    double clip_near_m, double clip_far_m,
-    bool need_rgb, bool need_depth, RawCameraFrame& out)
+void MujocoCameraRenderer::ReleaseContext()
 {
-    if (!need_rgb && !need_depth) return false;
+    if (context_) {
+        context_->ReleaseCurrent();
+    }
+}
 
-    if (window_ != nullptr) {
-        glfwMakeContextCurrent(window_);
+bool MujocoCameraRenderer::LoadPixelBufferApi()
+{
+    if (pbo_api_) {
+        return true;
     }
+    const auto load = [this](const char* name) -> void* {
+        if (context_) {
+            return context_->GetProcAddress(name);
+        }
+        return reinterpret_cast<void*>(glfwGetProcAddress(name));
+    };
+    auto api = std::make_unique<PixelBufferApi>();
+    api->gen_buffers = reinterpret_cast<GlGenBuffersProc>(load("glGenBuffers"));
+    api->delete_buffers = reinterpret_cast<GlDeleteBuffersProc>(load("glDeleteBuffers"));
+    api->bind_buffer = reinterpret_cast<GlBindBufferProc>(load("glBindBuffer"));
+    api->buffer_data = reinterpret_cast<GlBufferDataProc>(load("glBufferData"));
+    api->map_buffer = reinterpret_cast<GlMapBufferProc>(load("glMapBuffer"));
+    api->unmap_buffer = reinterpret_cast<GlUnmapBufferProc>(load("glUnmapBuffer"));
+    api->flush = reinterpret_cast<decltype(&glFlush)>(load("glFlush"));
+    if (!api->gen_buffers || !api->delete_buffers || !api->bind_buffer || !api->buffer_data ||
+        !api->map_buffer || !api->unmap_buffer || !api->flush)
+    {
+        std::cerr << "OpenGL pixel buffer objects are not available." << std::endl;
+        return false;
+    }
+    pbo_api_ = std::move(api);
+    return true;
+}
+
+bool MujocoCameraRenderer::BeginOffscreen()
+{
+    MakeContextCurrent();
+    // A pointer handed out by RenderRgbPipelined() is only valid until here.
+    UnmapPixelBuffer();
     mjr_setBuffer(mjFB_OFFSCREEN, &con_);
     if (con_.currentBuffer != mjFB_OFFSCREEN) {
         std::cerr << "Offscreen rendering is not available." << std::endl;
         return false;
     }
+    return true;
+}
+
+hako::robots::physics::CameraHandle MujocoCameraRenderer::FindCamera(const std::string& camera_name) const
+{
+    const auto camera = world_->getRegistry()->findCamera(camera_name);
+    if (!camera.valid()) {
+        std::cerr << "Camera not found: " << camera_name << std::endl;
+    }
+    return camera;
+}
+
+bool MujocoCameraRenderer::RenderScene(
+    const hako::robots::physics::CameraHandle& camera, int width, int height, double hfov_rad,
+    double clip_near_m, double clip_far_m, RawCameraFrame& out)
+{
+    if (!BeginOffscreen()) {
+        return false;
+    }
 
     if (width > con_.offWidth || height > con_.offHeight) {
         std::cerr << "Requested camera image size " << width << "x" << height
@@ -154,9 +301,9 @@ bool MujocoCameraRenderer::Render(
 
     auto* model = world_->getModel();
     auto* data = world_->getData();
-    int cam_id = mj_name2id(model, mjOBJ_CAMERA, camera_name.c_str());
-    if (cam_id < 0) {
-        std::cerr << "Camera not found: " << camera_name << std::endl;
+    const int cam_id = camera.id;
+    if (cam_id < 0 || cam_id >= model->ncam) {
+        std::cerr << "Invalid camera id: " << cam_id << std::endl;
         return false;
     }
 
@@ -170,9 +317,8 @@ bool MujocoCameraRenderer::Render(
     // single-threaded sensor updates.
     std::unique_ptr<CameraFovyOverrideGuard> fovy_override_guard;
     if (width > 0 && height > 0) {
-        const double vfov_rad = 2.0 * std::atan(std::tan(hfov_rad / 2.0) * (height / static_cast<double>(width)));
         fovy_override_guard = std::make_unique<CameraFovyOverrideGuard>(
-            model, cam_id, static_cast<mjtNum>(vfov_rad * 180.0 / M_PI));
+            model, cam_id, VerticalFovDeg(hfov_rad, width, height));
     }
 
     mjrRect viewport = {0, 0, width, height};
@@ -185,46 +331,339 @@ bool MujocoCameraRenderer::Render(
     out.znear = static_cast<double>(model->vis.map.znear) * extent;
     out.zfar = static_cast<double>(model->vis.map.zfar) * extent;
     out.depth_map = con_.readDepthMap;
+    out.timestamp = data->time;
+    return true;
+}
 
+bool MujocoCameraRenderer::Render(
+    const hako::robots::physics::CameraHandle& camera, int width, int height, double hfov_rad,
+    double clip_near_m, double clip_far_m,
+    bool need_rgb, bool need_depth, RawCameraFrame& out)
+{
+    if (!need_rgb && !need_depth) return false;
+    if (!RenderScene(camera, width, height, hfov_rad, clip_near_m, clip_far_m, out)) {
+        return false;
+    }
+
+    const std::size_t pixels = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
     if (need_rgb) {
-        out.rgb.resize(width * height * 3);
+        read_rgb_.resize(pixels * 3);
     }
     if (need_depth) {
-        out.depth_buffer.resize(width * height);
+        read_depth_.resize(pixels);
     }
-
+    mjrRect viewport = {0, 0, width, height};
     mjr_readPixels(
-        need_rgb ? out.rgb.data() : nullptr,
-        need_depth ? out.depth_buffer.data() : nullptr,
+        need_rgb ? read_rgb_.data() : nullptr,
+        need_depth ? read_depth_.data() : nullptr,
         viewport,
         &con_
     );
 
+    // OpenGL rows are bottom-up; flip straight into the caller's buffers,
+    // which keep their capacity when the caller reuses the frame.
     if (need_rgb) {
-        std::vector<uint8_t> flipped_rgb(out.rgb.size());
-        int row_size = width * 3;
-        for (int y = 0; y < height; ++y) {
-            std::memcpy(
-                flipped_rgb.data() + y * row_size,
-                out.rgb.data() + (height - 1 - y) * row_size,
-                row_size);
-        }
-        out.rgb = std::move(flipped_rgb);
+        const std::size_t row_size = static_cast<std::size_t>(width) * 3;
+        out.rgb.resize(pixels * 3);
+        FlipRows(read_rgb_.data(), row_size, row_size, height, out.rgb.data());
     }
 
     if (need_depth) {
-        std::vector<float> flipped_depth(out.depth_buffer.size());
-        for (int y = 0; y < height; ++y) {
-            std::copy_n(
-                out.depth_buffer.data() + (height - 1 - y) * width,
-                width,
-                flipped_depth.data() + y * width
-            );
+        const std::size_t row_size = static_cast<std::size_t>(width) * sizeof(float);
+        out.depth_buffer.resize(pixels);
+        FlipRows(
+            reinterpret_cast<const std::uint8_t*>(read_depth_.data()), row_size, row_size, height,
+            reinterpret_cast<std::uint8_t*>(out.depth_buffer.data()));
+    }
+    return true;
+}
+
+bool MujocoCameraRenderer::RenderRgbBottomUp(
+    const hako::robots::physics::CameraHandle& camera, int width, int height, double hfov_rad,
+    double clip_near_m, double clip_far_m,
+    const uint8_t*& bottom_up_rgb, double& timestamp)
+{
+    bottom_up_rgb = nullptr;
+    RawCameraFrame info;
+    if (!RenderScene(camera, width, height, hfov_rad, clip_near_m, clip_far_m, info)) {
+        return false;
+    }
+    read_rgb_.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 3);
+    mjrRect viewport = {0, 0, width, height};
+    mjr_readPixels(read_rgb_.data(), nullptr, viewport, &con_);
+    bottom_up_rgb = read_rgb_.data();
+    timestamp = info.timestamp;
+    return true;
+}
+
+void MujocoCameraRenderer::UnmapPixelBuffer()
+{
+    if (mapped_pbo_ < 0) {
+        return;
+    }
+    pbo_api_->bind_buffer(GL_PIXEL_PACK_BUFFER, pbo_ids_[static_cast<std::size_t>(mapped_pbo_)]);
+    pbo_api_->unmap_buffer(GL_PIXEL_PACK_BUFFER);
+    pbo_api_->bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
+    mapped_pbo_ = -1;
+}
+
+void MujocoCameraRenderer::ReleasePixelBuffers()
+{
+    UnmapPixelBuffer();
+    if (!pbo_ids_.empty()) {
+        pbo_api_->delete_buffers(static_cast<GLsizei>(pbo_ids_.size()), pbo_ids_.data());
+    }
+    pbo_ids_.clear();
+    pbo_timestamps_.clear();
+    pbo_width_ = 0;
+    pbo_height_ = 0;
+    pbo_queued_ = 0;
+}
+
+bool MujocoCameraRenderer::RenderRgbPipelined(
+    const hako::robots::physics::CameraHandle& camera, int width, int height, double hfov_rad,
+    double clip_near_m, double clip_far_m, int buffer_count,
+    const uint8_t*& bottom_up_rgb, double& timestamp)
+{
+    bottom_up_rgb = nullptr;
+    buffer_count = std::clamp(buffer_count, 2, 3);
+    if (!LoadPixelBufferApi()) {
+        return false;
+    }
+
+    RawCameraFrame info;
+    if (!RenderScene(camera, width, height, hfov_rad, clip_near_m, clip_far_m, info)) {
+        return false;
+    }
+
+    // mjr_readPixels() passes its rgb pointer to glReadPixels(), which reads
+    // it as a byte offset while a pixel pack buffer is bound. Offset 0 would
+    // be taken as "no rgb", so every buffer keeps one leading pad byte.
+    constexpr std::size_t kPboOffset = 1;
+    const std::size_t frame_bytes = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 3;
+    if (width != pbo_width_ || height != pbo_height_ ||
+        pbo_ids_.size() != static_cast<std::size_t>(buffer_count))
+    {
+        ReleasePixelBuffers();
+        pbo_ids_.assign(static_cast<std::size_t>(buffer_count), 0);
+        pbo_timestamps_.assign(static_cast<std::size_t>(buffer_count), 0.0);
+        pbo_api_->gen_buffers(buffer_count, pbo_ids_.data());
+        for (unsigned int id : pbo_ids_) {
+            pbo_api_->bind_buffer(GL_PIXEL_PACK_BUFFER, id);
+            pbo_api_->buffer_data(
+                GL_PIXEL_PACK_BUFFER,
+                static_cast<GlSizeIPtr>(frame_bytes + kPboOffset),
+                nullptr,
+                GL_STREAM_READ);
+        }
+        pbo_width_ = width;
+        pbo_height_ = height;
+    }
+
+    // Queue the transfer of this frame; glReadPixels returns without waiting.
+    const std::size_t write_index = pbo_queued_ % pbo_ids_.size();
+    mjrRect viewport = {0, 0, width, height};
+    pbo_api_->bind_buffer(GL_PIXEL_PACK_BUFFER, pbo_ids_[write_index]);
+    mjr_readPixels(reinterpret_cast<unsigned char*>(kPboOffset), nullptr, viewport, &con_);
+    pbo_timestamps_[write_index] = info.timestamp;
+    ++pbo_queued_;
+    pbo_api_->flush();
+
+    // Map the oldest queued frame. Its transfer had buffer_count-1 renders to
+    // complete, so mapping normally does not stall. Until the ring is full
+    // there is no such frame yet.
+    if (pbo_queued_ < pbo_ids_.size()) {
+        timestamp = info.timestamp;
+        return true;
+    }
+    const std::size_t read_index = pbo_queued_ % pbo_ids_.size();
+    pbo_api_->bind_buffer(GL_PIXEL_PACK_BUFFER, pbo_ids_[read_index]);
+    const auto* mapped = static_cast<const uint8_t*>(pbo_api_->map_buffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+    pbo_api_->bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (mapped == nullptr) {
+        std::cerr << "Failed to map camera pixel buffer." << std::endl;
+        return false;
+    }
+    mapped_pbo_ = static_cast<int>(read_index);
+    bottom_up_rgb = mapped + kPboOffset;
+    timestamp = pbo_timestamps_[read_index];
+    return true;
+}
+
+void MujocoCameraRenderer::DrawViewTiles(
+    const std::vector<CameraView>& views, int atlas, bool segmentation_pass, std::vector<RawCameraFrame>& out)
+{
+    auto* model = world_->getModel();
+    auto* data = world_->getData();
+    const double extent = static_cast<double>(model->stat.extent);
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        const CameraTile& tile = view_tiles_[i];
+        const CameraView& view = views[i];
+        const bool drawn = segmentation_pass ? view.need_segmentation : (view.need_rgb || view.need_depth);
+        if (tile.atlas != atlas || !drawn) {
+            continue;
+        }
+        // Same model overrides as RenderScene(), scoped to this tile.
+        CameraClipOverrideGuard clip_override_guard(model, view.clip_near_m, view.clip_far_m);
+        CameraFovyOverrideGuard fovy_override_guard(
+            model, view_cam_ids_[i], VerticalFovDeg(view.hfov_rad, view.width, view.height));
+        cam_.fixedcamid = view_cam_ids_[i];
+        mjv_updateCamera(model, data, &cam_, &scn_);
+        mjrRect viewport = {tile.x, tile.y, tile.width, tile.height};
+        mjr_render(viewport, &scn_, &con_);
+
+        RawCameraFrame& frame = out[i];
+        frame.width = view.width;
+        frame.height = view.height;
+        frame.znear = static_cast<double>(model->vis.map.znear) * extent;
+        frame.zfar = static_cast<double>(model->vis.map.zfar) * extent;
+        frame.depth_map = con_.readDepthMap;
+        frame.timestamp = data->time;
+    }
+}
+
+void MujocoCameraRenderer::BuildSegmentationTable()
+{
+    segid_to_geom_.assign(static_cast<std::size_t>(scn_.ngeom), -1);
+    for (int i = 0; i < scn_.ngeom; ++i) {
+        const mjvGeom& geom = scn_.geoms[i];
+        if (geom.segid >= 0 && geom.segid < scn_.ngeom && geom.objtype == mjOBJ_GEOM) {
+            segid_to_geom_[static_cast<std::size_t>(geom.segid)] = geom.objid;
+        }
+    }
+}
+
+bool MujocoCameraRenderer::RenderViews(const std::vector<CameraView>& views, std::vector<RawCameraFrame>& out)
+{
+    out.resize(views.size());
+    if (views.empty()) {
+        return true;
+    }
+    auto* model = world_->getModel();
+    auto* data = world_->getData();
+
+    view_tiles_.assign(views.size(), CameraTile {});
+    view_cam_ids_.assign(views.size(), -1);
+    bool need_rgb = false;
+    bool need_depth = false;
+    bool need_segmentation = false;
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        const CameraView& view = views[i];
+        if (!view.need_rgb && !view.need_depth && !view.need_segmentation) {
+            std::cerr << "Camera view " << view.camera_name << " requests no image" << std::endl;
+            return false;
+        }
+        view_cam_ids_[i] = view.camera.id;
+        if (view_cam_ids_[i] < 0 || view_cam_ids_[i] >= model->ncam) {
+            std::cerr << "Camera not found: " << view.camera_name << std::endl;
+            return false;
+        }
+        view_tiles_[i].width = view.width;
+        view_tiles_[i].height = view.height;
+        need_rgb = need_rgb || view.need_rgb;
+        need_depth = need_depth || view.need_depth;
+        need_segmentation = need_segmentation || view.need_segmentation;
+    }
+
+    if (!BeginOffscreen()) {
+        return false;
+    }
+    if (!LayoutCameraTiles(con_.offWidth, con_.offHeight, view_tiles_)) {
+        std::cerr << "Requested camera views do not fit the MuJoCo offscreen buffer size "
+                  << con_.offWidth << "x" << con_.offHeight << std::endl;
+        return false;
+    }
+
+    // The scene (geoms, lights) depends on the physics state only; each view
+    // just replaces the scene camera with mjv_updateCamera().
+    cam_.type = mjCAMERA_FIXED;
+    cam_.fixedcamid = view_cam_ids_[0];
+    mjv_updateScene(model, data, &opt_, nullptr, &cam_, mjCAT_ALL, &scn_);
+
+    // Images a view does not ask for are left empty.
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        if (!views[i].need_rgb) {
+            out[i].rgb.clear();
+        }
+        if (!views[i].need_depth) {
+            out[i].depth_buffer.clear();
+        }
+        if (!views[i].need_segmentation) {
+            out[i].segmentation.clear();
+        }
+    }
+
+    const int atlas_count = CountCameraTileAtlases(view_tiles_);
+    const int color_atlas_count = (need_rgb || need_depth) ? atlas_count : 0;
+    for (int atlas = 0; atlas < color_atlas_count; ++atlas) {
+        DrawViewTiles(views, atlas, false, out);
+
+        int atlas_width = 0;
+        int atlas_height = 0;
+        GetCameraTileAtlasExtent(view_tiles_, atlas, atlas_width, atlas_height);
+        const std::size_t atlas_pixels =
+            static_cast<std::size_t>(atlas_width) * static_cast<std::size_t>(atlas_height);
+        if (need_rgb) {
+            read_rgb_.resize(atlas_pixels * 3);
+        }
+        if (need_depth) {
+            read_depth_.resize(atlas_pixels);
+        }
+        mjrRect read_rect = {0, 0, atlas_width, atlas_height};
+        mjr_readPixels(
+            need_rgb ? read_rgb_.data() : nullptr,
+            need_depth ? read_depth_.data() : nullptr,
+            read_rect,
+            &con_);
+
+        for (std::size_t i = 0; i < views.size(); ++i) {
+            const CameraTile& tile = view_tiles_[i];
+            if (tile.atlas != atlas) {
+                continue;
+            }
+            const std::size_t pixels =
+                static_cast<std::size_t>(tile.width) * static_cast<std::size_t>(tile.height);
+            RawCameraFrame& frame = out[i];
+            if (views[i].need_rgb) {
+                frame.rgb.resize(pixels * 3);
+                CopyCameraTileRows(read_rgb_.data(), atlas_width, 3, tile, frame.rgb.data());
+            }
+            if (views[i].need_depth) {
+                frame.depth_buffer.resize(pixels);
+                CopyCameraTileRows(read_depth_.data(), atlas_width, 1, tile, frame.depth_buffer.data());
+            }
+        }
+    }
+
+    if (!need_segmentation) {
+        return true;
+    }
+
+    // Second pass over the same scene. Segmentation mode draws every object
+    // in a flat colour encoding its segid and turns off lighting, textures,
+    // reflections and multisampling, so no pixel mixes two objects.
+    BuildSegmentationTable();
+    SceneSegmentationGuard segmentation_guard(scn_);
+    for (int atlas = 0; atlas < atlas_count; ++atlas) {
+        DrawViewTiles(views, atlas, true, out);
+
+        int atlas_width = 0;
+        int atlas_height = 0;
+        GetCameraTileAtlasExtent(view_tiles_, atlas, atlas_width, atlas_height);
+        read_rgb_.resize(static_cast<std::size_t>(atlas_width) * static_cast<std::size_t>(atlas_height) * 3);
+        mjrRect read_rect = {0, 0, atlas_width, atlas_height};
+        mjr_readPixels(read_rgb_.data(), nullptr, read_rect, &con_);
+
+        for (std::size_t i = 0; i < views.size(); ++i) {
+            const CameraTile& tile = view_tiles_[i];
+            if (tile.atlas != atlas || !views[i].need_segmentation) {
+                continue;
+            }
+            RawCameraFrame& frame = out[i];
+            frame.segmentation.resize(static_cast<std::size_t>(tile.width) * static_cast<std::size_t>(tile.height));
+            DecodeSegmentationTile(read_rgb_.data(), atlas_width, tile, segid_to_geom_, frame.segmentation.data());
         }
-        out.depth_buffer = std::move(flipped_depth);
     }
-    
-    out.timestamp = data->time;
     return true;
 }
 
@@ -0,0 +1,112 @@
+#include "sensors/camera/render_context.hpp"
+#include "sensors/camera/render_context_backends.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#ifndef HAKO_DEFAULT_RENDER_BACKEND
+#define HAKO_DEFAULT_RENDER_BACKEND "glfw"
+#endif
+
+namespace hako::robots::sensor::camera
+{
+bool ParseRenderBackend(const std::string& name, RenderBackend& out)
+{
+    if (name == "glfw") {
+        out = RenderBackend::Glfw;
+        return true;
+    }
+    if (name == "egl") {
+        out = RenderBackend::Egl;
+        return true;
+    }
+    if (name == "osmesa") {
+        out = RenderBackend::Osmesa;
+        return true;
+    }
+    return false;
+}
+
+const char* RenderBackendName(RenderBackend backend)
+{
+    switch (backend) {
+    case RenderBackend::Glfw:
+        return "glfw";
+    case RenderBackend::Egl:
+        return "egl";
+    case RenderBackend::Osmesa:
+        return "osmesa";
+    }
+    return "unknown";
+}
+
+bool IsRenderBackendAvailable(RenderBackend backend)
+{
+    switch (backend) {
+    case RenderBackend::Glfw:
+        return true;
+    case RenderBackend::Egl:
+#if defined(HAKO_RENDER_WITH_EGL)
+        return true;
+#else
+        return false;
+#endif
+    case RenderBackend::Osmesa:
+#if defined(HAKO_RENDER_WITH_OSMESA)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+RenderBackend DefaultRenderBackend()
+{
+    RenderBackend build_default = RenderBackend::Glfw;
+    if (!ParseRenderBackend(HAKO_DEFAULT_RENDER_BACKEND, build_default)) {
+        build_default = RenderBackend::Glfw;
+    }
+
+    const char* env = std::getenv("HAKO_RENDER_BACKEND");
+    if (env == nullptr || env[0] == '\0') {
+        return build_default;
+    }
+    RenderBackend backend = build_default;
+    if (!ParseRenderBackend(env, backend)) {
+        std::cerr << "WARNING: unknown HAKO_RENDER_BACKEND '" << env
+                  << "', using " << RenderBackendName(build_default) << std::endl;
+        return build_default;
+    }
+    if (!IsRenderBackendAvailable(backend)) {
+        std::cerr << "WARNING: HAKO_RENDER_BACKEND '" << env
+                  << "' is not built in, using " << RenderBackendName(build_default) << std::endl;
+        return build_default;
+    }
+    return backend;
+}
+
+std::unique_ptr<IRenderContext> CreateRenderContext(RenderBackend backend)
+{
+    switch (backend) {
+    case RenderBackend::Glfw:
+        return CreateGlfwRenderContext();
+    case RenderBackend::Egl:
+#if defined(HAKO_RENDER_WITH_EGL)
+        return CreateEglRenderContext();
+#else
+        break;
+#endif
+    case RenderBackend::Osmesa:
+#if defined(HAKO_RENDER_WITH_OSMESA)
+        return CreateOsmesaRenderContext();
+#else
+        break;
+#endif
+    }
+    throw std::runtime_error(
+        std::string("Render backend '") + RenderBackendName(backend) +
+        "' is not built in. Reconfigure with -DHAKO_RENDER_WITH_EGL=ON or -DHAKO_RENDER_WITH_OSMESA=ON.");
+}
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <memory>
+
+#include "sensors/camera/render_context.hpp"
+
+namespace hako::robots::sensor::camera
+{
+    // One factory per backend source file; only the compiled-in ones exist.
+    std::unique_ptr<IRenderContext> CreateGlfwRenderContext();
+#if defined(HAKO_RENDER_WITH_EGL)
+    std::unique_ptr<IRenderContext> CreateEglRenderContext();
+#endif
+#if defined(HAKO_RENDER_WITH_OSMESA)
+    std::unique_ptr<IRenderContext> CreateOsmesaRenderContext();
+#endif
+}
@@ -0,0 +1,159 @@
+#include "sensors/camera/render_context_backends.hpp"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace hako::robots::sensor::camera
+{
+namespace
+{
+constexpr EGLint kMaxDevices = 16;
+
+int RequestedDeviceIndex()
+{
+    const char* env = std::getenv("HAKO_EGL_DEVICE_ID");
+    if (env == nullptr || env[0] == '\0') {
+        return 0;
+    }
+    char* end = nullptr;
+    const long value = std::strtol(env, &end, 10);
+    if (end == env || *end != '\0' || value < 0) {
+        std::cerr << "WARNING: invalid HAKO_EGL_DEVICE_ID '" << env << "', using device 0" << std::endl;
+        return 0;
+    }
+    return static_cast<int>(value);
+}
+
+// Prefer a GPU picked through EGL_EXT_platform_device, then Mesa's
+// surfaceless platform, then whatever the default display is. None of them
+// needs an X server.
+EGLDisplay OpenHeadlessDisplay()
+{
+    const auto query_devices =
+        reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+    const auto get_platform_display =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+    if (query_devices != nullptr && get_platform_display != nullptr) {
+        EGLDeviceEXT devices[kMaxDevices];
+        EGLint count = 0;
+        if (query_devices(kMaxDevices, devices, &count) == EGL_TRUE && count > 0) {
+            const int index = RequestedDeviceIndex();
+            if (index >= count) {
+                throw std::runtime_error(
+                    "HAKO_EGL_DEVICE_ID=" + std::to_string(index) + " but only " +
+                    std::to_string(count) + " EGL device(s) found");
+            }
+            EGLDisplay display = get_platform_display(EGL_PLATFORM_DEVICE_EXT, devices[index], nullptr);
+            if (display != EGL_NO_DISPLAY) {
+                return display;
+            }
+        }
+    }
+#if defined(EGL_PLATFORM_SURFACELESS_MESA)
+    if (get_platform_display != nullptr) {
+        EGLDisplay display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display != EGL_NO_DISPLAY) {
+            return display;
+        }
+    }
+#endif
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+// Desktop OpenGL context without a surface (EGL_KHR_surfaceless_context).
+class EglRenderContext : public IRenderContext
+{
+public:
+    EglRenderContext()
+    {
+        display_ = OpenHeadlessDisplay();
+        if (display_ == EGL_NO_DISPLAY) {
+            throw std::runtime_error("Failed to open an EGL display for headless rendering");
+        }
+        EGLint major = 0;
+        EGLint minor = 0;
+        if (eglInitialize(display_, &major, &minor) != EGL_TRUE) {
+            throw std::runtime_error("Failed to initialize EGL");
+        }
+
+        const EGLint config_attributes[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_ALPHA_SIZE, 8,
+            EGL_DEPTH_SIZE, 24,
+            EGL_STENCIL_SIZE, 8,
+            EGL_NONE
+        };
+        EGLConfig config = nullptr;
+        EGLint config_count = 0;
+        if (eglChooseConfig(display_, config_attributes, &config, 1, &config_count) != EGL_TRUE ||
+            config_count < 1)
+        {
+            throw std::runtime_error("No EGL config supports desktop OpenGL rendering");
+        }
+        if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE) {
+            throw std::runtime_error("EGL does not support the desktop OpenGL API");
+        }
+        context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, nullptr);
+        if (context_ == EGL_NO_CONTEXT) {
+            throw std::runtime_error("Failed to create EGL context");
+        }
+        if (eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_) != EGL_TRUE) {
+            eglDestroyContext(display_, context_);
+            throw std::runtime_error("Failed to make the EGL context current (surfaceless contexts unsupported?)");
+        }
+    }
+
+    ~EglRenderContext() override
+    {
+        if (eglGetCurrentContext() == context_) {
+            eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+        // The display is shared by every context on the device, so it is
+        // left initialized; eglTerminate() would invalidate the others.
+        eglDestroyContext(display_, context_);
+    }
+
+    EglRenderContext(const EglRenderContext&) = delete;
+    EglRenderContext& operator=(const EglRenderContext&) = delete;
+
+    RenderBackend Backend() const override { return RenderBackend::Egl; }
+
+    void MakeCurrent() override
+    {
+        eglBindAPI(EGL_OPENGL_API);
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_);
+    }
+
+    void ReleaseCurrent() override
+    {
+        if (eglGetCurrentContext() == context_) {
+            eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+    }
+
+    void* GetProcAddress(const char* name) const override
+    {
+        return reinterpret_cast<void*>(eglGetProcAddress(name));
+    }
+
+private:
+    EGLDisplay display_ = EGL_NO_DISPLAY;
+    EGLContext context_ = EGL_NO_CONTEXT;
+};
+}
+
+std::unique_ptr<IRenderContext> CreateEglRenderContext()
+{
+    return std::make_unique<EglRenderContext>();
+}
+}
@@ -0,0 +1,66 @@
+#include "sensors/camera/render_context_backends.hpp"
+#include "sensors/camera/glfw_manager.hpp"
+
+#include <stdexcept>
+
+namespace hako::robots::sensor::camera
+{
+namespace
+{
+// Hidden 1x1 window; its default framebuffer is never drawn to.
+class GlfwRenderContext : public IRenderContext
+{
+public:
+    GlfwRenderContext()
+        : glfw_manager_(GlfwManager::getInstance())
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        window_ = glfwCreateWindow(1, 1, "Offscreen", nullptr, nullptr);
+        if (!window_) {
+            throw std::runtime_error(
+                "Failed to create hidden GLFW window for MuJoCo offscreen rendering. "
+                "Ensure an OpenGL-capable display/GPU context is available, "
+                "or use HAKO_RENDER_BACKEND=egl/osmesa on headless hosts."
+            );
+        }
+        glfwMakeContextCurrent(window_);
+    }
+
+    ~GlfwRenderContext() override
+    {
+        if (glfwGetCurrentContext() == window_) {
+            glfwMakeContextCurrent(nullptr);
+        }
+        glfwDestroyWindow(window_);
+    }
+
+    GlfwRenderContext(const GlfwRenderContext&) = delete;
+    GlfwRenderContext& operator=(const GlfwRenderContext&) = delete;
+
+    RenderBackend Backend() const override { return RenderBackend::Glfw; }
+
+    void MakeCurrent() override { glfwMakeContextCurrent(window_); }
+
+    void ReleaseCurrent() override
+    {
+        if (glfwGetCurrentContext() == window_) {
+            glfwMakeContextCurrent(nullptr);
+        }
+    }
+
+    void* GetProcAddress(const char* name) const override
+    {
+        return reinterpret_cast<void*>(glfwGetProcAddress(name));
+    }
+
+private:
+    GlfwManager& glfw_manager_;
+    GLFWwindow* window_ = nullptr;
+};
+}
+
+std::unique_ptr<IRenderContext> CreateGlfwRenderContext()
+{
+    return std::make_unique<GlfwRenderContext>();
+}
+}
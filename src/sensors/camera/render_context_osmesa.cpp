@@ -0,0 +1,71 @@
+#include "sensors/camera/render_context_backends.hpp"
+
+#include <GL/osmesa.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace hako::robots::sensor::camera
+{
+namespace
+{
+// OSMesa needs a client color buffer to make a context current. MuJoCo
+// draws into its own framebuffer object, so a tiny one is enough.
+constexpr int kOsmesaBufferSize = 16;
+
+// Software (llvmpipe/softpipe) context for CPU-only hosts.
+class OsmesaRenderContext : public IRenderContext
+{
+public:
+    OsmesaRenderContext()
+        : buffer_(static_cast<std::size_t>(kOsmesaBufferSize * kOsmesaBufferSize * 4))
+    {
+        context_ = OSMesaCreateContextExt(OSMESA_RGBA, 24, 8, 0, nullptr);
+        if (context_ == nullptr) {
+            throw std::runtime_error("Failed to create OSMesa context");
+        }
+        MakeCurrent();
+        if (OSMesaGetCurrentContext() != context_) {
+            OSMesaDestroyContext(context_);
+            throw std::runtime_error("Failed to make the OSMesa context current");
+        }
+    }
+
+    ~OsmesaRenderContext() override
+    {
+        OSMesaDestroyContext(context_);
+    }
+
+    OsmesaRenderContext(const OsmesaRenderContext&) = delete;
+    OsmesaRenderContext& operator=(const OsmesaRenderContext&) = delete;
+
+    RenderBackend Backend() const override { return RenderBackend::Osmesa; }
+
+    void MakeCurrent() override
+    {
+        OSMesaMakeCurrent(context_, buffer_.data(), GL_UNSIGNED_BYTE, kOsmesaBufferSize, kOsmesaBufferSize);
+    }
+
+    void ReleaseCurrent() override
+    {
+        if (OSMesaGetCurrentContext() == context_) {
+            OSMesaMakeCurrent(nullptr, nullptr, GL_UNSIGNED_BYTE, 0, 0);
+        }
+    }
+
+    void* GetProcAddress(const char* name) const override
+    {
+        return reinterpret_cast<void*>(OSMesaGetProcAddress(name));
+    }
+
+private:
+    OSMesaContext context_ = nullptr;
+    std::vector<unsigned char> buffer_;
+};
+}
+
+std::unique_ptr<IRenderContext> CreateOsmesaRenderContext()
+{
+    return std::make_unique<OsmesaRenderContext>();
+}
+}
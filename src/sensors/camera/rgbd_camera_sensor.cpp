@@ -20,11 +20,12 @@ constexpr double kFovMatchEpsilon = 1.0e-9;
 }
 
 RgbdCameraSensor::RgbdCameraSensor(std::shared_ptr<MujocoCameraRenderer> renderer, const std::string& camera_name)
-    : renderer_(renderer), camera_name_(camera_name)
+    : renderer_(renderer), camera_name_(camera_name), raw_(std::make_unique<RawCameraFrame>())
 {
     if (!renderer) {
         throw std::invalid_argument("Renderer is null");
     }
+    camera_ = renderer_->FindCamera(camera_name_);
 }
 
 RgbdCameraSensor::~RgbdCameraSensor() = default;
@@ -61,9 +62,9 @@ bool RgbdCameraSensor::LoadConfig(const RgbdCameraConfig& config)
                   << ", far=" << config.rgb.clip.far << std::endl;
         return false;
     }
-    if (config.rgb.image.format != "R8G8B8" &&
-        config.rgb.image.format != "B8G8R8" &&
-        config.rgb.image.format != "L8")
+    PixelFormat pixel_format;
+    if (!ParsePixelFormat(config.rgb.image.format, pixel_format) ||
+        !IsValidPixelFormatWidth(pixel_format, config.rgb.image.width))
     {
         std::cerr << "Invalid RGB image format: " << config.rgb.image.format << std::endl;
         return false;
@@ -119,9 +120,10 @@ const RgbdCameraConfig& RgbdCameraSensor::GetConfig() const
 
 void RgbdCameraSensor::Capture(ImageFrame& rgb_out, DepthFrame& depth_out)
 {
-    RawCameraFrame raw;
+    // raw_ keeps its readback buffers from one capture to the next.
+    RawCameraFrame& raw = *raw_;
     const bool success = renderer_->Render(
-        camera_name_,
+        camera_,
         config_.rgb.image.width,
         config_.rgb.image.height,
         config_.rgb.horizontal_fov,
@@ -148,4 +150,38 @@ void RgbdCameraSensor::Capture(ImageFrame& rgb_out, DepthFrame& depth_out)
     }
 }
 
+std::size_t RgbdCameraSensor::AppendViews(std::vector<CameraView>& views) const
+{
+    // One view with both buffers, the same render Capture() does.
+    CameraView view;
+    view.camera = camera_;
+    view.camera_name = camera_name_;
+    view.width = config_.rgb.image.width;
+    view.height = config_.rgb.image.height;
+    view.hfov_rad = config_.rgb.horizontal_fov;
+    view.clip_near_m = config_.depth.clip.near;
+    view.clip_far_m = config_.depth.clip.far;
+    view.need_rgb = true;
+    view.need_depth = true;
+    views.push_back(view);
+    return 1;
+}
+
+void RgbdCameraSensor::FinishTiles(const RawCameraFrame* views, ImageFrame& rgb_out, DepthFrame& depth_out) const
+{
+    if (views == nullptr) {
+        ClearImageFrame(rgb_out);
+        ClearDepthFrame(depth_out);
+        return;
+    }
+    if (!EncodeImage(views[0], config_.rgb, rgb_out)) {
+        std::cerr << "Failed to encode RGB frame" << std::endl;
+        ClearImageFrame(rgb_out);
+    }
+    if (!EncodeDepth(views[0], config_.depth, depth_out)) {
+        std::cerr << "Failed to encode depth frame" << std::endl;
+        ClearDepthFrame(depth_out);
+    }
+}
+
 }
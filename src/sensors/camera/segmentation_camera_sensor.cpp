@@ -0,0 +1,163 @@
+#include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/camera_config_loader.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include "sensors/camera/mujoco_camera_renderer.hpp"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace hako::robots::sensor::camera
+{
+namespace
+{
+void ClearSegmentationFrame(SegmentationFrame& out)
+{
+    out.width = 0;
+    out.height = 0;
+    out.data.clear();
+    out.timestamp = 0.0;
+}
+}
+
+SegmentationCameraSensor::SegmentationCameraSensor(
+    std::shared_ptr<MujocoCameraRenderer> renderer, const std::string& camera_name)
+    : renderer_(renderer), camera_name_(camera_name)
+{
+    if (!renderer) {
+        throw std::invalid_argument("Renderer is null");
+    }
+    camera_ = renderer_->FindCamera(camera_name_);
+}
+
+SegmentationCameraSensor::~SegmentationCameraSensor() = default;
+
+bool SegmentationCameraSensor::LoadConfig(const std::string& path)
+{
+    SegmentationCameraConfig config {};
+    if (!LoadSegmentationCameraConfigFromJson(path, config)) {
+        return false;
+    }
+    if (!LoadConfig(config)) {
+        std::cerr << "Failed to validate SegmentationCameraConfig loaded from '" << path << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SegmentationCameraSensor::LoadConfig(const SegmentationCameraConfig& config)
+{
+    if (config.image.width <= 0 || config.image.height <= 0) {
+        std::cerr << "Invalid segmentation camera image size" << std::endl;
+        return false;
+    }
+    if (config.update_rate_hz <= 0.0) {
+        std::cerr << "Invalid segmentation camera update_rate_hz: " << config.update_rate_hz << std::endl;
+        return false;
+    }
+    if (config.horizontal_fov <= 0.0 || config.horizontal_fov > M_PI) {
+        std::cerr << "Invalid segmentation camera horizontal_fov: " << config.horizontal_fov << std::endl;
+        return false;
+    }
+    if (config.clip.near <= 0.0 || config.clip.far <= config.clip.near) {
+        std::cerr << "Invalid segmentation camera clip range: near=" << config.clip.near
+                  << ", far=" << config.clip.far << std::endl;
+        return false;
+    }
+    if (config.image.format != "LABEL_S32" && config.image.format != "LABEL_U16") {
+        std::cerr << "Invalid segmentation camera image format: " << config.image.format << std::endl;
+        return false;
+    }
+    if (config.label != "geom" && config.label != "body") {
+        std::cerr << "Invalid segmentation camera label: " << config.label << std::endl;
+        return false;
+    }
+
+    const mjModel* model = renderer_->GetModel();
+    geom_body_ids_.clear();
+    if (config.label == "body") {
+        geom_body_ids_.assign(model->geom_bodyid, model->geom_bodyid + model->ngeom);
+    }
+    // LABEL_U16 keeps 0xFFFF for "nothing hit", so the largest id must fit below it.
+    const int id_count = config.label == "body" ? model->nbody : model->ngeom;
+    if (config.image.format == "LABEL_U16" && id_count > 0xFFFF) {
+        std::cerr << "Segmentation camera: " << id_count << " " << config.label
+                  << " ids do not fit LABEL_U16" << std::endl;
+        return false;
+    }
+
+    config_ = config;
+    StartScheduler(config_.update_rate_hz);
+    return true;
+}
+
+const SegmentationCameraConfig& SegmentationCameraSensor::GetConfig() const
+{
+    return config_;
+}
+
+void SegmentationCameraSensor::Capture(SegmentationFrame& out)
+{
+    views_.clear();
+    AppendViews(views_);
+    if (!renderer_->RenderViews(views_, raw_views_)) {
+        FinishTiles(nullptr, out);
+        return;
+    }
+    FinishTiles(raw_views_.data(), out);
+}
+
+std::size_t SegmentationCameraSensor::AppendViews(std::vector<CameraView>& views) const
+{
+    CameraView view;
+    view.camera = camera_;
+    view.camera_name = camera_name_;
+    view.width = config_.image.width;
+    view.height = config_.image.height;
+    view.hfov_rad = config_.horizontal_fov;
+    view.clip_near_m = config_.clip.near;
+    view.clip_far_m = config_.clip.far;
+    view.need_rgb = false;
+    view.need_depth = false;
+    view.need_segmentation = true;
+    views.push_back(view);
+    return 1;
+}
+
+void SegmentationCameraSensor::FinishTiles(const RawCameraFrame* views, SegmentationFrame& out) const
+{
+    if (views == nullptr) {
+        ClearSegmentationFrame(out);
+        return;
+    }
+    const RawCameraFrame& raw = views[0];
+    const std::size_t pixels = static_cast<std::size_t>(raw.width) * static_cast<std::size_t>(raw.height);
+    if (raw.width <= 0 || raw.height <= 0 || raw.segmentation.size() != pixels) {
+        std::cerr << "Failed to build segmentation frame: no labels rendered" << std::endl;
+        ClearSegmentationFrame(out);
+        return;
+    }
+
+    out.width = raw.width;
+    out.height = raw.height;
+    out.format = config_.image.format;
+    out.label = config_.label;
+    out.frame_id = config_.frame_id;
+    out.timestamp = raw.timestamp;
+    if (geom_body_ids_.empty()) {
+        out.data.assign(raw.segmentation.begin(), raw.segmentation.end());
+        return;
+    }
+    out.data.resize(pixels);
+    const std::size_t geom_count = geom_body_ids_.size();
+    for (std::size_t i = 0; i < pixels; ++i) {
+        const std::int32_t geom = raw.segmentation[i];
+        out.data[i] = (geom >= 0 && static_cast<std::size_t>(geom) < geom_count) ? geom_body_ids_[geom] : -1;
+    }
+}
+
+}
@@ -37,9 +37,9 @@ bool ValidateStereoSideConfig(const CameraConfig& config, const char* side_name)
                   << ", far=" << config.clip.far << std::endl;
         return false;
     }
-    if (config.image.format != "R8G8B8" &&
-        config.image.format != "B8G8R8" &&
-        config.image.format != "L8")
+    PixelFormat pixel_format;
+    if (!ParsePixelFormat(config.image.format, pixel_format) ||
+        !IsValidPixelFormatWidth(pixel_format, config.image.width))
     {
         std::cerr << "Invalid " << side_name << " stereo image format: " << config.image.format << std::endl;
         return false;
@@ -59,6 +59,8 @@ StereoCameraSensor::StereoCameraSensor(
     if (!renderer_) {
         throw std::invalid_argument("Renderer is null");
     }
+    left_camera_ = renderer_->FindCamera(left_camera_name_);
+    right_camera_ = renderer_->FindCamera(right_camera_name_);
 }
 
 StereoCameraSensor::~StereoCameraSensor() = default;
@@ -119,37 +121,62 @@ const StereoCameraConfig& StereoCameraSensor::GetConfig() const
 
 void StereoCameraSensor::Capture(ImageFrame& left_out, ImageFrame& right_out)
 {
-    RawCameraFrame left_raw;
-    RawCameraFrame right_raw;
-    const bool left_ok = renderer_->Render(
-        left_camera_name_,
-        config_.left.image.width,
-        config_.left.image.height,
-        config_.left.horizontal_fov,
-        config_.left.clip.near,
-        config_.left.clip.far,
-        true,
-        false,
-        left_raw);
-    const bool right_ok = renderer_->Render(
-        right_camera_name_,
-        config_.right.image.width,
-        config_.right.image.height,
-        config_.right.horizontal_fov,
-        config_.right.clip.near,
-        config_.right.clip.far,
-        true,
-        false,
-        right_raw);
-
-    if (!left_ok || !right_ok) {
+    views_.clear();
+    AppendViews(views_);
+    if (!renderer_->RenderViews(views_, raw_views_)) {
+        FinishTiles(nullptr, left_out, right_out);
+        return;
+    }
+    FinishTiles(raw_views_.data(), left_out, right_out);
+}
+
+void StereoCameraSensor::Capture(ImageFrame& left_out, ImageFrame& right_out, DisparityFrame& disparity_out)
+{
+    views_.clear();
+    AppendViews(views_);
+    if (!renderer_->RenderViews(views_, raw_views_)) {
+        FinishTiles(nullptr, left_out, right_out, disparity_out);
+        return;
+    }
+    FinishTiles(raw_views_.data(), left_out, right_out, disparity_out);
+}
+
+std::size_t StereoCameraSensor::AppendViews(std::vector<CameraView>& views) const
+{
+    const auto append = [&views](
+        const hako::robots::physics::CameraHandle& camera,
+        const std::string& camera_name,
+        const CameraConfig& side,
+        bool need_depth)
+    {
+        CameraView view;
+        view.camera = camera;
+        view.camera_name = camera_name;
+        view.width = side.image.width;
+        view.height = side.image.height;
+        view.hfov_rad = side.horizontal_fov;
+        view.clip_near_m = side.clip.near;
+        view.clip_far_m = side.clip.far;
+        view.need_rgb = true;
+        view.need_depth = need_depth;
+        views.push_back(view);
+    };
+    // Disparity is measured on the left image, so only its depth is read back.
+    append(left_camera_, left_camera_name_, config_.left, config_.disparity);
+    append(right_camera_, right_camera_name_, config_.right, false);
+    return 2;
+}
+
+void StereoCameraSensor::FinishTiles(const RawCameraFrame* views, ImageFrame& left_out, ImageFrame& right_out) const
+{
+    if (views == nullptr) {
         ClearImageFrame(left_out);
         ClearImageFrame(right_out);
         return;
     }
 
-    const bool left_encoded = EncodeImage(left_raw, config_.left, left_out);
-    const bool right_encoded = EncodeImage(right_raw, config_.right, right_out);
+    const bool left_encoded = EncodeImage(views[0], config_.left, left_out);
+    const bool right_encoded = EncodeImage(views[1], config_.right, right_out);
     if (!left_encoded || !right_encoded) {
         if (!left_encoded) {
             std::cerr << "Failed to encode left stereo frame" << std::endl;
@@ -168,4 +195,21 @@ void StereoCameraSensor::Capture(ImageFrame& left_out, ImageFrame& right_out)
     }
 }
 
+void StereoCameraSensor::FinishTiles(
+    const RawCameraFrame* views,
+    ImageFrame& left_out,
+    ImageFrame& right_out,
+    DisparityFrame& disparity_out) const
+{
+    FinishTiles(views, left_out, right_out);
+    if (views == nullptr || !config_.disparity || left_out.data.empty()) {
+        ClearDisparityFrame(disparity_out);
+        return;
+    }
+    if (!EncodeDisparity(views[0], config_, disparity_out)) {
+        std::cerr << "Failed to encode stereo disparity frame" << std::endl;
+        ClearDisparityFrame(disparity_out);
+    }
+}
+
 }
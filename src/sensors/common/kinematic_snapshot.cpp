@@ -0,0 +1,74 @@
+#include "sensors/common/kinematic_snapshot.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace hako::robots::sensor::common
+{
+namespace
+{
+void CopyIn(std::vector<mjtNum>& dst, const mjtNum* src, int count)
+{
+    const auto size = static_cast<std::size_t>(std::max(0, count));
+    dst.resize(size);
+    std::copy(src, src + size, dst.begin());
+}
+
+bool CopyOut(const std::vector<mjtNum>& src, mjtNum* dst, int count)
+{
+    if (src.size() != static_cast<std::size_t>(std::max(0, count))) {
+        return false;
+    }
+    std::copy(src.begin(), src.end(), dst);
+    return true;
+}
+}
+
+void KinematicSnapshot::Capture(const mjModel* model, const mjData* data)
+{
+    time = data->time;
+    CopyIn(qpos, data->qpos, model->nq);
+    CopyIn(qvel, data->qvel, model->nv);
+    CopyIn(xpos, data->xpos, 3 * model->nbody);
+    CopyIn(xquat, data->xquat, 4 * model->nbody);
+    CopyIn(xmat, data->xmat, 9 * model->nbody);
+    CopyIn(xipos, data->xipos, 3 * model->nbody);
+    CopyIn(ximat, data->ximat, 9 * model->nbody);
+    CopyIn(geom_xpos, data->geom_xpos, 3 * model->ngeom);
+    CopyIn(geom_xmat, data->geom_xmat, 9 * model->ngeom);
+    CopyIn(site_xpos, data->site_xpos, 3 * model->nsite);
+    CopyIn(site_xmat, data->site_xmat, 9 * model->nsite);
+    CopyIn(cam_xpos, data->cam_xpos, 3 * model->ncam);
+    CopyIn(cam_xmat, data->cam_xmat, 9 * model->ncam);
+    CopyIn(light_xpos, data->light_xpos, 3 * model->nlight);
+    CopyIn(light_xdir, data->light_xdir, 3 * model->nlight);
+    CopyIn(cvel, data->cvel, 6 * model->nbody);
+    CopyIn(subtree_com, data->subtree_com, 3 * model->nbody);
+}
+
+bool KinematicSnapshot::ApplyTo(const mjModel* model, mjData* data) const
+{
+    const bool ok =
+        CopyOut(qpos, data->qpos, model->nq) &&
+        CopyOut(qvel, data->qvel, model->nv) &&
+        CopyOut(xpos, data->xpos, 3 * model->nbody) &&
+        CopyOut(xquat, data->xquat, 4 * model->nbody) &&
+        CopyOut(xmat, data->xmat, 9 * model->nbody) &&
+        CopyOut(xipos, data->xipos, 3 * model->nbody) &&
+        CopyOut(ximat, data->ximat, 9 * model->nbody) &&
+        CopyOut(geom_xpos, data->geom_xpos, 3 * model->ngeom) &&
+        CopyOut(geom_xmat, data->geom_xmat, 9 * model->ngeom) &&
+        CopyOut(site_xpos, data->site_xpos, 3 * model->nsite) &&
+        CopyOut(site_xmat, data->site_xmat, 9 * model->nsite) &&
+        CopyOut(cam_xpos, data->cam_xpos, 3 * model->ncam) &&
+        CopyOut(cam_xmat, data->cam_xmat, 9 * model->ncam) &&
+        CopyOut(light_xpos, data->light_xpos, 3 * model->nlight) &&
+        CopyOut(light_xdir, data->light_xdir, 3 * model->nlight) &&
+        CopyOut(cvel, data->cvel, 6 * model->nbody) &&
+        CopyOut(subtree_com, data->subtree_com, 3 * model->nbody);
+    if (ok) {
+        data->time = time;
+    }
+    return ok;
+}
+}
@@ -0,0 +1,152 @@
+#include "sensors/common/ray_caster.hpp"
+
+#include <algorithm>
+
+namespace hako::robots::sensor::common
+{
+namespace
+{
+// mj_ray clamps geom groups into [0, mjNGROUP) before testing geomgroup.
+int ClampedGeomGroup(const mjModel* model, int geom_id)
+{
+    return std::clamp(model->geom_group[geom_id], 0, mjNGROUP - 1);
+}
+}
+
+void RayCaster::Configure(const mjModel* model, int exclude_root_body, int origin_body)
+{
+    model_ = model;
+    filter_ = SelfFilter::None;
+    body_exclude_ = -1;
+    geomgroup_.fill(1);
+    self_geom_.clear();
+
+    if (model == nullptr || exclude_root_body < 0 || exclude_root_body >= model->nbody) {
+        return;
+    }
+
+    // Bodies are stored parent-first, so one forward pass marks the subtree.
+    std::vector<std::uint8_t> self_body(static_cast<std::size_t>(model->nbody), 0);
+    self_body[static_cast<std::size_t>(exclude_root_body)] = 1;
+    for (int body_id = exclude_root_body + 1; body_id < model->nbody; ++body_id) {
+        const int parent_id = model->body_parentid[body_id];
+        self_body[static_cast<std::size_t>(body_id)] = self_body[static_cast<std::size_t>(parent_id)];
+    }
+
+    self_geom_.assign(static_cast<std::size_t>(model->ngeom), 0);
+    std::array<bool, mjNGROUP> self_groups {};
+    std::array<bool, mjNGROUP> env_groups {};
+    int self_count = 0;
+    int single_body = -1;
+    bool one_body = true;
+    for (int geom_id = 0; geom_id < model->ngeom; ++geom_id) {
+        const int body_id = model->geom_bodyid[geom_id];
+        const int group = ClampedGeomGroup(model, geom_id);
+        if (self_body[static_cast<std::size_t>(body_id)] == 0) {
+            env_groups[static_cast<std::size_t>(group)] = true;
+            continue;
+        }
+        self_geom_[static_cast<std::size_t>(geom_id)] = 1;
+        self_groups[static_cast<std::size_t>(group)] = true;
+        if (self_count++ == 0) {
+            single_body = body_id;
+        } else if (body_id != single_body) {
+            one_body = false;
+        }
+    }
+
+    if (self_count == 0) {
+        return;
+    }
+
+    bool groups_disjoint = true;
+    for (int group = 0; group < mjNGROUP; ++group) {
+        if (self_groups[static_cast<std::size_t>(group)] && env_groups[static_cast<std::size_t>(group)]) {
+            groups_disjoint = false;
+        }
+    }
+
+    if (groups_disjoint) {
+        filter_ = SelfFilter::GeomGroup;
+        for (int group = 0; group < mjNGROUP; ++group) {
+            geomgroup_[static_cast<std::size_t>(group)] = self_groups[static_cast<std::size_t>(group)] ? 0 : 1;
+        }
+        return;
+    }
+    if (one_body) {
+        filter_ = SelfFilter::BodyExclude;
+        body_exclude_ = single_body;
+        return;
+    }
+
+    filter_ = SelfFilter::Mask;
+    if (origin_body >= 0 && origin_body < model->nbody && self_body[static_cast<std::size_t>(origin_body)] != 0) {
+        body_exclude_ = origin_body;
+    }
+}
+
+bool RayCaster::IsSelfGeom(int geom_id) const
+{
+    return geom_id >= 0 &&
+        static_cast<std::size_t>(geom_id) < self_geom_.size() &&
+        self_geom_[static_cast<std::size_t>(geom_id)] != 0;
+}
+
+mjtNum RayCaster::Cast(
+    const mjModel* model,
+    const mjData* data,
+    const mjtNum* origin,
+    const mjtNum* dir,
+    mjtNum max_distance,
+    int* geom_id) const
+{
+    const mjtByte* geomgroup = (filter_ == SelfFilter::GeomGroup) ? geomgroup_.data() : nullptr;
+    int hit_geom = -1;
+    mjtNum normal[3] = {0.0, 0.0, 0.0};
+
+    if (filter_ != SelfFilter::Mask) {
+        mjtNum hit_dist = mj_ray(model, data, origin, dir, geomgroup, 1, body_exclude_, &hit_geom, normal);
+        if (hit_dist < 0.0 || hit_dist >= max_distance) {
+            hit_dist = -1.0;
+            hit_geom = -1;
+        }
+        if (geom_id != nullptr) {
+            *geom_id = hit_geom;
+        }
+        return hit_dist;
+    }
+
+    mjtNum from[3] = {origin[0], origin[1], origin[2]};
+    mjtNum traveled = 0.0;
+    for (int attempt = 0; attempt < kMaxSelfHits; ++attempt) {
+        const mjtNum hit_dist = mj_ray(model, data, from, dir, nullptr, 1, body_exclude_, &hit_geom, normal);
+        if (hit_dist < 0.0) {
+            break;
+        }
+        if (!IsSelfGeom(hit_geom)) {
+            const mjtNum total = traveled + hit_dist;
+            if (total >= max_distance) {
+                break;
+            }
+            if (geom_id != nullptr) {
+                *geom_id = hit_geom;
+            }
+            return total;
+        }
+
+        const mjtNum step = hit_dist + retry_epsilon_;
+        traveled += step;
+        if (traveled >= max_distance) {
+            break;
+        }
+        from[0] += dir[0] * step;
+        from[1] += dir[1] * step;
+        from[2] += dir[2] * step;
+    }
+
+    if (geom_id != nullptr) {
+        *geom_id = -1;
+    }
+    return -1.0;
+}
+}
@@ -0,0 +1,177 @@
+#include "sensors/common/sensor_group.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace hako::robots::sensor::common
+{
+namespace
+{
+// Same tolerance as UpdateScheduler, so both agree on the step an entry fires.
+constexpr double kDueEpsilon = 1.0e-9;
+
+bool LaterDue(const std::pair<double, int>& a, const std::pair<double, int>& b)
+{
+    // std::*_heap build max-heaps; invert the order to keep the earliest due
+    // time (then the lowest index) at the front.
+    if (a.first != b.first) {
+        return a.first > b.first;
+    }
+    return a.second > b.second;
+}
+}
+
+SensorGroup::SensorGroup(int ray_threads, std::size_t min_rays_per_thread)
+{
+    SetRayThreads(ray_threads, min_rays_per_thread);
+}
+
+void SensorGroup::SetRayThreads(int ray_threads, std::size_t min_rays_per_thread)
+{
+    min_rays_per_thread_ = std::max<std::size_t>(1, min_rays_per_thread);
+    if (ray_threads <= 1) {
+        ray_pool_.reset();
+        return;
+    }
+    if (ray_pool_ == nullptr || ray_pool_->ThreadCount() != ray_threads) {
+        ray_pool_ = std::make_unique<runtime::WorkerPool>(ray_threads);
+    }
+}
+
+int SensorGroup::Add(double period_sec, Callback on_due, IRayBatchSensor* rays)
+{
+    Entry entry {};
+    entry.period_sec = std::max(0.0, period_sec);
+    entry.next_due_sec = now_sec_;
+    entry.on_due = std::move(on_due);
+    entry.rays = rays;
+    entries_.push_back(std::move(entry));
+
+    const int index = static_cast<int>(entries_.size()) - 1;
+    PushHeap(index);
+    return index;
+}
+
+void SensorGroup::Clear()
+{
+    entries_.clear();
+    heap_.clear();
+    due_.clear();
+    now_sec_ = 0.0;
+}
+
+void SensorGroup::Reset()
+{
+    now_sec_ = 0.0;
+    heap_.clear();
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        entries_[i].next_due_sec = 0.0;
+        entries_[i].due = false;
+        PushHeap(static_cast<int>(i));
+    }
+}
+
+void SensorGroup::PushHeap(int index)
+{
+    heap_.emplace_back(entries_[static_cast<std::size_t>(index)].next_due_sec, index);
+    std::push_heap(heap_.begin(), heap_.end(), LaterDue);
+}
+
+std::size_t SensorGroup::Step(double delta_sec)
+{
+    for (int index : due_) {
+        entries_[static_cast<std::size_t>(index)].due = false;
+    }
+    due_.clear();
+
+    now_sec_ += delta_sec;
+    while (!heap_.empty() && heap_.front().first <= now_sec_ + kDueEpsilon) {
+        std::pop_heap(heap_.begin(), heap_.end(), LaterDue);
+        due_.push_back(heap_.back().second);
+        heap_.pop_back();
+    }
+    if (due_.empty()) {
+        return 0;
+    }
+    std::sort(due_.begin(), due_.end());
+
+    // Reschedule before running callbacks so an entry fires at most once per
+    // step. A late entry keeps its backlog (next due may already be past) the
+    // same way UpdateScheduler keeps the leftover elapsed time.
+    for (int index : due_) {
+        auto& entry = entries_[static_cast<std::size_t>(index)];
+        entry.due = true;
+        entry.next_due_sec = std::min(entry.next_due_sec, now_sec_) + entry.period_sec;
+        PushHeap(index);
+    }
+
+    CastDueRays();
+    for (int index : due_) {
+        auto& entry = entries_[static_cast<std::size_t>(index)];
+        if (entry.on_due) {
+            entry.on_due();
+        }
+    }
+    return due_.size();
+}
+
+void SensorGroup::CastDueRays()
+{
+    ray_sources_.clear();
+    ray_offsets_.clear();
+    std::size_t total = 0;
+    for (int index : due_) {
+        auto* rays = entries_[static_cast<std::size_t>(index)].rays;
+        if (rays == nullptr) {
+            continue;
+        }
+        const std::size_t count = rays->PrepareRayBatch();
+        if (count == 0) {
+            continue;
+        }
+        ray_sources_.push_back(rays);
+        ray_offsets_.push_back(total);
+        total += count;
+    }
+    if (total == 0) {
+        return;
+    }
+    ray_offsets_.push_back(total);
+
+    // Rays of all due sensors form one index space; a chunk may straddle
+    // several sensors and is split at their boundaries.
+    const auto cast_range = [this](std::size_t begin, std::size_t end) {
+        auto it = std::upper_bound(ray_offsets_.begin(), ray_offsets_.end(), begin);
+        std::size_t source = static_cast<std::size_t>(it - ray_offsets_.begin()) - 1;
+        while (begin < end) {
+            const std::size_t source_begin = ray_offsets_[source];
+            const std::size_t source_end = std::min(end, ray_offsets_[source + 1]);
+            ray_sources_[source]->CastRayBatch(begin - source_begin, source_end - source_begin);
+            begin = source_end;
+            ++source;
+        }
+    };
+
+    if (ray_pool_ == nullptr) {
+        cast_range(0, total);
+        return;
+    }
+    ray_pool_->ParallelFor(total, min_rays_per_thread_, cast_range);
+}
+
+bool SensorGroup::WasDue(int index) const
+{
+    if (index < 0 || static_cast<std::size_t>(index) >= entries_.size()) {
+        return false;
+    }
+    return entries_[static_cast<std::size_t>(index)].due;
+}
+
+double SensorGroup::NextDueSec() const
+{
+    if (heap_.empty()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return heap_.front().first;
+}
+}
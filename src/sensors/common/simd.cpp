@@ -0,0 +1,55 @@
+#include "sensors/common/simd.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace hako::robots::sensor::common
+{
+namespace
+{
+bool ScalarForced()
+{
+    const char* env = std::getenv("HAKO_SENSOR_SIMD");
+    return env != nullptr && (std::strcmp(env, "scalar") == 0 || std::strcmp(env, "off") == 0);
+}
+
+bool DetectAvx2()
+{
+#if defined(HAKO_SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(HAKO_SIMD_AVX2)
+    return true;
+#else
+    return false;
+#endif
+}
+}
+
+bool SimdAvx2Enabled()
+{
+    static const bool enabled = !ScalarForced() && DetectAvx2();
+    return enabled;
+}
+
+bool SimdNeonEnabled()
+{
+#if defined(HAKO_SIMD_NEON)
+    static const bool enabled = !ScalarForced();
+    return enabled;
+#else
+    return false;
+#endif
+}
+
+const char* SimdIsaName()
+{
+    if (SimdAvx2Enabled()) {
+        return "avx2";
+    }
+    if (SimdNeonEnabled()) {
+        return "neon";
+    }
+    return "scalar";
+}
+}
@@ -0,0 +1,107 @@
+#include "sensors/common/snapshot_sensor_worker.hpp"
+
+#include <iostream>
+#include <utility>
+
+namespace hako::robots::sensor::common
+{
+SnapshotSensorWorker::~SnapshotSensorWorker()
+{
+    Stop();
+}
+
+bool SnapshotSensorWorker::Start(const mjModel* model, mjData* view_data, Evaluate evaluate)
+{
+    if (Running()) {
+        std::cerr << "ERROR: SnapshotSensorWorker::Start: worker is already running" << std::endl;
+        return false;
+    }
+    if (model == nullptr || view_data == nullptr || !evaluate) {
+        std::cerr << "ERROR: SnapshotSensorWorker::Start: model, view data and evaluate are required" << std::endl;
+        return false;
+    }
+    model_ = model;
+    view_data_ = view_data;
+    evaluate_ = std::move(evaluate);
+    stopping_.store(false);
+    thread_ = std::thread([this]() { Run(); });
+    return true;
+}
+
+void SnapshotSensorWorker::Stop()
+{
+    if (!Running()) {
+        return;
+    }
+    stopping_.store(true);
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+    thread_.join();
+    while (snapshots_.ReadSlot() != nullptr) {
+        snapshots_.CommitRead();
+    }
+}
+
+bool SnapshotSensorWorker::Publish(const mjData* live_data, double stamp_sec)
+{
+    if (!Running() || live_data == nullptr) {
+        return false;
+    }
+    published_.fetch_add(1, std::memory_order_relaxed);
+    KinematicSnapshot* slot = snapshots_.WriteSlot();
+    if (slot == nullptr) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    slot->Capture(model_, live_data);
+    slot->stamp_sec = stamp_sec;
+    snapshots_.CommitWrite();
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+    return true;
+}
+
+SnapshotSensorWorker::Stats SnapshotSensorWorker::GetStats() const
+{
+    Stats stats {};
+    stats.published = published_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.evaluated = evaluated_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SnapshotSensorWorker::Run()
+{
+    bool has_previous = false;
+    double previous_time = 0.0;
+    while (true) {
+        // Read the signal before checking the ring so a Publish() racing with
+        // the check wakes the wait below instead of being missed.
+        const std::uint64_t seen = signal_.load(std::memory_order_acquire);
+        if (stopping_.load()) {
+            return;
+        }
+
+        const KinematicSnapshot* slot = snapshots_.ReadSlot();
+        if (slot == nullptr) {
+            signal_.wait(seen, std::memory_order_acquire);
+            continue;
+        }
+        const bool applied = slot->ApplyTo(model_, view_data_);
+        const double time = slot->time;
+        const double stamp_sec = slot->stamp_sec;
+        // The view data now holds the state; let physics reuse the slot.
+        snapshots_.CommitRead();
+        if (!applied) {
+            std::cerr << "ERROR: SnapshotSensorWorker::Run: snapshot does not match the model" << std::endl;
+            continue;
+        }
+
+        const double delta_sec = has_previous ? time - previous_time : model_->opt.timestep;
+        has_previous = true;
+        previous_time = time;
+        evaluate_(delta_sec, stamp_sec);
+        evaluated_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+}
@@ -127,6 +127,7 @@ bool ImuSensor::LoadConfig(const std::string& config_path)
         }
     }
 
+    source_body_handle_ = world_->getBodyHandle(config_.source_body);
     source_body_ = world_->getRigidBody(config_.source_body);
     scheduler_.StartReady(GetUpdatePeriodSec());
     has_prev_velocity_ = false;
@@ -141,23 +142,23 @@ const ImuConfig& ImuSensor::GetConfig() const
 
 void ImuSensor::Build(ImuFrame& out)
 {
-    auto* model = world_->getModel();
-    auto* data = world_->getData();
-    const int body_id = mj_name2id(model, mjOBJ_BODY, config_.source_body.c_str());
-    if (body_id < 0) {
+    if (!source_body_handle_.valid()) {
         return;
     }
+    const auto* data = world_->getData();
+    const int body_id = source_body_handle_.id;
 
     out.header.frame_id = config_.frame_id;
     out.orientation = quat_from_mj(&data->xquat[4 * body_id]);
 
-    const auto body_ang_vel = source_body_->GetBodyAngularVelocity();
+    const auto& state = source_body_->GetState();
+    const auto& body_ang_vel = state.body_angular_velocity;
     const auto ang_vel_noisy = angular_velocity_noise_.Apply({body_ang_vel.x, body_ang_vel.y, body_ang_vel.z});
     out.angular_velocity.x = ang_vel_noisy.x;
     out.angular_velocity.y = ang_vel_noisy.y;
     out.angular_velocity.z = ang_vel_noisy.z;
 
-    const auto body_vel = source_body_->GetBodyVelocity();
+    const auto& body_vel = state.body_velocity;
     noise::AxisValue lin_acc_input {};
     const double dt = GetUpdatePeriodSec();
     if (has_prev_velocity_ && dt > 0.0) {
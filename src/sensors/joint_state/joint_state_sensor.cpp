@@ -74,7 +74,7 @@ bool JointStateSensor::LoadConfig(const std::string& config_path)
 
     ResolveJointIds();
     scheduler_.StartReady(GetUpdatePeriodSec());
-    return !joint_ids_.empty();
+    return !joints_.empty();
 }
 
 const JointStateConfig& JointStateSensor::GetConfig() const
@@ -84,7 +84,6 @@ const JointStateConfig& JointStateSensor::GetConfig() const
 
 void JointStateSensor::Build(JointStateFrame& out)
 {
-    auto* model = world_->getModel();
     auto* data = world_->getData();
 
     out.names.clear();
@@ -93,10 +92,10 @@ void JointStateSensor::Build(JointStateFrame& out)
     out.effort.clear();
 
     for (size_t i = 0; i < config_.joints.size(); ++i) {
-        const int joint_id = joint_ids_.at(i);
+        const auto& joint = joints_.at(i);
         out.names.push_back(config_.joints[i].name);
-        out.position.push_back(data->qpos[model->jnt_qposadr[joint_id]]);
-        out.velocity.push_back(data->qvel[model->jnt_dofadr[joint_id]]);
+        out.position.push_back(data->qpos[joint.qpos_adr]);
+        out.velocity.push_back(data->qvel[joint.dof_adr]);
         out.effort.push_back(0.0);
     }
 }
@@ -118,14 +117,10 @@ bool JointStateSensor::ShouldUpdate(double delta_sec)
 
 void JointStateSensor::ResolveJointIds()
 {
-    joint_ids_.clear();
-    auto* model = world_->getModel();
+    joints_.clear();
+    const auto registry = world_->getRegistry();
     for (const auto& joint : config_.joints) {
-        const int joint_id = mj_name2id(model, mjOBJ_JOINT, joint.mjcf_joint.c_str());
-        if (joint_id < 0) {
-            throw std::runtime_error("Joint not found: " + joint.mjcf_joint);
-        }
-        joint_ids_.push_back(joint_id);
+        joints_.push_back(registry->getJoint(joint.mjcf_joint));
     }
 }
 }
@@ -1,5 +1,6 @@
 #include "sensors/lidar/lidar_2d_sensor.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <utility>
@@ -12,21 +13,6 @@ namespace hako::robots::sensor::lidar
 namespace
 {
 constexpr double kPi = 3.14159265358979323846;
-
-noise::NoiseType parse_noise_type(const std::string& value)
-{
-    if (value == "none" || value == "None") {
-        return noise::NoiseType::None;
-    }
-    if (value == "gaussian_quantized" ||
-        value == "GaussianQuantized" ||
-        value == "gaussian-quantized" ||
-        value == "Gaussian-Quantized")
-    {
-        return noise::NoiseType::GaussianQuantized;
-    }
-    return noise::NoiseType::Gaussian;
-}
 }
 
 LiDAR2DSensor::LiDAR2DSensor(
@@ -38,6 +24,7 @@ LiDAR2DSensor::LiDAR2DSensor(
     , exclude_body_name_(std::move(exclude_body_name))
 {
     sensor_body_ = world_->getRigidBody(sensor_body_name_);
+    RebuildBeamTable();
 }
 
 bool LiDAR2DSensor::LoadConfig(const std::string& config_path)
@@ -57,28 +44,8 @@ bool LiDAR2DSensor::LoadConfig(const std::string& config_path)
 
     config_.frame_id = spec_root.value("frame_id", std::string("laser"));
 
-    if (spec_root.contains("DetectionDistance")) {
-        const auto& det = spec_root.at("DetectionDistance");
-        config_.detection_distance.min = common::get_json_number(det, "Min", config_.detection_distance.min) / 1000.0;
-        config_.detection_distance.max = common::get_json_number(det, "Max", config_.detection_distance.max) / 1000.0;
-    }
-
-    if (spec_root.contains("AngleRange")) {
-        const auto& angle = spec_root.at("AngleRange");
-        config_.angle_range.min_deg = common::get_json_number(angle, "Min", config_.angle_range.min_deg);
-        config_.angle_range.max_deg = common::get_json_number(angle, "Max", config_.angle_range.max_deg);
-        if (angle.contains("AscendingOrderOfData") && angle.at("AscendingOrderOfData").is_boolean()) {
-            config_.angle_range.ascending_order_of_data = angle.at("AscendingOrderOfData").get<bool>();
-        }
-        config_.angle_range.resolution_deg = common::get_json_number(angle, "Resolution", config_.angle_range.resolution_deg);
-        config_.angle_range.scan_frequency_hz = common::get_json_int(angle, "ScanFrequency", config_.angle_range.scan_frequency_hz);
-        if (angle.contains("BlindPaddingRange") && angle.at("BlindPaddingRange").is_object()) {
-            const auto& blind = angle.at("BlindPaddingRange");
-            config_.angle_range.blind_padding.enabled = true;
-            config_.angle_range.blind_padding.size = common::get_json_int(blind, "Size", 0);
-            config_.angle_range.blind_padding.value = common::get_json_number(blind, "Value", 0.0);
-        }
-    }
+    ReadDetectionDistance(spec_root, config_.detection_distance);
+    ReadAngleRange(spec_root, config_.angle_range);
 
     config_.output.update_rate_hz = static_cast<double>(config_.angle_range.scan_frequency_hz);
     if (spec == nullptr) {
@@ -90,50 +57,8 @@ bool LiDAR2DSensor::LoadConfig(const std::string& config_path)
         config_.angle_range.scan_frequency_hz = static_cast<int>(std::lround(config_.output.update_rate_hz));
     }
 
-    config_.distance_accuracy.clear();
-    if (spec_root.contains("DistanceAccuracy") && spec_root.at("DistanceAccuracy").is_array()) {
-        for (const auto& entry : spec_root.at("DistanceAccuracy")) {
-            DistanceAccuracy accuracy {};
-            if (entry.contains("Range") && entry.at("Range").is_object()) {
-                const auto& range = entry.at("Range");
-                accuracy.range.min = common::get_json_number(range, "Min", 0.0) / 1000.0;
-                accuracy.range.max = common::get_json_number(range, "Max", 0.0) / 1000.0;
-            }
-            std::string type = entry.value("type", std::string(""));
-            if (type.empty()) {
-                type = entry.value("Type", std::string("independent"));
-            }
-            accuracy.distance_dependent = (type == "dependent");
-            if (accuracy.distance_dependent) {
-                if (entry.contains("DistanceDependentAccuracy")) {
-                    const auto& dep = entry.at("DistanceDependentAccuracy");
-                    accuracy.percentage = common::get_json_number(dep, "Percentage", 0.0);
-                    accuracy.noise_distribution = dep.value("NoiseDistribution", std::string("Gaussian"));
-                    accuracy.precision = common::get_json_number(dep, "Precision", 0.0);
-                }
-                else if (entry.contains("DistanceDepedentAccuracy")) {
-                    const auto& dep = entry.at("DistanceDepedentAccuracy");
-                    accuracy.percentage = common::get_json_number(dep, "Percentage", 0.0);
-                    accuracy.noise_distribution = dep.value("NoiseDistribution", std::string("Gaussian"));
-                    accuracy.precision = common::get_json_number(dep, "Precision", 0.0);
-                }
-            } else {
-                if (entry.contains("DistanceIndependentAccuracy")) {
-                    const auto& indep = entry.at("DistanceIndependentAccuracy");
-                    accuracy.stddev = common::get_json_number(indep, "StdDev", 0.0);
-                    accuracy.noise_distribution = indep.value("NoiseDistribution", std::string("Gaussian"));
-                    accuracy.precision = common::get_json_number(indep, "Precision", 0.0);
-                }
-                else if (entry.contains("DistanceIndepedentAccuracy")) {
-                    const auto& indep = entry.at("DistanceIndepedentAccuracy");
-                    accuracy.stddev = common::get_json_number(indep, "StdDev", 0.0);
-                    accuracy.noise_distribution = indep.value("NoiseDistribution", std::string("Gaussian"));
-                    accuracy.precision = common::get_json_number(indep, "Precision", 0.0);
-                }
-            }
-            config_.distance_accuracy.push_back(std::move(accuracy));
-        }
-    }
+    config_.distance_accuracy = ReadDistanceAccuracy(spec_root);
+    ReadScanEngine(spec_root, config_.scan_engine);
 
     const auto* mjcf_binding = hako::robots::config::FindMjcfBinding(root);
     if (mjcf_binding != nullptr) {
@@ -145,6 +70,11 @@ bool LiDAR2DSensor::LoadConfig(const std::string& config_path)
 
     scheduler_.StartReady(GetUpdatePeriodSec());
     RebuildNoisePipeline();
+    RebuildWorkerPool();
+    RebuildBeamTable();
+    ray_caster_.SetRetryEpsilon(std::max(1.0e-4, config_.origin_offset_m * 0.1));
+    resolved_model_ = nullptr;
+    ResolveBodyIds(world_->getModel());
     return true;
 }
 
@@ -152,6 +82,8 @@ void LiDAR2DSensor::SetRuntimeOptions(double yaw_bias_deg, double origin_offset_
 {
     config_.yaw_bias_deg = yaw_bias_deg;
     config_.origin_offset_m = origin_offset_m;
+    RebuildBeamTable();
+    ray_caster_.SetRetryEpsilon(std::max(1.0e-4, config_.origin_offset_m * 0.1));
 }
 
 const LiDAR2DConfig& LiDAR2DSensor::GetConfig() const
@@ -162,6 +94,8 @@ const LiDAR2DConfig& LiDAR2DSensor::GetConfig() const
 void LiDAR2DSensor::Reset()
 {
     scheduler_.Reset();
+    sweep_elapsed_sec_ = 0.0;
+    sweep_cast_count_ = 0;
 }
 
 double LiDAR2DSensor::GetUpdatePeriodSec() const
@@ -179,60 +113,49 @@ bool LiDAR2DSensor::ShouldUpdate(double delta_sec)
 
 float LiDAR2DSensor::CastRay(
     const mjModel* model,
-    mjData* data,
+    const mjData* data,
     const mjtNum* sensor_pos,
-    int body_exclude,
-    double base_yaw_rad,
-    double degree_yaw) const
+    mjtNum dir_x,
+    mjtNum dir_y) const
+{
+    const mjtNum dir[3] = {dir_x, dir_y, 0.0};
+    const mjtNum max_dist = static_cast<mjtNum>(config_.detection_distance.max);
+    const mjtNum hit_dist = ray_caster_.Cast(model, data, sensor_pos, dir, max_dist);
+    if (hit_dist < 0.0) {
+        return static_cast<float>(config_.detection_distance.max);
+    }
+
+    const float true_dist = static_cast<float>(hit_dist);
+    if (true_dist < static_cast<float>(config_.detection_distance.min) ||
+        true_dist > static_cast<float>(config_.detection_distance.max)) {
+        return static_cast<float>(config_.detection_distance.max);
+    }
+    return true_dist;
+}
+
+void LiDAR2DSensor::CastBeams(std::size_t begin, std::size_t end)
 {
-    const double local_yaw_rad = (degree_yaw + config_.yaw_bias_deg) * kPi / 180.0;
-    const double world_yaw_rad = base_yaw_rad + local_yaw_rad;
-    mjtNum dir[3] = {
-        std::cos(world_yaw_rad),
-        std::sin(world_yaw_rad),
-        0.0,
-    };
-    mjtNum origin[3] = {sensor_pos[0], sensor_pos[1], sensor_pos[2]};
-    const mjtNum epsilon = std::max<mjtNum>(1.0e-4, static_cast<mjtNum>(config_.origin_offset_m * 0.1));
-    mjtNum traveled = 0.0;
-
-    for (int attempt = 0; attempt < 16; ++attempt) {
-        int geomid = -1;
-        mjtNum normal[3] = {0.0, 0.0, 0.0};
-        const mjtNum hit_dist = mj_ray(
-            model,
-            data,
-            origin,
-            dir,
-            nullptr,
-            1,
-            -1,
-            &geomid,
-            normal);
-        if (hit_dist < 0.0) {
-            return static_cast<float>(config_.detection_distance.max);
-        }
-
-        if (!IsSelfGeom(model, body_exclude, geomid)) {
-            const float true_dist = static_cast<float>(traveled + hit_dist);
-            if (true_dist < static_cast<float>(config_.detection_distance.min) ||
-                true_dist > static_cast<float>(config_.detection_distance.max)) {
-                return static_cast<float>(config_.detection_distance.max);
-            }
-            return true_dist;
-        }
-
-        const mjtNum step = hit_dist + epsilon;
-        traveled += step;
-        if (traveled >= static_cast<mjtNum>(config_.detection_distance.max)) {
-            return static_cast<float>(config_.detection_distance.max);
-        }
-        origin[0] += dir[0] * step;
-        origin[1] += dir[1] * step;
-        origin[2] += dir[2] * step;
+    const size_t count = (end > begin) ? end - begin : 0;
+    if (worker_pool_ == nullptr) {
+        CastRayBatch(begin, end);
+        return;
     }
+    // Every beam only reads model/data and writes its own slot, so chunks can
+    // run on any thread without changing the result.
+    worker_pool_->ParallelFor(
+        count,
+        static_cast<size_t>(config_.scan_engine.min_beams_per_thread),
+        [this, begin](size_t chunk_begin, size_t chunk_end) {
+            CastRayBatch(begin + chunk_begin, begin + chunk_end);
+        });
+}
 
-    return static_cast<float>(config_.detection_distance.max);
+void LiDAR2DSensor::CastRayBatch(std::size_t begin, std::size_t end)
+{
+    end = std::min(end, raw_ranges_.size());
+    for (size_t i = begin; i < end; ++i) {
+        raw_ranges_[i] = CastRay(batch_model_, batch_data_, batch_origin_, beam_dir_x_[i], beam_dir_y_[i]);
+    }
 }
 
 void LiDAR2DSensor::ApplyBlindPadding(std::vector<float>& ranges) const
@@ -250,53 +173,142 @@ void LiDAR2DSensor::ApplyBlindPadding(std::vector<float>& ranges) const
 
 void LiDAR2DSensor::RebuildNoisePipeline()
 {
-    noise_pipeline_.Clear();
-    for (const auto& accuracy : config_.distance_accuracy) {
-        noise::RangeNoiseRule rule {};
-        rule.range.min = accuracy.range.min;
-        rule.range.max = accuracy.range.max;
-        rule.distance_dependent = accuracy.distance_dependent;
-        rule.percentage = accuracy.percentage;
-        rule.noise.stddev = accuracy.stddev;
-        rule.noise.precision = accuracy.precision;
-        rule.noise.type = parse_noise_type(accuracy.noise_distribution);
-        noise_pipeline_.AddRule(rule);
+    BuildRangeNoisePipeline(config_.distance_accuracy, noise_pipeline_);
+}
+
+void LiDAR2DSensor::RebuildWorkerPool()
+{
+    if (config_.scan_engine.threads <= 1) {
+        worker_pool_.reset();
+        return;
     }
+    if (worker_pool_ == nullptr || worker_pool_->ThreadCount() != config_.scan_engine.threads) {
+        worker_pool_ = std::make_unique<runtime::WorkerPool>(config_.scan_engine.threads);
+    }
+}
+
+void LiDAR2DSensor::RebuildBeamTable()
+{
+    beam_table_.Build(
+        config_.angle_range.min_deg,
+        config_.angle_range.max_deg,
+        config_.angle_range.resolution_deg,
+        config_.angle_range.ascending_order_of_data,
+        config_.yaw_bias_deg);
+    beam_dir_x_.resize(beam_table_.Size());
+    beam_dir_y_.resize(beam_table_.Size());
+    raw_ranges_.resize(beam_table_.Size());
+    sweep_elapsed_sec_ = 0.0;
+    sweep_cast_count_ = 0;
+}
+
+bool LiDAR2DSensor::ResolveBodyIds(const mjModel* model)
+{
+    if (model == nullptr) {
+        return false;
+    }
+    if (model != resolved_model_) {
+        const auto registry = world_->getRegistry();
+        sensor_body_id_ = registry->findBody(sensor_body_name_).id;
+        exclude_body_id_ = registry->findBody(exclude_body_name_).id;
+        ray_caster_.Configure(model, exclude_body_id_, sensor_body_id_);
+        resolved_model_ = model;
+    }
+    return sensor_body_id_ >= 0;
+}
+
+bool LiDAR2DSensor::BeginBatch()
+{
+    const auto* model = world_->getModel();
+    const auto* data = world_->getData();
+    if (!ResolveBodyIds(model) || data == nullptr ||
+        config_.angle_range.resolution_deg <= 0.0 || beam_table_.Empty()) {
+        batch_model_ = nullptr;
+        batch_data_ = nullptr;
+        return false;
+    }
+    const mjtNum* pos = &data->xpos[3 * sensor_body_id_];
+    batch_origin_[0] = pos[0];
+    batch_origin_[1] = pos[1];
+    batch_origin_[2] = pos[2];
+    batch_model_ = model;
+    batch_data_ = data;
+    return true;
+}
+
+std::size_t LiDAR2DSensor::PrepareRayBatch()
+{
+    if (!BeginBatch()) {
+        return 0;
+    }
+    beam_table_.Rotate(sensor_body_->GetEuler().z, beam_dir_x_.data(), beam_dir_y_.data());
+    return raw_ranges_.size();
 }
 
 void LiDAR2DSensor::Scan(LaserScanFrame& out)
 {
-    auto* model = world_->getModel();
-    auto* data = world_->getData();
-    const int sensor_body_id = mj_name2id(model, mjOBJ_BODY, sensor_body_name_.c_str());
-    const int body_exclude_id = mj_name2id(model, mjOBJ_BODY, exclude_body_name_.c_str());
-    if (sensor_body_id < 0) {
+    const std::size_t ray_count = PrepareRayBatch();
+    if (ray_count == 0) {
         return;
     }
+    CastBeams(0, ray_count);
+    FinishRayBatch(out);
+}
 
-    const mjtNum* pos = &data->xpos[3 * sensor_body_id];
-    const double base_yaw_rad = sensor_body_->GetEuler().z;
+bool LiDAR2DSensor::Update(double delta_sec, LaserScanFrame& out)
+{
+    if (!config_.scan_engine.incremental) {
+        return ILidar2DSensor::Update(delta_sec, out);
+    }
+    return AdvanceSweep(delta_sec, out);
+}
 
-    if (config_.angle_range.resolution_deg <= 0.0) {
-        return;
+bool LiDAR2DSensor::AdvanceSweep(double delta_sec, LaserScanFrame& out)
+{
+    if (!BeginBatch()) {
+        return false;
+    }
+
+    const double period_sec = GetUpdatePeriodSec();
+    const std::size_t ray_count = beam_table_.Size();
+    sweep_elapsed_sec_ += delta_sec;
+
+    // Beams are cast in data order as the head reaches them, each slice from
+    // the sensor pose of the current step.
+    const double phase = std::min(1.0, sweep_elapsed_sec_ / period_sec);
+    const std::size_t due = std::min(
+        ray_count,
+        static_cast<std::size_t>(std::floor(phase * static_cast<double>(ray_count) + 1.0e-6)));
+    if (due > sweep_cast_count_) {
+        const double base_yaw_rad = sensor_body_->GetEuler().z;
+        beam_table_.Rotate(base_yaw_rad, sweep_cast_count_, due, beam_dir_x_.data(), beam_dir_y_.data());
+        CastBeams(sweep_cast_count_, due);
+        sweep_cast_count_ = due;
+    }
+    if (sweep_cast_count_ < ray_count) {
+        return false;
     }
 
-    const int ray_count = std::max(
-        1,
-        static_cast<int>(std::ceil((config_.angle_range.max_deg - config_.angle_range.min_deg) / config_.angle_range.resolution_deg)));
-    std::vector<float> ranges(static_cast<size_t>(ray_count), static_cast<float>(config_.detection_distance.max));
-
-    double yaw_deg = config_.angle_range.ascending_order_of_data
-        ? config_.angle_range.min_deg
-        : config_.angle_range.max_deg;
-    const double delta_yaw = config_.angle_range.ascending_order_of_data
-        ? config_.angle_range.resolution_deg
-        : -config_.angle_range.resolution_deg;
-
-    for (int i = 0; i < ray_count; ++i, yaw_deg += delta_yaw) {
-        const float raw = CastRay(model, data, pos, body_exclude_id, base_yaw_rad, yaw_deg);
-        const float noisy = noise_pipeline_.Apply(raw);
-        ranges[static_cast<size_t>(i)] = std::min(noisy, static_cast<float>(config_.detection_distance.max));
+    FinishRayBatch(out);
+    sweep_cast_count_ = 0;
+    sweep_elapsed_sec_ = std::max(0.0, sweep_elapsed_sec_ - period_sec);
+    if (sweep_elapsed_sec_ >= period_sec) {
+        // Steps longer than a sweep cannot be sliced; restart the sweep.
+        sweep_elapsed_sec_ = 0.0;
+    }
+    return true;
+}
+
+void LiDAR2DSensor::FinishRayBatch(LaserScanFrame& out)
+{
+    const std::size_t ray_count = raw_ranges_.size();
+    std::vector<float> ranges(ray_count, static_cast<float>(config_.detection_distance.max));
+
+    // Noise draws stay on this thread and in beam order so a seeded noise
+    // model produces the same sequence regardless of the engine thread count.
+    for (std::size_t i = 0; i < ray_count; ++i) {
+        const float noisy = noise_pipeline_.Apply(raw_ranges_[i]);
+        ranges[i] = std::min(noisy, static_cast<float>(config_.detection_distance.max));
     }
 
     ApplyBlindPadding(ranges);
@@ -0,0 +1,340 @@
+#include "sensors/lidar/lidar_3d_sensor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "config/json_config_utils.hpp"
+#include "sensors/common/json_utils.hpp"
+#include "sensors/lidar/lidar_beam_table.hpp"
+
+namespace hako::robots::sensor::lidar
+{
+namespace
+{
+constexpr double kPi = 3.14159265358979323846;
+
+// Point layout: x, y, z, intensity, time (float32), ring (uint16), padding.
+constexpr std::uint32_t kOffsetX = 0;
+constexpr std::uint32_t kOffsetY = 4;
+constexpr std::uint32_t kOffsetZ = 8;
+constexpr std::uint32_t kOffsetIntensity = 12;
+constexpr std::uint32_t kOffsetTime = 16;
+constexpr std::uint32_t kOffsetRing = 20;
+constexpr std::uint32_t kPointStep = 24;
+
+std::vector<PointField> MakePointFields()
+{
+    return {
+        {"x", kOffsetX, PointField::kFloat32, 1},
+        {"y", kOffsetY, PointField::kFloat32, 1},
+        {"z", kOffsetZ, PointField::kFloat32, 1},
+        {"intensity", kOffsetIntensity, PointField::kFloat32, 1},
+        {"time", kOffsetTime, PointField::kFloat32, 1},
+        {"ring", kOffsetRing, PointField::kUint16, 1},
+    };
+}
+
+void StoreFloat(std::uint8_t* dst, float value)
+{
+    std::memcpy(dst, &value, sizeof(value));
+}
+}
+
+LiDAR3DSensor::LiDAR3DSensor(
+    std::shared_ptr<hako::robots::physics::IWorld> world,
+    std::string sensor_body_name,
+    std::string exclude_body_name)
+    : world_(std::move(world))
+    , sensor_body_name_(std::move(sensor_body_name))
+    , exclude_body_name_(std::move(exclude_body_name))
+{
+}
+
+bool LiDAR3DSensor::LoadConfig(const std::string& config_path)
+{
+    common::json root;
+    if (!common::load_json_file(config_path, root)) {
+        return false;
+    }
+
+    config_ = LiDAR3DConfig {};
+    const auto* spec = hako::robots::config::FindObject(root, "spec");
+    const auto& spec_root = (spec != nullptr) ? *spec : root;
+
+    config_.output.name = common::get_json_string(spec_root, "name", "point_cloud");
+    config_.output.pdu_name = "point_cloud";
+    config_.output.update_rate_hz = 10.0;
+    config_.frame_id = spec_root.value("frame_id", std::string("lidar"));
+
+    ReadDetectionDistance(spec_root, config_.detection_distance);
+    ReadAngleRange(spec_root, config_.angle_range);
+
+    config_.output.update_rate_hz = static_cast<double>(config_.angle_range.scan_frequency_hz);
+    hako::robots::config::ReadPduConfig(root, config_.output.pdu_name, config_.output.update_rate_hz);
+    if (config_.output.update_rate_hz > 0.0) {
+        config_.angle_range.scan_frequency_hz = static_cast<int>(std::lround(config_.output.update_rate_hz));
+    }
+
+    if (spec_root.contains("Channels") && spec_root.at("Channels").is_array()) {
+        for (const auto& entry : spec_root.at("Channels")) {
+            if (!entry.is_object()) {
+                continue;
+            }
+            LiDARChannel channel {};
+            channel.vertical_angle_deg = common::get_json_number(entry, "VerticalAngle", 0.0);
+            channel.azimuth_offset_deg = common::get_json_number(entry, "AzimuthOffset", 0.0);
+            channel.firing_time_offset_us = common::get_json_number(entry, "FiringTimeOffset", 0.0);
+            config_.channels.push_back(channel);
+        }
+    }
+    if (config_.channels.empty()) {
+        std::cerr << "ERROR: LiDAR3DSensor::LoadConfig: no Channels in " << config_path << std::endl;
+        return false;
+    }
+    if (config_.angle_range.resolution_deg <= 0.0) {
+        std::cerr << "ERROR: LiDAR3DSensor::LoadConfig: AngleRange.Resolution must be positive in "
+                  << config_path << std::endl;
+        return false;
+    }
+
+    config_.distance_accuracy = ReadDistanceAccuracy(spec_root);
+    ReadScanEngine(spec_root, config_.scan_engine);
+
+    const auto* mjcf_binding = hako::robots::config::FindMjcfBinding(root);
+    if (mjcf_binding != nullptr) {
+        sensor_body_name_ = common::get_json_string(*mjcf_binding, "source_body", sensor_body_name_);
+        exclude_body_name_ = common::get_json_string(*mjcf_binding, "exclude_body", exclude_body_name_);
+        config_.frame_id = common::get_json_string(*mjcf_binding, "frame_id_override", config_.frame_id);
+    }
+
+    scheduler_.StartReady(GetUpdatePeriodSec());
+    BuildRangeNoisePipeline(config_.distance_accuracy, noise_pipeline_);
+    RebuildWorkerPool();
+    RebuildBeamTable();
+    resolved_model_ = nullptr;
+    ResolveBodyIds(world_->getModel());
+    return true;
+}
+
+const LiDAR3DConfig& LiDAR3DSensor::GetConfig() const
+{
+    return config_;
+}
+
+void LiDAR3DSensor::Reset()
+{
+    scheduler_.Reset();
+}
+
+double LiDAR3DSensor::GetUpdatePeriodSec() const
+{
+    if (config_.angle_range.scan_frequency_hz <= 0) {
+        return 0.1;
+    }
+    return 1.0 / static_cast<double>(config_.angle_range.scan_frequency_hz);
+}
+
+bool LiDAR3DSensor::ShouldUpdate(double delta_sec)
+{
+    return scheduler_.ShouldUpdate(delta_sec, GetUpdatePeriodSec());
+}
+
+void LiDAR3DSensor::RebuildBeamTable()
+{
+    const auto& angle = config_.angle_range;
+    column_count_ = LiDARBeamTable::RayCount(angle.min_deg, angle.max_deg, angle.resolution_deg);
+
+    const std::size_t beam_count = config_.channels.size() * static_cast<std::size_t>(column_count_);
+    local_x_.resize(beam_count);
+    local_y_.resize(beam_count);
+    local_z_.resize(beam_count);
+    beam_time_.resize(beam_count);
+    world_x_.resize(beam_count);
+    world_y_.resize(beam_count);
+    world_z_.resize(beam_count);
+    ranges_.resize(beam_count);
+
+    const double period_sec = GetUpdatePeriodSec();
+    const double block_time_sec = period_sec / static_cast<double>(column_count_);
+    const double spin_sign = angle.ascending_order_of_data ? 1.0 : -1.0;
+    const double spin_deg_per_us = 360.0 / period_sec * 1.0e-6;
+    const double start_deg = angle.ascending_order_of_data ? angle.min_deg : angle.max_deg;
+    const double delta_deg = spin_sign * angle.resolution_deg;
+
+    for (std::size_t channel = 0; channel < config_.channels.size(); ++channel) {
+        const auto& laser = config_.channels[channel];
+        const double elevation_rad = laser.vertical_angle_deg * kPi / 180.0;
+        const double cos_el = std::cos(elevation_rad);
+        const double sin_el = std::sin(elevation_rad);
+        const double channel_azimuth_deg =
+            laser.azimuth_offset_deg + spin_sign * spin_deg_per_us * laser.firing_time_offset_us;
+
+        double column_deg = start_deg;
+        for (int column = 0; column < column_count_; ++column, column_deg += delta_deg) {
+            const double azimuth_rad = (column_deg + channel_azimuth_deg) * kPi / 180.0;
+            const std::size_t i = channel * static_cast<std::size_t>(column_count_) + static_cast<std::size_t>(column);
+            local_x_[i] = cos_el * std::cos(azimuth_rad);
+            local_y_[i] = cos_el * std::sin(azimuth_rad);
+            local_z_[i] = sin_el;
+            beam_time_[i] = static_cast<float>(
+                block_time_sec * static_cast<double>(column) + laser.firing_time_offset_us * 1.0e-6);
+        }
+    }
+}
+
+void LiDAR3DSensor::RebuildWorkerPool()
+{
+    if (config_.scan_engine.threads <= 1) {
+        worker_pool_.reset();
+        return;
+    }
+    if (worker_pool_ == nullptr || worker_pool_->ThreadCount() != config_.scan_engine.threads) {
+        worker_pool_ = std::make_unique<runtime::WorkerPool>(config_.scan_engine.threads);
+    }
+}
+
+bool LiDAR3DSensor::ResolveBodyIds(const mjModel* model)
+{
+    if (model == nullptr) {
+        return false;
+    }
+    if (model != resolved_model_) {
+        const auto registry = world_->getRegistry();
+        sensor_body_id_ = registry->findBody(sensor_body_name_).id;
+        exclude_body_id_ = registry->findBody(exclude_body_name_).id;
+        ray_caster_.Configure(model, exclude_body_id_, sensor_body_id_);
+        resolved_model_ = model;
+    }
+    return sensor_body_id_ >= 0;
+}
+
+void LiDAR3DSensor::RotateBeams(const mjtNum* sensor_mat)
+{
+    // world = R * local with the row-major body rotation matrix.
+    const mjtNum r00 = sensor_mat[0], r01 = sensor_mat[1], r02 = sensor_mat[2];
+    const mjtNum r10 = sensor_mat[3], r11 = sensor_mat[4], r12 = sensor_mat[5];
+    const mjtNum r20 = sensor_mat[6], r21 = sensor_mat[7], r22 = sensor_mat[8];
+    const mjtNum* lx = local_x_.data();
+    const mjtNum* ly = local_y_.data();
+    const mjtNum* lz = local_z_.data();
+    mjtNum* wx = world_x_.data();
+    mjtNum* wy = world_y_.data();
+    mjtNum* wz = world_z_.data();
+    const std::size_t count = local_x_.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        wx[i] = r00 * lx[i] + r01 * ly[i] + r02 * lz[i];
+        wy[i] = r10 * lx[i] + r11 * ly[i] + r12 * lz[i];
+        wz[i] = r20 * lx[i] + r21 * ly[i] + r22 * lz[i];
+    }
+}
+
+void LiDAR3DSensor::CastBeams()
+{
+    if (worker_pool_ == nullptr) {
+        CastRayBatch(0, ranges_.size());
+        return;
+    }
+    // Every beam only reads model/data and writes its own slot, so chunks can
+    // run on any thread without changing the result.
+    worker_pool_->ParallelFor(
+        ranges_.size(),
+        static_cast<std::size_t>(config_.scan_engine.min_beams_per_thread),
+        [this](std::size_t begin, std::size_t end) { CastRayBatch(begin, end); });
+}
+
+void LiDAR3DSensor::CastRayBatch(std::size_t begin, std::size_t end)
+{
+    const mjtNum max_dist = static_cast<mjtNum>(config_.detection_distance.max);
+    const float min_range = static_cast<float>(config_.detection_distance.min);
+    const float no_return = std::numeric_limits<float>::quiet_NaN();
+
+    end = std::min(end, ranges_.size());
+    for (std::size_t i = begin; i < end; ++i) {
+        const mjtNum dir[3] = {world_x_[i], world_y_[i], world_z_[i]};
+        const mjtNum hit = ray_caster_.Cast(batch_model_, batch_data_, batch_origin_, dir, max_dist);
+        const float range = static_cast<float>(hit);
+        ranges_[i] = (hit < 0.0 || range < min_range) ? no_return : range;
+    }
+}
+
+void LiDAR3DSensor::PackPoints(PointCloudFrame& out) const
+{
+    out.height = static_cast<std::uint32_t>(config_.channels.size());
+    out.width = static_cast<std::uint32_t>(column_count_);
+    if (out.fields.empty()) {
+        out.fields = MakePointFields();
+    }
+    out.is_bigendian = false;
+    out.point_step = kPointStep;
+    out.row_step = kPointStep * out.width;
+    out.is_dense = false;
+    out.data.assign(static_cast<std::size_t>(out.row_step) * out.height, 0);
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (std::size_t i = 0; i < ranges_.size(); ++i) {
+        std::uint8_t* point = out.data.data() + i * kPointStep;
+        const float range = ranges_[i];
+        const bool valid = std::isfinite(range);
+        StoreFloat(point + kOffsetX, valid ? static_cast<float>(local_x_[i]) * range : nan);
+        StoreFloat(point + kOffsetY, valid ? static_cast<float>(local_y_[i]) * range : nan);
+        StoreFloat(point + kOffsetZ, valid ? static_cast<float>(local_z_[i]) * range : nan);
+        StoreFloat(point + kOffsetIntensity, 0.0F);
+        StoreFloat(point + kOffsetTime, beam_time_[i]);
+        const auto ring = static_cast<std::uint16_t>(i / static_cast<std::size_t>(column_count_));
+        std::memcpy(point + kOffsetRing, &ring, sizeof(ring));
+    }
+}
+
+std::size_t LiDAR3DSensor::PrepareRayBatch()
+{
+    const auto* model = world_->getModel();
+    const auto* data = world_->getData();
+    if (!ResolveBodyIds(model) || data == nullptr || ranges_.empty()) {
+        batch_model_ = nullptr;
+        batch_data_ = nullptr;
+        return 0;
+    }
+
+    RotateBeams(&data->xmat[9 * sensor_body_id_]);
+    const mjtNum* pos = &data->xpos[3 * sensor_body_id_];
+    batch_origin_[0] = pos[0];
+    batch_origin_[1] = pos[1];
+    batch_origin_[2] = pos[2];
+    batch_model_ = model;
+    batch_data_ = data;
+    return ranges_.size();
+}
+
+void LiDAR3DSensor::Scan(PointCloudFrame& out)
+{
+    if (PrepareRayBatch() == 0) {
+        return;
+    }
+    CastBeams();
+    FinishRayBatch(out);
+}
+
+void LiDAR3DSensor::FinishRayBatch(PointCloudFrame& out)
+{
+    if (batch_data_ == nullptr) {
+        return;
+    }
+
+    // Noise draws stay on this thread and in beam order so a seeded noise
+    // model produces the same sequence regardless of the engine thread count.
+    const float max_range = static_cast<float>(config_.detection_distance.max);
+    for (auto& range : ranges_) {
+        if (std::isfinite(range)) {
+            range = std::min(static_cast<float>(noise_pipeline_.Apply(range)), max_range);
+        }
+    }
+
+    out.frame_id = config_.frame_id;
+    out.timestamp = static_cast<double>(batch_data_->time);
+    PackPoints(out);
+}
+}
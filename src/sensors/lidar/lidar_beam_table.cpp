@@ -0,0 +1,60 @@
+#include "sensors/lidar/lidar_beam_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hako::robots::sensor::lidar
+{
+namespace
+{
+constexpr double kPi = 3.14159265358979323846;
+}
+
+int LiDARBeamTable::RayCount(double min_deg, double max_deg, double resolution_deg)
+{
+    if (resolution_deg <= 0.0) {
+        return 1;
+    }
+    return std::max(1, static_cast<int>(std::ceil((max_deg - min_deg) / resolution_deg)));
+}
+
+void LiDARBeamTable::Build(
+    double min_deg,
+    double max_deg,
+    double resolution_deg,
+    bool ascending_order_of_data,
+    double yaw_bias_deg)
+{
+    const int ray_count = RayCount(min_deg, max_deg, resolution_deg);
+    local_cos_.resize(static_cast<std::size_t>(ray_count));
+    local_sin_.resize(static_cast<std::size_t>(ray_count));
+
+    // Keep the accumulated yaw the scan used to compute per beam, so the table
+    // reproduces the historical beam layout.
+    double yaw_deg = ascending_order_of_data ? min_deg : max_deg;
+    const double delta_yaw = ascending_order_of_data ? resolution_deg : -resolution_deg;
+    for (int i = 0; i < ray_count; ++i, yaw_deg += delta_yaw) {
+        const double local_yaw_rad = (yaw_deg + yaw_bias_deg) * kPi / 180.0;
+        local_cos_[static_cast<std::size_t>(i)] = std::cos(local_yaw_rad);
+        local_sin_[static_cast<std::size_t>(i)] = std::sin(local_yaw_rad);
+    }
+}
+
+void LiDARBeamTable::Rotate(double yaw_rad, double* out_x, double* out_y) const
+{
+    Rotate(yaw_rad, 0, local_cos_.size(), out_x, out_y);
+}
+
+void LiDARBeamTable::Rotate(double yaw_rad, std::size_t begin, std::size_t end, double* out_x, double* out_y) const
+{
+    const double c = std::cos(yaw_rad);
+    const double s = std::sin(yaw_rad);
+    const double* local_cos = local_cos_.data();
+    const double* local_sin = local_sin_.data();
+    end = std::min(end, local_cos_.size());
+    for (std::size_t i = begin; i < end; ++i) {
+        out_x[i] = c * local_cos[i] - s * local_sin[i];
+        out_y[i] = s * local_cos[i] + c * local_sin[i];
+    }
+}
+}
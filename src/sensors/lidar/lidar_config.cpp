@@ -0,0 +1,134 @@
+#include "sensors/lidar/lidar_config.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace hako::robots::sensor::lidar
+{
+namespace
+{
+noise::NoiseType parse_noise_type(const std::string& value)
+{
+    if (value == "none" || value == "None") {
+        return noise::NoiseType::None;
+    }
+    if (value == "gaussian_quantized" ||
+        value == "GaussianQuantized" ||
+        value == "gaussian-quantized" ||
+        value == "Gaussian-Quantized")
+    {
+        return noise::NoiseType::GaussianQuantized;
+    }
+    return noise::NoiseType::Gaussian;
+}
+}
+
+void ReadDetectionDistance(const common::json& spec_root, DetectionDistance& out)
+{
+    if (spec_root.contains("DetectionDistance")) {
+        const auto& det = spec_root.at("DetectionDistance");
+        out.min = common::get_json_number(det, "Min", out.min) / 1000.0;
+        out.max = common::get_json_number(det, "Max", out.max) / 1000.0;
+    }
+}
+
+void ReadAngleRange(const common::json& spec_root, AngleRange& out)
+{
+    if (spec_root.contains("AngleRange")) {
+        const auto& angle = spec_root.at("AngleRange");
+        out.min_deg = common::get_json_number(angle, "Min", out.min_deg);
+        out.max_deg = common::get_json_number(angle, "Max", out.max_deg);
+        if (angle.contains("AscendingOrderOfData") && angle.at("AscendingOrderOfData").is_boolean()) {
+            out.ascending_order_of_data = angle.at("AscendingOrderOfData").get<bool>();
+        }
+        out.resolution_deg = common::get_json_number(angle, "Resolution", out.resolution_deg);
+        out.scan_frequency_hz = common::get_json_int(angle, "ScanFrequency", out.scan_frequency_hz);
+        if (angle.contains("BlindPaddingRange") && angle.at("BlindPaddingRange").is_object()) {
+            const auto& blind = angle.at("BlindPaddingRange");
+            out.blind_padding.enabled = true;
+            out.blind_padding.size = common::get_json_int(blind, "Size", 0);
+            out.blind_padding.value = common::get_json_number(blind, "Value", 0.0);
+        }
+    }
+}
+
+std::vector<DistanceAccuracy> ReadDistanceAccuracy(const common::json& spec_root)
+{
+    std::vector<DistanceAccuracy> out;
+    if (spec_root.contains("DistanceAccuracy") && spec_root.at("DistanceAccuracy").is_array()) {
+        for (const auto& entry : spec_root.at("DistanceAccuracy")) {
+            DistanceAccuracy accuracy {};
+            if (entry.contains("Range") && entry.at("Range").is_object()) {
+                const auto& range = entry.at("Range");
+                accuracy.range.min = common::get_json_number(range, "Min", 0.0) / 1000.0;
+                accuracy.range.max = common::get_json_number(range, "Max", 0.0) / 1000.0;
+            }
+            std::string type = entry.value("type", std::string(""));
+            if (type.empty()) {
+                type = entry.value("Type", std::string("independent"));
+            }
+            accuracy.distance_dependent = (type == "dependent");
+            if (accuracy.distance_dependent) {
+                if (entry.contains("DistanceDependentAccuracy")) {
+                    const auto& dep = entry.at("DistanceDependentAccuracy");
+                    accuracy.percentage = common::get_json_number(dep, "Percentage", 0.0);
+                    accuracy.noise_distribution = dep.value("NoiseDistribution", std::string("Gaussian"));
+                    accuracy.precision = common::get_json_number(dep, "Precision", 0.0);
+                }
+                else if (entry.contains("DistanceDepedentAccuracy")) {
+                    const auto& dep = entry.at("DistanceDepedentAccuracy");
+                    accuracy.percentage = common::get_json_number(dep, "Percentage", 0.0);
+                    accuracy.noise_distribution = dep.value("NoiseDistribution", std::string("Gaussian"));
+                    accuracy.precision = common::get_json_number(dep, "Precision", 0.0);
+                }
+            } else {
+                if (entry.contains("DistanceIndependentAccuracy")) {
+                    const auto& indep = entry.at("DistanceIndependentAccuracy");
+                    accuracy.stddev = common::get_json_number(indep, "StdDev", 0.0);
+                    accuracy.noise_distribution = indep.value("NoiseDistribution", std::string("Gaussian"));
+                    accuracy.precision = common::get_json_number(indep, "Precision", 0.0);
+                }
+                else if (entry.contains("DistanceIndepedentAccuracy")) {
+                    const auto& indep = entry.at("DistanceIndepedentAccuracy");
+                    accuracy.stddev = common::get_json_number(indep, "StdDev", 0.0);
+                    accuracy.noise_distribution = indep.value("NoiseDistribution", std::string("Gaussian"));
+                    accuracy.precision = common::get_json_number(indep, "Precision", 0.0);
+                }
+            }
+            out.push_back(std::move(accuracy));
+        }
+    }
+    return out;
+}
+
+void ReadScanEngine(const common::json& spec_root, ScanEngineConfig& out)
+{
+    if (spec_root.contains("ScanEngine") && spec_root.at("ScanEngine").is_object()) {
+        const auto& engine = spec_root.at("ScanEngine");
+        out.threads = std::max(1, common::get_json_int(engine, "Threads", out.threads));
+        out.min_beams_per_thread = std::max(
+            1,
+            common::get_json_int(engine, "MinBeamsPerThread", out.min_beams_per_thread));
+        out.incremental = (common::get_json_string(engine, "Mode", "full") == "incremental");
+    }
+}
+
+void BuildRangeNoisePipeline(
+    const std::vector<DistanceAccuracy>& distance_accuracy,
+    noise::RangeNoisePipeline& pipeline)
+{
+    pipeline.Clear();
+    for (const auto& accuracy : distance_accuracy) {
+        noise::RangeNoiseRule rule {};
+        rule.range.min = accuracy.range.min;
+        rule.range.max = accuracy.range.max;
+        rule.distance_dependent = accuracy.distance_dependent;
+        rule.percentage = accuracy.percentage;
+        rule.noise.stddev = accuracy.stddev;
+        rule.noise.precision = accuracy.precision;
+        rule.noise.type = parse_noise_type(accuracy.noise_distribution);
+        pipeline.AddRule(rule);
+    }
+}
+}
@@ -52,6 +52,7 @@ bool OdometryPublisher::LoadConfig(const std::string& config_path)
     const auto& binding_root = (mjcf_binding != nullptr) ? *mjcf_binding : root;
     config_.source_body = common::get_json_string(binding_root, "source_body", "base_footprint");
 
+    source_body_handle_ = world_->getBodyHandle(config_.source_body);
     source_body_ = world_->getRigidBody(config_.source_body);
     scheduler_.StartReady(GetUpdatePeriodSec());
     return true;
@@ -64,20 +65,20 @@ const OdometryConfig& OdometryPublisher::GetConfig() const
 
 void OdometryPublisher::Build(OdometryFrame& out)
 {
-    auto* model = world_->getModel();
-    auto* data = world_->getData();
-    const int body_id = mj_name2id(model, mjOBJ_BODY, config_.source_body.c_str());
-    if (body_id < 0) {
+    if (!source_body_handle_.valid()) {
         return;
     }
+    const auto* data = world_->getData();
+    const int body_id = source_body_handle_.id;
 
     out.header.frame_id = config_.frame_id;
     out.child_frame_id = config_.child_frame_id;
-    out.pose.position = source_body_->GetPosition();
+    const auto& state = source_body_->GetState();
+    out.pose.position = state.position;
     out.pose.orientation = quat_from_mj(&data->xquat[4 * body_id]);
 
-    const auto body_vel = source_body_->GetBodyVelocity();
-    const auto body_ang_vel = source_body_->GetBodyAngularVelocity();
+    const auto& body_vel = state.body_velocity;
+    const auto& body_ang_vel = state.body_angular_velocity;
     out.twist.linear.x = body_vel.x;
     out.twist.linear.y = body_vel.y;
     out.twist.linear.z = body_vel.z;
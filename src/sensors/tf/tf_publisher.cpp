@@ -58,14 +58,11 @@ hako::robots::types::Vector3 rotate_vector(const Quaternion& q, const hako::robo
 WorldPose get_world_pose(
     hako::robots::physics::IWorld* world,
     const std::shared_ptr<hako::robots::physics::IRigidBody>& body,
-    const std::string& body_name)
+    const hako::robots::physics::BodyHandle& handle)
 {
     WorldPose pose {};
     pose.position = body->GetPosition();
-    const int body_id = mj_name2id(world->getModel(), mjOBJ_BODY, body_name.c_str());
-    if (body_id >= 0) {
-        pose.orientation = quat_from_mj(&world->getData()->xquat[4 * body_id]);
-    }
+    pose.orientation = quat_from_mj(&world->getData()->xquat[4 * handle.id]);
     return pose;
 }
 }
@@ -97,6 +94,7 @@ bool TfPublisher::LoadConfig(const std::string& config_path)
 
     body_cache_.clear();
     child_to_body_.clear();
+    bound_transforms_.clear();
     config_.transforms.clear();
     const auto* binding_root = hako::robots::config::FindMjcfBinding(root);
     const common::json* binding_transforms = nullptr;
@@ -127,9 +125,30 @@ bool TfPublisher::LoadConfig(const std::string& config_path)
             config_.transforms.push_back(binding);
             child_to_body_[binding.child_frame_id] = binding.source_body;
             if (!binding.source_body.empty()) {
-                body_cache_[binding.source_body] = world_->getRigidBody(binding.source_body);
+                auto& bound = body_cache_[binding.source_body];
+                bound.body = world_->getRigidBody(binding.source_body);
+                bound.handle = world_->getBodyHandle(binding.source_body);
+            }
+        }
+    }
+    for (const auto& binding : config_.transforms) {
+        BoundTransform bound {};
+        const auto child_it = body_cache_.find(binding.source_body);
+        if (child_it != body_cache_.end()) {
+            bound.child = &child_it->second;
+        }
+        const auto parent_body_it = child_to_body_.find(binding.parent_frame_id);
+        if (binding.parent_frame_id != "odom" && !binding.parent_frame_id.empty() &&
+            parent_body_it != child_to_body_.end()) {
+            const auto parent_it = body_cache_.find(parent_body_it->second);
+            if (parent_it != body_cache_.end()) {
+                bound.parent = &parent_it->second;
+            } else {
+                // The parent frame has no body to measure against.
+                bound.child = nullptr;
             }
         }
+        bound_transforms_.push_back(bound);
     }
 
     scheduler_.StartReady(GetUpdatePeriodSec());
@@ -145,37 +164,24 @@ void TfPublisher::Build(TfFrame& out)
 {
     out.transforms.clear();
 
-    for (const auto& binding : config_.transforms) {
+    for (std::size_t i = 0; i < config_.transforms.size(); ++i) {
+        const auto& binding = config_.transforms[i];
+        const auto& bound = bound_transforms_[i];
+        if (bound.child == nullptr) {
+            continue;
+        }
         TransformFrame frame {};
         frame.header.frame_id = binding.parent_frame_id;
         frame.child_frame_id = binding.child_frame_id;
 
-        auto child_it = body_cache_.find(binding.source_body);
-        if (child_it == body_cache_.end()) {
-            continue;
-        }
-        const auto child_pose = get_world_pose(world_.get(), child_it->second, binding.source_body);
-
-        if (binding.parent_frame_id == "odom" || binding.parent_frame_id.empty()) {
-            frame.transform.position = child_pose.position;
-            frame.transform.orientation = child_pose.orientation;
-            out.transforms.push_back(std::move(frame));
-            continue;
-        }
-
-        auto parent_body_it = child_to_body_.find(binding.parent_frame_id);
-        if (parent_body_it == child_to_body_.end()) {
+        const auto child_pose = get_world_pose(world_.get(), bound.child->body, bound.child->handle);
+        if (bound.parent == nullptr) {
             frame.transform.position = child_pose.position;
             frame.transform.orientation = child_pose.orientation;
             out.transforms.push_back(std::move(frame));
             continue;
         }
-
-        const auto parent_cache_it = body_cache_.find(parent_body_it->second);
-        if (parent_cache_it == body_cache_.end()) {
-            continue;
-        }
-        const auto parent_pose = get_world_pose(world_.get(), parent_cache_it->second, parent_body_it->second);
+        const auto parent_pose = get_world_pose(world_.get(), bound.parent->body, bound.parent->handle);
 
         const Quaternion parent_inv = quat_conjugate(parent_pose.orientation);
         hako::robots::types::Vector3 delta_world {
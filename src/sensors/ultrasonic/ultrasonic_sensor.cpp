@@ -8,6 +8,7 @@
 #include <array>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -150,6 +151,17 @@ bool UltrasonicSensor::LoadConfig(const std::string& config_path)
             config_.cone.ray_count = common::get_json_int(j_cone, "RayCount", 1);
         }
 
+        config_.ray_engine = RayEngine{};
+        if (spec.contains("RayEngine") && spec.at("RayEngine").is_object()) {
+            const auto& j_engine = spec.at("RayEngine");
+            config_.ray_engine.threads = std::max(
+                1,
+                common::get_json_int(j_engine, "Threads", config_.ray_engine.threads));
+            config_.ray_engine.min_rays_per_thread = std::max(
+                1,
+                common::get_json_int(j_engine, "MinRaysPerThread", config_.ray_engine.min_rays_per_thread));
+        }
+
         config_.update_rate_hz = spec.value("update_rate_hz", spec.value("UpdateRate", 10.0));
 
         config_.distance_accuracy.clear();
@@ -275,8 +287,7 @@ bool UltrasonicSensor::LoadConfig(const std::string& config_path)
          * Resolve excluded body once.
          *
          * body_exclude_id_ may remain -1.
-         * In that case mj_ray will not exclude a specific body, and IsSelfGeom()
-         * will also return false.
+         * In that case the ray caster does not exclude anything.
          */
         body_exclude_id_ = -1;
         if (!exclude_body_name_.empty()) {
@@ -291,6 +302,10 @@ bool UltrasonicSensor::LoadConfig(const std::string& config_path)
                     << exclude_body_name_ << std::endl;
             }
         }
+        const int origin_body_id = (runtime_frame_type_ == RuntimeFrameType::Site)
+            ? model->site_bodyid[runtime_frame_id_]
+            : runtime_frame_id_;
+        ray_caster_.Configure(model, body_exclude_id_, origin_body_id);
 
         /*
          * Precompute local ray directions once.
@@ -301,14 +316,16 @@ bool UltrasonicSensor::LoadConfig(const std::string& config_path)
          * - +Y: horizontal direction
          * - +Z: vertical direction
          */
-        ray_dirs_local_.clear();
-
         const int ray_count = std::max(1, config_.cone.ray_count);
         const int side = std::max(
             1,
             static_cast<int>(std::ceil(std::sqrt(static_cast<double>(ray_count)))));
 
-        ray_dirs_local_.reserve(static_cast<std::size_t>(ray_count));
+        ray_local_x_.resize(static_cast<std::size_t>(ray_count));
+        ray_local_y_.resize(static_cast<std::size_t>(ray_count));
+        ray_local_z_.resize(static_cast<std::size_t>(ray_count));
+        ray_dirs_world_.resize(3 * static_cast<std::size_t>(ray_count));
+        ray_hits_.resize(static_cast<std::size_t>(ray_count));
 
         for (int i = 0; i < ray_count; ++i) {
             const int row = i / side;
@@ -327,9 +344,13 @@ bool UltrasonicSensor::LoadConfig(const std::string& config_path)
             const double yaw = h_ratio * config_.cone.horizontal;
             const double pitch = v_ratio * config_.cone.vertical;
 
-            ray_dirs_local_.push_back(make_local_ray_direction(yaw, pitch));
+            const auto dir = make_local_ray_direction(yaw, pitch);
+            ray_local_x_[static_cast<std::size_t>(i)] = static_cast<mjtNum>(dir[0]);
+            ray_local_y_[static_cast<std::size_t>(i)] = static_cast<mjtNum>(dir[1]);
+            ray_local_z_[static_cast<std::size_t>(i)] = static_cast<mjtNum>(dir[2]);
         }
 
+        RebuildWorkerPool();
         rebuild_noise_pipeline(config_, noise_pipeline_);
         scheduler_.StartReady(GetUpdatePeriodSec());
 
@@ -368,22 +389,30 @@ bool UltrasonicSensor::ShouldUpdate(double delta_sec)
 
 void UltrasonicSensor::Measure(UltrasonicFrame& out)
 {
+    if (PrepareRayBatch() > 0) {
+        CastRays();
+    }
+    FinishRayBatch(out);
+}
+
+std::size_t UltrasonicSensor::PrepareRayBatch()
+{
+    batch_model_ = nullptr;
+    batch_data_ = nullptr;
+
     auto* model = world_->getModel();
     auto* data = world_->getData();
 
     if (model == nullptr || data == nullptr) {
-        set_invalid(out, config_);
-        return;
+        return 0;
     }
 
     if (runtime_frame_type_ == RuntimeFrameType::None || runtime_frame_id_ < 0) {
-        set_invalid(out, config_);
-        return;
+        return 0;
     }
 
-    if (ray_dirs_local_.empty()) {
-        set_invalid(out, config_);
-        return;
+    if (ray_local_x_.empty()) {
+        return 0;
     }
 
     const mjtNum* sensor_pos = nullptr;
@@ -396,79 +425,55 @@ void UltrasonicSensor::Measure(UltrasonicFrame& out)
         sensor_pos = &data->xpos[3 * runtime_frame_id_];
         sensor_mat = &data->xmat[9 * runtime_frame_id_];
     } else {
+        return 0;
+    }
+
+    RotateRays(sensor_mat);
+    batch_origin_[0] = sensor_pos[0];
+    batch_origin_[1] = sensor_pos[1];
+    batch_origin_[2] = sensor_pos[2];
+    batch_model_ = model;
+    batch_data_ = data;
+    return ray_hits_.size();
+}
+
+void UltrasonicSensor::CastRayBatch(std::size_t begin, std::size_t end)
+{
+    end = std::min(end, ray_hits_.size());
+    for (std::size_t i = begin; i < end; ++i) {
+        ray_hits_[i] = ray_caster_.Cast(
+            batch_model_,
+            batch_data_,
+            batch_origin_,
+            &ray_dirs_world_[3 * i],
+            std::numeric_limits<mjtNum>::max());
+    }
+}
+
+void UltrasonicSensor::FinishRayBatch(UltrasonicFrame& out)
+{
+    if (batch_model_ == nullptr) {
         set_invalid(out, config_);
         return;
     }
 
     /*
-     * Convert sensor local +X into world coordinates.
-     *
-     * This is the measurement axis used for forward-axis projection.
+     * Reduce to the nearest valid hit, projected onto the measurement axis
+     * (sensor local +X). The reduction runs in ray order on this thread, so
+     * the result does not depend on how the rays were split across threads.
      */
-    mjtNum sensor_forward_local[3] = {1.0, 0.0, 0.0};
-    mjtNum sensor_forward_world[3] = {0.0, 0.0, 0.0};
-
-    mju_mulMatVec3(
-        sensor_forward_world,
-        sensor_mat,
-        sensor_forward_local);
-
-    mju_normalize3(sensor_forward_world);
-
     double min_projected_dist = config_.detection_distance.max;
     bool hit_found = false;
     bool below_min_found = false;
 
-    for (const auto& local_dir : ray_dirs_local_) {
-        mjtNum ray_dir_local[3] = {
-            static_cast<mjtNum>(local_dir[0]),
-            static_cast<mjtNum>(local_dir[1]),
-            static_cast<mjtNum>(local_dir[2])
-        };
-
-        mjtNum ray_dir_world[3] = {0.0, 0.0, 0.0};
-
-        mju_mulMatVec3(
-            ray_dir_world,
-            sensor_mat,
-            ray_dir_local);
-
-        mju_normalize3(ray_dir_world);
-
-        mjtNum from[3] = {
-            sensor_pos[0],
-            sensor_pos[1],
-            sensor_pos[2]
-        };
-
-        int geom_id[1] = {-1};
-        mjtNum normal[3] = {0.0, 0.0, 0.0};
-
-        const mjtNum hit_dist = mj_ray(
-            model,
-            data,
-            from,
-            ray_dir_world,
-            nullptr,
-            1,
-            body_exclude_id_,
-            geom_id,
-            normal);
-
+    const std::size_t ray_count = ray_hits_.size();
+    for (std::size_t i = 0; i < ray_count; ++i) {
+        const mjtNum hit_dist = ray_hits_[i];
         if (hit_dist < 0.0) {
             continue;
         }
 
-        if (IsSelfGeom(model, body_exclude_id_, geom_id[0])) {
-            continue;
-        }
-
-        const double cos_theta =
-            static_cast<double>(
-                sensor_forward_world[0] * ray_dir_world[0] +
-                sensor_forward_world[1] * ray_dir_world[1] +
-                sensor_forward_world[2] * ray_dir_world[2]);
-
+        const double cos_theta = static_cast<double>(ray_local_x_[i]);
         if (cos_theta <= 0.0) {
             continue;
         }
@@ -512,4 +517,52 @@ void UltrasonicSensor::Measure(UltrasonicFrame& out)
     out.variance = stddev * stddev;
 }
 
+void UltrasonicSensor::RebuildWorkerPool()
+{
+    if (config_.ray_engine.threads <= 1) {
+        worker_pool_.reset();
+        return;
+    }
+    if (worker_pool_ == nullptr || worker_pool_->ThreadCount() != config_.ray_engine.threads) {
+        worker_pool_ = std::make_unique<runtime::WorkerPool>(config_.ray_engine.threads);
+    }
+}
+
+void UltrasonicSensor::RotateRays(const mjtNum* sensor_mat)
+{
+    // Same product as mju_mulMatVec3(world, sensor_mat, local) for every ray,
+    // written as one flat loop over the SoA table so it vectorizes.
+    const mjtNum m00 = sensor_mat[0], m01 = sensor_mat[1], m02 = sensor_mat[2];
+    const mjtNum m10 = sensor_mat[3], m11 = sensor_mat[4], m12 = sensor_mat[5];
+    const mjtNum m20 = sensor_mat[6], m21 = sensor_mat[7], m22 = sensor_mat[8];
+
+    const std::size_t ray_count = ray_local_x_.size();
+    const mjtNum* lx = ray_local_x_.data();
+    const mjtNum* ly = ray_local_y_.data();
+    const mjtNum* lz = ray_local_z_.data();
+    mjtNum* world = ray_dirs_world_.data();
+
+    for (std::size_t i = 0; i < ray_count; ++i) {
+        world[3 * i + 0] = m00 * lx[i] + m01 * ly[i] + m02 * lz[i];
+        world[3 * i + 1] = m10 * lx[i] + m11 * ly[i] + m12 * lz[i];
+        world[3 * i + 2] = m20 * lx[i] + m21 * ly[i] + m22 * lz[i];
+    }
+}
+
+void UltrasonicSensor::CastRays()
+{
+    if (worker_pool_ == nullptr) {
+        CastRayBatch(0, ray_hits_.size());
+        return;
+    }
+    // mj_ray only reads model and data, so chunks may run concurrently; each
+    // chunk writes a disjoint slice of ray_hits_. Capturing only this keeps
+    // the std::function in ParallelFor within its small-buffer storage: no
+    // allocation per measurement.
+    worker_pool_->ParallelFor(
+        ray_hits_.size(),
+        static_cast<std::size_t>(config_.ray_engine.min_rays_per_thread),
+        [this](std::size_t begin, std::size_t end) { CastRayBatch(begin, end); });
+}
+
 } // namespace hako::robots::sensor::ultrasonic
@@ -0,0 +1,78 @@
+#include "physics/batched_world.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <mujoco/mujoco.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Environment-steps per second of a BatchedWorld on the TB3 sample world,
+// against the pool's thread count. One thread steps every environment
+// inline, which is what N separate WorldImpl would cost.
+
+namespace
+{
+using hako::robots::physics::impl::BatchedWorld;
+using hako::robots::sensor::test::RepoRoot;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kEnvCount = 64;
+constexpr int kStepsPerCall = 10;
+constexpr int kCalls = 50;
+
+double MeasureEnvStepsPerSec(const std::string& xml, int thread_count)
+{
+    BatchedWorld batch(kEnvCount, thread_count);
+    batch.loadModel(xml);
+    // Something for each environment to do besides settle.
+    const int nu = batch.getModel()->nu;
+    const BatchedWorld::ControlFunction control = [nu](std::size_t env, mjData* env_data) {
+        for (int i = 0; i < nu; ++i) {
+            env_data->ctrl[i] = 0.5 + 0.01 * static_cast<double>(env);
+        }
+    };
+    batch.advanceTimeSteps(kStepsPerCall, control);
+
+    const auto start = Clock::now();
+    for (int call = 0; call < kCalls; ++call) {
+        batch.advanceTimeSteps(kStepsPerCall, control);
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(kEnvCount) * kStepsPerCall * kCalls / elapsed;
+}
+}
+
+int main()
+{
+    try {
+        const std::string xml = (RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string();
+        const int max_threads = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+        std::vector<int> thread_counts;
+        for (int threads = 1; threads < max_threads; threads *= 2) {
+            thread_counts.push_back(threads);
+        }
+        thread_counts.push_back(max_threads);
+
+        double baseline = 0.0;
+        for (const int threads : thread_counts) {
+            const double rate = MeasureEnvStepsPerSec(xml, threads);
+            if (threads == 1) {
+                baseline = rate;
+            }
+            std::printf("envs=%3zu  threads=%3d  env-steps/s=%11.0f  (x%.2f)\n",
+                        kEnvCount, threads, rate, rate / baseline);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
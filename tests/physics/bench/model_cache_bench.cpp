@@ -0,0 +1,77 @@
+#include "physics/model_cache.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <mujoco/mujoco.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Time to first step of the sample worlds: load the model, make data and
+// take one mj_step. "xml" compiles the MJCF every time, as loadModel did
+// before the cache; "cached" loads the compiled model the first run stored.
+
+namespace
+{
+using hako::robots::physics::impl::ModelCache;
+using hako::robots::physics::impl::ModelCacheResult;
+using hako::robots::sensor::test::RepoRoot;
+using Clock = std::chrono::steady_clock;
+
+constexpr int kIterations = 10;
+
+double TimeToFirstStepMs(const ModelCache& cache, const std::string& model_file, bool expect_hit)
+{
+    double total_ms = 0.0;
+    for (int i = 0; i < kIterations; ++i) {
+        ModelCacheResult result;
+        const auto start = Clock::now();
+        mjModel* model = cache.load(model_file, &result);
+        if (!model) {
+            throw std::runtime_error("failed to load " + model_file);
+        }
+        mjData* data = mj_makeData(model);
+        mj_step(model, data);
+        total_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        mj_deleteData(data);
+        mj_deleteModel(model);
+        if (result.hit != expect_hit) {
+            throw std::runtime_error("unexpected cache result for " + model_file);
+        }
+    }
+    return total_ms / kIterations;
+}
+}
+
+int main()
+{
+    const auto cache_dir = std::filesystem::temp_directory_path() / "hako_model_cache_bench";
+    try {
+        std::filesystem::remove_all(cache_dir);
+        const ModelCache disabled({});
+        const ModelCache cache(cache_dir);
+        const char* worlds[] = {
+            "models/tb3/turtlebot3_burger_world.xml",
+            "models/forklift/forklift.xml",
+        };
+        for (const char* world : worlds) {
+            const std::string model_file = (RepoRoot() / world).string();
+            const double xml_ms = TimeToFirstStepMs(disabled, model_file, false);
+            // Stores the compiled model; not part of the timing.
+            mj_deleteModel(cache.load(model_file));
+            const double cached_ms = TimeToFirstStepMs(cache, model_file, true);
+            std::printf("%-42s xml=%8.2f ms  cached=%8.2f ms  (x%.1f)\n",
+                        world, xml_ms, cached_ms, xml_ms / cached_ms);
+        }
+        std::filesystem::remove_all(cache_dir);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
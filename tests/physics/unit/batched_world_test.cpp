@@ -0,0 +1,136 @@
+#include "physics/batched_world.hpp"
+#include "physics/physics_impl.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+using hako::robots::physics::impl::BatchedWorld;
+using hako::robots::physics::impl::BatchedWorldEnvironment;
+using hako::robots::physics::impl::WorldImpl;
+
+constexpr std::size_t kEnvCount = 8;
+constexpr int kSteps = 200;
+
+// A box pushed along a damped slide joint by a motor.
+std::filesystem::path WriteSliderXml()
+{
+    const auto path = std::filesystem::temp_directory_path() / "hako_batched_world_test.xml";
+    std::ofstream xml(path);
+    xml << R"(<mujoco model="batched_world_test">
+  <option timestep="0.002" gravity="0 0 0"/>
+  <worldbody>
+    <body name="slider">
+      <joint name="slide" type="slide" axis="1 0 0" damping="0.5"/>
+      <geom type="box" size="0.1 0.1 0.1" mass="1"/>
+    </body>
+  </worldbody>
+  <actuator>
+    <motor name="push" joint="slide"/>
+  </actuator>
+</mujoco>
+)";
+    return path;
+}
+
+double ForceFor(std::size_t env)
+{
+    return 0.25 * static_cast<double>(env);
+}
+
+bool Throws(const std::function<void()>& fn)
+{
+    try {
+        fn();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+void TestMatchesSerialWorlds(const std::filesystem::path& xml)
+{
+    auto batch = std::make_shared<BatchedWorld>(kEnvCount, 3);
+    batch->loadModel(xml.string());
+    HAKO_TEST_EXPECT(batch->getEnvCount() == kEnvCount && batch->getThreadCount() == 3, "unexpected batch shape");
+    HAKO_TEST_EXPECT(batch->getData() == batch->getEnvData(0), "getData() should be environment 0");
+
+    // Each environment gets its own control from the pool thread stepping it.
+    batch->advanceTimeSteps(kSteps, [](std::size_t env, mjData* env_data) { env_data->ctrl[0] = ForceFor(env); });
+
+    for (std::size_t env = 0; env < kEnvCount; ++env) {
+        WorldImpl serial;
+        serial.loadModel(xml.string());
+        for (int step = 0; step < kSteps; ++step) {
+            serial.getData()->ctrl[0] = ForceFor(env);
+            serial.advanceTimeStep();
+        }
+        const mjData* batched = batch->getEnvData(env);
+        HAKO_TEST_EXPECT(batched->time == serial.getData()->time, "batched time should match a serial world");
+        HAKO_TEST_EXPECT(batched->qpos[0] == serial.getData()->qpos[0] && batched->qvel[0] == serial.getData()->qvel[0],
+                         "batched state should match a serial world bit for bit");
+    }
+    HAKO_TEST_EXPECT(batch->getEnvData(kEnvCount - 1)->qpos[0] > batch->getEnvData(1)->qpos[0],
+                     "environments should evolve independently");
+    HAKO_TEST_EXPECT(batch->getEnvData(0)->qpos[0] == 0.0, "an unforced environment should not move");
+
+    batch->advanceTimeStep();
+    HAKO_TEST_EXPECT(batch->getEnvData(3)->time > kSteps * 0.002, "advanceTimeStep should step every environment");
+}
+
+void TestEnvironmentViews(const std::filesystem::path& xml)
+{
+    auto batch = std::make_shared<BatchedWorld>(kEnvCount, 2);
+    batch->loadModel(xml.string());
+
+    // An actuator bound to environment 5 drives only that environment.
+    auto env5 = std::make_shared<BatchedWorldEnvironment>(batch, 5);
+    HAKO_TEST_EXPECT(env5->getModel() == batch->getModel(), "views should share the batch model");
+    HAKO_TEST_EXPECT(env5->getData() == batch->getEnvData(5), "view should expose its environment");
+    env5->getTorqueActuator("push")->SetTorque(2.0);
+    batch->advanceTimeSteps(50);
+    for (std::size_t env = 0; env < kEnvCount; ++env) {
+        const bool moved = batch->getEnvData(env)->qpos[0] > 0.0;
+        HAKO_TEST_EXPECT(moved == (env == 5), "only environment 5 should move");
+    }
+    const auto position = env5->getRigidBody("slider")->GetPosition();
+    HAKO_TEST_EXPECT(position.x == batch->getEnvData(5)->xpos[3], "rigid body should read its environment");
+
+    batch->resetEnv(5);
+    HAKO_TEST_EXPECT(batch->getEnvData(5)->time == 0.0 && batch->getEnvData(5)->qpos[0] == 0.0,
+                     "resetEnv should restore the initial state");
+    HAKO_TEST_EXPECT(batch->getEnvData(4)->time > 0.0, "resetEnv should leave other environments alone");
+
+    HAKO_TEST_EXPECT(Throws([&]() { env5->advanceTimeStep(); }), "views should not step on their own");
+    HAKO_TEST_EXPECT(Throws([&]() { env5->loadModel(xml.string()); }), "views should not load models");
+    HAKO_TEST_EXPECT(Throws([&]() { batch->getEnvData(kEnvCount); }), "out-of-range environment should throw");
+    HAKO_TEST_EXPECT(Throws([&]() { BatchedWorldEnvironment(batch, kEnvCount); }), "out-of-range view should throw");
+    HAKO_TEST_EXPECT(Throws([&]() { batch->loadModel(xml.string()); }), "a second loadModel should throw");
+    HAKO_TEST_EXPECT(Throws([]() { BatchedWorld(0, 1); }), "an empty batch should throw");
+}
+}
+
+int main()
+{
+    try {
+        const auto xml = WriteSliderXml();
+        TestMatchesSerialWorlds(xml);
+        TestEnvironmentViews(xml);
+        std::filesystem::remove(xml);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "batched_world_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+#include "physics/model_cache.hpp"
+#include "physics/physics_impl.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+using hako::robots::physics::impl::ModelCache;
+using hako::robots::physics::impl::ModelCacheResult;
+
+void WriteFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream ofs(path, std::ios::binary);
+    ofs << text;
+}
+
+std::string BodyXml(double mass)
+{
+    return "<mujoco>\n  <worldbody>\n    <body name=\"box\" pos=\"0 0 1\">\n"
+           "      <freejoint/>\n      <geom type=\"box\" size=\"0.1 0.1 0.1\" mass=\"" + std::to_string(mass) + "\"/>\n"
+           "    </body>\n  </worldbody>\n</mujoco>\n";
+}
+
+// The model keeps its body in an included file, so the key must follow it.
+std::filesystem::path WriteModel(const std::filesystem::path& dir, double mass)
+{
+    WriteFile(dir / "parts/box.xml", BodyXml(mass));
+    const auto model = dir / "scene.xml";
+    WriteFile(model, "<mujoco model=\"model_cache_test\">\n"
+                     "  <option timestep=\"0.002\"/>\n"
+                     "  <include file=\"parts/box.xml\"/>\n"
+                     "</mujoco>\n");
+    return model;
+}
+
+bool Contains(const std::vector<std::filesystem::path>& files, const std::filesystem::path& path)
+{
+    return std::find(files.begin(), files.end(), path.lexically_normal()) != files.end();
+}
+
+void TestReferencedFiles(const std::filesystem::path& dir)
+{
+    WriteFile(dir / "refs/meshes/wheel.stl", "solid wheel");
+    WriteFile(dir / "refs/textures/floor.png", "png");
+    WriteFile(dir / "refs/parts/arm.xml", "<mujoco><asset><mesh file=\"wheel.stl\"/></asset></mujoco>\n");
+    const auto model = dir / "refs/robot.xml";
+    WriteFile(model, "<mujoco>\n"
+                     "  <compiler meshdir=\"meshes\" texturedir=\"textures\"/>\n"
+                     "  <include file=\"parts/arm.xml\"/>\n"
+                     "  <asset><texture name=\"floor\" type=\"2d\" file=\"floor.png\"/>\n"
+                     "    <mesh name=\"missing\" file=\"not_there.stl\"/></asset>\n"
+                     "</mujoco>\n");
+
+    const auto files = ModelCache::referencedFiles(model.string());
+    HAKO_TEST_EXPECT(files.size() == 4 && files.front() == model, "unexpected referenced file count");
+    HAKO_TEST_EXPECT(Contains(files, dir / "refs/parts/arm.xml"), "includes should be followed");
+    HAKO_TEST_EXPECT(Contains(files, dir / "refs/meshes/wheel.stl"), "meshes should resolve against meshdir");
+    HAKO_TEST_EXPECT(Contains(files, dir / "refs/textures/floor.png"), "textures should resolve against texturedir");
+
+    // Editing any referenced file changes the key.
+    const std::string key = ModelCache::keyFor(model.string());
+    HAKO_TEST_EXPECT(key.size() == 16 && key == ModelCache::keyFor(model.string()), "keys should be stable");
+    WriteFile(dir / "refs/meshes/wheel.stl", "solid wheel 2");
+    HAKO_TEST_EXPECT(ModelCache::keyFor(model.string()) != key, "a mesh edit should change the key");
+    HAKO_TEST_EXPECT(ModelCache::keyFor((dir / "refs/absent.xml").string()).empty(), "a missing model has no key");
+}
+
+void TestMissThenHit(const std::filesystem::path& dir)
+{
+    const auto model_file = WriteModel(dir / "model", 2.0);
+    const ModelCache cache(dir / "cache");
+
+    ModelCacheResult result;
+    mjModel* compiled = cache.load(model_file.string(), &result);
+    HAKO_TEST_EXPECT(compiled != nullptr && result.enabled, "cold load should compile the XML");
+    HAKO_TEST_EXPECT(!result.hit && result.stored && std::filesystem::exists(result.path), "cold load should store");
+    const std::string first_key = result.key;
+
+    mjModel* cached = cache.load(model_file.string(), &result);
+    HAKO_TEST_EXPECT(cached != nullptr && result.hit && !result.stored, "warm load should hit the cache");
+    HAKO_TEST_EXPECT(cached->nbody == compiled->nbody && cached->nq == compiled->nq, "cached model layout differs");
+    const int body = mj_name2id(cached, mjOBJ_BODY, "box");
+    HAKO_TEST_EXPECT(body > 0 && cached->body_mass[body] == compiled->body_mass[body], "cached model should keep masses");
+
+    // The cached model steps like the compiled one.
+    mjData* compiled_data = mj_makeData(compiled);
+    mjData* cached_data = mj_makeData(cached);
+    for (int i = 0; i < 50; ++i) {
+        mj_step(compiled, compiled_data);
+        mj_step(cached, cached_data);
+    }
+    HAKO_TEST_EXPECT(cached_data->qpos[2] == compiled_data->qpos[2], "cached model should step identically");
+    mj_deleteData(compiled_data);
+    mj_deleteData(cached_data);
+    mj_deleteModel(compiled);
+    mj_deleteModel(cached);
+
+    // An edited include is a new key, not a stale hit.
+    WriteFile(dir / "model/parts/box.xml", BodyXml(5.0));
+    cached = cache.load(model_file.string(), &result);
+    HAKO_TEST_EXPECT(cached != nullptr && !result.hit && result.key != first_key, "an edited include should miss");
+    HAKO_TEST_EXPECT(cached->body_mass[body] == 5.0, "the edited model should be compiled");
+    mj_deleteModel(cached);
+
+    // A corrupt entry falls back to the XML and is rewritten.
+    WriteFile(result.path, "not a model");
+    cached = cache.load(model_file.string(), &result);
+    HAKO_TEST_EXPECT(cached != nullptr && !result.hit && result.stored, "a corrupt entry should be recompiled");
+    mj_deleteModel(cached);
+    cached = cache.load(model_file.string(), &result);
+    HAKO_TEST_EXPECT(cached != nullptr && result.hit, "the rewritten entry should hit");
+    mj_deleteModel(cached);
+}
+
+void TestDisabled(const std::filesystem::path& dir)
+{
+    const auto model_file = WriteModel(dir / "disabled", 1.0);
+    const ModelCache cache({});
+    ModelCacheResult result;
+    mjModel* compiled = cache.load(model_file.string(), &result);
+    HAKO_TEST_EXPECT(compiled != nullptr && !result.enabled && !result.hit && !result.stored,
+                     "an empty directory should disable the cache");
+    mj_deleteModel(compiled);
+    HAKO_TEST_EXPECT(cache.load((dir / "disabled/absent.xml").string(), &result) == nullptr,
+                     "a missing model should fail to load");
+
+    // WorldImpl goes through the same path.
+    hako::robots::physics::impl::WorldImpl world;
+    world.loadModel(model_file.string());
+    HAKO_TEST_EXPECT(world.getModel() != nullptr && world.getData() != nullptr, "WorldImpl should load the model");
+}
+}
+
+int main()
+{
+    const auto dir = std::filesystem::temp_directory_path() / "hako_model_cache_test";
+    try {
+        std::filesystem::remove_all(dir);
+        TestReferencedFiles(dir);
+        TestMissThenHit(dir);
+        TestDisabled(dir);
+        std::filesystem::remove_all(dir);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "model_cache_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#include "physics/physics_impl.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+using hako::robots::physics::ModelRegistry;
+using hako::robots::physics::impl::WorldImpl;
+
+std::filesystem::path WriteArmXml()
+{
+    const auto path = std::filesystem::temp_directory_path() / "hako_model_registry_test.xml";
+    std::ofstream xml(path);
+    xml << R"(<mujoco model="model_registry_test">
+  <worldbody>
+    <body name="base" pos="0 0 1">
+      <freejoint name="base_free"/>
+      <geom type="box" size="0.2 0.2 0.05" mass="2"/>
+      <body name="arm" pos="0 0 0.1">
+        <joint name="shoulder" type="hinge" axis="0 1 0"/>
+        <geom type="capsule" fromto="0 0 0 0.3 0 0" size="0.02" mass="0.3"/>
+        <site name="tip" pos="0.3 0 0"/>
+        <camera name="tip_camera" pos="0.3 0 0"/>
+      </body>
+    </body>
+  </worldbody>
+  <actuator>
+    <motor name="shoulder_motor" joint="shoulder"/>
+    <motor name="tip_push" site="tip" gear="1 0 0 0 0 0"/>
+  </actuator>
+  <sensor>
+    <jointpos name="shoulder_pos" joint="shoulder"/>
+    <framepos name="tip_pos" objtype="site" objname="tip"/>
+  </sensor>
+</mujoco>
+)";
+    return path;
+}
+
+bool ThrowsWith(const std::function<void()>& fn, const std::string& message)
+{
+    try {
+        fn();
+    } catch (const std::runtime_error& e) {
+        return message == e.what();
+    }
+    return false;
+}
+
+void TestHandles()
+{
+    auto world = std::make_shared<WorldImpl>();
+    world->loadModel(WriteArmXml().string());
+    const mjModel* model = world->getModel();
+    const auto registry = world->getRegistry();
+    HAKO_TEST_EXPECT(registry->getModel() == model, "registry should describe the world model");
+    HAKO_TEST_EXPECT(world->getRegistry() == registry, "the registry should be built once");
+
+    const auto base = world->getBodyHandle("base");
+    const auto arm = world->getBodyHandle("arm");
+    const int free_joint = mj_name2id(model, mjOBJ_JOINT, "base_free");
+    HAKO_TEST_EXPECT(base.id == mj_name2id(model, mjOBJ_BODY, "base") && arm.root_id == base.id,
+                     "body handles should match the model");
+    HAKO_TEST_EXPECT(base.free_qpos_adr == model->jnt_qposadr[free_joint] &&
+                         base.free_dof_adr == model->jnt_dofadr[free_joint],
+                     "a free body should carry its joint addresses");
+    HAKO_TEST_EXPECT(arm.free_qpos_adr < 0 && arm.free_dof_adr < 0, "a hinged body has no free joint");
+
+    const auto shoulder = world->getJointHandle("shoulder");
+    HAKO_TEST_EXPECT(shoulder.body_id == arm.id && shoulder.type == mjJNT_HINGE &&
+                         shoulder.qpos_adr == 7 && shoulder.dof_adr == 6,
+                     "joint handles should carry qpos/dof addresses");
+
+    const auto motor = world->getActuatorHandle("shoulder_motor");
+    const auto push = world->getActuatorHandle("tip_push");
+    HAKO_TEST_EXPECT(motor.ctrl_adr == 0 && motor.joint_id == shoulder.id, "joint actuators should know their joint");
+    HAKO_TEST_EXPECT(push.ctrl_adr == 1 && push.joint_id < 0, "site actuators have no joint");
+
+    const auto tip = world->getSensorHandle("tip_pos");
+    HAKO_TEST_EXPECT(world->getSensorHandle("shoulder_pos").dim == 1 && tip.dim == 3 && tip.adr == 1,
+                     "sensor handles should cover their sensordata range");
+
+    HAKO_TEST_EXPECT(world->getCameraHandle("tip_camera").id == mj_name2id(model, mjOBJ_CAMERA, "tip_camera"),
+                     "camera handles should match the model");
+
+    HAKO_TEST_EXPECT(!registry->findBody("missing").valid() && !registry->findJoint("missing").valid() &&
+                         !registry->findActuator("missing").valid() && !registry->findCamera("missing").valid() &&
+                         !registry->findSensor("missing").valid(),
+                     "find should return invalid handles for unknown names");
+    HAKO_TEST_EXPECT(ThrowsWith([&]() { world->getBodyHandle("missing"); }, "Body not found: missing"),
+                     "unknown bodies should throw");
+    HAKO_TEST_EXPECT(ThrowsWith([&]() { world->getActuatorHandle("missing"); }, "Actuator not found: missing"),
+                     "unknown actuators should throw");
+    HAKO_TEST_EXPECT(ThrowsWith([&]() { world->getRigidBody("missing"); }, "Body not found: missing"),
+                     "getRigidBody should report unknown bodies as before");
+}
+
+void TestHandlesDriveTheWorld()
+{
+    auto world = std::make_shared<WorldImpl>();
+    world->loadModel(WriteArmXml().string());
+    mjData* data = world->getData();
+
+    world->getTorqueActuator("shoulder_motor")->SetTorque(0.75);
+    HAKO_TEST_EXPECT(data->ctrl[0] == 0.75 && data->ctrl[1] == 0.0, "torque should go to the actuator's ctrl");
+
+    data->qpos[world->getJointHandle("shoulder").qpos_adr] = 0.5;
+    data->qpos[world->getBodyHandle("base").free_qpos_adr] = 3.0;
+    mj_forward(world->getModel(), data);
+    const auto tip = world->getSensorHandle("tip_pos");
+    HAKO_TEST_EXPECT(std::abs(data->sensordata[tip.adr] - (3.0 + 0.3 * std::cos(0.5))) < 1.0e-9,
+                     "handles should address the same state MuJoCo uses");
+    HAKO_TEST_EXPECT(world->getRigidBody("base")->GetPosition().x == 3.0, "rigid bodies should bind through handles");
+
+    // Snapshot views share the layout and get their own registry.
+    hako::robots::physics::impl::SnapshotWorldImpl snapshot(world, true);
+    HAKO_TEST_EXPECT(snapshot.getRegistry()->getModel() == snapshot.getModel() &&
+                         snapshot.getBodyHandle("arm").id == world->getBodyHandle("arm").id,
+                     "a copied model should have matching handles");
+}
+}
+
+int main()
+{
+    try {
+        TestHandles();
+        TestHandlesDriveTheWorld();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "model_registry_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+#include "physics/physics_impl.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+using hako::robots::physics::RigidBodyState;
+using hako::robots::physics::impl::WorldImpl;
+
+// A tumbling box on a free joint, so every component of the state moves,
+// and a body whose inertial frame is rotated against its body frame (like
+// TB3 base_link), where mjOBJ_BODY velocities are in the inertial frame.
+std::filesystem::path WriteTumblerXml()
+{
+    const auto path = std::filesystem::temp_directory_path() / "hako_rigid_body_state_test.xml";
+    std::ofstream xml(path);
+    xml << R"(<mujoco model="rigid_body_state_test">
+  <option timestep="0.002" gravity="0 0 -9.81"/>
+  <worldbody>
+    <body name="tumbler" pos="0 0 2" euler="0.3 -0.2 0.5">
+      <freejoint name="free"/>
+      <geom type="box" size="0.2 0.1 0.05" mass="1"/>
+      <body name="tip" pos="0.3 0 0">
+        <geom type="sphere" size="0.05" mass="0.2"/>
+      </body>
+    </body>
+    <body name="skewed" pos="1 0 2" euler="-0.1 0.2 0.4">
+      <freejoint name="skewed_free"/>
+      <inertial pos="0.05 0 0" quat="0.994532 0 0 0.104528" mass="1" diaginertia="0.01 0.02 0.03"/>
+      <geom type="box" size="0.2 0.1 0.05" contype="0" conaffinity="0"/>
+    </body>
+  </worldbody>
+</mujoco>
+)";
+    return path;
+}
+
+// What the per-quantity getters computed before the cache.
+void ExpectMatchesDirect(const mjModel* model, const mjData* data, int body_id, const RigidBodyState& state)
+{
+    mjtNum world[6] = {};
+    mjtNum local[6] = {};
+    mj_objectVelocity(model, data, mjOBJ_BODY, body_id, world, 0);
+    mj_objectVelocity(model, data, mjOBJ_BODY, body_id, local, 1);
+    HAKO_TEST_EXPECT(state.time == data->time, "state should be stamped with the data time");
+    HAKO_TEST_EXPECT(state.position.x == data->xpos[3 * body_id] && state.position.z == data->xpos[3 * body_id + 2],
+                     "position should match xpos");
+    HAKO_TEST_EXPECT(state.velocity.x == world[3] && state.velocity.y == world[4] && state.velocity.z == world[5],
+                     "world linear velocity should match mj_objectVelocity");
+    HAKO_TEST_EXPECT(state.angular_velocity.x == world[0] && state.angular_velocity.z == world[2],
+                     "world angular velocity should match mj_objectVelocity");
+    HAKO_TEST_EXPECT(state.body_velocity.x == local[3] && state.body_velocity.y == local[4] &&
+                         state.body_velocity.z == local[5],
+                     "body linear velocity should match the local mj_objectVelocity");
+    HAKO_TEST_EXPECT(state.body_angular_velocity.x == local[0] && state.body_angular_velocity.y == local[1] &&
+                         state.body_angular_velocity.z == local[2],
+                     "body angular velocity should match the local mj_objectVelocity");
+}
+
+void TestStateFollowsSteps()
+{
+    WorldImpl world;
+    world.loadModel(WriteTumblerXml().string());
+    mjModel* model = world.getModel();
+    mjData* data = world.getData();
+    const int body_id = mj_name2id(model, mjOBJ_BODY, "tumbler");
+    for (int i = 0; i < 12; ++i) {
+        data->qvel[i] = 0.4 * ((i % 6) + 1);
+    }
+    mj_forward(model, data);
+
+    auto body = world.getRigidBody("tumbler");
+    const RigidBodyState* first = &body->GetState();
+    ExpectMatchesDirect(model, data, body_id, *first);
+
+    // Individual getters read the same cached state.
+    HAKO_TEST_EXPECT(body->GetBodyVelocity().x == first->body_velocity.x &&
+                         body->GetBodyAngularVelocity().z == first->body_angular_velocity.z &&
+                         body->GetVelocity().y == first->velocity.y && body->GetEuler().z == first->euler.z,
+                     "getters should agree with GetState");
+    HAKO_TEST_EXPECT(&body->GetState() == first, "GetState should return the same cached object");
+
+    for (int step = 0; step < 25; ++step) {
+        const double before = body->GetState().time;
+        world.advanceTimeStep();
+        const auto& state = body->GetState();
+        HAKO_TEST_EXPECT(state.time > before, "a step should refresh the state");
+        ExpectMatchesDirect(model, data, body_id, state);
+    }
+
+    // The inertial frame, not the body frame, is the local frame of
+    // mj_objectVelocity(mjOBJ_BODY).
+    const int skewed_id = mj_name2id(model, mjOBJ_BODY, "skewed");
+    HAKO_TEST_EXPECT(data->ximat[9 * skewed_id] != data->xmat[9 * skewed_id],
+                     "the skewed body should have a rotated inertial frame");
+    auto skewed = world.getRigidBody("skewed");
+    ExpectMatchesDirect(model, data, skewed_id, skewed->GetState());
+
+    // The nested body's tree root is the tumbler.
+    auto tip = world.getRigidBody("tip");
+    ExpectMatchesDirect(model, data, mj_name2id(model, mjOBJ_BODY, "tip"), tip->GetState());
+}
+
+// State restores and mirrored poses write qpos/qvel and call mj_forward
+// without advancing time; the cache must not hide that.
+void TestSameTimeWrites()
+{
+    WorldImpl world;
+    world.loadModel(WriteTumblerXml().string());
+    mjModel* model = world.getModel();
+    mjData* data = world.getData();
+    auto body = world.getRigidBody("tumbler");
+    const double time = body->GetState().time;
+    const double x = body->GetState().position.x;
+
+    data->qpos[0] += 1.0;
+    data->qvel[5] = 3.0;
+    mj_forward(model, data);
+    const auto& state = body->GetState();
+    HAKO_TEST_EXPECT(data->time == time, "the write should not advance time");
+    HAKO_TEST_EXPECT(state.position.x == x + 1.0, "a same-time pose write should refresh the state");
+    ExpectMatchesDirect(model, data, mj_name2id(model, mjOBJ_BODY, "tumbler"), state);
+}
+}
+
+int main()
+{
+    try {
+        TestStateFollowsSteps();
+        TestSameTimeWrites();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "rigid_body_state_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
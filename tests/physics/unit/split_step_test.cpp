@@ -0,0 +1,223 @@
+#include "physics/batched_world.hpp"
+#include "physics/physics_impl.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+using hako::robots::physics::impl::BatchedWorld;
+using hako::robots::physics::impl::WorldImpl;
+
+constexpr int kSteps = 100;
+constexpr double kKp = 40.0;
+constexpr double kKd = 4.0;
+constexpr double kTarget = 0.3;
+
+// A box on a slide joint driven by a motor; the body origin tracks the joint.
+std::filesystem::path WriteSliderXml(const std::string& integrator)
+{
+    const auto path = std::filesystem::temp_directory_path() / ("hako_split_step_test_" + integrator + ".xml");
+    std::ofstream xml(path);
+    xml << R"(<mujoco model="split_step_test">
+  <option timestep="0.001" gravity="0 0 0" integrator=")" << integrator << R"("/>
+  <worldbody>
+    <body name="slider">
+      <joint name="slide" type="slide" axis="1 0 0" damping="0.5"/>
+      <geom type="box" size="0.1 0.1 0.1" mass="1"/>
+    </body>
+  </worldbody>
+  <actuator>
+    <motor name="push" joint="slide"/>
+  </actuator>
+</mujoco>
+)";
+    return path;
+}
+
+std::shared_ptr<WorldImpl> LoadWorld(const std::string& integrator = "Euler")
+{
+    auto world = std::make_shared<WorldImpl>();
+    world->loadModel(WriteSliderXml(integrator).string());
+    return world;
+}
+
+bool Throws(const std::function<void()>& fn)
+{
+    try {
+        fn();
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+void TestRateDivisors()
+{
+    auto world = LoadWorld();
+    int fast = 0;
+    int mid = 0;
+    int slow = 0;
+    world->addControlCallback([&](const mjModel*, mjData*) { ++fast; });
+    world->addControlCallback([&](const mjModel*, mjData*) { ++mid; }, 2);
+    const int slow_id = world->addControlCallback([&](const mjModel*, mjData*) { ++slow; }, 10);
+    world->advanceTimeStep();
+    HAKO_TEST_EXPECT(fast == 1 && mid == 1 && slow == 1, "every callback should run on its first step");
+    for (int step = 1; step < kSteps; ++step) {
+        world->advanceTimeStep();
+    }
+    HAKO_TEST_EXPECT(fast == kSteps && mid == kSteps / 2 && slow == kSteps / 10,
+                     "callbacks should run at physics rate / divisor");
+
+    // A late registration starts on the next step, not on the global phase.
+    int late = 0;
+    world->addControlCallback([&](const mjModel*, mjData*) { ++late; }, 7);
+    world->advanceTimeStep();
+    HAKO_TEST_EXPECT(late == 1, "a new callback should run on the next step");
+
+    HAKO_TEST_EXPECT(world->removeControlCallback(slow_id), "remove should find the callback");
+    HAKO_TEST_EXPECT(!world->removeControlCallback(slow_id), "remove should report unknown ids");
+    const int slow_before = slow;
+    for (int step = 0; step < 20; ++step) {
+        world->advanceTimeStep();
+    }
+    HAKO_TEST_EXPECT(slow == slow_before, "removed callbacks should not run");
+
+    HAKO_TEST_EXPECT(Throws([&]() { world->addControlCallback([](const mjModel*, mjData*) {}, 0); }),
+                     "divisor 0 should be rejected");
+    HAKO_TEST_EXPECT(Throws([&]() { world->addControlCallback({}); }), "empty callbacks should be rejected");
+}
+
+void TestCallbacksSeeTheSteppedState()
+{
+    auto world = LoadWorld();
+    mjData* data = world->getData();
+    const auto slide = world->getJointHandle("slide");
+    const int body = world->getBodyHandle("slider").id;
+    data->qvel[slide.dof_adr] = 1.0;
+    int stale = 0;
+    world->addControlCallback([&](const mjModel*, mjData* d) {
+        if (d->xpos[3 * body] != d->qpos[slide.qpos_adr]) {
+            ++stale;
+        }
+    });
+    for (int step = 0; step < kSteps; ++step) {
+        world->advanceTimeStep();
+    }
+    HAKO_TEST_EXPECT(stale == 0, "kinematics in the callback should match qpos of the step being taken");
+    // After a plain step the kinematics lag the integrated qpos.
+    HAKO_TEST_EXPECT(data->xpos[3 * body] != data->qpos[slide.qpos_adr], "xpos should lag qpos after mj_step2");
+}
+
+// A PD loop in the callback matches writing ctrl between hand-written
+// mj_step1/mj_step2 calls, with the controller's ctrl held between runs.
+void TestControlInsideTheStep(int divisor)
+{
+    auto world = LoadWorld();
+    const mjModel* model = world->getModel();
+    mjData* data = world->getData();
+    auto reference = LoadWorld();
+    mjData* ref = reference->getData();
+    const int q = world->getJointHandle("slide").qpos_adr;
+    const int v = world->getJointHandle("slide").dof_adr;
+    const int u = world->getActuatorHandle("push").ctrl_adr;
+
+    auto pd = [&](const mjData* d) { return kKp * (kTarget - d->qpos[q]) - kKd * d->qvel[v]; };
+    int runs = 0;
+    world->addControlCallback(
+        [&](const mjModel*, mjData* d) {
+            d->ctrl[u] = pd(d);
+            ++runs;
+        },
+        divisor);
+
+    for (int step = 0; step < kSteps; ++step) {
+        world->advanceTimeStep();
+        mj_step1(reference->getModel(), ref);
+        if (step % divisor == 0) {
+            ref->ctrl[u] = pd(ref);
+        }
+        mj_step2(reference->getModel(), ref);
+    }
+    HAKO_TEST_EXPECT(runs == (kSteps + divisor - 1) / divisor, "the controller should run once per period");
+    HAKO_TEST_EXPECT(data->qpos[q] == ref->qpos[q] && data->qvel[v] == ref->qvel[v] && data->ctrl[u] == ref->ctrl[u],
+                     "split stepping should match mj_step1/ctrl/mj_step2 for divisor " + std::to_string(divisor));
+    HAKO_TEST_EXPECT(data->qpos[q] > 0.0 && data->qpos[q] < kTarget, "the slider should move toward the target");
+
+    // Without callbacks the world steps exactly like mj_step.
+    auto plain = LoadWorld();
+    mjData* direct = mj_makeData(model);
+    mj_forward(model, direct);
+    for (int step = 0; step < kSteps; ++step) {
+        plain->getData()->ctrl[u] = 0.5;
+        direct->ctrl[u] = 0.5;
+        plain->advanceTimeStep();
+        mj_step(model, direct);
+    }
+    HAKO_TEST_EXPECT(plain->getData()->qpos[q] == direct->qpos[q], "no callbacks should mean plain mj_step");
+    mj_deleteData(direct);
+}
+
+void TestRk4KeepsTheRate()
+{
+    auto world = LoadWorld("RK4");
+    int runs = 0;
+    world->addControlCallback([&](const mjModel*, mjData*) { ++runs; }, 4);
+    for (int step = 0; step < kSteps; ++step) {
+        world->advanceTimeStep();
+    }
+    HAKO_TEST_EXPECT(runs == kSteps / 4, "RK4 worlds should keep the callback rate");
+}
+
+void TestBatchedWorld()
+{
+    constexpr std::size_t kEnvCount = 4;
+    constexpr int kDivisor = 5;
+    auto batch = std::make_shared<BatchedWorld>(kEnvCount, 2);
+    batch->loadModel(WriteSliderXml("Euler").string());
+    const int u = batch->getActuatorHandle("push").ctrl_adr;
+    std::atomic<int> runs {0};
+    batch->addControlCallback(
+        [&](const mjModel*, mjData* d) {
+            d->ctrl[u] = 1.0;
+            runs.fetch_add(1, std::memory_order_relaxed);
+        },
+        kDivisor);
+    batch->advanceTimeSteps(12);
+    batch->advanceTimeSteps(8);
+    HAKO_TEST_EXPECT(runs.load() == static_cast<int>(kEnvCount) * 20 / kDivisor,
+                     "batched environments should share the rate schedule across calls");
+    for (std::size_t env = 1; env < kEnvCount; ++env) {
+        HAKO_TEST_EXPECT(batch->getEnvData(env)->qpos[0] == batch->getEnvData(0)->qpos[0],
+                         "every environment should see the same control");
+    }
+    HAKO_TEST_EXPECT(batch->getEnvData(0)->qpos[0] > 0.0, "the callback ctrl should move the slider");
+}
+}
+
+int main()
+{
+    try {
+        TestRateDivisors();
+        TestCallbacksSeeTheSteppedState();
+        TestControlInsideTheStep(1);
+        TestControlInsideTheStep(10);
+        TestRk4KeepsTheRate();
+        TestBatchedWorld();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "split_step_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
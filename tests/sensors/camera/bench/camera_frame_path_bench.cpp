@@ -0,0 +1,144 @@
+#include "hakoniwa/pdu/converter/sensor_msgs/image.hpp"
+#include "sensors/camera/camera_encoding_utils.hpp"
+#include "sensors/camera/camera_sensor.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+// CPU cost and bytes copied per camera frame between mjr_readPixels and a
+// filled HakoCpp_Image, before and after the single-pass frame path.
+//
+// "legacy" reproduces the old chain: readback into RawCameraFrame::rgb, a
+// row flip into a freshly allocated buffer, EncodeImage() copying into
+// ImageFrame::data and ToHakoPdu() copying again into the PDU. "pooled" is
+// the current path: readback into the renderer's kept buffer, one flip and
+// convert pass into a reused ImageFrame, and SwapIntoHakoPdu() lending that
+// buffer to the PDU. The readback itself is simulated with a memcpy from a
+// fake GL buffer, and the endpoint serialization is not included.
+
+namespace
+{
+using hako::robots::sensor::camera::CameraConfig;
+using hako::robots::sensor::camera::EncodeImageRows;
+using hako::robots::sensor::camera::ImageFrame;
+using Clock = std::chrono::steady_clock;
+
+constexpr int kIterations = 60;
+
+struct BenchCase
+{
+    const char* label;
+    int width;
+    int height;
+    const char* format;
+};
+
+volatile std::uint32_t g_sink = 0;
+
+template <typename Fn>
+double MeasureUsPerIteration(Fn&& fn)
+{
+    fn();
+    const auto start = Clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return elapsed / static_cast<double>(kIterations);
+}
+
+void RunCase(const BenchCase& bench)
+{
+    CameraConfig config {};
+    config.image.width = bench.width;
+    config.image.height = bench.height;
+    config.image.format = bench.format;
+
+    const std::size_t rgb_bytes =
+        static_cast<std::size_t>(bench.width) * static_cast<std::size_t>(bench.height) * 3;
+    std::vector<std::uint8_t> gl_buffer(rgb_bytes);
+    for (std::size_t i = 0; i < gl_buffer.size(); ++i) {
+        gl_buffer[i] = static_cast<std::uint8_t>(i * 31U);
+    }
+
+    std::size_t legacy_bytes = 0;
+    const double legacy_us = MeasureUsPerIteration([&]() {
+        legacy_bytes = 0;
+        std::vector<std::uint8_t> readback(rgb_bytes);
+        std::memcpy(readback.data(), gl_buffer.data(), rgb_bytes);
+        legacy_bytes += rgb_bytes;
+
+        std::vector<std::uint8_t> flipped(rgb_bytes);
+        const std::size_t row_size = static_cast<std::size_t>(bench.width) * 3;
+        for (int y = 0; y < bench.height; ++y) {
+            std::memcpy(
+                flipped.data() + static_cast<std::size_t>(y) * row_size,
+                readback.data() + static_cast<std::size_t>(bench.height - 1 - y) * row_size,
+                row_size);
+        }
+        legacy_bytes += rgb_bytes;
+
+        ImageFrame frame {};
+        EncodeImageRows(flipped.data(), bench.width, bench.height, false, 0.0, config, frame);
+        legacy_bytes += frame.data.size();
+
+        HakoCpp_Image pdu {};
+        hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(frame, pdu);
+        legacy_bytes += pdu.data.size();
+        g_sink = g_sink + pdu.data[pdu.data.size() / 2];
+    });
+
+    std::vector<std::uint8_t> readback;
+    ImageFrame frame {};
+    HakoCpp_Image pdu {};
+    std::size_t pooled_bytes = 0;
+    const double pooled_us = MeasureUsPerIteration([&]() {
+        pooled_bytes = 0;
+        readback.resize(rgb_bytes);
+        std::memcpy(readback.data(), gl_buffer.data(), rgb_bytes);
+        pooled_bytes += rgb_bytes;
+
+        EncodeImageRows(readback.data(), bench.width, bench.height, true, 0.0, config, frame);
+        pooled_bytes += frame.data.size();
+
+        hako::robots::pdu::converter::sensor_msgs::SwapIntoHakoPdu(frame, pdu);
+        g_sink = g_sink + pdu.data[pdu.data.size() / 2];
+        pdu.data.swap(frame.data);
+    });
+
+    std::printf(
+        "%-6s %-7s legacy=%8.1f us %6.2f MB/frame  pooled=%8.1f us %6.2f MB/frame  (x%.1f)\n",
+        bench.label,
+        bench.format,
+        legacy_us,
+        static_cast<double>(legacy_bytes) / 1.0e6,
+        pooled_us,
+        static_cast<double>(pooled_bytes) / 1.0e6,
+        legacy_us / pooled_us);
+}
+}
+
+int main()
+{
+    try {
+        const BenchCase cases[] = {
+            {"480p", 640, 480, "R8G8B8"},
+            {"720p", 1280, 720, "R8G8B8"},
+            {"720p", 1280, 720, "B8G8R8"},
+            {"720p", 1280, 720, "L8"},
+        };
+        for (const auto& bench : cases) {
+            RunCase(bench);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
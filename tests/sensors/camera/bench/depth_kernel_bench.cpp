@@ -0,0 +1,138 @@
+#include "sensors/camera/depth_kernels.hpp"
+#include "sensors/common/simd.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+// CPU cost of turning a 640x480 OpenGL depth buffer into metres and into
+// DEPTH_U16_MM millimetres.
+//
+// "legacy" reproduces the old EncodeDepth chain: copy the depth buffer,
+// linearize in double, a second pass writing NaN outside the clip range and,
+// for millimetres, a third std::round loop in the converter. "scalar" is the
+// fused kernel with SIMD disabled and "simd" the dispatched kernel on this
+// CPU (set HAKO_SENSOR_SIMD=scalar to compare both on the same build).
+
+namespace
+{
+using hako::robots::sensor::camera::DepthKernelParams;
+using Clock = std::chrono::steady_clock;
+namespace camera = hako::robots::sensor::camera;
+
+constexpr int kWidth = 640;
+constexpr int kHeight = 480;
+constexpr int kIterations = 200;
+
+volatile float g_sink = 0.0F;
+
+template <typename Fn>
+double MeasureUsPerIteration(Fn&& fn)
+{
+    fn();
+    const auto start = Clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return elapsed / static_cast<double>(kIterations);
+}
+
+void LegacyMeters(const std::vector<float>& gl_depth, const DepthKernelParams& params, std::vector<float>& out)
+{
+    std::vector<float> buffer = gl_depth;
+    const double znear = params.znear;
+    const double zfar = params.zfar;
+    for (float& sample : buffer) {
+        const double z_ndc = 2.0 * static_cast<double>(sample) - 1.0;
+        sample = static_cast<float>((2.0 * znear * zfar) / (zfar + znear - z_ndc * (zfar - znear)));
+    }
+    out = buffer;
+    for (float& depth : out) {
+        if (depth < params.clip_near || depth > params.clip_far) {
+            depth = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+}
+
+void LegacyMillimeters(const std::vector<float>& meters, std::vector<std::uint16_t>& out)
+{
+    out.resize(meters.size());
+    for (std::size_t i = 0; i < meters.size(); ++i) {
+        const float depth_m = meters[i];
+        if (!std::isfinite(depth_m) || depth_m <= 0.0F) {
+            out[i] = 0;
+            continue;
+        }
+        const double mm = std::round(static_cast<double>(depth_m) * 1000.0);
+        out[i] = (mm <= 0.0 || mm > 65535.0) ? 0 : static_cast<std::uint16_t>(mm);
+    }
+}
+}
+
+int main()
+{
+    try {
+        const std::size_t count = static_cast<std::size_t>(kWidth) * static_cast<std::size_t>(kHeight);
+        std::vector<float> gl_depth(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            // Mostly mid-range samples with some beyond the clip planes.
+            gl_depth[i] = 0.90F + 0.1F * static_cast<float>((i * 7919U) % 1000U) / 1000.0F;
+        }
+        DepthKernelParams params;
+        params.znear = 0.05F;
+        params.zfar = 50.0F;
+        params.clip_near = 0.1F;
+        params.clip_far = 10.0F;
+
+        std::vector<float> meters;
+        std::vector<std::uint16_t> millimeters;
+        const double legacy_m_us = MeasureUsPerIteration([&]() {
+            LegacyMeters(gl_depth, params, meters);
+            g_sink = g_sink + meters[count / 2];
+        });
+        const double legacy_mm_us = MeasureUsPerIteration([&]() {
+            LegacyMeters(gl_depth, params, meters);
+            LegacyMillimeters(meters, millimeters);
+            g_sink = g_sink + static_cast<float>(millimeters[count / 2]);
+        });
+
+        meters.assign(count, 0.0F);
+        millimeters.assign(count, 0);
+        const double scalar_m_us = MeasureUsPerIteration([&]() {
+            camera::detail::LinearizeDepthMetersScalar(gl_depth.data(), count, params, meters.data());
+            g_sink = g_sink + meters[count / 2];
+        });
+        const double scalar_mm_us = MeasureUsPerIteration([&]() {
+            camera::detail::LinearizeDepthMillimetersScalar(gl_depth.data(), count, params, millimeters.data());
+            g_sink = g_sink + static_cast<float>(millimeters[count / 2]);
+        });
+        const double simd_m_us = MeasureUsPerIteration([&]() {
+            camera::LinearizeDepthMeters(gl_depth.data(), count, params, meters.data());
+            g_sink = g_sink + meters[count / 2];
+        });
+        const double simd_mm_us = MeasureUsPerIteration([&]() {
+            camera::LinearizeDepthMillimeters(gl_depth.data(), count, params, millimeters.data());
+            g_sink = g_sink + static_cast<float>(millimeters[count / 2]);
+        });
+
+        std::printf("depth %dx%d, kernels: %s\n", kWidth, kHeight, hako::robots::sensor::common::SimdIsaName());
+        std::printf(
+            "metres  legacy=%8.1f us  scalar=%8.1f us  simd=%8.1f us  (x%.1f)\n",
+            legacy_m_us, scalar_m_us, simd_m_us, legacy_m_us / simd_m_us);
+        std::printf(
+            "u16 mm  legacy=%8.1f us  scalar=%8.1f us  simd=%8.1f us  (x%.1f)\n",
+            legacy_mm_us, scalar_mm_us, simd_mm_us, legacy_mm_us / simd_mm_us);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
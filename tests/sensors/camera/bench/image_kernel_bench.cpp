@@ -0,0 +1,164 @@
+#include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/image_kernels.hpp"
+#include "sensors/common/simd.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+// CPU cost of the camera pixel conversions at 720p and 1080p.
+//
+// "legacy" reproduces the loops EncodeImageRows() and
+// TryExtractAverageRGBAColor() used before the image kernels: a byte swizzle
+// for B8G8R8, double precision luma for L8 and a per-pixel, per-format
+// branch for the region average. "scalar" is the portable kernel and "simd"
+// the dispatched one on this CPU (HAKO_SENSOR_SIMD=scalar disables it).
+// R8G8B8A8 and YUV422 have no legacy path.
+
+namespace
+{
+using hako::robots::sensor::camera::ImageFrame;
+using hako::robots::sensor::camera::PixelFormat;
+using hako::robots::sensor::camera::PixelFormatBytesPerPixel;
+using Clock = std::chrono::steady_clock;
+namespace camera = hako::robots::sensor::camera;
+
+constexpr int kIterations = 40;
+
+volatile std::uint32_t g_sink = 0;
+
+template <typename Fn>
+double MeasureUsPerIteration(Fn&& fn)
+{
+    fn();
+    const auto start = Clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return elapsed / static_cast<double>(kIterations);
+}
+
+void LegacyConvert(const std::uint8_t* rgb, int width, int height, PixelFormat format, std::uint8_t* dst)
+{
+    for (int y = 0; y < height; ++y) {
+        const std::uint8_t* src = rgb + static_cast<std::size_t>(y) * width * 3;
+        if (format == PixelFormat::Bgr8) {
+            std::uint8_t* out = dst + static_cast<std::size_t>(y) * width * 3;
+            for (int x = 0; x < width; ++x, src += 3, out += 3) {
+                out[0] = src[2];
+                out[1] = src[1];
+                out[2] = src[0];
+            }
+        } else {
+            std::uint8_t* out = dst + static_cast<std::size_t>(y) * width;
+            for (int x = 0; x < width; ++x, src += 3) {
+                out[x] = static_cast<std::uint8_t>(0.299 * src[0] + 0.587 * src[1] + 0.114 * src[2]);
+            }
+        }
+    }
+}
+
+double LegacyAverage(const ImageFrame& frame)
+{
+    double r = 0.0;
+    double g = 0.0;
+    double b = 0.0;
+    for (int py = 0; py < frame.height; ++py) {
+        for (int px = 0; px < frame.width; ++px) {
+            const std::size_t idx = (static_cast<std::size_t>(py) * frame.width + px) * 3;
+            if (frame.format == "R8G8B8") {
+                r += frame.data[idx + 0];
+                g += frame.data[idx + 1];
+                b += frame.data[idx + 2];
+            } else if (frame.format == "B8G8R8") {
+                r += frame.data[idx + 2];
+                g += frame.data[idx + 1];
+                b += frame.data[idx + 0];
+            }
+        }
+    }
+    return r + g + b;
+}
+
+void RunSize(const char* label, int width, int height)
+{
+    const std::size_t pixels = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    std::vector<std::uint8_t> rgb(pixels * 3);
+    for (std::size_t i = 0; i < rgb.size(); ++i) {
+        rgb[i] = static_cast<std::uint8_t>(i * 31U);
+    }
+    std::vector<std::uint8_t> dst(pixels * 4);
+
+    const struct
+    {
+        const char* name;
+        PixelFormat format;
+        bool has_legacy;
+    } formats[] = {
+        {"B8G8R8", PixelFormat::Bgr8, true},
+        {"L8", PixelFormat::Mono8, true},
+        {"R8G8B8A8", PixelFormat::Rgba8, false},
+        {"YUV422", PixelFormat::Yuv422, false},
+    };
+    for (const auto& f : formats) {
+        const std::size_t dst_row = static_cast<std::size_t>(width) * PixelFormatBytesPerPixel(f.format);
+        const auto convert = [&](auto row_kernel) {
+            return MeasureUsPerIteration([&]() {
+                for (int y = 0; y < height; ++y) {
+                    row_kernel(rgb.data() + static_cast<std::size_t>(y) * width * 3, width, f.format,
+                               dst.data() + static_cast<std::size_t>(y) * dst_row);
+                }
+                g_sink = g_sink + dst[dst_row];
+            });
+        };
+        const double legacy_us = f.has_legacy ? MeasureUsPerIteration([&]() {
+            LegacyConvert(rgb.data(), width, height, f.format, dst.data());
+            g_sink = g_sink + dst[dst_row];
+        })
+                                              : 0.0;
+        const double scalar_us = convert(camera::detail::ConvertRgbRowScalar);
+        const double simd_us = convert(camera::ConvertRgbRow);
+        if (f.has_legacy) {
+            std::printf("%-6s %-9s legacy=%8.1f us  scalar=%8.1f us  simd=%8.1f us  (x%.1f)\n",
+                        label, f.name, legacy_us, scalar_us, simd_us, legacy_us / simd_us);
+        } else {
+            std::printf("%-6s %-9s %20s  scalar=%8.1f us  simd=%8.1f us\n", label, f.name, "", scalar_us, simd_us);
+        }
+    }
+
+    ImageFrame frame {};
+    frame.width = width;
+    frame.height = height;
+    frame.channels = 3;
+    frame.format = "B8G8R8";
+    frame.data = rgb;
+    const double legacy_us = MeasureUsPerIteration([&]() {
+        g_sink = g_sink + static_cast<std::uint32_t>(LegacyAverage(frame));
+    });
+    const double kernel_us = MeasureUsPerIteration([&]() {
+        camera::RGBAColor color;
+        camera::TryExtractAverageRGBAColor(frame, color, 0, 0, width, height);
+        g_sink = g_sink + static_cast<std::uint32_t>(color.r * 255.0F);
+    });
+    std::printf("%-6s %-9s legacy=%8.1f us  %22s  simd=%8.1f us  (x%.1f)\n",
+                label, "average", legacy_us, "", kernel_us, legacy_us / kernel_us);
+}
+}
+
+int main()
+{
+    try {
+        std::printf("image kernels: %s\n", hako::robots::sensor::common::SimdIsaName());
+        RunSize("720p", 1280, 720);
+        RunSize("1080p", 1920, 1080);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -158,7 +158,7 @@ bool CaptureDepthFrame(
 
     std::cout << "[depth_render_smoke_test] capturing frame" << std::endl;
     if (!renderer->Render(
-            kCameraName,
+            renderer->FindCamera(kCameraName),
             config.image.width,
             config.image.height,
             config.horizontal_fov,
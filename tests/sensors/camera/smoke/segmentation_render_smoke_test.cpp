@@ -0,0 +1,188 @@
+#include "physics/physics_impl.hpp"
+#include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/camera_tile_pass.hpp"
+#include "sensors/camera/mujoco_camera_renderer.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#if defined(__APPLE__)
+#include <ApplicationServices/ApplicationServices.h>
+#endif
+
+namespace
+{
+constexpr const char* kCameraName = "front_cam";
+constexpr int kImageWidth = 64;
+constexpr int kImageHeight = 48;
+constexpr double kHorizontalFovRad = 1.0;
+
+// Two boxes of the same colour, one on each side of the camera axis, so
+// only the labels can tell them apart. The right body carries two geoms.
+std::filesystem::path WriteSceneXml()
+{
+    const std::filesystem::path xml_path =
+        std::filesystem::temp_directory_path() / "hakoniwa_segmentation_render_smoke.xml";
+    std::ofstream xml(xml_path);
+    xml << "<mujoco model=\"segmentation_render_smoke\">\n";
+    xml << "  <visual><global offwidth=\"256\" offheight=\"256\"/></visual>\n";
+    xml << "  <worldbody>\n";
+    xml << "    <light name=\"top\" pos=\"0 0 3\" dir=\"0 0 -1\"/>\n";
+    xml << "    <body name=\"left\" pos=\"1 0.25 0\">\n";
+    xml << "      <geom name=\"left_box\" type=\"box\" size=\"0.05 0.1 0.1\" rgba=\"0.5 0.5 0.5 1\"/>\n";
+    xml << "    </body>\n";
+    xml << "    <body name=\"right\" pos=\"1 -0.25 0\">\n";
+    xml << "      <geom name=\"right_box\" type=\"box\" size=\"0.05 0.1 0.1\" rgba=\"0.5 0.5 0.5 1\"/>\n";
+    xml << "      <geom name=\"right_cap\" type=\"box\" pos=\"0 0 0.2\" size=\"0.05 0.1 0.1\" rgba=\"0.5 0.5 0.5 1\"/>\n";
+    xml << "    </body>\n";
+    xml << "    <camera name=\"" << kCameraName << "\" pos=\"0 0 0\" xyaxes=\"0 -1 0 0 0 1\"/>\n";
+    xml << "  </worldbody>\n";
+    xml << "</mujoco>\n";
+    return xml_path;
+}
+
+bool HasRenderableGuiSession()
+{
+#if defined(__APPLE__)
+    CFDictionaryRef session = CGSessionCopyCurrentDictionary();
+    if (session == nullptr) {
+        return false;
+    }
+    CFRelease(session);
+#endif
+    return true;
+}
+
+bool Check(bool condition, const std::string& message)
+{
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+    }
+    return condition;
+}
+
+// Image column of a point at lateral offset y_m, depth_m in front of the camera.
+int ColumnOf(double y_m, double depth_m)
+{
+    const double focal = 0.5 * kImageWidth / std::tan(0.5 * kHorizontalFovRad);
+    return static_cast<int>(0.5 * kImageWidth - focal * y_m / depth_m);
+}
+
+std::int32_t LabelAt(const hako::robots::sensor::camera::SegmentationFrame& frame, int x, int y)
+{
+    return frame.data[static_cast<std::size_t>(y) * static_cast<std::size_t>(frame.width) + static_cast<std::size_t>(x)];
+}
+
+bool RunSharedPass()
+{
+    using namespace hako::robots::sensor::camera;
+
+    auto world = std::make_shared<hako::robots::physics::impl::WorldImpl>();
+    world->loadModel(WriteSceneXml().string());
+    auto renderer = std::make_shared<MujocoCameraRenderer>(world);
+    const mjModel* model = world->getModel();
+
+    CameraConfig rgb_config {};
+    rgb_config.horizontal_fov = kHorizontalFovRad;
+    rgb_config.image = ImageConfig {kImageWidth, kImageHeight, "R8G8B8"};
+    DepthCameraConfig depth_config {};
+    depth_config.horizontal_fov = kHorizontalFovRad;
+    depth_config.image = ImageConfig {kImageWidth, kImageHeight, "DEPTH_F32_M"};
+    SegmentationCameraConfig geom_config {};
+    geom_config.horizontal_fov = kHorizontalFovRad;
+    geom_config.image = ImageConfig {kImageWidth, kImageHeight, "LABEL_S32"};
+    SegmentationCameraConfig body_config = geom_config;
+    body_config.label = "body";
+
+    CameraSensor rgb_camera(renderer, kCameraName);
+    DepthCameraSensor depth_camera(renderer, kCameraName);
+    SegmentationCameraSensor geom_camera(renderer, kCameraName);
+    SegmentationCameraSensor body_camera(renderer, kCameraName);
+    if (!rgb_camera.LoadConfig(rgb_config) || !depth_camera.LoadConfig(depth_config) ||
+        !geom_camera.LoadConfig(geom_config) || !body_camera.LoadConfig(body_config))
+    {
+        throw std::runtime_error("invalid camera config");
+    }
+
+    // RGB, depth and both label images from one scene update.
+    CameraTilePass pass(renderer);
+    const int rgb = pass.Add(rgb_camera);
+    const int depth = pass.Add(depth_camera);
+    const int geom = pass.Add(geom_camera);
+    const int body = pass.Add(body_camera);
+    if (!pass.Render()) {
+        throw std::runtime_error("CameraTilePass::Render failed");
+    }
+    ImageFrame rgb_frame {};
+    DepthFrame depth_frame {};
+    SegmentationFrame geom_frame {};
+    SegmentationFrame body_frame {};
+    rgb_camera.FinishTiles(pass.Views(rgb), rgb_frame);
+    depth_camera.FinishTiles(pass.Views(depth), depth_frame);
+    geom_camera.FinishTiles(pass.Views(geom), geom_frame);
+    body_camera.FinishTiles(pass.Views(body), body_frame);
+
+    const int left_box = mj_name2id(model, mjOBJ_GEOM, "left_box");
+    const int right_box = mj_name2id(model, mjOBJ_GEOM, "right_box");
+    const int right_cap = mj_name2id(model, mjOBJ_GEOM, "right_cap");
+    const int left_body = mj_name2id(model, mjOBJ_BODY, "left");
+    const int right_body = mj_name2id(model, mjOBJ_BODY, "right");
+    const int left_x = ColumnOf(0.25, 0.95);
+    const int right_x = ColumnOf(-0.25, 0.95);
+    const int center_y = kImageHeight / 2;
+
+    bool passed = true;
+    passed = Check(!rgb_frame.data.empty() && !depth_frame.data.empty(), "rgb and depth should render") && passed;
+    passed = Check(geom_frame.width == kImageWidth && geom_frame.height == kImageHeight &&
+                   geom_frame.data.size() == static_cast<std::size_t>(kImageWidth * kImageHeight),
+                   "unexpected label image size") && passed;
+    passed = Check(geom_frame.timestamp == depth_frame.timestamp, "labels and depth should share a timestamp") && passed;
+    passed = Check(LabelAt(geom_frame, left_x, center_y) == left_box, "left box geom id expected") && passed;
+    passed = Check(LabelAt(geom_frame, right_x, center_y) == right_box, "right box geom id expected") && passed;
+    passed = Check(LabelAt(geom_frame, 0, 0) == -1, "background should be -1") && passed;
+    passed = Check(LabelAt(body_frame, left_x, center_y) == left_body, "left body id expected") && passed;
+    passed = Check(LabelAt(body_frame, right_x, center_y) == right_body, "right body id expected") && passed;
+    passed = Check(std::isfinite(depth_frame.data[static_cast<std::size_t>(center_y) * kImageWidth + left_x]),
+                   "depth should hit the left box") && passed;
+
+    // No blending: every pixel, edges included, is one of the scene's ids.
+    const std::set<std::int32_t> allowed_geoms {-1, left_box, right_box, right_cap};
+    const std::set<std::int32_t> seen_geoms(geom_frame.data.begin(), geom_frame.data.end());
+    for (const std::int32_t label : seen_geoms) {
+        passed = Check(allowed_geoms.count(label) == 1, "unexpected geom label " + std::to_string(label)) && passed;
+    }
+    const std::set<std::int32_t> seen_bodies(body_frame.data.begin(), body_frame.data.end());
+    passed = Check(seen_bodies == std::set<std::int32_t>({-1, left_body, right_body}),
+                   "body labels should be exactly background and the two bodies") && passed;
+
+    // Capture() alone renders the same labels.
+    SegmentationFrame single {};
+    geom_camera.Capture(single);
+    passed = Check(single.data == geom_frame.data, "Capture() should match the shared pass") && passed;
+    return passed;
+}
+}
+
+int main()
+{
+    if (!HasRenderableGuiSession()) {
+        std::cout << "SKIPPED: OpenGL context unavailable (no active macOS GUI session)" << std::endl;
+        return 0;
+    }
+
+    try {
+        const bool passed = RunSharedPass();
+        std::cout << "segmentation_render_smoke_test " << (passed ? "passed" : "failed") << std::endl;
+        return passed ? 0 : 1;
+    } catch (const std::exception& ex) {
+        std::cerr << "SKIPPED: OpenGL context unavailable: " << ex.what() << std::endl;
+        return 0;
+    }
+}
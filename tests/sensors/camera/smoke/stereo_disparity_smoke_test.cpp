@@ -0,0 +1,155 @@
+#include "physics/physics_impl.hpp"
+#include "sensors/camera/camera_sensor.hpp"
+#include "sensors/camera/mujoco_camera_renderer.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#if defined(__APPLE__)
+#include <ApplicationServices/ApplicationServices.h>
+#endif
+
+namespace
+{
+constexpr int kImageWidth = 64;
+constexpr int kImageHeight = 48;
+constexpr double kHorizontalFovRad = 1.0;
+constexpr double kBaseline = 0.12;
+constexpr double kBoxFaceDepth = 0.95;
+
+// A red box straight ahead of a parallel stereo pair 0.12 m apart.
+std::filesystem::path WriteSceneXml()
+{
+    const std::filesystem::path xml_path =
+        std::filesystem::temp_directory_path() / "hakoniwa_stereo_disparity_smoke.xml";
+    std::ofstream xml(xml_path);
+    xml << "<mujoco model=\"stereo_disparity_smoke\">\n";
+    xml << "  <visual><global offwidth=\"256\" offheight=\"256\"/></visual>\n";
+    xml << "  <worldbody>\n";
+    xml << "    <light name=\"top\" pos=\"0 0 3\" dir=\"0 0 -1\"/>\n";
+    xml << "    <geom name=\"box\" type=\"box\" pos=\"1 0 0\" size=\"0.05 0.1 0.2\" rgba=\"0.9 0.1 0.1 1\"/>\n";
+    xml << "    <camera name=\"left_camera\" pos=\"0 " << kBaseline / 2.0 << " 0\" xyaxes=\"0 -1 0 0 0 1\"/>\n";
+    xml << "    <camera name=\"right_camera\" pos=\"0 " << -kBaseline / 2.0 << " 0\" xyaxes=\"0 -1 0 0 0 1\"/>\n";
+    xml << "  </worldbody>\n";
+    xml << "</mujoco>\n";
+    return xml_path;
+}
+
+bool HasRenderableGuiSession()
+{
+#if defined(__APPLE__)
+    CFDictionaryRef session = CGSessionCopyCurrentDictionary();
+    if (session == nullptr) {
+        return false;
+    }
+    CFRelease(session);
+#endif
+    return true;
+}
+
+bool Check(bool condition, const std::string& message)
+{
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+    }
+    return condition;
+}
+
+// First column of the centre row where the red box is visible, or -1.
+int FirstBoxColumn(const hako::robots::sensor::camera::ImageFrame& frame)
+{
+    const std::size_t row = static_cast<std::size_t>(frame.height / 2) * static_cast<std::size_t>(frame.width) * 3U;
+    for (int x = 0; x < frame.width; ++x) {
+        const std::uint8_t* px = frame.data.data() + row + static_cast<std::size_t>(x) * 3U;
+        if (px[0] > px[1] + 60) {
+            return x;
+        }
+    }
+    return -1;
+}
+
+bool RunStereoDisparity()
+{
+    using namespace hako::robots::sensor::camera;
+
+    auto world = std::make_shared<hako::robots::physics::impl::WorldImpl>();
+    world->loadModel(WriteSceneXml().string());
+    auto renderer = std::make_shared<MujocoCameraRenderer>(world);
+
+    StereoCameraConfig config {};
+    config.left.frame_id = "left_camera_frame";
+    config.left.horizontal_fov = kHorizontalFovRad;
+    config.left.image = ImageConfig {kImageWidth, kImageHeight, "R8G8B8"};
+    config.right = config.left;
+    config.right.frame_id = "right_camera_frame";
+    config.baseline = kBaseline;
+    config.disparity = true;
+
+    StereoCameraSensor stereo(renderer, "left_camera", "right_camera");
+    if (!stereo.LoadConfig(config)) {
+        throw std::runtime_error("invalid stereo config");
+    }
+
+    ImageFrame left {};
+    ImageFrame right {};
+    DisparityFrame disparity {};
+    stereo.Capture(left, right, disparity);
+
+    const double focal = 0.5 * kImageWidth / std::tan(0.5 * kHorizontalFovRad);
+    const double expected = focal * kBaseline / kBoxFaceDepth;
+    const int center = (kImageHeight / 2) * kImageWidth + kImageWidth / 2;
+
+    bool passed = true;
+    passed = Check(!left.data.empty() && !right.data.empty(), "both eyes should render") && passed;
+    passed = Check(disparity.width == kImageWidth && disparity.height == kImageHeight &&
+                   disparity.data.size() == static_cast<std::size_t>(kImageWidth * kImageHeight),
+                   "unexpected disparity size") && passed;
+    passed = Check(disparity.timestamp == left.timestamp && disparity.frame_id == "left_camera_frame",
+                   "disparity should belong to the left image") && passed;
+    passed = Check(std::abs(disparity.data[center] - expected) < 0.02 * expected,
+                   "centre disparity " + std::to_string(disparity.data[center]) + " should be about " +
+                       std::to_string(expected)) && passed;
+    // Empty background sits on the far plane: NaN or the smallest disparity.
+    passed = Check(std::isnan(disparity.data[0]) || disparity.data[0] <= disparity.min_disparity * 1.01,
+                   "background should have no disparity") && passed;
+
+    // The box edge moves by the disparity between the two images.
+    const int left_edge = FirstBoxColumn(left);
+    const int right_edge = FirstBoxColumn(right);
+    passed = Check(left_edge >= 0 && right_edge >= 0, "the box should be visible in both eyes") && passed;
+    passed = Check(std::abs((left_edge - right_edge) - expected) <= 1.5,
+                   "edge shift " + std::to_string(left_edge - right_edge) + " should match the disparity") && passed;
+
+    // Without disparity enabled the frame is cleared and no depth is read back.
+    config.disparity = false;
+    if (!stereo.LoadConfig(config)) {
+        throw std::runtime_error("invalid stereo config");
+    }
+    stereo.Capture(left, right, disparity);
+    passed = Check(disparity.data.empty() && !left.data.empty(), "disparity should be off") && passed;
+    return passed;
+}
+}
+
+int main()
+{
+    if (!HasRenderableGuiSession()) {
+        std::cout << "SKIPPED: OpenGL context unavailable (no active macOS GUI session)" << std::endl;
+        return 0;
+    }
+
+    try {
+        const bool passed = RunStereoDisparity();
+        std::cout << "stereo_disparity_smoke_test " << (passed ? "passed" : "failed") << std::endl;
+        return passed ? 0 : 1;
+    } catch (const std::exception& ex) {
+        std::cerr << "SKIPPED: OpenGL context unavailable: " << ex.what() << std::endl;
+        return 0;
+    }
+}
@@ -34,6 +34,10 @@ namespace hako::robots::sensor::camera::test
             frame.channels = 3;
         } else if (format == "L8") {
             frame.channels = 1;
+        } else if (format == "R8G8B8A8") {
+            frame.channels = 4;
+        } else if (format == "YUV422") {
+            frame.channels = 2;
         }
         return frame;
     }
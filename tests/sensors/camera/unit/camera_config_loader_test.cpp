@@ -4,6 +4,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 
 namespace
@@ -28,6 +29,7 @@ void TestCameraConfigLoader()
     HAKO_TEST_EXPECT(config.noise.type == "gaussian", "unexpected noise.type");
     HAKO_TEST_EXPECT(NearlyEqual(config.noise.mean, 0.0), "unexpected noise.mean");
     HAKO_TEST_EXPECT(NearlyEqual(config.noise.stddev, 0.007), "unexpected noise.stddev");
+    HAKO_TEST_EXPECT(config.readback.mode == "sync", "readback should default to sync");
 }
 
 void TestCameraProfileConfigLoader()
@@ -70,6 +72,23 @@ void TestDepthCameraConfigLoader()
     HAKO_TEST_EXPECT(NearlyEqual(config.noise.stddev, 0.01), "unexpected depth noise.stddev");
 }
 
+void TestSegmentationCameraConfigLoader()
+{
+    hako::robots::sensor::camera::SegmentationCameraConfig config {};
+    const auto path = (RepoRoot() / "config/sensors/camera/sample_segmentation_camera.json").string();
+    const bool ok = hako::robots::sensor::camera::LoadSegmentationCameraConfigFromJson(path, config);
+    HAKO_TEST_EXPECT(ok, "sample_segmentation_camera.json should load");
+    HAKO_TEST_EXPECT(config.frame_id == "camera_segmentation_frame", "unexpected segmentation frame_id");
+    HAKO_TEST_EXPECT(NearlyEqual(config.update_rate_hz, 30.0), "unexpected segmentation update_rate_hz");
+    HAKO_TEST_EXPECT(NearlyEqual(config.horizontal_fov, 1.047), "unexpected segmentation horizontal_fov");
+    HAKO_TEST_EXPECT(config.image.width == 640, "unexpected segmentation image.width");
+    HAKO_TEST_EXPECT(config.image.height == 480, "unexpected segmentation image.height");
+    HAKO_TEST_EXPECT(config.image.format == "LABEL_U16", "unexpected segmentation image.format");
+    HAKO_TEST_EXPECT(config.label == "body", "unexpected segmentation label");
+    HAKO_TEST_EXPECT(NearlyEqual(config.clip.near, 0.1), "unexpected segmentation clip.near");
+    HAKO_TEST_EXPECT(NearlyEqual(config.clip.far, 10.0), "unexpected segmentation clip.far");
+}
+
 void TestRgbdCameraConfigLoader()
 {
     hako::robots::sensor::camera::RgbdCameraConfig config {};
@@ -99,6 +118,91 @@ void TestStereoCameraConfigLoader()
     HAKO_TEST_EXPECT(NearlyEqual(config.left.horizontal_fov, 1.39626), "unexpected left fov");
     HAKO_TEST_EXPECT(NearlyEqual(config.right.horizontal_fov, 1.39626), "unexpected right fov");
     HAKO_TEST_EXPECT(NearlyEqual(config.baseline, 0.12, 1.0e-9), "unexpected stereo baseline");
+    HAKO_TEST_EXPECT(!config.disparity, "disparity should default to off");
+
+    // The sample with "disparity" set, then with a non-boolean value.
+    std::ifstream sample(path);
+    const std::string text((std::istreambuf_iterator<char>(sample)), std::istreambuf_iterator<char>());
+    const std::string name_field = "\"name\": \"stereo_camera\",";
+    const auto name_pos = text.find(name_field);
+    HAKO_TEST_EXPECT(name_pos != std::string::npos, "sample_multicamera.json should name the stereo camera");
+    const auto disparity_path = std::filesystem::temp_directory_path() / "disparity_multicamera.json";
+    const auto write_with = [&](const std::string& value) {
+        std::string patched = text;
+        patched.insert(name_pos + name_field.size(), " \"disparity\": " + value + ",");
+        std::ofstream ofs(disparity_path);
+        ofs << patched;
+    };
+    write_with("true");
+    hako::robots::sensor::camera::StereoCameraConfig with_disparity {};
+    HAKO_TEST_EXPECT(
+        hako::robots::sensor::camera::LoadStereoCameraConfigFromJson(disparity_path.string(), with_disparity),
+        "stereo config with disparity should load");
+    HAKO_TEST_EXPECT(with_disparity.disparity, "disparity should be enabled");
+    write_with("\"yes\"");
+    HAKO_TEST_EXPECT(
+        !hako::robots::sensor::camera::LoadStereoCameraConfigFromJson(disparity_path.string(), with_disparity),
+        "a non-boolean disparity should be rejected");
+    std::filesystem::remove(disparity_path);
+}
+
+void TestReadbackConfigLoader()
+{
+    const auto path = std::filesystem::temp_directory_path() / "pbo_camera_config.json";
+    std::ofstream ofs(path);
+    ofs << R"({
+  "frame_id": "camera_rgb_frame",
+  "update_rate_hz": 30.0,
+  "horizontal_fov": 1.2,
+  "image": { "width": 320, "height": 240, "format": "R8G8B8" },
+  "clip": { "near": 0.05, "far": 10.0 },
+  "readback": { "mode": "pbo", "buffers": 3 }
+})";
+    ofs.close();
+
+    hako::robots::sensor::camera::CameraConfig config {};
+    const bool ok = hako::robots::sensor::camera::LoadCameraConfigFromJson(path.string(), config);
+    HAKO_TEST_EXPECT(ok, "pbo readback config should load");
+    HAKO_TEST_EXPECT(config.readback.mode == "pbo", "unexpected readback.mode");
+    HAKO_TEST_EXPECT(config.readback.buffers == 3, "unexpected readback.buffers");
+
+    std::filesystem::remove(path);
+}
+
+void TestCompressedImagePduConfigLoader()
+{
+    hako::robots::sensor::camera::CameraProfileConfig config {};
+    const auto path = (RepoRoot() / "config/sensors/camera/sample_compressed_camera.json").string();
+    const bool ok = hako::robots::sensor::camera::LoadCameraProfileConfigFromJson(path, config);
+    HAKO_TEST_EXPECT(ok, "sample_compressed_camera.json should load");
+    HAKO_TEST_EXPECT(
+        hako::robots::sensor::camera::IsCompressedImagePdu(config.pdu_config),
+        "message_type should select CompressedImage");
+    HAKO_TEST_EXPECT(config.pdu_config.compression.codec == "jpeg", "unexpected compression.codec");
+    HAKO_TEST_EXPECT(config.pdu_config.compression.jpeg_quality == 85, "unexpected compression.jpeg_quality");
+
+    const auto invalid_path = std::filesystem::temp_directory_path() / "invalid_codec_camera_config.json";
+    std::ofstream ofs(invalid_path);
+    ofs << R"({
+  "spec": {
+    "frame_id": "camera_rgb_frame",
+    "update_rate_hz": 30.0,
+    "horizontal_fov": 1.2,
+    "image": { "width": 320, "height": 240, "format": "R8G8B8" },
+    "clip": { "near": 0.05, "far": 10.0 }
+  },
+  "pdu_config": {
+    "pdu_name": "camera_image",
+    "message_type": "sensor_msgs/CompressedImage",
+    "compression": { "codec": "webp" }
+  }
+})";
+    ofs.close();
+    hako::robots::sensor::camera::CameraProfileConfig invalid {};
+    HAKO_TEST_EXPECT(
+        !hako::robots::sensor::camera::LoadCameraProfileConfigFromJson(invalid_path.string(), invalid),
+        "unknown compression codec should fail");
+    std::filesystem::remove(invalid_path);
 }
 
 void TestMissingFileFailure()
@@ -129,8 +233,11 @@ int main()
     TestCameraConfigLoader();
     TestCameraProfileConfigLoader();
     TestDepthCameraConfigLoader();
+    TestSegmentationCameraConfigLoader();
     TestRgbdCameraConfigLoader();
     TestStereoCameraConfigLoader();
+    TestReadbackConfigLoader();
+    TestCompressedImagePduConfigLoader();
     TestMissingFileFailure();
     TestInvalidJsonFailure();
 
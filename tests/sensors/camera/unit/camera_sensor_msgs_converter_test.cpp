@@ -7,6 +7,7 @@
 #include <cstring>
 #include <iostream>
 #include <limits>
+#include <string>
 #include <vector>
 
 namespace
@@ -14,7 +15,9 @@ namespace
 using hako::robots::sensor::camera::CameraConfig;
 using hako::robots::sensor::camera::DepthCameraConfig;
 using hako::robots::sensor::camera::DepthFrame;
+using hako::robots::sensor::camera::DisparityFrame;
 using hako::robots::sensor::camera::ImageFrame;
+using hako::robots::sensor::camera::SegmentationFrame;
 using hako::robots::sensor::camera::test::MakeDepthFrame;
 using hako::robots::sensor::camera::test::MakeImageFrame;
 using hako::robots::sensor::camera::test::NearlyEqual;
@@ -130,6 +133,81 @@ void TestDepthU16Conversion()
     HAKO_TEST_EXPECT(roundtrip[3] == 0, "out-of-range depth should become 0");
 }
 
+void TestDisparityConversion()
+{
+    DisparityFrame frame {};
+    frame.width = 3;
+    frame.height = 1;
+    frame.frame_id = "left_camera_frame";
+    frame.timestamp = 2.5;
+    frame.data = {12.5F, std::numeric_limits<float>::quiet_NaN(), 0.25F};
+
+    HakoCpp_Image out {};
+    const bool ok = hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(frame, out);
+    HAKO_TEST_EXPECT(ok, "disparity conversion should succeed");
+    HAKO_TEST_EXPECT(out.encoding == "32FC1", "unexpected disparity encoding");
+    HAKO_TEST_EXPECT(out.step == 3 * sizeof(float), "unexpected disparity step");
+    HAKO_TEST_EXPECT(out.header.frame_id == "left_camera_frame", "unexpected disparity frame_id");
+
+    std::vector<float> roundtrip(frame.data.size(), 0.0F);
+    std::memcpy(roundtrip.data(), out.data.data(), out.data.size());
+    HAKO_TEST_EXPECT(roundtrip[0] == 12.5F && roundtrip[2] == 0.25F, "disparity should be sent unchanged");
+    HAKO_TEST_EXPECT(std::isnan(roundtrip[1]), "invalid disparity should stay NaN");
+
+    frame.format = "DEPTH_F32_M";
+    HAKO_TEST_EXPECT(
+        !hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(frame, out),
+        "unknown disparity format should fail");
+}
+
+SegmentationFrame MakeSegmentationFrame(const std::string& format, const std::vector<std::int32_t>& data)
+{
+    SegmentationFrame frame {};
+    frame.width = static_cast<int>(data.size());
+    frame.height = 1;
+    frame.format = format;
+    frame.frame_id = "camera_segmentation_frame";
+    frame.data = data;
+    return frame;
+}
+
+void TestSegmentationS32Conversion()
+{
+    const SegmentationFrame frame = MakeSegmentationFrame("LABEL_S32", {-1, 0, 7, 70000});
+
+    HakoCpp_Image out {};
+    const bool ok = hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(frame, out);
+    HAKO_TEST_EXPECT(ok, "LABEL_S32 conversion should succeed");
+    HAKO_TEST_EXPECT(out.encoding == "32SC1", "unexpected LABEL_S32 encoding");
+    HAKO_TEST_EXPECT(out.step == 4 * sizeof(std::int32_t), "unexpected LABEL_S32 step");
+    HAKO_TEST_EXPECT(out.header.frame_id == "camera_segmentation_frame", "unexpected LABEL_S32 frame_id");
+
+    std::vector<std::int32_t> roundtrip(frame.data.size(), 0);
+    std::memcpy(roundtrip.data(), out.data.data(), out.data.size());
+    HAKO_TEST_EXPECT(roundtrip == frame.data, "LABEL_S32 ids should be sent unchanged");
+}
+
+void TestSegmentationU16Conversion()
+{
+    const SegmentationFrame frame = MakeSegmentationFrame("LABEL_U16", {-1, 0, 7, 65534});
+
+    HakoCpp_Image out {};
+    const bool ok = hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(frame, out);
+    HAKO_TEST_EXPECT(ok, "LABEL_U16 conversion should succeed");
+    HAKO_TEST_EXPECT(out.encoding == "16UC1", "unexpected LABEL_U16 encoding");
+    HAKO_TEST_EXPECT(out.step == 4 * sizeof(std::uint16_t), "unexpected LABEL_U16 step");
+
+    std::vector<std::uint16_t> roundtrip(frame.data.size(), 0);
+    std::memcpy(roundtrip.data(), out.data.data(), out.data.size());
+    HAKO_TEST_EXPECT(roundtrip[0] == 0xFFFF, "background should become 65535");
+    HAKO_TEST_EXPECT(roundtrip[1] == 0 && roundtrip[2] == 7 && roundtrip[3] == 65534, "unexpected LABEL_U16 ids");
+
+    const SegmentationFrame too_large = MakeSegmentationFrame("LABEL_U16", {0, 65535});
+    HAKO_TEST_EXPECT(
+        !hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(too_large, out),
+        "ids that collide with the LABEL_U16 background should fail");
+}
+
 void TestCameraInfoConversion()
 {
     CameraConfig config {};
@@ -186,6 +264,37 @@ void TestDepthCameraInfoConversion()
     HAKO_TEST_EXPECT(out.height == 240, "unexpected depth CameraInfo height");
 }
 
+void TestSwapIntoPduLendsBuffer()
+{
+    ImageFrame frame = MakeImageFrame(
+        2,
+        1,
+        "R8G8B8",
+        "camera_rgb_frame",
+        12.345678,
+        {1, 2, 3, 4, 5, 6});
+    const std::vector<std::uint8_t> pixels = frame.data;
+    const std::uint8_t* buffer = frame.data.data();
+
+    HakoCpp_Image out {};
+    const bool ok = hako::robots::pdu::converter::sensor_msgs::SwapIntoHakoPdu(frame, out);
+    HAKO_TEST_EXPECT(ok, "swapped RGB conversion should succeed");
+    HAKO_TEST_EXPECT(out.encoding == "rgb8", "unexpected swapped encoding");
+    HAKO_TEST_EXPECT(out.step == 6, "unexpected swapped step");
+    HAKO_TEST_EXPECT_TIME(out.header.stamp, 12, 345678000);
+    HAKO_TEST_EXPECT(out.data == pixels, "unexpected swapped payload");
+    HAKO_TEST_EXPECT(out.data.data() == buffer, "payload should be moved, not copied");
+
+    out.data.swap(frame.data);
+    HAKO_TEST_EXPECT(frame.data.data() == buffer, "swapping back should return the frame buffer");
+
+    ImageFrame bad = MakeImageFrame(1, 1, "R8G8B8", "bad", 0.0, {1, 2});
+    HAKO_TEST_EXPECT(
+        !hako::robots::pdu::converter::sensor_msgs::SwapIntoHakoPdu(bad, out),
+        "invalid RGB image should fail without swapping");
+    HAKO_TEST_EXPECT(bad.data.size() == 2U, "failed swap must leave the frame untouched");
+}
+
 void TestInvalidInputFailures()
 {
     const ImageFrame bad_image = MakeImageFrame(1, 1, "R8G8B8", "bad", 0.0, {1, 2});
@@ -198,6 +307,16 @@ void TestInvalidInputFailures()
     HAKO_TEST_EXPECT(
         !hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(bad_depth, out_image),
         "invalid depth image should fail");
+
+    SegmentationFrame bad_segmentation = MakeSegmentationFrame("LABEL_F32", {0});
+    HAKO_TEST_EXPECT(
+        !hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(bad_segmentation, out_image),
+        "unknown segmentation format should fail");
+    bad_segmentation = MakeSegmentationFrame("LABEL_S32", {0, 1});
+    bad_segmentation.height = 2;
+    HAKO_TEST_EXPECT(
+        !hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(bad_segmentation, out_image),
+        "segmentation size mismatch should fail");
 }
 }
 
@@ -208,8 +327,12 @@ int main()
     TestMonoImageConversion();
     TestDepthF32Conversion();
     TestDepthU16Conversion();
+    TestDisparityConversion();
+    TestSegmentationS32Conversion();
+    TestSegmentationU16Conversion();
     TestCameraInfoConversion();
     TestDepthCameraInfoConversion();
+    TestSwapIntoPduLendsBuffer();
     TestInvalidInputFailures();
 
     std::cout << "camera_sensor_msgs_converter_test passed" << std::endl;
@@ -0,0 +1,129 @@
+#include "sensors/camera/camera_tile_layout.hpp"
+#include "tests/sensors/camera/support/camera_test_utils.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+using hako::robots::sensor::camera::CameraTile;
+using hako::robots::sensor::camera::CopyCameraTileRows;
+using hako::robots::sensor::camera::CountCameraTileAtlases;
+using hako::robots::sensor::camera::DecodeSegmentationTile;
+using hako::robots::sensor::camera::GetCameraTileAtlasExtent;
+using hako::robots::sensor::camera::LayoutCameraTiles;
+
+CameraTile Sized(int width, int height)
+{
+    CameraTile tile;
+    tile.width = width;
+    tile.height = height;
+    return tile;
+}
+
+bool Overlaps(const CameraTile& a, const CameraTile& b)
+{
+    return a.atlas == b.atlas &&
+           a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// A stereo pair and two smaller cameras share one 1280x1024 buffer.
+void TestTilesShareOneAtlas()
+{
+    std::vector<CameraTile> tiles {Sized(640, 480), Sized(640, 480), Sized(320, 240), Sized(320, 240)};
+    HAKO_TEST_EXPECT(LayoutCameraTiles(1280, 1024, tiles), "tiles should fit");
+    HAKO_TEST_EXPECT(CountCameraTileAtlases(tiles) == 1, "four views should need one readback");
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        HAKO_TEST_EXPECT(tiles[i].x + tiles[i].width <= 1280, "tile exceeds atlas width");
+        HAKO_TEST_EXPECT(tiles[i].y + tiles[i].height <= 1024, "tile exceeds atlas height");
+        for (std::size_t j = i + 1; j < tiles.size(); ++j) {
+            HAKO_TEST_EXPECT(!Overlaps(tiles[i], tiles[j]), "tiles must not overlap");
+        }
+    }
+    int width = 0;
+    int height = 0;
+    GetCameraTileAtlasExtent(tiles, 0, width, height);
+    HAKO_TEST_EXPECT(width == 1280 && height == 720, "readback should cover only the used rows");
+}
+
+void TestOverflowStartsNewAtlas()
+{
+    std::vector<CameraTile> tiles {Sized(640, 480), Sized(640, 480), Sized(640, 480)};
+    HAKO_TEST_EXPECT(LayoutCameraTiles(800, 600, tiles), "tiles should be placed");
+    HAKO_TEST_EXPECT(CountCameraTileAtlases(tiles) == 3, "each view needs its own readback");
+    HAKO_TEST_EXPECT(tiles[2].atlas == 2 && tiles[2].x == 0 && tiles[2].y == 0, "new atlas starts at the origin");
+
+    std::vector<CameraTile> too_big {Sized(1024, 64)};
+    HAKO_TEST_EXPECT(!LayoutCameraTiles(800, 600, too_big), "tile wider than the buffer must fail");
+    std::vector<CameraTile> empty {Sized(0, 64)};
+    HAKO_TEST_EXPECT(!LayoutCameraTiles(800, 600, empty), "empty tile must fail");
+}
+
+// 4x3 bottom-up atlas; the 2x2 tile at (1, 1) is copied out top-down.
+void TestCopyTileFlipsRows()
+{
+    const std::vector<std::uint8_t> atlas {
+        0, 1, 2, 3,
+        10, 11, 12, 13,
+        20, 21, 22, 23,
+    };
+    CameraTile tile = Sized(2, 2);
+    tile.x = 1;
+    tile.y = 1;
+    std::vector<std::uint8_t> out(4);
+    CopyCameraTileRows(atlas.data(), 4, 1, tile, out.data());
+    HAKO_TEST_EXPECT((out == std::vector<std::uint8_t> {21, 22, 11, 12}), "unexpected tile rows");
+
+    const std::vector<float> depth_atlas {0.1F, 0.2F, 0.3F, 0.4F};
+    CameraTile depth_tile = Sized(1, 2);
+    depth_tile.x = 1;
+    std::vector<float> depth(2);
+    CopyCameraTileRows(depth_atlas.data(), 2, 1, depth_tile, depth.data());
+    HAKO_TEST_EXPECT(depth[0] == 0.4F && depth[1] == 0.2F, "unexpected depth tile rows");
+}
+
+// 3x2 bottom-up segmentation atlas; the 2x2 tile at (1, 0) is decoded.
+void TestDecodeSegmentationTile()
+{
+    // Pixel colours are segid + 1 as r | g << 8 | b << 16.
+    const std::vector<std::uint8_t> atlas {
+        9, 9, 9,   0, 0, 0,   1, 0, 0,    // bottom row: background, segid 0
+        9, 9, 9,   2, 1, 0,   3, 0, 0,    // top row: segid 257, segid 2
+    };
+    std::vector<int> segid_to_label(258, -1);
+    segid_to_label[0] = 4;
+    segid_to_label[2] = -1; // a decor object such as a site
+    segid_to_label[257] = 11;
+    CameraTile tile = Sized(2, 2);
+    tile.x = 1;
+    std::vector<std::int32_t> labels(4);
+    DecodeSegmentationTile(atlas.data(), 3, tile, segid_to_label, labels.data());
+    HAKO_TEST_EXPECT((labels == std::vector<std::int32_t> {11, -1, -1, 4}), "unexpected segmentation labels");
+
+    // Colours beyond the scene's segids (never drawn) must not index past the table.
+    const std::vector<std::uint8_t> stray {255, 255, 255};
+    std::int32_t label = 0;
+    DecodeSegmentationTile(stray.data(), 1, Sized(1, 1), segid_to_label, &label);
+    HAKO_TEST_EXPECT(label == -1, "unknown segid should decode to -1");
+}
+}
+
+int main()
+{
+    try {
+        TestTilesShareOneAtlas();
+        TestOverflowStartsNewAtlas();
+        TestCopyTileFlipsRows();
+        TestDecodeSegmentationTile();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "camera_tile_layout_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
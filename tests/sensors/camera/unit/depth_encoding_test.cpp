@@ -43,11 +43,50 @@ void RunDepthEncodingTest()
     HAKO_TEST_EXPECT(out_u16_hint.data.size() == static_cast<size_t>(raw.width * raw.height), "unexpected DEPTH_U16_MM sample count");
     HAKO_TEST_EXPECT(out_u16_hint.format == "DEPTH_U16_MM", "unexpected DEPTH_U16_MM format tag");
 }
+
+void RunDisparityEncodingTest()
+{
+    // Same mock samples; the middle one is about 0.2m away.
+    hako::robots::sensor::camera::RawCameraFrame raw;
+    raw.width = 3;
+    raw.height = 1;
+    raw.depth_buffer = {0.0F, 0.5F, 1.0F};
+    raw.znear = 0.1;
+    raw.zfar = 1000.0;
+    raw.timestamp = 1.5;
+
+    hako::robots::sensor::camera::StereoCameraConfig config;
+    config.left.frame_id = "left_camera_frame";
+    config.left.horizontal_fov = 2.0 * std::atan(0.5);
+    config.left.clip.near = 0.19;
+    config.left.clip.far = 500.0;
+    config.baseline = 0.12;
+
+    hako::robots::sensor::camera::DisparityFrame out;
+    const bool success = hako::robots::sensor::camera::EncodeDisparity(raw, config, out);
+    HAKO_TEST_EXPECT(success, "EncodeDisparity should succeed");
+    HAKO_TEST_EXPECT(out.format == "DISPARITY_F32_PX", "unexpected disparity format");
+    HAKO_TEST_EXPECT(out.frame_id == "left_camera_frame", "disparity should use the left frame_id");
+    HAKO_TEST_EXPECT(out.width == 3 && out.height == 1 && out.data.size() == 3, "unexpected disparity size");
+    HAKO_TEST_EXPECT(out.timestamp == raw.timestamp, "unexpected disparity timestamp");
+    // tan(hfov / 2) = 0.5, so the focal length equals the width in pixels.
+    HAKO_TEST_EXPECT(NearlyEqual(out.focal_length_px, 3.0, 1.0e-9), "unexpected focal length");
+    HAKO_TEST_EXPECT(NearlyEqual(out.min_disparity, 3.0 * 0.12 / 500.0, 1.0e-9), "unexpected min_disparity");
+    HAKO_TEST_EXPECT(NearlyEqual(out.max_disparity, 3.0 * 0.12 / 0.19, 1.0e-9), "unexpected max_disparity");
+    HAKO_TEST_EXPECT(std::isnan(out.data[0]) && std::isnan(out.data[2]), "clipped samples should be NaN");
+    HAKO_TEST_EXPECT(NearlyEqual(out.data[1], 3.0F * 0.12F / 0.2F, 0.01F), "middle sample should be f*B/0.2m");
+
+    raw.depth_buffer.pop_back();
+    HAKO_TEST_EXPECT(
+        !hako::robots::sensor::camera::EncodeDisparity(raw, config, out),
+        "a depth buffer that does not match the size should fail");
+}
 }
 
 int main()
 {
     RunDepthEncodingTest();
+    RunDisparityEncodingTest();
     std::cout << "depth_encoding_test passed" << std::endl;
     return 0;
 }
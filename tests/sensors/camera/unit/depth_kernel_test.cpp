@@ -0,0 +1,218 @@
+#include "sensors/camera/camera_encoding_utils.hpp"
+#include "sensors/camera/depth_kernels.hpp"
+#include "sensors/camera/mujoco_camera_renderer.hpp"
+#include "sensors/common/simd.hpp"
+#include "tests/sensors/camera/support/camera_test_utils.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+using hako::robots::sensor::camera::DepthKernelParams;
+using hako::robots::sensor::camera::LinearizeDepthMeters;
+using hako::robots::sensor::camera::LinearizeDepthMillimeters;
+using hako::robots::sensor::camera::QuantizeDepthMillimeters;
+namespace detail = hako::robots::sensor::camera::detail;
+
+// The conversion EncodeDepth and the DEPTH_U16_MM converter used before the
+// fused kernel: double precision NDC formula, a NaN mask pass, std::round.
+std::vector<float> ReferenceMeters(const std::vector<float>& samples, const DepthKernelParams& params)
+{
+    const double znear = params.znear;
+    const double zfar = params.zfar;
+    std::vector<float> out(samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const double z_ndc = 2.0 * static_cast<double>(samples[i]) - 1.0;
+        out[i] = static_cast<float>((2.0 * znear * zfar) / (zfar + znear - z_ndc * (zfar - znear)));
+        if (out[i] < params.clip_near || out[i] > params.clip_far) {
+            out[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+    return out;
+}
+
+std::uint16_t ReferenceMillimeters(float depth_m)
+{
+    if (!std::isfinite(depth_m) || depth_m <= 0.0F) {
+        return 0;
+    }
+    const double mm = std::round(static_cast<double>(depth_m) * 1000.0);
+    if (mm <= 0.0 || mm > static_cast<double>(std::numeric_limits<std::uint16_t>::max())) {
+        return 0;
+    }
+    return static_cast<std::uint16_t>(mm);
+}
+
+// Uniform samples, the exact plane values and an odd count so the vector
+// kernels also run their scalar tail.
+std::vector<float> MakeSamples()
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> uniform(0.0F, 1.0F);
+    std::vector<float> samples {0.0F, 1.0F, 0.5F, 0.999F, 0.9999999F};
+    while (samples.size() < 4099) {
+        samples.push_back(uniform(rng));
+    }
+    return samples;
+}
+
+bool NearClipEdge(float reference, const DepthKernelParams& params)
+{
+    constexpr float kEdge = 1.0e-5F;
+    return std::abs(reference - params.clip_near) <= kEdge * params.clip_near ||
+           std::abs(reference - params.clip_far) <= kEdge * params.clip_far;
+}
+
+template <typename Kernel>
+void ExpectMetersMatchReference(Kernel kernel, const DepthKernelParams& params, const char* label)
+{
+    const std::vector<float> samples = MakeSamples();
+    // Unclipped reference to judge samples that land on the clip boundary.
+    DepthKernelParams unclipped = params;
+    unclipped.clip_near = 0.0F;
+    unclipped.clip_far = std::numeric_limits<float>::infinity();
+    const std::vector<float> raw_reference = ReferenceMeters(samples, unclipped);
+    const std::vector<float> reference = ReferenceMeters(samples, params);
+
+    std::vector<float> out(samples.size());
+    kernel(samples.data(), samples.size(), params, out.data());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        if (std::isnan(reference[i]) != std::isnan(out[i])) {
+            HAKO_TEST_EXPECT(NearClipEdge(raw_reference[i], params), label);
+            continue;
+        }
+        if (std::isnan(reference[i])) {
+            continue;
+        }
+        // A few float roundings against the double reference.
+        HAKO_TEST_EXPECT(std::abs(out[i] - reference[i]) <= 1.0e-6F * reference[i], label);
+    }
+}
+
+void TestMetersMatchReference()
+{
+    DepthKernelParams params;
+    params.znear = 0.1F;
+    params.zfar = 1000.0F;
+    params.clip_near = 0.19F;
+    params.clip_far = 500.0F;
+    ExpectMetersMatchReference(LinearizeDepthMeters, params, "dispatched kernel differs from reference");
+    ExpectMetersMatchReference(detail::LinearizeDepthMetersScalar, params, "scalar kernel differs from reference");
+
+    params.znear = 0.05F;
+    params.zfar = 10.0F;
+    params.clip_near = 0.05F;
+    params.clip_far = 10.0F;
+    ExpectMetersMatchReference(LinearizeDepthMeters, params, "dispatched kernel differs for a short range");
+}
+
+void TestMillimetersMatchReference()
+{
+    DepthKernelParams params;
+    params.znear = 0.05F;
+    params.zfar = 100.0F;
+    params.clip_near = 0.1F;
+    params.clip_far = 80.0F;
+    const std::vector<float> samples = MakeSamples();
+
+    std::vector<float> meters(samples.size());
+    LinearizeDepthMeters(samples.data(), samples.size(), params, meters.data());
+    std::vector<std::uint16_t> fused(samples.size());
+    std::vector<std::uint16_t> scalar(samples.size());
+    std::vector<std::uint16_t> quantized(samples.size());
+    LinearizeDepthMillimeters(samples.data(), samples.size(), params, fused.data());
+    detail::LinearizeDepthMillimetersScalar(samples.data(), samples.size(), params, scalar.data());
+    QuantizeDepthMillimeters(meters.data(), meters.size(), quantized.data());
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const int expected = ReferenceMillimeters(meters[i]);
+        // float rounding of m*1000 may land on the other side of a .5 tie.
+        HAKO_TEST_EXPECT(std::abs(static_cast<int>(quantized[i]) - expected) <= 1, "quantized mm differs");
+        HAKO_TEST_EXPECT(fused[i] == quantized[i], "fused mm should equal linearize then quantize");
+        HAKO_TEST_EXPECT(std::abs(static_cast<int>(scalar[i]) - expected) <= 1, "scalar mm differs");
+    }
+
+    const std::vector<float> edge {
+        std::numeric_limits<float>::quiet_NaN(), -1.0F, 0.0F, 0.0004F, 0.0006F, 65.535F, 65.536F,
+        std::numeric_limits<float>::infinity(), 1.2345F};
+    std::vector<std::uint16_t> edge_mm(edge.size());
+    QuantizeDepthMillimeters(edge.data(), edge.size(), edge_mm.data());
+    const std::vector<std::uint16_t> expected_edge {0, 0, 0, 0, 1, 65535, 0, 0, 1235};
+    HAKO_TEST_EXPECT(edge_mm == expected_edge, "unexpected DEPTH_U16_MM edge cases");
+
+    // The byte overload stores the same values little-endian.
+    std::vector<std::uint8_t> bytes(meters.size() * 2);
+    QuantizeDepthMillimeters(meters.data(), meters.size(), bytes.data());
+    for (std::size_t i = 0; i < meters.size(); ++i) {
+        const int value = bytes[2 * i] | (bytes[2 * i + 1] << 8);
+        HAKO_TEST_EXPECT(value == quantized[i], "byte output should match the uint16_t output");
+    }
+}
+
+// Reversed-Z samples of known distances decode back to those distances.
+void TestReversedDepthMap()
+{
+    const double znear = 0.1;
+    const double zfar = 50.0;
+    const std::vector<double> distances {0.1, 0.25, 1.0, 3.5, 12.0, 49.0};
+
+    hako::robots::sensor::camera::RawCameraFrame raw;
+    raw.width = static_cast<int>(distances.size());
+    raw.height = 1;
+    raw.znear = znear;
+    raw.zfar = zfar;
+    raw.depth_map = mjDEPTH_ZEROFAR;
+    for (double z : distances) {
+        raw.depth_buffer.push_back(static_cast<float>(znear * (zfar - z) / (z * (zfar - znear))));
+    }
+
+    hako::robots::sensor::camera::DepthCameraConfig config;
+    config.clip.near = 0.2;
+    config.clip.far = 40.0;
+    hako::robots::sensor::camera::DepthFrame out;
+    HAKO_TEST_EXPECT(
+        hako::robots::sensor::camera::EncodeDepth(raw, config, out), "reversed depth map should be accepted");
+    HAKO_TEST_EXPECT(std::isnan(out.data[0]), "sample before clip.near should be NaN");
+    HAKO_TEST_EXPECT(std::isnan(out.data[5]), "sample beyond clip.far should be NaN");
+    for (std::size_t i = 1; i + 1 < distances.size(); ++i) {
+        HAKO_TEST_EXPECT(
+            std::abs(static_cast<double>(out.data[i]) - distances[i]) <= 1.0e-5 * distances[i],
+            "reversed depth should decode to the original distance");
+    }
+
+    std::vector<std::uint16_t> mm(raw.depth_buffer.size());
+    HAKO_TEST_EXPECT(
+        hako::robots::sensor::camera::EncodeDepthMillimeters(raw, config, mm.data()),
+        "reversed depth map should quantize");
+    HAKO_TEST_EXPECT(mm[0] == 0 && mm[1] == 250 && mm[2] == 1000 && mm[4] == 12000 && mm[5] == 0,
+                     "unexpected reversed DEPTH_U16_MM values");
+
+    raw.depth_map = 7;
+    HAKO_TEST_EXPECT(
+        !hako::robots::sensor::camera::EncodeDepth(raw, config, out), "unknown depth map should be rejected");
+}
+}
+
+int main()
+{
+    try {
+        std::cout << "depth kernels: " << hako::robots::sensor::common::SimdIsaName() << std::endl;
+        TestMetersMatchReference();
+        TestMillimetersMatchReference();
+        TestReversedDepthMap();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "depth_kernel_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
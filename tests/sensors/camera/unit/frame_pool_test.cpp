@@ -0,0 +1,167 @@
+#include "sensors/camera/frame_pool.hpp"
+#include "tests/sensors/camera/support/camera_test_utils.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using hako::robots::sensor::camera::DepthFramePool;
+using hako::robots::sensor::camera::ImageFramePool;
+using hako::robots::sensor::camera::PooledDepthFrame;
+using hako::robots::sensor::camera::PooledImageFrame;
+
+void TestReuse()
+{
+    ImageFramePool pool;
+    const std::uint8_t* buffer = nullptr;
+    for (int i = 0; i < 100; ++i) {
+        PooledImageFrame frame = pool.Acquire(64, 48, "R8G8B8");
+        HAKO_TEST_EXPECT(frame && frame.UseCount() == 1, "Acquire should return a unique frame");
+        frame->data.resize(64U * 48U * 3U);
+        if (i == 0) {
+            buffer = frame->data.data();
+        }
+        HAKO_TEST_EXPECT(frame->data.data() == buffer, "a reused frame should keep its buffer");
+    }
+    auto stats = pool.GetStats();
+    HAKO_TEST_EXPECT(stats.acquired == 100 && stats.allocated == 1 && stats.reused == 99,
+                     "one frame should serve every sequential capture");
+    HAKO_TEST_EXPECT(stats.released == 100 && stats.live == 0 && stats.idle == 1, "unexpected pool counters");
+
+    // Another resolution or format never gets that frame.
+    PooledImageFrame other_size = pool.Acquire(32, 24, "R8G8B8");
+    PooledImageFrame other_format = pool.Acquire(64, 48, "L8");
+    PooledImageFrame same = pool.Acquire(64, 48, "R8G8B8");
+    stats = pool.GetStats();
+    HAKO_TEST_EXPECT(stats.allocated == 3 && stats.reused == 100, "keys should be kept apart");
+    HAKO_TEST_EXPECT(same->data.data() == buffer, "the matching key should reuse its frame");
+    HAKO_TEST_EXPECT(other_size->data.empty() && other_format->data.empty(), "new frames start empty");
+    HAKO_TEST_EXPECT(stats.live == 3 && stats.idle == 0, "unexpected live count");
+}
+
+void TestSharedReferences()
+{
+    DepthFramePool pool;
+    PooledDepthFrame first = pool.Acquire(4, 4, "DEPTH_F32_M");
+    first->data.assign(16, 1.5f);
+    PooledDepthFrame second = first;
+    PooledDepthFrame third;
+    third = second;
+    HAKO_TEST_EXPECT(first.UseCount() == 3 && second.get() == first.get(), "copies should share the frame");
+
+    PooledDepthFrame moved = std::move(third);
+    HAKO_TEST_EXPECT(!third && moved.UseCount() == 3, "a move should not add a reference");
+
+    first.Reset();
+    second.Reset();
+    HAKO_TEST_EXPECT(pool.GetStats().live == 1 && pool.GetStats().released == 0,
+                     "the frame stays borrowed while a reference remains");
+    HAKO_TEST_EXPECT(moved->data.size() == 16 && moved->data[0] == 1.5f, "data should survive other resets");
+    moved.Reset();
+    HAKO_TEST_EXPECT(pool.GetStats().live == 0 && pool.GetStats().released == 1, "the last reset should return it");
+    HAKO_TEST_EXPECT(moved.UseCount() == 0 && moved.get() == nullptr, "a reset handle should be empty");
+}
+
+void TestHandleOutlivesPool()
+{
+    PooledImageFrame survivor;
+    {
+        ImageFramePool pool;
+        PooledImageFrame idle = pool.Acquire(8, 8, "L8");
+        survivor = pool.Acquire(8, 8, "L8");
+        survivor->data.assign(64, 7);
+        idle.Reset();
+    }
+    // Destroying the pool freed the idle frame; the borrowed one is still valid.
+    HAKO_TEST_EXPECT(survivor->data.size() == 64 && survivor->data[63] == 7, "a borrowed frame should stay valid");
+    PooledImageFrame copy = survivor;
+    survivor.Reset();
+    copy.Reset();
+}
+
+// A producer borrows frames and hands them to consumer threads that release
+// them, like the capture thread feeding a sender and an encoder.
+void TestCrossThreadRelease()
+{
+    constexpr int kFrames = 20000;
+    constexpr std::size_t kQueueLimit = 4;
+    ImageFramePool pool;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<PooledImageFrame> queues[2];
+    bool done = false;
+    std::atomic<int> torn {0};
+
+    auto consume = [&](std::deque<PooledImageFrame>& queue) {
+        while (true) {
+            PooledImageFrame frame;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return done || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                frame = std::move(queue.front());
+                queue.pop_front();
+            }
+            changed.notify_all();
+            if (frame->data.size() != 16 || frame->data[0] != frame->data[15]) {
+                ++torn;
+            }
+        }
+    };
+    std::thread sender(consume, std::ref(queues[0]));
+    std::thread encoder(consume, std::ref(queues[1]));
+
+    for (int i = 0; i < kFrames; ++i) {
+        PooledImageFrame frame = pool.Acquire(4, 4, "L8");
+        frame->data.assign(16, static_cast<std::uint8_t>(i));
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&]() { return queues[0].size() < kQueueLimit && queues[1].size() < kQueueLimit; });
+        queues[0].push_back(frame);
+        queues[1].push_back(std::move(frame));
+        lock.unlock();
+        changed.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    changed.notify_all();
+    sender.join();
+    encoder.join();
+
+    HAKO_TEST_EXPECT(torn == 0, "consumers should see whole frames");
+    const auto stats = pool.GetStats();
+    HAKO_TEST_EXPECT(stats.acquired == kFrames && stats.released == kFrames && stats.live == 0,
+                     "every frame should return to the pool");
+    // Bounded by what the queues and the producer can hold at once.
+    HAKO_TEST_EXPECT(stats.allocated <= 2 * kQueueLimit + 2, "steady state should reuse frames");
+    HAKO_TEST_EXPECT(stats.idle == stats.allocated, "every frame should end idle");
+}
+}
+
+int main()
+{
+    try {
+        TestReuse();
+        TestSharedReferences();
+        TestHandleOutlivesPool();
+        TestCrossThreadRelease();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "frame_pool_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,348 @@
+#include "hakoniwa/pdu/converter/sensor_msgs/compressed_image.hpp"
+#include "sensors/camera/image_codecs.hpp"
+#include "sensors/camera/image_compression_worker.hpp"
+#include "sensors/camera/image_frame_writer.hpp"
+#include "tests/sensors/camera/support/camera_test_utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using hako::robots::sensor::camera::CompressImageFrame;
+using hako::robots::sensor::camera::CompressedImageFrame;
+using hako::robots::sensor::camera::EncodeJpeg;
+using hako::robots::sensor::camera::EncodeQoi;
+using hako::robots::sensor::camera::ImageCompressionConfig;
+using hako::robots::sensor::camera::ImageCompressionWorker;
+using hako::robots::sensor::camera::ImageFrame;
+using hako::robots::sensor::camera::ImageFramePool;
+using hako::robots::sensor::camera::PooledImageFrame;
+using hako::robots::sensor::camera::test::MakeImageFrame;
+
+// Smooth gradients with a few flat areas, so QOI exercises every op.
+std::vector<std::uint8_t> MakePattern(int width, int height, int channels)
+{
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(width * height * channels));
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < channels; ++c) {
+                std::uint8_t value = static_cast<std::uint8_t>((x * (c + 1) * 7 + y * 3) & 0xFF);
+                if (x < 8) {
+                    value = 40;
+                } else if (c == 3) {
+                    value = static_cast<std::uint8_t>(x % 5 == 0 ? 128 : 255);
+                }
+                data[static_cast<std::size_t>((y * width + x) * channels + c)] = value;
+            }
+        }
+    }
+    return data;
+}
+
+std::uint32_t ReadBe32(const std::vector<std::uint8_t>& data, std::size_t offset)
+{
+    return (static_cast<std::uint32_t>(data[offset]) << 24) | (static_cast<std::uint32_t>(data[offset + 1]) << 16) |
+           (static_cast<std::uint32_t>(data[offset + 2]) << 8) | static_cast<std::uint32_t>(data[offset + 3]);
+}
+
+// Reference QOI decoder following the specification; returns RGBA pixels.
+std::vector<std::uint8_t> DecodeQoi(const std::vector<std::uint8_t>& data, int& width, int& height, int& channels)
+{
+    HAKO_TEST_EXPECT(data.size() >= 22, "qoi stream too short");
+    HAKO_TEST_EXPECT(data[0] == 'q' && data[1] == 'o' && data[2] == 'i' && data[3] == 'f', "missing qoi magic");
+    width = static_cast<int>(ReadBe32(data, 4));
+    height = static_cast<int>(ReadBe32(data, 8));
+    channels = data[12];
+    std::vector<std::uint8_t> out;
+    std::uint8_t index[64][4] {};
+    std::uint8_t px[4] = {0, 0, 0, 255};
+    std::size_t pos = 14;
+    const std::size_t count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    int run = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (run > 0) {
+            --run;
+        } else {
+            const std::uint8_t op = data[pos++];
+            if (op == 0xFE) {
+                px[0] = data[pos++];
+                px[1] = data[pos++];
+                px[2] = data[pos++];
+            } else if (op == 0xFF) {
+                for (int c = 0; c < 4; ++c) {
+                    px[c] = data[pos++];
+                }
+            } else if ((op & 0xC0) == 0x00) {
+                for (int c = 0; c < 4; ++c) {
+                    px[c] = index[op][c];
+                }
+            } else if ((op & 0xC0) == 0x40) {
+                px[0] = static_cast<std::uint8_t>(px[0] + ((op >> 4) & 3) - 2);
+                px[1] = static_cast<std::uint8_t>(px[1] + ((op >> 2) & 3) - 2);
+                px[2] = static_cast<std::uint8_t>(px[2] + (op & 3) - 2);
+            } else if ((op & 0xC0) == 0x80) {
+                const int dg = (op & 0x3F) - 32;
+                const std::uint8_t next = data[pos++];
+                px[0] = static_cast<std::uint8_t>(px[0] + dg - 8 + ((next >> 4) & 0x0F));
+                px[1] = static_cast<std::uint8_t>(px[1] + dg);
+                px[2] = static_cast<std::uint8_t>(px[2] + dg - 8 + (next & 0x0F));
+            } else {
+                run = op & 0x3F;
+            }
+            const int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+            for (int c = 0; c < 4; ++c) {
+                index[hash][c] = px[c];
+            }
+        }
+        out.insert(out.end(), px, px + 4);
+    }
+    const std::vector<std::uint8_t> end_marker {0, 0, 0, 0, 0, 0, 0, 1};
+    HAKO_TEST_EXPECT(data.size() == pos + end_marker.size(), "qoi stream has trailing bytes");
+    HAKO_TEST_EXPECT(
+        std::equal(end_marker.begin(), end_marker.end(), data.begin() + static_cast<std::ptrdiff_t>(pos)),
+        "missing qoi end marker");
+    return out;
+}
+
+void TestQoiRoundTrip()
+{
+    struct Case
+    {
+        const char* format;
+        int channels;
+        int r;
+        int b;
+    };
+    const Case cases[] = {
+        {"R8G8B8", 3, 0, 2},
+        {"B8G8R8", 3, 2, 0},
+        {"R8G8B8A8", 4, 0, 2},
+        {"L8", 1, 0, 0},
+    };
+    for (const auto& test_case : cases) {
+        const int width = 67;
+        const int height = 13;
+        const ImageFrame frame = MakeImageFrame(
+            width, height, test_case.format, "camera", 1.0, MakePattern(width, height, test_case.channels));
+        std::vector<std::uint8_t> encoded;
+        HAKO_TEST_EXPECT(EncodeQoi(frame, encoded), "qoi encode failed");
+
+        int decoded_width = 0;
+        int decoded_height = 0;
+        int decoded_channels = 0;
+        const auto rgba = DecodeQoi(encoded, decoded_width, decoded_height, decoded_channels);
+        HAKO_TEST_EXPECT(decoded_width == width && decoded_height == height, "qoi size mismatch");
+        HAKO_TEST_EXPECT(decoded_channels == (test_case.channels == 4 ? 4 : 3), "qoi channel mismatch");
+        for (std::size_t i = 0; i < static_cast<std::size_t>(width * height); ++i) {
+            const std::uint8_t* src = frame.data.data() + i * static_cast<std::size_t>(test_case.channels);
+            const std::uint8_t* got = rgba.data() + i * 4;
+            const int g = test_case.channels == 1 ? 0 : 1;
+            const std::uint8_t alpha = test_case.channels == 4 ? src[3] : 255;
+            HAKO_TEST_EXPECT(
+                got[0] == src[test_case.r] && got[1] == src[g] && got[2] == src[test_case.b] && got[3] == alpha,
+                std::string("qoi pixel mismatch for ") + test_case.format);
+        }
+    }
+}
+
+void TestPngHeader()
+{
+    const ImageFrame frame = MakeImageFrame(5, 3, "R8G8B8A8", "camera", 0.0, MakePattern(5, 3, 4));
+    std::vector<std::uint8_t> png;
+    HAKO_TEST_EXPECT(hako::robots::sensor::camera::EncodeImageFrameToPng(frame, png), "png encode failed");
+    const std::vector<std::uint8_t> signature {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    HAKO_TEST_EXPECT(std::equal(signature.begin(), signature.end(), png.begin()), "missing png signature");
+    HAKO_TEST_EXPECT(png[12] == 'I' && png[13] == 'H' && png[14] == 'D' && png[15] == 'R', "missing IHDR");
+    HAKO_TEST_EXPECT(ReadBe32(png, 16) == 5 && ReadBe32(png, 20) == 3, "unexpected png size");
+    HAKO_TEST_EXPECT(png[24] == 8 && png[25] == 6, "R8G8B8A8 should be 8-bit RGBA");
+
+    const ImageFrame yuv = MakeImageFrame(4, 2, "YUV422", "camera", 0.0, std::vector<std::uint8_t>(16, 128));
+    HAKO_TEST_EXPECT(!hako::robots::sensor::camera::EncodeImageFrameToPng(yuv, png), "png should reject YUV422");
+}
+
+std::size_t FindMarker(const std::vector<std::uint8_t>& data, std::uint8_t marker)
+{
+    for (std::size_t i = 0; i + 1 < data.size(); ++i) {
+        if (data[i] == 0xFF && data[i + 1] == marker) {
+            return i;
+        }
+    }
+    return data.size();
+}
+
+void TestJpegStructure()
+{
+    const int width = 45;
+    const int height = 30;
+    const ImageFrame frame = MakeImageFrame(width, height, "R8G8B8", "camera", 0.0, MakePattern(width, height, 3));
+    std::vector<std::uint8_t> high;
+    std::vector<std::uint8_t> low;
+    HAKO_TEST_EXPECT(EncodeJpeg(frame, 95, high), "jpeg encode failed");
+    HAKO_TEST_EXPECT(EncodeJpeg(frame, 20, low), "jpeg encode failed");
+
+    HAKO_TEST_EXPECT(high[0] == 0xFF && high[1] == 0xD8, "missing SOI");
+    HAKO_TEST_EXPECT(high[high.size() - 2] == 0xFF && high[high.size() - 1] == 0xD9, "missing EOI");
+    const std::size_t sof = FindMarker(high, 0xC0);
+    HAKO_TEST_EXPECT(sof < high.size(), "missing SOF0");
+    HAKO_TEST_EXPECT(((high[sof + 5] << 8) | high[sof + 6]) == height, "unexpected SOF0 height");
+    HAKO_TEST_EXPECT(((high[sof + 7] << 8) | high[sof + 8]) == width, "unexpected SOF0 width");
+    HAKO_TEST_EXPECT(high[sof + 9] == 3, "colour JPEG should have three components");
+    HAKO_TEST_EXPECT(FindMarker(high, 0xDA) < high.size(), "missing SOS");
+    HAKO_TEST_EXPECT(low.size() < high.size(), "lower quality should produce a smaller JPEG");
+
+    const ImageFrame mono = MakeImageFrame(width, height, "L8", "camera", 0.0, MakePattern(width, height, 1));
+    std::vector<std::uint8_t> grey;
+    HAKO_TEST_EXPECT(EncodeJpeg(mono, 80, grey), "grey jpeg encode failed");
+    HAKO_TEST_EXPECT(grey[FindMarker(grey, 0xC0) + 9] == 1, "L8 JPEG should have one component");
+
+    std::vector<std::uint8_t> rejected;
+    HAKO_TEST_EXPECT(!EncodeJpeg(frame, 0, rejected), "quality 0 should fail");
+}
+
+void TestCompressImageFrameToPdu()
+{
+    ImageFrame frame = MakeImageFrame(16, 8, "B8G8R8", "camera_rgb_frame", 12.25, MakePattern(16, 8, 3));
+    ImageCompressionConfig config {};
+    config.codec = "qoi";
+    CompressedImageFrame compressed {};
+    HAKO_TEST_EXPECT(CompressImageFrame(frame, config, compressed), "CompressImageFrame failed");
+    HAKO_TEST_EXPECT(compressed.format == "qoi", "unexpected compressed format");
+    HAKO_TEST_EXPECT(compressed.frame_id == "camera_rgb_frame", "frame_id should be copied");
+
+    HakoCpp_CompressedImage pdu {};
+    const std::size_t size = compressed.data.size();
+    HAKO_TEST_EXPECT(
+        hako::robots::pdu::converter::sensor_msgs::SwapIntoHakoPdu(compressed, pdu), "SwapIntoHakoPdu failed");
+    HAKO_TEST_EXPECT(pdu.format == "qoi" && pdu.data.size() == size, "unexpected CompressedImage PDU");
+    HAKO_TEST_EXPECT(pdu.header.frame_id == "camera_rgb_frame", "unexpected PDU frame_id");
+    HAKO_TEST_EXPECT_TIME(pdu.header.stamp, 12, 250000000U);
+
+    config.codec = "webp";
+    HAKO_TEST_EXPECT(!CompressImageFrame(frame, config, compressed), "unknown codec should fail");
+}
+
+void TestCompressionWorker()
+{
+    ImageCompressionWorker worker;
+    ImageCompressionConfig config {};
+    config.codec = "jpeg";
+    config.jpeg_quality = 70;
+    HAKO_TEST_EXPECT(worker.Start(config, 1, 1), "worker should start");
+    HAKO_TEST_EXPECT(!worker.Start(config, 1, 1), "second Start should fail");
+
+    CompressedImageFrame out {};
+    HAKO_TEST_EXPECT(!worker.TryTakeLatest(out), "nothing should be ready before Submit");
+
+    // Submit far more frames than one slot can hold; the extra ones are
+    // dropped instead of blocking, and the newest encoded frame wins.
+    double last_accepted = 0.0;
+    for (int i = 1; i <= 50; ++i) {
+        ImageFrame frame = MakeImageFrame(320, 240, "R8G8B8", "camera", i, MakePattern(320, 240, 3));
+        if (worker.Submit(frame)) {
+            last_accepted = i;
+        }
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (worker.GetStats().encoded + worker.GetStats().failed + worker.GetStats().dropped < 50 &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto stats = worker.GetStats();
+    HAKO_TEST_EXPECT(stats.submitted == 50, "unexpected submitted count");
+    HAKO_TEST_EXPECT(stats.failed == 0, "no frame should fail");
+    HAKO_TEST_EXPECT(stats.encoded + stats.dropped == 50, "every frame should be encoded or dropped");
+    HAKO_TEST_EXPECT(stats.encoded >= 1, "at least one frame should be encoded");
+
+    HAKO_TEST_EXPECT(worker.TryTakeLatest(out), "an encoded frame should be ready");
+    HAKO_TEST_EXPECT(out.format == "jpeg", "unexpected worker format");
+    HAKO_TEST_EXPECT(out.timestamp == last_accepted, "worker should return the newest accepted frame");
+    HAKO_TEST_EXPECT(out.data.size() > 2 && out.data[0] == 0xFF && out.data[1] == 0xD8, "worker output is not JPEG");
+    HAKO_TEST_EXPECT(!worker.TryTakeLatest(out), "a frame should be taken only once");
+
+    worker.Stop();
+    HAKO_TEST_EXPECT(!worker.Running(), "worker should stop");
+    ImageFrame frame = MakeImageFrame(4, 4, "R8G8B8", "camera", 0.0, MakePattern(4, 4, 3));
+    HAKO_TEST_EXPECT(!worker.Submit(frame), "Submit after Stop should fail");
+
+    config.jpeg_quality = 101;
+    HAKO_TEST_EXPECT(!worker.Start(config), "invalid quality should not start");
+}
+
+void TestCompressionWorkerPooledFrames()
+{
+    ImageCompressionWorker worker;
+    ImageCompressionConfig config {};
+    config.codec = "qoi";
+    HAKO_TEST_EXPECT(worker.Start(config, 2, 2), "worker should start");
+
+    // Frames go back to the pool once encoded, so a handful serve every capture.
+    ImageFramePool pool;
+    const std::vector<std::uint8_t> pattern = MakePattern(64, 48, 3);
+    CompressedImageFrame out {};
+    std::uint64_t accepted = 0;
+    for (int i = 1; i <= 200; ++i) {
+        PooledImageFrame frame = pool.Acquire(64, 48, "R8G8B8");
+        frame->width = 64;
+        frame->height = 48;
+        frame->channels = 3;
+        frame->format = "R8G8B8";
+        frame->frame_id = "camera";
+        frame->timestamp = i;
+        frame->data.assign(pattern.begin(), pattern.end());
+        if (worker.Submit(frame)) {
+            ++accepted;
+            // Still readable here while the encoder holds its own reference.
+            HAKO_TEST_EXPECT(frame->data.size() == pattern.size(), "Submit should not take the pixels");
+        }
+        worker.TryTakeLatest(out);
+    }
+    HAKO_TEST_EXPECT(!worker.Submit(PooledImageFrame {}), "an empty handle should be rejected");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (worker.GetStats().encoded + worker.GetStats().failed < accepted &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    worker.Stop();
+    const auto stats = worker.GetStats();
+    const auto pool_stats = pool.GetStats();
+    HAKO_TEST_EXPECT(stats.failed == 0 && stats.encoded == accepted, "every accepted frame should be encoded");
+    HAKO_TEST_EXPECT(pool_stats.acquired == 200 && pool_stats.live == 0, "every frame should return to the pool");
+    // The caller's frame, two queue slots and two encoders.
+    HAKO_TEST_EXPECT(pool_stats.allocated <= 5, "pooled submits should reuse frames");
+
+    worker.TryTakeLatest(out);
+    std::vector<std::uint8_t> expected;
+    HAKO_TEST_EXPECT(EncodeQoi(MakeImageFrame(64, 48, "R8G8B8", "camera", 0.0, pattern), expected), "qoi encode failed");
+    HAKO_TEST_EXPECT(out.format == "qoi" && out.data == expected, "pooled frames should encode like plain ones");
+}
+}
+
+int main()
+{
+    try {
+        TestQoiRoundTrip();
+        TestPngHeader();
+        TestJpegStructure();
+        TestCompressImageFrameToPdu();
+        TestCompressionWorker();
+        TestCompressionWorkerPooledFrames();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "image_codec_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
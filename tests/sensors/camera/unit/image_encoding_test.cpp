@@ -0,0 +1,78 @@
+#include "sensors/camera/camera_encoding_utils.hpp"
+#include "sensors/camera/mujoco_camera_renderer.hpp"
+#include "tests/sensors/camera/support/camera_test_utils.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+using hako::robots::sensor::camera::CameraConfig;
+using hako::robots::sensor::camera::ImageFrame;
+using hako::robots::sensor::camera::RawCameraFrame;
+
+// 2x2 RGB image, top row first.
+const std::vector<std::uint8_t> kTopDown {
+    10, 20, 30,  40, 50, 60,
+    70, 80, 90,  100, 110, 120,
+};
+// The same image in OpenGL readback order, bottom row first.
+const std::vector<std::uint8_t> kBottomUp {
+    70, 80, 90,  100, 110, 120,
+    10, 20, 30,  40, 50, 60,
+};
+
+void RunImageEncodingTest()
+{
+    RawCameraFrame raw;
+    raw.width = 2;
+    raw.height = 2;
+    raw.rgb = kTopDown;
+    raw.timestamp = 1.5;
+
+    for (const char* format : {"R8G8B8", "B8G8R8", "L8"}) {
+        CameraConfig config;
+        config.frame_id = "camera_frame";
+        config.image.format = format;
+
+        ImageFrame expected;
+        HAKO_TEST_EXPECT(
+            hako::robots::sensor::camera::EncodeImage(raw, config, expected),
+            "EncodeImage should succeed");
+
+        // A reused frame with stale contents must be fully overwritten.
+        ImageFrame actual;
+        actual.data.assign(64, 0xFF);
+        HAKO_TEST_EXPECT(
+            hako::robots::sensor::camera::EncodeImageRows(kBottomUp.data(), 2, 2, true, 1.5, config, actual),
+            "EncodeImageRows should succeed");
+        HAKO_TEST_EXPECT(actual.data == expected.data, "flipped single-pass encode should match EncodeImage");
+        HAKO_TEST_EXPECT(actual.channels == expected.channels, "unexpected channel count");
+        HAKO_TEST_EXPECT(actual.format == format, "unexpected format tag");
+        HAKO_TEST_EXPECT(actual.frame_id == "camera_frame", "unexpected frame_id");
+        HAKO_TEST_EXPECT(actual.timestamp == 1.5, "unexpected timestamp");
+    }
+
+    CameraConfig bgr;
+    bgr.image.format = "B8G8R8";
+    ImageFrame out;
+    HAKO_TEST_EXPECT(
+        hako::robots::sensor::camera::EncodeImageRows(kBottomUp.data(), 2, 2, true, 0.0, bgr, out),
+        "B8G8R8 encode should succeed");
+    HAKO_TEST_EXPECT(out.data[0] == 30 && out.data[1] == 20 && out.data[2] == 10, "B8G8R8 should swap R and B of the top row");
+
+    CameraConfig unsupported;
+    unsupported.image.format = "YUV";
+    HAKO_TEST_EXPECT(
+        !hako::robots::sensor::camera::EncodeImageRows(kBottomUp.data(), 2, 2, true, 0.0, unsupported, out),
+        "unsupported format should fail");
+}
+}
+
+int main()
+{
+    RunImageEncodingTest();
+    std::cout << "image_encoding_test passed" << std::endl;
+    return 0;
+}
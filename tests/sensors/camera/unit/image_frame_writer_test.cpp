@@ -0,0 +1,506 @@
+#include "sensors/camera/deflate.hpp"
+#include "sensors/camera/image_frame_recorder.hpp"
+#include "sensors/camera/image_frame_writer.hpp"
+#include "tests/sensors/camera/support/camera_test_utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using hako::robots::sensor::camera::Adler32;
+using hako::robots::sensor::camera::Crc32;
+using hako::robots::sensor::camera::EncodeImageFrameToPng;
+using hako::robots::sensor::camera::ImageFrame;
+using hako::robots::sensor::camera::ImageFrameRecorder;
+using hako::robots::sensor::camera::ImageFrameRecorderConfig;
+using hako::robots::sensor::camera::kDefaultPngCompressionLevel;
+using hako::robots::sensor::camera::ImageFramePool;
+using hako::robots::sensor::camera::PooledImageFrame;
+using hako::robots::sensor::camera::ZlibCompress;
+using hako::robots::sensor::camera::test::MakeImageFrame;
+
+// Minimal RFC 1951 decoder, enough to check the encoder's output
+// independently of it.
+class Inflater
+{
+public:
+    explicit Inflater(const std::vector<std::uint8_t>& in) : in_(in) {}
+
+    std::vector<std::uint8_t> Run()
+    {
+        std::vector<std::uint8_t> out;
+        bool last = false;
+        while (!last) {
+            last = Bits(1) != 0;
+            const std::uint32_t type = Bits(2);
+            if (type == 0) {
+                bit_buffer_ = 0;
+                bit_count_ = 0;
+                const std::uint32_t len = Byte() | (Byte() << 8);
+                const std::uint32_t nlen = Byte() | (Byte() << 8);
+                if ((len ^ 0xFFFFu) != nlen) {
+                    throw std::runtime_error("inflate: bad stored length");
+                }
+                for (std::uint32_t i = 0; i < len; ++i) {
+                    out.push_back(static_cast<std::uint8_t>(Byte()));
+                }
+            } else if (type == 1) {
+                std::vector<int> lengths(288 + 32);
+                for (int i = 0; i < 288; ++i) {
+                    lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+                }
+                for (int i = 288; i < 320; ++i) {
+                    lengths[i] = 5;
+                }
+                Block(Huffman(lengths.data(), 288), Huffman(lengths.data() + 288, 32), out);
+            } else if (type == 2) {
+                const int hlit = static_cast<int>(Bits(5)) + 257;
+                const int hdist = static_cast<int>(Bits(5)) + 1;
+                const int hclen = static_cast<int>(Bits(4)) + 4;
+                static const int kOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+                int code_lengths[19] = {};
+                for (int i = 0; i < hclen; ++i) {
+                    code_lengths[kOrder[i]] = static_cast<int>(Bits(3));
+                }
+                const Huffman code_code(code_lengths, 19);
+                std::vector<int> lengths;
+                while (static_cast<int>(lengths.size()) < hlit + hdist) {
+                    const int symbol = Decode(code_code);
+                    if (symbol < 16) {
+                        lengths.push_back(symbol);
+                    } else if (symbol == 16) {
+                        if (lengths.empty()) {
+                            throw std::runtime_error("inflate: repeat without previous length");
+                        }
+                        const int repeat = 3 + static_cast<int>(Bits(2));
+                        lengths.insert(lengths.end(), repeat, lengths.back());
+                    } else {
+                        const int repeat = symbol == 17 ? 3 + static_cast<int>(Bits(3)) : 11 + static_cast<int>(Bits(7));
+                        lengths.insert(lengths.end(), repeat, 0);
+                    }
+                }
+                if (static_cast<int>(lengths.size()) != hlit + hdist) {
+                    throw std::runtime_error("inflate: code lengths overrun");
+                }
+                Block(Huffman(lengths.data(), hlit), Huffman(lengths.data() + hlit, hdist), out);
+            } else {
+                throw std::runtime_error("inflate: bad block type");
+            }
+        }
+        return out;
+    }
+
+    std::size_t Position() const { return pos_; }
+
+private:
+    struct Huffman
+    {
+        Huffman(const int* lengths, int n)
+        {
+            for (int i = 0; i < n; ++i) {
+                ++counts[lengths[i]];
+            }
+            counts[0] = 0;
+            int offsets[16] = {};
+            for (int len = 1; len < 16; ++len) {
+                offsets[len] = offsets[len - 1] + counts[len - 1];
+            }
+            symbols.resize(static_cast<std::size_t>(n));
+            for (int i = 0; i < n; ++i) {
+                if (lengths[i] != 0) {
+                    symbols[static_cast<std::size_t>(offsets[lengths[i]]++)] = i;
+                }
+            }
+        }
+        int counts[16] = {};
+        std::vector<int> symbols;
+    };
+
+    std::uint32_t Byte()
+    {
+        if (pos_ >= in_.size()) {
+            throw std::runtime_error("inflate: unexpected end of input");
+        }
+        return in_[pos_++];
+    }
+
+    std::uint32_t Bits(int n)
+    {
+        while (bit_count_ < n) {
+            bit_buffer_ |= Byte() << bit_count_;
+            bit_count_ += 8;
+        }
+        const std::uint32_t value = bit_buffer_ & ((1u << n) - 1u);
+        bit_buffer_ >>= n;
+        bit_count_ -= n;
+        return value;
+    }
+
+    int Decode(const Huffman& huffman)
+    {
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (int len = 1; len < 16; ++len) {
+            code |= static_cast<int>(Bits(1));
+            const int count = huffman.counts[len];
+            if (code - first < count) {
+                return huffman.symbols[static_cast<std::size_t>(index + code - first)];
+            }
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        throw std::runtime_error("inflate: invalid code");
+    }
+
+    void Block(const Huffman& lit, const Huffman& dist, std::vector<std::uint8_t>& out)
+    {
+        static const int kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const int kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                             3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static const int kDistBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                          193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+                                          6145, 8193, 12289, 16385, 24577};
+        static const int kDistExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                           6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+        while (true) {
+            const int symbol = Decode(lit);
+            if (symbol < 256) {
+                out.push_back(static_cast<std::uint8_t>(symbol));
+                continue;
+            }
+            if (symbol == 256) {
+                return;
+            }
+            const int length_index = symbol - 257;
+            if (length_index >= 29) {
+                throw std::runtime_error("inflate: bad length symbol");
+            }
+            const int length = kLengthBase[length_index] + static_cast<int>(Bits(kLengthExtra[length_index]));
+            const int dist_index = Decode(dist);
+            if (dist_index >= 30) {
+                throw std::runtime_error("inflate: bad distance symbol");
+            }
+            const std::size_t distance =
+                static_cast<std::size_t>(kDistBase[dist_index]) + Bits(kDistExtra[dist_index]);
+            if (distance > out.size()) {
+                throw std::runtime_error("inflate: distance too far back");
+            }
+            for (int i = 0; i < length; ++i) {
+                out.push_back(out[out.size() - distance]);
+            }
+        }
+    }
+
+    const std::vector<std::uint8_t>& in_;
+    std::size_t pos_ {0};
+    std::uint32_t bit_buffer_ {0};
+    int bit_count_ {0};
+};
+
+std::vector<std::uint8_t> ZlibDecompress(const std::vector<std::uint8_t>& stream)
+{
+    HAKO_TEST_EXPECT(stream.size() >= 6, "zlib stream too short");
+    HAKO_TEST_EXPECT((stream[0] & 0x0F) == 8, "zlib method should be deflate");
+    HAKO_TEST_EXPECT(((stream[0] << 8) | stream[1]) % 31 == 0, "zlib header check failed");
+    const std::vector<std::uint8_t> body(stream.begin() + 2, stream.end());
+    Inflater inflater(body);
+    std::vector<std::uint8_t> out = inflater.Run();
+    HAKO_TEST_EXPECT(inflater.Position() + 4 == body.size(), "zlib trailer should follow the last block");
+    const std::size_t p = inflater.Position();
+    const std::uint32_t adler = (std::uint32_t(body[p]) << 24) | (std::uint32_t(body[p + 1]) << 16) |
+                                (std::uint32_t(body[p + 2]) << 8) | body[p + 3];
+    HAKO_TEST_EXPECT(adler == Adler32(out.data(), out.size()), "zlib Adler-32 mismatch");
+    return out;
+}
+
+std::uint32_t ReadBe32(const std::vector<std::uint8_t>& data, std::size_t offset)
+{
+    return (std::uint32_t(data[offset]) << 24) | (std::uint32_t(data[offset + 1]) << 16) |
+           (std::uint32_t(data[offset + 2]) << 8) | data[offset + 3];
+}
+
+// Decode an 8-bit non-interlaced PNG to its unfiltered scanlines.
+std::vector<std::uint8_t> DecodePng(const std::vector<std::uint8_t>& png, int channels)
+{
+    HAKO_TEST_EXPECT(png.size() > 8 && png[1] == 'P' && png[2] == 'N' && png[3] == 'G', "not a PNG");
+    std::size_t width = 0;
+    std::size_t height = 0;
+    std::vector<std::uint8_t> idat;
+    for (std::size_t pos = 8; pos + 12 <= png.size();) {
+        const std::uint32_t length = ReadBe32(png, pos);
+        const std::string type(png.begin() + static_cast<std::ptrdiff_t>(pos + 4),
+                               png.begin() + static_cast<std::ptrdiff_t>(pos + 8));
+        const std::uint32_t crc = ReadBe32(png, pos + 8 + length);
+        HAKO_TEST_EXPECT(crc == Crc32(png.data() + pos + 4, length + 4), "PNG chunk CRC mismatch: " + type);
+        if (type == "IHDR") {
+            width = ReadBe32(png, pos + 8);
+            height = ReadBe32(png, pos + 12);
+        } else if (type == "IDAT") {
+            idat.insert(idat.end(), png.begin() + static_cast<std::ptrdiff_t>(pos + 8),
+                        png.begin() + static_cast<std::ptrdiff_t>(pos + 8 + length));
+        }
+        pos += 12 + length;
+    }
+    const std::vector<std::uint8_t> raw = ZlibDecompress(idat);
+    const std::size_t stride = width * static_cast<std::size_t>(channels);
+    HAKO_TEST_EXPECT(raw.size() == height * (stride + 1), "unexpected PNG data size");
+
+    std::vector<std::uint8_t> pixels(height * stride);
+    const std::size_t bpp = static_cast<std::size_t>(channels);
+    for (std::size_t y = 0; y < height; ++y) {
+        const std::uint8_t filter = raw[y * (stride + 1)];
+        const std::uint8_t* src = raw.data() + y * (stride + 1) + 1;
+        std::uint8_t* row = pixels.data() + y * stride;
+        const std::uint8_t* prior = y > 0 ? row - stride : nullptr;
+        for (std::size_t x = 0; x < stride; ++x) {
+            const int a = x >= bpp ? row[x - bpp] : 0;
+            const int b = prior ? prior[x] : 0;
+            const int c = prior && x >= bpp ? prior[x - bpp] : 0;
+            int predictor = 0;
+            switch (filter) {
+            case 0: predictor = 0; break;
+            case 1: predictor = a; break;
+            case 2: predictor = b; break;
+            case 3: predictor = (a + b) / 2; break;
+            case 4: {
+                const int p = a + b - c;
+                const int pa = std::abs(p - a);
+                const int pb = std::abs(p - b);
+                const int pc = std::abs(p - c);
+                predictor = pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+                break;
+            }
+            default: HAKO_TEST_EXPECT(false, "unknown PNG filter");
+            }
+            row[x] = static_cast<std::uint8_t>(src[x] + predictor);
+        }
+    }
+    return pixels;
+}
+
+// Gradients, flat areas and noise, so every PNG filter and match length
+// gets used.
+std::vector<std::uint8_t> MakePattern(int width, int height, int channels)
+{
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(width * height * channels));
+    std::uint32_t seed = 12345u;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < channels; ++c) {
+                seed = seed * 1664525u + 1013904223u;
+                std::uint8_t value = static_cast<std::uint8_t>(x * 2 + y * (c + 1));
+                if (x < width / 4) {
+                    value = 90;
+                } else if (x > width * 3 / 4) {
+                    value = static_cast<std::uint8_t>(seed >> 24);
+                }
+                data[static_cast<std::size_t>((y * width + x) * channels + c)] = value;
+            }
+        }
+    }
+    return data;
+}
+
+void TestChecksums()
+{
+    const std::string digits = "123456789";
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(digits.data());
+    HAKO_TEST_EXPECT(Crc32(bytes, digits.size()) == 0xCBF43926u, "CRC-32 check value mismatch");
+    HAKO_TEST_EXPECT(Crc32(bytes + 4, digits.size() - 4, Crc32(bytes, 4)) == 0xCBF43926u,
+                     "chained CRC-32 should match a single pass");
+    HAKO_TEST_EXPECT(Crc32(bytes, 0) == 0u, "CRC-32 of nothing should be 0");
+
+    const std::string wikipedia = "Wikipedia";
+    HAKO_TEST_EXPECT(Adler32(reinterpret_cast<const std::uint8_t*>(wikipedia.data()), wikipedia.size()) ==
+                         0x11E60398u,
+                     "Adler-32 check value mismatch");
+
+    // Long inputs cross the slicing and modulo boundaries.
+    const std::vector<std::uint8_t> data = MakePattern(211, 97, 3);
+    std::uint32_t crc = 0;
+    std::uint32_t adler = 1;
+    for (std::size_t offset = 0; offset < data.size(); offset += 7) {
+        const std::size_t n = std::min<std::size_t>(7, data.size() - offset);
+        crc = Crc32(data.data() + offset, n, crc);
+        adler = Adler32(data.data() + offset, n, adler);
+    }
+    HAKO_TEST_EXPECT(crc == Crc32(data.data(), data.size()), "piecewise CRC-32 should match");
+    HAKO_TEST_EXPECT(adler == Adler32(data.data(), data.size()), "piecewise Adler-32 should match");
+}
+
+void TestZlibRoundTrip()
+{
+    std::vector<std::vector<std::uint8_t>> inputs;
+    inputs.emplace_back();
+    inputs.emplace_back(1, 42);
+    inputs.emplace_back(100000, 7);
+    inputs.push_back(MakePattern(320, 240, 3));
+    const std::string text = "the quick brown fox jumps over the lazy dog; the lazy dog sleeps. ";
+    std::vector<std::uint8_t> repeated;
+    for (int i = 0; i < 500; ++i) {
+        repeated.insert(repeated.end(), text.begin(), text.begin() + 10 + i % 50);
+    }
+    inputs.push_back(repeated);
+
+    std::vector<std::uint8_t> compressed;
+    for (const auto& input : inputs) {
+        std::size_t previous_size = 0;
+        for (int level = 0; level <= 9; ++level) {
+            ZlibCompress(input.data(), input.size(), level, compressed);
+            HAKO_TEST_EXPECT(ZlibDecompress(compressed) == input,
+                             "zlib round trip failed at level " + std::to_string(level));
+            if (level == 0) {
+                previous_size = compressed.size();
+            } else if (level == 1 && input.size() > 1000) {
+                HAKO_TEST_EXPECT(compressed.size() < previous_size, "level 1 should compress better than stored");
+            }
+        }
+    }
+}
+
+void TestPngRoundTrip()
+{
+    const int width = 97;
+    const int height = 41;
+    struct Case
+    {
+        const char* format;
+        int channels;
+    };
+    for (const Case& c : {Case {"R8G8B8", 3}, Case {"B8G8R8", 3}, Case {"L8", 1}, Case {"R8G8B8A8", 4}}) {
+        const ImageFrame frame =
+            MakeImageFrame(width, height, c.format, "camera", 0.0, MakePattern(width, height, c.channels));
+        for (int level : {0, 1, 6}) {
+            std::vector<std::uint8_t> png;
+            HAKO_TEST_EXPECT(EncodeImageFrameToPng(frame, png, level), "PNG encode failed");
+            std::vector<std::uint8_t> pixels = DecodePng(png, c.channels);
+            if (std::string(c.format) == "B8G8R8") {
+                for (std::size_t i = 0; i + 2 < pixels.size(); i += 3) {
+                    std::swap(pixels[i], pixels[i + 2]);
+                }
+            }
+            HAKO_TEST_EXPECT(pixels == frame.data, std::string("PNG round trip failed for ") + c.format);
+        }
+    }
+}
+
+std::size_t CountFiles(const std::filesystem::path& directory)
+{
+    std::size_t count = 0;
+    if (std::filesystem::exists(directory)) {
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            count += entry.is_regular_file() ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+void TestRecorder()
+{
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / ("image_frame_recorder_test_" +
+                                                    std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::remove_all(directory);
+
+    ImageFrameRecorder recorder;
+    ImageFrameRecorderConfig config {};
+    config.directory = directory;
+    config.queue_capacity = 64;
+    HAKO_TEST_EXPECT(recorder.Start(config), "recorder should start");
+    HAKO_TEST_EXPECT(!recorder.Start(config), "recorder should not start twice");
+
+    const ImageFrame color = MakeImageFrame(64, 48, "R8G8B8", "camera", 1.0, MakePattern(64, 48, 3));
+    const ImageFrame mono = MakeImageFrame(64, 48, "L8", "camera", 1.0, MakePattern(64, 48, 1));
+    for (int i = 0; i < 5; ++i) {
+        HAKO_TEST_EXPECT(recorder.Submit("color", color), "frame should be queued");
+        HAKO_TEST_EXPECT(recorder.Submit("mono", mono), "frame should be queued");
+    }
+    recorder.Stop();
+    auto stats = recorder.GetStats();
+    HAKO_TEST_EXPECT(stats.submitted == 10 && stats.written == 10, "Stop should write every queued frame");
+    HAKO_TEST_EXPECT(stats.dropped == 0 && stats.failed == 0, "no frame should be dropped or fail");
+    HAKO_TEST_EXPECT(stats.bytes_written > 0, "bytes should be counted");
+    HAKO_TEST_EXPECT(CountFiles(directory / "color") == 5 && CountFiles(directory / "mono") == 5,
+                     "one file per recorded frame");
+    HAKO_TEST_EXPECT(std::filesystem::exists(directory / "color" / "000004.png"), "unexpected file name");
+
+    std::vector<std::uint8_t> png;
+    HAKO_TEST_EXPECT(EncodeImageFrameToPng(mono, png), "PNG encode failed");
+    HAKO_TEST_EXPECT(std::filesystem::file_size(directory / "mono" / "000000.png") == png.size(),
+                     "recorded file should match the encoder output");
+    HAKO_TEST_EXPECT(!recorder.Submit("color", color), "Submit after Stop should fail");
+
+    // A one-slot queue fed faster than the writer encodes must drop frames.
+    std::filesystem::remove_all(directory);
+    config.queue_capacity = 1;
+    config.compression_level = 9;
+    HAKO_TEST_EXPECT(recorder.Start(config), "recorder should restart");
+    const ImageFrame large = MakeImageFrame(320, 240, "R8G8B8", "camera", 2.0, MakePattern(320, 240, 3));
+    for (int i = 0; i < 20; ++i) {
+        recorder.Submit("burst", large);
+    }
+    recorder.Stop();
+    stats = recorder.GetStats();
+    HAKO_TEST_EXPECT(stats.submitted == 20, "unexpected submitted count");
+    HAKO_TEST_EXPECT(stats.dropped > 0, "a full queue should drop frames");
+    HAKO_TEST_EXPECT(stats.written + stats.dropped == 20, "every frame should be written or dropped");
+    HAKO_TEST_EXPECT(CountFiles(directory / "burst") == stats.written, "one file per written frame");
+
+    // Pooled frames are queued by reference and return to the pool once written.
+    std::filesystem::remove_all(directory);
+    config.queue_capacity = 4;
+    config.compression_level = kDefaultPngCompressionLevel;
+    HAKO_TEST_EXPECT(recorder.Start(config), "recorder should restart");
+    ImageFramePool pool;
+    {
+        PooledImageFrame frame = pool.Acquire(64, 48, "R8G8B8");
+        *frame = color;
+        HAKO_TEST_EXPECT(recorder.Submit("pooled", frame), "pooled frame should be queued");
+        HAKO_TEST_EXPECT(frame.UseCount() == 2, "the recorder should hold a reference, not a copy");
+    }
+    HAKO_TEST_EXPECT(!recorder.Submit("pooled", PooledImageFrame {}), "an empty handle should be rejected");
+    for (const char* stream : {"", "..", "../escape", "nested/stream", "nested\\stream", "C:stream"}) {
+        HAKO_TEST_EXPECT(!recorder.Submit(stream, color), "a stream name that is not a plain directory should be rejected");
+    }
+    recorder.Stop();
+    stats = recorder.GetStats();
+    HAKO_TEST_EXPECT(stats.written == 1 && pool.GetStats().live == 0, "the written frame should return to the pool");
+    HAKO_TEST_EXPECT(stats.submitted == 1, "rejected stream names should not be counted");
+    HAKO_TEST_EXPECT(!std::filesystem::exists(directory.parent_path() / "escape"), "nothing should be written outside the directory");
+    std::vector<std::uint8_t> color_png;
+    HAKO_TEST_EXPECT(EncodeImageFrameToPng(color, color_png), "PNG encode failed");
+    HAKO_TEST_EXPECT(std::filesystem::file_size(directory / "pooled" / "000000.png") == color_png.size(),
+                     "a pooled frame should record like a plain one");
+
+    std::filesystem::remove_all(directory);
+}
+}
+
+int main()
+{
+    try {
+        TestChecksums();
+        TestZlibRoundTrip();
+        TestPngRoundTrip();
+        TestRecorder();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "image_frame_writer_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
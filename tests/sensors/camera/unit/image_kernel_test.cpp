@@ -0,0 +1,185 @@
+#include "sensors/camera/camera_encoding_utils.hpp"
+#include "sensors/camera/image_kernels.hpp"
+#include "sensors/common/simd.hpp"
+#include "tests/sensors/camera/support/camera_test_utils.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+using hako::robots::sensor::camera::CameraConfig;
+using hako::robots::sensor::camera::ConvertRgbRow;
+using hako::robots::sensor::camera::ImageFrame;
+using hako::robots::sensor::camera::PixelFormat;
+using hako::robots::sensor::camera::PixelFormatBytesPerPixel;
+using hako::robots::sensor::camera::RGBAColor;
+using hako::robots::sensor::camera::SumInterleavedBytes;
+using hako::robots::sensor::camera::test::MakeImageFrame;
+using hako::robots::sensor::camera::test::NearlyEqual;
+namespace detail = hako::robots::sensor::camera::detail;
+
+std::vector<std::uint8_t> RandomBytes(std::size_t size, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<std::uint8_t> data(size);
+    for (auto& value : data) {
+        value = static_cast<std::uint8_t>(byte(rng));
+    }
+    return data;
+}
+
+// Widths around every vector step (10, 16, 32 pixels) so that both the
+// vector bodies and the scalar tails run.
+void TestRowConversionMatchesScalar()
+{
+    const PixelFormat formats[] = {
+        PixelFormat::Rgb8, PixelFormat::Bgr8, PixelFormat::Mono8, PixelFormat::Rgba8, PixelFormat::Yuv422};
+    for (int width = 1; width <= 100; ++width) {
+        const auto rgb = RandomBytes(static_cast<std::size_t>(width) * 3, static_cast<unsigned>(width));
+        for (PixelFormat format : formats) {
+            if (format == PixelFormat::Yuv422 && width % 2 != 0) {
+                continue;
+            }
+            const std::size_t size = static_cast<std::size_t>(width) * PixelFormatBytesPerPixel(format);
+            // A guard byte past the row must survive the vector stores.
+            std::vector<std::uint8_t> dispatched(size + 1, 0xA5);
+            std::vector<std::uint8_t> scalar(size + 1, 0xA5);
+            ConvertRgbRow(rgb.data(), width, format, dispatched.data());
+            detail::ConvertRgbRowScalar(rgb.data(), width, format, scalar.data());
+            HAKO_TEST_EXPECT(dispatched == scalar, "dispatched row conversion differs from scalar");
+            HAKO_TEST_EXPECT(dispatched[size] == 0xA5, "row conversion wrote past the row");
+
+            for (int x = 0; x < width; ++x) {
+                const std::uint8_t* px = rgb.data() + 3 * x;
+                if (format == PixelFormat::Bgr8) {
+                    HAKO_TEST_EXPECT(scalar[3 * x] == px[2] && scalar[3 * x + 2] == px[0], "B8G8R8 should swap R and B");
+                } else if (format == PixelFormat::Mono8) {
+                    // Fixed point against the former double formula.
+                    const double legacy = 0.299 * px[0] + 0.587 * px[1] + 0.114 * px[2];
+                    HAKO_TEST_EXPECT(std::abs(scalar[x] - legacy) <= 1.0, "L8 luma differs from BT.601");
+                } else if (format == PixelFormat::Rgba8) {
+                    HAKO_TEST_EXPECT(
+                        scalar[4 * x] == px[0] && scalar[4 * x + 2] == px[2] && scalar[4 * x + 3] == 255,
+                        "R8G8B8A8 should copy RGB and set alpha 255");
+                }
+            }
+        }
+    }
+}
+
+void TestYuv422KnownColors()
+{
+    struct Case
+    {
+        std::uint8_t rgb[3];
+        std::uint8_t uyvy[4];
+    };
+    // BT.601 video range references.
+    const Case cases[] = {
+        {{0, 0, 0}, {128, 16, 128, 16}},
+        {{255, 255, 255}, {128, 235, 128, 235}},
+        {{255, 0, 0}, {90, 82, 240, 82}},
+        {{0, 0, 255}, {240, 41, 110, 41}},
+    };
+    for (const auto& c : cases) {
+        const std::uint8_t pair[6] = {c.rgb[0], c.rgb[1], c.rgb[2], c.rgb[0], c.rgb[1], c.rgb[2]};
+        std::uint8_t out[4] = {};
+        ConvertRgbRow(pair, 2, PixelFormat::Yuv422, out);
+        for (int i = 0; i < 4; ++i) {
+            HAKO_TEST_EXPECT(std::abs(out[i] - c.uyvy[i]) <= 1, "unexpected UYVY value");
+        }
+    }
+
+    // Encoding needs an even width.
+    CameraConfig config;
+    config.image.format = "YUV422";
+    const auto rgb = RandomBytes(3 * 3 * 2, 5);
+    ImageFrame frame;
+    HAKO_TEST_EXPECT(
+        !hako::robots::sensor::camera::EncodeImageRows(rgb.data(), 3, 2, false, 0.0, config, frame),
+        "odd width YUV422 should fail");
+    HAKO_TEST_EXPECT(
+        hako::robots::sensor::camera::EncodeImageRows(rgb.data(), 2, 3, true, 0.0, config, frame),
+        "even width YUV422 should encode");
+    HAKO_TEST_EXPECT(frame.channels == 2 && frame.data.size() == 12U, "unexpected YUV422 frame size");
+}
+
+void TestSumsMatchScalar()
+{
+    const auto data = RandomBytes(4 * 300 + 1, 11);
+    for (int stride = 1; stride <= 4; ++stride) {
+        for (std::size_t groups : {0U, 1U, 7U, 31U, 32U, 33U, 95U, 257U, 300U}) {
+            std::uint64_t dispatched[4] = {1, 2, 3, 4};
+            std::uint64_t scalar[4] = {1, 2, 3, 4};
+            SumInterleavedBytes(data.data() + 1, groups, stride, dispatched);
+            detail::SumInterleavedBytesScalar(data.data() + 1, groups, stride, scalar);
+            for (int c = 0; c < 4; ++c) {
+                HAKO_TEST_EXPECT(dispatched[c] == scalar[c], "dispatched sums differ from scalar");
+            }
+        }
+    }
+}
+
+void TestRegionAverageForNewFormats()
+{
+    // 4x2 R8G8B8A8 with a constant left half and a constant right half.
+    std::vector<std::uint8_t> rgba;
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            const std::uint8_t v = x < 2 ? 0 : 255;
+            rgba.insert(rgba.end(), {v, 51, static_cast<std::uint8_t>(255 - v), 255});
+        }
+    }
+    const ImageFrame rgba_frame = MakeImageFrame(4, 2, "R8G8B8A8", "cam", 0.0, rgba);
+    RGBAColor color;
+    HAKO_TEST_EXPECT(
+        hako::robots::sensor::camera::TryExtractAverageRGBAColor(rgba_frame, color, 1, 0, 2, 2),
+        "R8G8B8A8 average should succeed");
+    HAKO_TEST_EXPECT(NearlyEqual(color.r, 0.5F, 1.0e-6F) && NearlyEqual(color.g, 0.2F, 1.0e-6F), "unexpected RGBA average");
+    HAKO_TEST_EXPECT(NearlyEqual(color.a, 1.0F, 1.0e-6F), "unexpected RGBA alpha");
+
+    // A uniform grey YUV422 frame decodes to the same grey everywhere.
+    std::vector<std::uint8_t> uyvy;
+    for (int i = 0; i < 4; ++i) {
+        uyvy.insert(uyvy.end(), {128, 126, 128, 126});
+    }
+    const ImageFrame yuv_frame = MakeImageFrame(4, 2, "YUV422", "cam", 0.0, uyvy);
+    HAKO_TEST_EXPECT(
+        hako::robots::sensor::camera::TryExtractAverageRGBAColor(yuv_frame, color, 1, 0, 2, 2),
+        "YUV422 average should succeed");
+    const float expected = 1.164F * (126 - 16) / 255.0F;
+    HAKO_TEST_EXPECT(
+        NearlyEqual(color.r, expected, 1.0e-3F) && NearlyEqual(color.g, expected, 1.0e-3F) &&
+            NearlyEqual(color.b, expected, 1.0e-3F),
+        "unexpected YUV422 average");
+    HAKO_TEST_EXPECT(
+        hako::robots::sensor::camera::TryExtractRGBAColor(yuv_frame, color, 3, 1),
+        "YUV422 pixel should decode");
+    HAKO_TEST_EXPECT(NearlyEqual(color.g, expected, 1.0e-3F), "unexpected YUV422 pixel");
+}
+}
+
+int main()
+{
+    try {
+        std::cout << "image kernels: " << hako::robots::sensor::common::SimdIsaName() << std::endl;
+        TestRowConversionMatchesScalar();
+        TestYuv422KnownColors();
+        TestSumsMatchScalar();
+        TestRegionAverageForNewFormats();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "image_kernel_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+#include "sensors/camera/render_context.hpp"
+#include "tests/sensors/camera/support/camera_test_utils.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+using hako::robots::sensor::camera::CreateRenderContext;
+using hako::robots::sensor::camera::DefaultRenderBackend;
+using hako::robots::sensor::camera::IsRenderBackendAvailable;
+using hako::robots::sensor::camera::ParseRenderBackend;
+using hako::robots::sensor::camera::RenderBackend;
+using hako::robots::sensor::camera::RenderBackendName;
+
+void SetBackendEnv(const char* value)
+{
+#if defined(_WIN32)
+    _putenv_s("HAKO_RENDER_BACKEND", value);
+#else
+    setenv("HAKO_RENDER_BACKEND", value, 1);
+#endif
+}
+
+void TestParseRoundTrip()
+{
+    for (RenderBackend backend : {RenderBackend::Glfw, RenderBackend::Egl, RenderBackend::Osmesa}) {
+        RenderBackend parsed = RenderBackend::Glfw;
+        HAKO_TEST_EXPECT(ParseRenderBackend(RenderBackendName(backend), parsed), "backend name should parse");
+        HAKO_TEST_EXPECT(parsed == backend, "backend name should round-trip");
+    }
+    RenderBackend parsed = RenderBackend::Egl;
+    HAKO_TEST_EXPECT(!ParseRenderBackend("vulkan", parsed), "unknown backend should be rejected");
+    HAKO_TEST_EXPECT(parsed == RenderBackend::Egl, "rejected name should leave out unchanged");
+    HAKO_TEST_EXPECT(IsRenderBackendAvailable(RenderBackend::Glfw), "GLFW backend is always built");
+}
+
+// The environment overrides the build default only with a built-in backend.
+void TestEnvironmentOverride()
+{
+    SetBackendEnv("");
+    const RenderBackend build_default = DefaultRenderBackend();
+
+    SetBackendEnv("glfw");
+    HAKO_TEST_EXPECT(DefaultRenderBackend() == RenderBackend::Glfw, "HAKO_RENDER_BACKEND=glfw should select GLFW");
+
+    SetBackendEnv("not-a-backend");
+    HAKO_TEST_EXPECT(DefaultRenderBackend() == build_default, "unknown value should fall back to the build default");
+
+    for (RenderBackend backend : {RenderBackend::Egl, RenderBackend::Osmesa}) {
+        SetBackendEnv(RenderBackendName(backend));
+        const RenderBackend expected = IsRenderBackendAvailable(backend) ? backend : build_default;
+        HAKO_TEST_EXPECT(DefaultRenderBackend() == expected, "unexpected backend for HAKO_RENDER_BACKEND");
+        if (!IsRenderBackendAvailable(backend)) {
+            bool threw = false;
+            try {
+                CreateRenderContext(backend);
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            HAKO_TEST_EXPECT(threw, "creating a backend that is not built in should throw");
+        }
+    }
+    SetBackendEnv("");
+}
+}
+
+int main()
+{
+    try {
+        TestParseRoundTrip();
+        TestEnvironmentOverride();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "render_backend_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
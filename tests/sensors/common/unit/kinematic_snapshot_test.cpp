@@ -0,0 +1,218 @@
+#include "physics/physics_impl.hpp"
+#include "sensors/common/kinematic_snapshot.hpp"
+#include "sensors/common/snapshot_sensor_worker.hpp"
+#include "sensors/common/spsc_ring.hpp"
+#include "sensors/lidar/lidar_2d_sensor.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <mujoco/mujoco.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using hako::robots::physics::impl::SnapshotWorldImpl;
+using hako::robots::physics::impl::WorldImpl;
+using hako::robots::sensor::common::KinematicSnapshot;
+using hako::robots::sensor::common::SnapshotSensorWorker;
+using hako::robots::sensor::common::SpscRing;
+using hako::robots::sensor::lidar::LaserScanFrame;
+using hako::robots::sensor::lidar::LiDAR2DSensor;
+using hako::robots::sensor::test::RepoRoot;
+
+std::filesystem::path WriteLidarConfig()
+{
+    const auto path = std::filesystem::temp_directory_path() / "hako_kinematic_snapshot_lidar.json";
+    std::ofstream ofs(path);
+    if (!ofs) {
+        throw std::runtime_error("failed to write LiDAR config: " + path.string());
+    }
+    ofs << R"({
+  "spec": {
+    "type": "lidar_2d",
+    "name": "snapshot_lidar",
+    "frame_id": "laser",
+    "DetectionDistance": { "Min": 120, "Max": 8000 },
+    "DistanceAccuracy": [],
+    "AngleRange": {
+      "Min": -180.0,
+      "Max": 180.0,
+      "AscendingOrderOfData": false,
+      "Resolution": 1.0,
+      "ScanFrequency": 5
+    }
+  },
+  "mjcf_binding": {
+    "source_body": "base_scan",
+    "exclude_body": "base_footprint"
+  },
+  "pdu_config": {
+    "pdu_name": "snapshot_lidar",
+    "update_rate_hz": 5.0,
+    "message_type": "sensor_msgs/LaserScan"
+  }
+})";
+    return path;
+}
+
+void TestSpscRingWrapsAndFills()
+{
+    SpscRing<int, 2> ring;
+    HAKO_TEST_EXPECT(ring.ReadSlot() == nullptr, "new ring should be empty");
+    for (int round = 0; round < 5; ++round) {
+        *ring.WriteSlot() = round;
+        ring.CommitWrite();
+        *ring.WriteSlot() = round + 100;
+        ring.CommitWrite();
+        HAKO_TEST_EXPECT(ring.WriteSlot() == nullptr, "ring should be full after two writes");
+        HAKO_TEST_EXPECT(*ring.ReadSlot() == round, "ring should read in FIFO order");
+        ring.CommitRead();
+        HAKO_TEST_EXPECT(*ring.ReadSlot() == round + 100, "ring should read in FIFO order");
+        ring.CommitRead();
+        HAKO_TEST_EXPECT(ring.Size() == 0U, "ring should be empty after two reads");
+    }
+}
+
+// A LiDAR bound to a snapshot world sees the captured state, not the live one.
+void TestSnapshotWorldMatchesCapturedState()
+{
+    auto world = std::make_shared<WorldImpl>();
+    world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+    auto view = std::make_shared<SnapshotWorldImpl>(world);
+    const auto config = WriteLidarConfig().string();
+
+    LiDAR2DSensor live(world);
+    LiDAR2DSensor viewed(view);
+    HAKO_TEST_EXPECT(live.LoadConfig(config), "live LiDAR config should load");
+    HAKO_TEST_EXPECT(viewed.LoadConfig(config), "snapshot LiDAR config should load");
+
+    // Knock the robot off its start pose so that later steps keep moving it.
+    mjModel* model = world->getModel();
+    mjData* data = world->getData();
+    data->qvel[0] = 0.5;
+    data->qvel[5] = 1.0;
+    for (int step = 0; step < 50; ++step) {
+        world->advanceTimeStep();
+    }
+
+    KinematicSnapshot snapshot;
+    snapshot.Capture(model, data);
+    HAKO_TEST_EXPECT(snapshot.ApplyTo(model, view->getData()), "snapshot should apply to its own model");
+
+    LaserScanFrame expected {};
+    LaserScanFrame actual {};
+    live.Scan(expected);
+    viewed.Scan(actual);
+    HAKO_TEST_EXPECT(actual.ranges == expected.ranges, "snapshot scan should match the live scan it was taken from");
+
+    for (int step = 0; step < 200; ++step) {
+        world->advanceTimeStep();
+    }
+    LaserScanFrame later {};
+    viewed.Scan(later);
+    HAKO_TEST_EXPECT(later.ranges == expected.ranges, "live steps must not change the snapshot");
+    HAKO_TEST_EXPECT(view->getData()->time != data->time, "live time should have moved on");
+}
+
+// Camera poses travel with the snapshot, and a view may own a model copy
+// that the renderer can modify without touching the live model.
+void TestSnapshotCarriesCameraPoses()
+{
+    auto world = std::make_shared<WorldImpl>();
+    world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+    auto view = std::make_shared<SnapshotWorldImpl>(world, true);
+    mjModel* model = world->getModel();
+    mjData* data = world->getData();
+    HAKO_TEST_EXPECT(view->getModel() != model, "copy_model should give the view its own model");
+    HAKO_TEST_EXPECT(view->getModel()->ncam == model->ncam && model->ncam > 0, "model copy should keep the cameras");
+
+    data->qvel[0] = 0.5;
+    for (int step = 0; step < 50; ++step) {
+        world->advanceTimeStep();
+    }
+    KinematicSnapshot snapshot;
+    snapshot.Capture(model, data);
+    HAKO_TEST_EXPECT(snapshot.ApplyTo(view->getModel(), view->getData()), "snapshot should apply to the model copy");
+    for (int i = 0; i < 3 * model->ncam; ++i) {
+        HAKO_TEST_EXPECT(view->getData()->cam_xpos[i] == data->cam_xpos[i], "camera position should be copied");
+    }
+    for (int i = 0; i < 9 * model->ncam; ++i) {
+        HAKO_TEST_EXPECT(view->getData()->cam_xmat[i] == data->cam_xmat[i], "camera orientation should be copied");
+    }
+
+    const mjtNum live_fovy = model->cam_fovy[0];
+    view->getModel()->cam_fovy[0] = live_fovy + 10.0;
+    HAKO_TEST_EXPECT(model->cam_fovy[0] == live_fovy, "writes to the model copy must not reach the live model");
+}
+
+// The worker evaluates each published snapshot on its own thread.
+void TestWorkerEvaluatesPublishedSnapshots()
+{
+    auto world = std::make_shared<WorldImpl>();
+    world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+    auto view = std::make_shared<SnapshotWorldImpl>(world);
+
+    std::atomic<int> evaluated {0};
+    std::vector<double> deltas;
+    std::vector<double> stamps;
+    SnapshotSensorWorker worker;
+    HAKO_TEST_EXPECT(
+        worker.Start(world->getModel(), view->getData(), [&](double delta_sec, double stamp_sec) {
+            deltas.push_back(delta_sec);
+            stamps.push_back(stamp_sec);
+            evaluated.fetch_add(1);
+        }),
+        "worker should start");
+
+    constexpr int kSnapshots = 20;
+    for (int i = 0; i < kSnapshots; ++i) {
+        world->advanceTimeStep();
+        HAKO_TEST_EXPECT(worker.Publish(world->getData(), 0.001 * (i + 1)), "publish should find a free slot");
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (evaluated.load() <= i) {
+            HAKO_TEST_EXPECT(std::chrono::steady_clock::now() < deadline, "worker did not evaluate the snapshot");
+            std::this_thread::yield();
+        }
+    }
+    worker.Stop();
+
+    const auto stats = worker.GetStats();
+    HAKO_TEST_EXPECT(stats.published == kSnapshots, "every snapshot should be counted");
+    HAKO_TEST_EXPECT(stats.dropped == 0U, "no snapshot should be dropped when waiting");
+    HAKO_TEST_EXPECT(stats.evaluated == kSnapshots, "every snapshot should be evaluated");
+    HAKO_TEST_EXPECT(stamps.size() == static_cast<std::size_t>(kSnapshots), "unexpected evaluate count");
+    const double timestep = world->getModel()->opt.timestep;
+    for (std::size_t i = 0; i < deltas.size(); ++i) {
+        HAKO_TEST_EXPECT(std::abs(deltas[i] - timestep) < 1.0e-12, "delta should be one physics step");
+        HAKO_TEST_EXPECT(stamps[i] == 0.001 * static_cast<double>(i + 1), "stamps should arrive in order");
+    }
+    HAKO_TEST_EXPECT(view->getData()->time == world->getData()->time, "view should hold the last snapshot");
+}
+}
+
+int main()
+{
+    try {
+        TestSpscRingWrapsAndFills();
+        TestSnapshotWorldMatchesCapturedState();
+        TestSnapshotCarriesCameraPoses();
+        TestWorkerEvaluatesPublishedSnapshots();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "kinematic_snapshot_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
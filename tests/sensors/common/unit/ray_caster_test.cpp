@@ -0,0 +1,124 @@
+#include "physics/physics_impl.hpp"
+#include "sensors/common/ray_caster.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <mujoco/mujoco.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+using hako::robots::sensor::common::RayCaster;
+using hako::robots::sensor::test::NearlyEqual;
+using hako::robots::sensor::test::RepoRoot;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr mjtNum kMaxDistance = 8.0;
+
+bool IsInSubtree(const mjModel* model, int root_body, int geom_id)
+{
+    int body_id = model->geom_bodyid[geom_id];
+    while (body_id > 0 && body_id != root_body) {
+        body_id = model->body_parentid[body_id];
+    }
+    return body_id == root_body;
+}
+
+// The re-casting loop the LiDAR sensor used before RayCaster existed.
+mjtNum LegacyCast(const mjModel* model, const mjData* data, int root_body, const mjtNum* pos, const mjtNum* dir)
+{
+    mjtNum origin[3] = {pos[0], pos[1], pos[2]};
+    mjtNum traveled = 0.0;
+    for (int attempt = 0; attempt < 16; ++attempt) {
+        int geom_id = -1;
+        mjtNum normal[3] = {0.0, 0.0, 0.0};
+        const mjtNum hit = mj_ray(model, data, origin, dir, nullptr, 1, -1, &geom_id, normal);
+        if (hit < 0.0) {
+            return -1.0;
+        }
+        if (!IsInSubtree(model, root_body, geom_id)) {
+            return (traveled + hit < kMaxDistance) ? traveled + hit : -1.0;
+        }
+        const mjtNum step = hit + 1.0e-4;
+        traveled += step;
+        origin[0] += dir[0] * step;
+        origin[1] += dir[1] * step;
+        origin[2] += dir[2] * step;
+    }
+    return -1.0;
+}
+
+void TestSelfSubtreeIsIgnored()
+{
+    auto world = std::make_shared<hako::robots::physics::impl::WorldImpl>();
+    world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+    const auto* model = world->getModel();
+    const auto* data = world->getData();
+
+    const int root_body = mj_name2id(model, mjOBJ_BODY, "base_footprint");
+    const int scan_body = mj_name2id(model, mjOBJ_BODY, "base_scan");
+    HAKO_TEST_EXPECT(root_body >= 0 && scan_body >= 0, "TB3 bodies should exist");
+
+    RayCaster caster;
+    caster.Configure(model, root_body, scan_body);
+    HAKO_TEST_EXPECT(caster.Filter() == RayCaster::SelfFilter::Mask, "TB3 shares geom group 0 with the scene");
+
+    for (int geom_id = 0; geom_id < model->ngeom; ++geom_id) {
+        HAKO_TEST_EXPECT(
+            caster.IsSelfGeom(geom_id) == IsInSubtree(model, root_body, geom_id),
+            "self geom mask should match the body subtree");
+    }
+
+    const mjtNum* pos = &data->xpos[3 * scan_body];
+    int hits = 0;
+    for (int i = 0; i < 360; ++i) {
+        const double yaw = static_cast<double>(i) * kPi / 180.0;
+        const mjtNum dir[3] = {std::cos(yaw), std::sin(yaw), 0.0};
+        int geom_id = -1;
+        const mjtNum actual = caster.Cast(model, data, pos, dir, kMaxDistance, &geom_id);
+        const mjtNum expected = LegacyCast(model, data, root_body, pos, dir);
+        HAKO_TEST_EXPECT((actual < 0.0) == (expected < 0.0), "hit/no-hit should match the legacy loop");
+        if (actual >= 0.0) {
+            ++hits;
+            HAKO_TEST_EXPECT(NearlyEqual(actual, expected, 1.0e-6), "hit distance should match the legacy loop");
+            HAKO_TEST_EXPECT(!caster.IsSelfGeom(geom_id), "reported geom should not belong to the robot");
+        }
+    }
+    HAKO_TEST_EXPECT(hits > 0, "scan should hit scene obstacles");
+
+    caster.Configure(model, -1);
+    HAKO_TEST_EXPECT(caster.Filter() == RayCaster::SelfFilter::None, "no exclude body should disable filtering");
+}
+
+void TestSingleBodyUsesBodyExclude()
+{
+    auto world = std::make_shared<hako::robots::physics::impl::WorldImpl>();
+    world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+    const auto* model = world->getModel();
+
+    RayCaster caster;
+    caster.Configure(model, mj_name2id(model, mjOBJ_BODY, "base_scan"));
+    HAKO_TEST_EXPECT(
+        caster.Filter() == RayCaster::SelfFilter::BodyExclude,
+        "a leaf body with geoms should map to mj_ray bodyexclude");
+}
+}
+
+int main()
+{
+    try {
+        TestSelfSubtreeIsIgnored();
+        TestSingleBodyUsesBodyExclude();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "ray_caster_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+#include "physics/physics_impl.hpp"
+#include "sensors/common/sensor_group.hpp"
+#include "sensors/common/update_scheduler.hpp"
+#include "sensors/lidar/lidar_2d_sensor.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <mujoco/mujoco.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+using hako::robots::sensor::common::SensorGroup;
+using hako::robots::sensor::common::UpdateScheduler;
+using hako::robots::sensor::lidar::LaserScanFrame;
+using hako::robots::sensor::lidar::LiDAR2DSensor;
+using hako::robots::sensor::test::RepoRoot;
+
+// The group must fire each entry on exactly the steps a StartReady()
+// UpdateScheduler with the same period would.
+void TestScheduleMatchesUpdateScheduler()
+{
+    const std::vector<double> periods {0.0, 0.001, 0.004, 0.01, 0.033, 0.2};
+    constexpr double kStep = 0.001;
+    constexpr int kSteps = 2000;
+
+    SensorGroup group;
+    std::vector<UpdateScheduler> schedulers(periods.size());
+    std::vector<int> calls(periods.size(), 0);
+    for (std::size_t i = 0; i < periods.size(); ++i) {
+        schedulers[i].StartReady(periods[i]);
+        group.Add(periods[i], [&calls, i]() { ++calls[i]; });
+    }
+
+    for (int step = 0; step < kSteps; ++step) {
+        group.Step(kStep);
+        for (std::size_t i = 0; i < periods.size(); ++i) {
+            const bool expected = schedulers[i].ShouldUpdate(kStep, periods[i]);
+            HAKO_TEST_EXPECT(
+                group.WasDue(static_cast<int>(i)) == expected,
+                "entry " + std::to_string(i) + " disagrees with UpdateScheduler at step " + std::to_string(step));
+        }
+    }
+    HAKO_TEST_EXPECT(calls[0] == kSteps, "period 0 should fire every step");
+    // Due on the first step, then every period: t = 0.001, 0.01, 0.02, ..., 2.0.
+    HAKO_TEST_EXPECT(calls[3] == 201, "10 ms entry should fire 201 times in 2 s");
+    HAKO_TEST_EXPECT(calls[5] == 11, "200 ms entry should fire 11 times in 2 s");
+
+    // Steps longer than a period fire once per step and keep the backlog.
+    SensorGroup slow;
+    UpdateScheduler scheduler;
+    scheduler.StartReady(0.01);
+    const int index = slow.Add(0.01, nullptr);
+    for (int step = 0; step < 50; ++step) {
+        slow.Step(0.025);
+        HAKO_TEST_EXPECT(
+            slow.WasDue(index) == scheduler.ShouldUpdate(0.025, 0.01),
+            "late entry disagrees with UpdateScheduler at step " + std::to_string(step));
+    }
+
+    group.Reset();
+    HAKO_TEST_EXPECT(group.NextDueSec() == 0.0, "every entry should be due after Reset()");
+}
+
+std::filesystem::path WriteLidarConfig(const std::string& name, double resolution_deg)
+{
+    const auto path = std::filesystem::temp_directory_path() / ("hako_sensor_group_" + name + ".json");
+    std::ofstream ofs(path);
+    if (!ofs) {
+        throw std::runtime_error("failed to write LiDAR config: " + path.string());
+    }
+    ofs << R"({
+  "spec": {
+    "type": "lidar_2d",
+    "name": ")" << name << R"(",
+    "frame_id": "laser",
+    "DetectionDistance": { "Min": 120, "Max": 8000 },
+    "DistanceAccuracy": [],
+    "AngleRange": {
+      "Min": -180.0,
+      "Max": 180.0,
+      "AscendingOrderOfData": false,
+      "Resolution": )" << resolution_deg << R"(,
+      "ScanFrequency": 5
+    }
+  },
+  "mjcf_binding": {
+    "source_body": "base_scan",
+    "exclude_body": "base_footprint"
+  },
+  "pdu_config": {
+    "pdu_name": ")" << name << R"(",
+    "update_rate_hz": 5.0,
+    "message_type": "sensor_msgs/LaserScan"
+  }
+})";
+    return path;
+}
+
+// Two LiDARs cast in one shared, multithreaded ray pass must produce the
+// same frames as their own Scan().
+void TestSharedRayPassMatchesScan()
+{
+    auto world = std::make_shared<hako::robots::physics::impl::WorldImpl>();
+    world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+
+    LiDAR2DSensor fine(world);
+    LiDAR2DSensor coarse(world);
+    HAKO_TEST_EXPECT(fine.LoadConfig(WriteLidarConfig("fine", 0.25).string()), "fine LiDAR config should load");
+    HAKO_TEST_EXPECT(coarse.LoadConfig(WriteLidarConfig("coarse", 1.0).string()), "coarse LiDAR config should load");
+
+    LaserScanFrame fine_expected {};
+    LaserScanFrame coarse_expected {};
+    fine.Scan(fine_expected);
+    coarse.Scan(coarse_expected);
+    HAKO_TEST_EXPECT(fine_expected.ranges.size() == 1440U, "unexpected fine beam count");
+    HAKO_TEST_EXPECT(coarse_expected.ranges.size() == 360U, "unexpected coarse beam count");
+
+    // Small chunks so that chunks straddle the two sensors.
+    SensorGroup group(4, 7);
+    LaserScanFrame fine_frame {};
+    LaserScanFrame coarse_frame {};
+    int fine_calls = 0;
+    group.Add(fine, [&]() { fine.FinishRayBatch(fine_frame); ++fine_calls; }, &fine);
+    group.Add(coarse, [&]() { coarse.FinishRayBatch(coarse_frame); }, &coarse);
+
+    HAKO_TEST_EXPECT(group.Step(0.001) == 2U, "both LiDARs should be due on the first step");
+    HAKO_TEST_EXPECT(fine_frame.ranges == fine_expected.ranges, "batched fine scan should match Scan()");
+    HAKO_TEST_EXPECT(coarse_frame.ranges == coarse_expected.ranges, "batched coarse scan should match Scan()");
+
+    for (int step = 1; step < 400; ++step) {
+        group.Step(0.001);
+    }
+    // Fired at t = 0.001 (first step), 0.2 and 0.4.
+    HAKO_TEST_EXPECT(fine_calls == 3, "5 Hz LiDAR should fire three times in 0.4 s");
+}
+}
+
+int main()
+{
+    try {
+        TestScheduleMatchesUpdateScheduler();
+        TestSharedRayPassMatchesScan();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "sensor_group_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
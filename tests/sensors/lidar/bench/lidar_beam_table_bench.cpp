@@ -0,0 +1,167 @@
+#include "physics/physics_impl.hpp"
+#include "sensors/lidar/lidar_2d_sensor.hpp"
+#include "sensors/lidar/lidar_beam_table.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <mujoco/mujoco.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Per-scan cost of the LiDAR beam setup before and after the precomputed
+// beam table, plus the resulting full Scan() cost on the TB3 sample world.
+//
+// "legacy" reproduces what Scan() used to do for every beam: two
+// mj_name2id lookups per scan, then a deg->rad conversion and cos/sin per
+// beam. "table" is the current path: a rotation of the prebuilt table.
+
+namespace
+{
+using hako::robots::sensor::lidar::LaserScanFrame;
+using hako::robots::sensor::lidar::LiDAR2DSensor;
+using hako::robots::sensor::lidar::LiDARBeamTable;
+using hako::robots::sensor::test::RepoRoot;
+using Clock = std::chrono::steady_clock;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr int kDirectionIterations = 20000;
+constexpr int kScanIterations = 200;
+
+struct BenchCase
+{
+    const char* label;
+    double resolution_deg;
+};
+
+volatile double g_sink = 0.0;
+
+template <typename Fn>
+double MeasureNsPerIteration(int iterations, Fn&& fn)
+{
+    fn();
+    const auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return elapsed / static_cast<double>(iterations);
+}
+
+std::filesystem::path WriteLidarConfig(double resolution_deg)
+{
+    const auto path = std::filesystem::temp_directory_path()
+        / ("hako_lidar_bench_" + std::to_string(static_cast<int>(360.0 / resolution_deg)) + ".json");
+    std::ofstream ofs(path);
+    if (!ofs) {
+        throw std::runtime_error("failed to write LiDAR config: " + path.string());
+    }
+    ofs << R"({
+  "spec": {
+    "type": "lidar_2d",
+    "name": "bench",
+    "frame_id": "laser",
+    "DetectionDistance": { "Min": 120, "Max": 8000 },
+    "DistanceAccuracy": [],
+    "AngleRange": {
+      "Min": -180.0,
+      "Max": 180.0,
+      "AscendingOrderOfData": false,
+      "Resolution": )" << resolution_deg << R"(,
+      "ScanFrequency": 5
+    }
+  },
+  "mjcf_binding": {
+    "source_body": "base_scan",
+    "exclude_body": "base_footprint"
+  },
+  "pdu_config": {
+    "pdu_name": "laser_scan",
+    "update_rate_hz": 5.0,
+    "message_type": "sensor_msgs/LaserScan"
+  }
+})";
+    return path;
+}
+
+double LegacyDirections(const mjModel* model, int ray_count, double resolution_deg, double base_yaw_rad, double* dir_x, double* dir_y)
+{
+    const int sensor_body_id = mj_name2id(model, mjOBJ_BODY, "base_scan");
+    const int exclude_body_id = mj_name2id(model, mjOBJ_BODY, "base_footprint");
+    double yaw_deg = 180.0;
+    for (int i = 0; i < ray_count; ++i, yaw_deg -= resolution_deg) {
+        const double world_yaw_rad = base_yaw_rad + (yaw_deg + 0.0) * kPi / 180.0;
+        dir_x[i] = std::cos(world_yaw_rad);
+        dir_y[i] = std::sin(world_yaw_rad);
+    }
+    return static_cast<double>(sensor_body_id + exclude_body_id);
+}
+
+void RunCase(const std::shared_ptr<hako::robots::physics::IWorld>& world, const BenchCase& bench)
+{
+    const int ray_count = LiDARBeamTable::RayCount(-180.0, 180.0, bench.resolution_deg);
+    std::vector<double> dir_x(static_cast<size_t>(ray_count));
+    std::vector<double> dir_y(static_cast<size_t>(ray_count));
+    LiDARBeamTable table;
+    table.Build(-180.0, 180.0, bench.resolution_deg, false, 0.0);
+
+    double yaw = 0.0;
+    const double legacy_ns = MeasureNsPerIteration(kDirectionIterations, [&]() {
+        yaw += 1.0e-3;
+        g_sink = g_sink + LegacyDirections(world->getModel(), ray_count, bench.resolution_deg, yaw, dir_x.data(), dir_y.data());
+        g_sink = g_sink + dir_x[static_cast<size_t>(ray_count / 2)];
+    });
+    const double table_ns = MeasureNsPerIteration(kDirectionIterations, [&]() {
+        yaw += 1.0e-3;
+        table.Rotate(yaw, dir_x.data(), dir_y.data());
+        g_sink = g_sink + dir_x[static_cast<size_t>(ray_count / 2)];
+    });
+
+    LiDAR2DSensor sensor(world);
+    if (!sensor.LoadConfig(WriteLidarConfig(bench.resolution_deg).string())) {
+        throw std::runtime_error("failed to load LiDAR bench config");
+    }
+    LaserScanFrame frame {};
+    const double scan_ns = MeasureNsPerIteration(kScanIterations, [&]() {
+        sensor.Scan(frame);
+        g_sink = g_sink + static_cast<double>(frame.ranges.front());
+    });
+
+    std::printf(
+        "%-10s beams=%5d  legacy setup=%9.0f ns  table setup=%9.0f ns  (x%.1f)  full scan=%9.1f us\n",
+        bench.label,
+        ray_count,
+        legacy_ns,
+        table_ns,
+        legacy_ns / table_ns,
+        scan_ns / 1000.0);
+}
+}
+
+int main()
+{
+    try {
+        auto world = std::make_shared<hako::robots::physics::impl::WorldImpl>();
+        world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+
+        const BenchCase cases[] = {
+            {"360-beam", 1.0},
+            {"1440-beam", 0.25},
+        };
+        for (const auto& bench : cases) {
+            RunCase(world, bench);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+#include "hakoniwa/pdu/converter/sensor_msgs/point_cloud2.hpp"
+#include "physics/physics_impl.hpp"
+#include "sensors/lidar/lidar_3d_sensor.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <mujoco/mujoco.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+using hako::robots::sensor::lidar::LiDAR3DSensor;
+using hako::robots::sensor::lidar::PointCloudFrame;
+using hako::robots::sensor::test::RepoRoot;
+
+constexpr int kChannelCount = 16;
+constexpr int kColumnCount = 360;
+constexpr int kLevelChannel = 1;
+
+// VLP-16 style channel table without noise, at 1 degree azimuth steps.
+std::filesystem::path WriteLidarConfig(int threads)
+{
+    const auto path = std::filesystem::temp_directory_path()
+        / ("hako_lidar_3d_scan_" + std::to_string(threads) + ".json");
+    std::ofstream ofs(path);
+    if (!ofs) {
+        throw std::runtime_error("failed to write LiDAR config: " + path.string());
+    }
+    ofs << R"({
+  "spec": {
+    "type": "lidar_3d",
+    "name": "lidar_3d_test",
+    "frame_id": "velodyne",
+    "DetectionDistance": { "Min": 100, "Max": 8000 },
+    "DistanceAccuracy": [],
+    "AngleRange": {
+      "Min": -180.0,
+      "Max": 180.0,
+      "AscendingOrderOfData": true,
+      "Resolution": 1.0,
+      "ScanFrequency": 10
+    },
+    "Channels": [)";
+    const int vertical[kChannelCount] = {-15, 1, -13, 3, -11, 5, -9, 7, -7, 9, -5, 11, -3, 13, -1, 15};
+    for (int i = 0; i < kChannelCount; ++i) {
+        ofs << (i == 0 ? "" : ",") << R"({ "VerticalAngle": )" << vertical[i]
+            << R"(, "FiringTimeOffset": )" << (2.304 * i) << " }";
+    }
+    ofs << R"(],
+    "ScanEngine": { "Threads": )" << threads << R"(, "MinBeamsPerThread": 64 }
+  },
+  "mjcf_binding": {
+    "source_body": "base_scan",
+    "exclude_body": "base_footprint"
+  },
+  "pdu_config": {
+    "pdu_name": "point_cloud",
+    "update_rate_hz": 10.0,
+    "message_type": "sensor_msgs/PointCloud2"
+  }
+})";
+    return path;
+}
+
+float ReadFloat(const PointCloudFrame& frame, int row, int column, std::uint32_t offset)
+{
+    float value = 0.0F;
+    const std::size_t index =
+        static_cast<std::size_t>(row) * frame.row_step +
+        static_cast<std::size_t>(column) * frame.point_step + offset;
+    std::memcpy(&value, frame.data.data() + index, sizeof(value));
+    return value;
+}
+
+PointCloudFrame ScanWithThreads(const std::shared_ptr<hako::robots::physics::IWorld>& world, int threads)
+{
+    LiDAR3DSensor sensor(world);
+    HAKO_TEST_EXPECT(sensor.LoadConfig(WriteLidarConfig(threads).string()), "3D LiDAR config should load");
+    HAKO_TEST_EXPECT(sensor.ChannelCount() == kChannelCount, "unexpected channel count");
+    HAKO_TEST_EXPECT(sensor.ColumnCount() == kColumnCount, "unexpected column count");
+
+    PointCloudFrame frame {};
+    sensor.Scan(frame);
+    return frame;
+}
+
+void TestOrganizedCloudLayout(const PointCloudFrame& frame)
+{
+    HAKO_TEST_EXPECT(frame.frame_id == "velodyne", "unexpected frame_id");
+    HAKO_TEST_EXPECT(frame.height == static_cast<std::uint32_t>(kChannelCount), "height should be the channel count");
+    HAKO_TEST_EXPECT(frame.width == static_cast<std::uint32_t>(kColumnCount), "width should be the column count");
+    HAKO_TEST_EXPECT(frame.point_step == 24U, "unexpected point_step");
+    HAKO_TEST_EXPECT(frame.row_step == frame.point_step * frame.width, "unexpected row_step");
+    HAKO_TEST_EXPECT(frame.data.size() == static_cast<std::size_t>(frame.row_step) * frame.height, "unexpected data size");
+    HAKO_TEST_EXPECT(frame.fields.size() == 6U, "unexpected field count");
+    HAKO_TEST_EXPECT(!frame.is_dense, "organized LiDAR clouds keep no-return slots");
+
+    // Column 180 points along +X; the 1 degree channel hits obstacle_front.
+    const float x = ReadFloat(frame, kLevelChannel, 180, 0);
+    const float y = ReadFloat(frame, kLevelChannel, 180, 4);
+    HAKO_TEST_EXPECT(std::isfinite(x) && x > 0.9F && x < 1.0F, "level channel should hit the front obstacle");
+    HAKO_TEST_EXPECT(std::abs(y) < 0.05F, "front hit should lie on the sensor X axis");
+
+    const float time_first = ReadFloat(frame, 0, 0, 16);
+    const float time_last = ReadFloat(frame, 0, kColumnCount - 1, 16);
+    HAKO_TEST_EXPECT(time_first == 0.0F, "first firing block should start at t=0");
+    HAKO_TEST_EXPECT(time_last > 0.09F && time_last < 0.1F, "last firing block should fire near the sweep end");
+}
+
+void TestPointCloud2Conversion(const PointCloudFrame& frame)
+{
+    HakoCpp_PointCloud2 out {};
+    HAKO_TEST_EXPECT(hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(frame, out), "PointCloud2 conversion should succeed");
+    HAKO_TEST_EXPECT(out.header.frame_id == frame.frame_id, "unexpected PointCloud2 frame_id");
+    HAKO_TEST_EXPECT(out.height == frame.height && out.width == frame.width, "unexpected PointCloud2 size");
+    HAKO_TEST_EXPECT(out.fields.size() == frame.fields.size(), "unexpected PointCloud2 field count");
+    HAKO_TEST_EXPECT(out.fields[5].name == "ring" && out.fields[5].datatype == 4, "unexpected ring field");
+    HAKO_TEST_EXPECT(out.data.size() == frame.data.size(), "unexpected PointCloud2 data size");
+
+    PointCloudFrame broken = frame;
+    broken.data.pop_back();
+    HakoCpp_PointCloud2 rejected {};
+    HAKO_TEST_EXPECT(
+        !hako::robots::pdu::converter::sensor_msgs::ToHakoPdu(broken, rejected),
+        "truncated point data should be rejected");
+}
+
+void TestLidar3DScan()
+{
+    auto world = std::make_shared<hako::robots::physics::impl::WorldImpl>();
+    world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+
+    const auto serial = ScanWithThreads(world, 1);
+    TestOrganizedCloudLayout(serial);
+    TestPointCloud2Conversion(serial);
+
+    const auto parallel = ScanWithThreads(world, 4);
+    HAKO_TEST_EXPECT(parallel.data == serial.data, "parallel sweep should match the serial sweep byte for byte");
+}
+}
+
+int main()
+{
+    try {
+        TestLidar3DScan();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "lidar_3d_scan_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
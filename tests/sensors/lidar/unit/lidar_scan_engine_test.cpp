@@ -0,0 +1,142 @@
+#include "physics/physics_impl.hpp"
+#include "sensors/lidar/lidar_2d_sensor.hpp"
+#include "tests/sensors/support/sensor_test_utils.hpp"
+
+#include <mujoco/mujoco.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+using hako::robots::sensor::lidar::LaserScanFrame;
+using hako::robots::sensor::lidar::LiDAR2DSensor;
+using hako::robots::sensor::test::RepoRoot;
+
+// Noise-free profile so that every beam is a pure function of the scene.
+std::filesystem::path WriteLidarConfig(int threads, const std::string& mode = "full")
+{
+    const auto path = std::filesystem::temp_directory_path()
+        / ("hako_lidar_scan_engine_" + mode + "_" + std::to_string(threads) + ".json");
+    std::ofstream ofs(path);
+    if (!ofs) {
+        throw std::runtime_error("failed to write LiDAR config: " + path.string());
+    }
+    ofs << R"({
+  "spec": {
+    "type": "lidar_2d",
+    "name": "scan_engine_test",
+    "frame_id": "laser",
+    "DetectionDistance": { "Min": 120, "Max": 8000 },
+    "DistanceAccuracy": [],
+    "AngleRange": {
+      "Min": -180.0,
+      "Max": 180.0,
+      "AscendingOrderOfData": false,
+      "Resolution": 0.25,
+      "ScanFrequency": 5
+    },
+    "ScanEngine": { "Threads": )" << threads << R"(, "MinBeamsPerThread": 16, "Mode": ")" << mode << R"(" }
+  },
+  "mjcf_binding": {
+    "source_body": "base_scan",
+    "exclude_body": "base_footprint"
+  },
+  "pdu_config": {
+    "pdu_name": "laser_scan",
+    "update_rate_hz": 5.0,
+    "message_type": "sensor_msgs/LaserScan"
+  }
+})";
+    return path;
+}
+
+LaserScanFrame ScanWithThreads(const std::shared_ptr<hako::robots::physics::IWorld>& world, int threads)
+{
+    LiDAR2DSensor sensor(world);
+    HAKO_TEST_EXPECT(sensor.LoadConfig(WriteLidarConfig(threads).string()), "LiDAR config should load");
+    HAKO_TEST_EXPECT(sensor.GetConfig().scan_engine.threads == threads, "unexpected ScanEngine.Threads");
+
+    LaserScanFrame frame {};
+    sensor.Scan(frame);
+    // Scan twice to make sure reused scratch buffers do not leak state.
+    LaserScanFrame second {};
+    sensor.Scan(second);
+    HAKO_TEST_EXPECT(frame.ranges == second.ranges, "repeated scans should match");
+    return frame;
+}
+
+void TestParallelScanMatchesSerial()
+{
+    auto world = std::make_shared<hako::robots::physics::impl::WorldImpl>();
+    world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+
+    const auto serial = ScanWithThreads(world, 1);
+    HAKO_TEST_EXPECT(serial.ranges.size() == 1440U, "unexpected beam count");
+
+    bool any_hit = false;
+    for (float range : serial.ranges) {
+        any_hit = any_hit || range < serial.range_max;
+    }
+    HAKO_TEST_EXPECT(any_hit, "serial scan should hit at least one obstacle");
+
+    for (int threads : {2, 3, 8}) {
+        const auto parallel = ScanWithThreads(world, threads);
+        HAKO_TEST_EXPECT(
+            parallel.ranges == serial.ranges,
+            "parallel scan with " + std::to_string(threads) + " threads should match the serial scan");
+    }
+}
+
+// A static scene must give the same frame whether the sweep is cast at once
+// or spread over the physics steps of one rotation.
+void TestIncrementalSweepMatchesFullScan()
+{
+    auto world = std::make_shared<hako::robots::physics::impl::WorldImpl>();
+    world->loadModel((RepoRoot() / "models/tb3/turtlebot3_burger_world.xml").string());
+
+    const auto full = ScanWithThreads(world, 1);
+
+    LiDAR2DSensor sensor(world);
+    HAKO_TEST_EXPECT(sensor.LoadConfig(WriteLidarConfig(2, "incremental").string()), "LiDAR config should load");
+    HAKO_TEST_EXPECT(sensor.GetConfig().scan_engine.incremental, "ScanEngine.Mode should be incremental");
+
+    // 5 Hz sweep at a 1 ms step: one frame every 200 steps.
+    constexpr double kStep = 0.001;
+    int frames = 0;
+    int first_frame_step = -1;
+    LaserScanFrame frame {};
+    for (int step = 1; step <= 450; ++step) {
+        if (sensor.Update(kStep, frame)) {
+            ++frames;
+            if (first_frame_step < 0) {
+                first_frame_step = step;
+            }
+            HAKO_TEST_EXPECT(frame.ranges == full.ranges, "incremental sweep should match the full scan");
+        }
+    }
+    HAKO_TEST_EXPECT(frames == 2, "expected two complete sweeps, got " + std::to_string(frames));
+    HAKO_TEST_EXPECT(
+        first_frame_step >= 199 && first_frame_step <= 201,
+        "first sweep should complete after one rotation, got step " + std::to_string(first_frame_step));
+}
+}
+
+int main()
+{
+    try {
+        TestParallelScanMatchesSerial();
+        TestIncrementalSweepMatchesFullScan();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "lidar_scan_engine_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
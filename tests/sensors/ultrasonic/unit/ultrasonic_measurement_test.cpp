@@ -5,6 +5,8 @@
 #include <mujoco/mujoco.h>
 
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -130,12 +132,73 @@ void TestDeterministicUltrasonicMeasurement()
     HAKO_TEST_EXPECT(NearlyEqual(no_hit_frame.range, 2.0, kEpsilon), "unexpected no-hit range");
     HAKO_TEST_EXPECT(NearlyEqual(no_hit_frame.variance, 0.0, kEpsilon), "unexpected no-hit variance");
 }
+
+std::filesystem::path WriteConeConfig(int threads)
+{
+    const auto path = std::filesystem::temp_directory_path()
+        / ("hako_ultrasonic_cone_" + std::to_string(threads) + ".json");
+    std::ofstream ofs(path);
+    if (!ofs) {
+        throw std::runtime_error("failed to write ultrasonic config: " + path.string());
+    }
+    ofs << R"({
+  "spec": {
+    "frame_id": "cone_test",
+    "RadiationType": "ultrasound",
+    "DetectionDistance": { "Min": 0.05, "Max": 2.0 },
+    "DistanceAccuracy": [
+      { "Range": { "Min": 0.05, "Max": 2.0 }, "StdDev": 0.0, "Precision": 0.0, "NoiseDistribution": "none" }
+    ],
+    "Cone": { "Horizontal": 0.8, "Vertical": 0.3, "RayCount": 64 },
+    "RayEngine": { "Threads": )" << threads << R"(, "MinRaysPerThread": 4 },
+    "update_rate_hz": 100.0
+  },
+  "mjcf_binding": { "source_site": "front_ultrasonic_site" },
+  "pdu_config": { "pdu_name": "range", "update_rate_hz": 100.0, "message_type": "sensor_msgs/Range" }
+})";
+    return path;
+}
+
+// A 64-ray cone must reduce to the same nearest hit however the rays are
+// split across threads.
+void TestParallelConeMatchesSerial()
+{
+    auto world = std::make_shared<TestWorld>();
+    world->loadModel((RepoRoot() / "models/sensors/ultrasonic/ultrasonic-sensor-test.xml").string());
+
+    auto* model = world->getModel();
+    auto* data = world->getData();
+    const int qpos_addr = FindBaseFreejointQposAddr(model);
+
+    hako::robots::sensor::ultrasonic::UltrasonicSensor serial(world, "front_ultrasonic_site", "base_footprint");
+    HAKO_TEST_EXPECT(serial.LoadConfig(WriteConeConfig(1).string()), "serial cone config should load");
+
+    hako::robots::sensor::ultrasonic::UltrasonicSensor parallel(world, "front_ultrasonic_site", "base_footprint");
+    HAKO_TEST_EXPECT(parallel.LoadConfig(WriteConeConfig(4).string()), "parallel cone config should load");
+    HAKO_TEST_EXPECT(parallel.GetConfig().ray_engine.threads == 4, "unexpected RayEngine.Threads");
+
+    const double positions[][2] = {{0.0, 0.0}, {0.05, 0.0}, {0.45, 0.30}, {0.45, 0.55}};
+    for (const auto& p : positions) {
+        SetBasePosition(model, data, qpos_addr, p[0], p[1], 0.1);
+        const auto expected = Measure(serial);
+        // Measure twice to make sure the reused ray buffers do not leak state.
+        for (int repeat = 0; repeat < 2; ++repeat) {
+            const auto actual = Measure(parallel);
+            HAKO_TEST_EXPECT(actual.status == expected.status, "parallel cone status should match serial");
+            HAKO_TEST_EXPECT(actual.range == expected.range, "parallel cone range should match serial");
+        }
+    }
+
+    SetBasePosition(model, data, qpos_addr, 0.0, 0.0, 0.1);
+    HAKO_TEST_EXPECT(Measure(parallel).status == UltrasonicStatus::OK, "cone should hit from the start pose");
+}
 }
 
 int main()
 {
     try {
         TestDeterministicUltrasonicMeasurement();
+        TestParallelConeMatchesSerial();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;